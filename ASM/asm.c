@@ -0,0 +1,85 @@
+/*
+ * Herramienta asm del Sistema Operativo Virtual (asm.exe).
+ * Ensambla un fuente con mnemónicos (sintaxis en ASM/assembler.h) al formato
+ * de palabras de texto que carga la consola o a una imagen binaria.
+ *
+ * Uso:
+ *   asm.exe fuente.asm [-o salida] [--image]
+ * Sin -o la salida es el fuente con extensión .txt (o .img con --image).
+ */
+
+/* Macro necesaria para clock_gettime() con -std=c99 */
+#define _POSIX_C_SOURCE 199309L
+
+/* Inclusión de cabeceras de otros módulos */
+#include "assembler.h"
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf, snprintf
+#include <string.h>   // Para strcmp, strrchr
+#include <time.h>     // Para clock_gettime
+
+/*
+ * Función auxiliar: default_output (ESTÁTICA)
+ * Propósito: Nombre de salida a partir del fuente, cambiando la extensión.
+ */
+static void default_output(const char* source, const char* extension, char* output, size_t size) {
+    snprintf(output, size, "%s", source);
+    char* dot = strrchr(output, '.');
+    char* slash = strrchr(output, '/');
+    if (dot != NULL && (slash == NULL || dot > slash)) *dot = '\0';
+    size_t length = strlen(output);
+    snprintf(output + length, size - length, "%s", extension);
+}
+
+int main(int argc, char* argv[]) {
+    const char* source = NULL;
+    const char* output = NULL;
+    int image = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "--image") == 0) {
+            image = 1;
+        } else if (argv[i][0] != '-' && source == NULL) {
+            source = argv[i];
+        } else {
+            source = NULL;
+            break;
+        }
+    }
+    if (source == NULL) {
+        printf("Uso: %s fuente.asm [-o salida] [--image]\n", argv[0]);
+        return 2;
+    }
+
+    char default_name[256];
+    if (output == NULL) {
+        default_output(source, image ? ".img" : ".txt", default_name, sizeof(default_name));
+        output = default_name;
+    }
+    if (strcmp(output, source) == 0) {
+        printf("Error: la salida sobrescribiría el fuente '%s'\n", source);
+        return 2;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    AsmProgram program;
+    int result = asm_assemble_file(source, &program);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed_ms = (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+
+    if (result != 0) {
+        printf("%s: %d errores, no se generó %s\n", source, program.errors, output);
+        asm_free(&program);
+        return 1;
+    }
+    result = image ? asm_write_image(&program, output) : asm_write_text(&program, output, source);
+    if (result == 0) {
+        printf("%s -> %s: %d palabras (%.2f ms)\n", source, output, program.count, elapsed_ms);
+    }
+    asm_free(&program);
+    return result == 0 ? 0 : 1;
+}
@@ -0,0 +1,917 @@
+/*
+ * Archivo de implementación del ensamblador del Sistema Operativo Virtual.
+ * Ensambla en una sola pasada sobre el fuente completo en memoria:
+ *   - Los símbolos (etiquetas y constantes) viven en una tabla hash con
+ *     direccionamiento abierto; los mnemónicos y las macros, en otra.
+ *   - Una referencia a una etiqueta aún no definida deja la palabra con el
+ *     valor en cero y anota la dirección en la lista de pendientes del símbolo;
+ *     al definirse la etiqueta se recorren sus pendientes y se completan.
+ *   - Las macros guardan su cuerpo al definirse y se expanden sustituyendo
+ *     los parámetros en el texto antes de ensamblar cada línea.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "assembler.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../ISA/isa.h"   // Tabla de mnemónicos
+#include "disassembler.h" // Para comentar el listado generado
+#include "../CPU/cpu.h"   // Para los modos de direccionamiento
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf, fopen, fread, fprintf
+#include <stdlib.h>   // Para malloc, realloc, free
+#include <string.h>   // Para memcpy, strlen, strchr
+#include <ctype.h>    // Para isdigit, isalpha, toupper
+#include <stdarg.h>   // Para los mensajes de error con formato
+
+/*
+ * CONSTANTES INTERNAS
+ * ARENA_BLOCK      - Bytes de cada bloque de la arena de nombres
+ * MAX_MACRO_PARAMS - Parámetros máximos de una macro
+ * MAX_NAME         - Longitud máxima de un mnemónico o nombre de macro
+ * MAX_OPERAND      - Mayor valor del campo de operando (5 dígitos)
+ */
+#define ARENA_BLOCK 65536
+#define MAX_MACRO_PARAMS 8
+#define MAX_NAME 32
+#define MAX_OPERAND 99999
+
+/*
+ * Tipos de símbolo
+ */
+enum {
+    SYM_UNDEFINED,  // Solo referenciado (tiene pendientes)
+    SYM_LABEL,      // Etiqueta: valor = dirección
+    SYM_CONST,      // Constante de .equ
+    SYM_OPCODE,     // Mnemónico: valor = opcode
+    SYM_MACRO       // Macro: valor = índice en la lista de macros
+};
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t used;
+    char data[ARENA_BLOCK];
+} ArenaBlock;
+
+typedef struct {
+    const char* name;   // En la arena
+    unsigned int hash;
+    int kind;
+    int value;
+    int fixups;         // Primera referencia pendiente (-1 = ninguna)
+} Symbol;
+
+typedef struct {
+    Symbol* list;       // Índices estables (la tabla hash guarda índice + 1)
+    int count;
+    int capacity;
+    int* slots;
+    int slot_mask;
+} SymbolTable;
+
+typedef struct {
+    int address;        // Palabra a completar
+    int addend;         // Constante sumada al símbolo
+    int line;
+    int data;           // 1 = palabra de .word, 0 = campo de operando
+    int next;           // Siguiente pendiente del mismo símbolo
+} Fixup;
+
+typedef struct {
+    const char* params[MAX_MACRO_PARAMS];
+    int param_count;
+    const char** body;
+    int lines;
+    int capacity;
+    int line;           // Línea de la definición
+} Macro;
+
+typedef struct {
+    AsmProgram* program;
+    const char* name;           // Archivo (mensajes de error)
+    ArenaBlock* arena;
+    SymbolTable symbols;        // Etiquetas y constantes
+    SymbolTable names;          // Mnemónicos y macros (en mayúsculas)
+    Fixup* fixups;
+    int fixup_count;
+    int fixup_capacity;
+    Macro* macros;
+    int macro_count;
+    int macro_capacity;
+    int open_macro;             // Macro en definición (-1 = ninguna)
+    int expansions;             // Contador para \@
+    const char* pending_label;  // Etiqueta para la próxima palabra generada
+    int pending_address;
+} Assembler;
+
+/*
+ * ============================================================================
+ * MEMORIA Y MENSAJES
+ * ============================================================================
+ */
+
+/*
+ * Función auxiliar: grow (ESTÁTICA)
+ * Propósito: Duplicar la capacidad de un arreglo dinámico si está lleno.
+ *            Un fallo de memoria termina el programa: no hay nada que rescatar.
+ */
+static void* grow(void* array, int* capacity, int count, size_t element) {
+    if (count < *capacity) return array;
+    *capacity = *capacity ? *capacity * 2 : 64;
+    array = realloc(array, (size_t)*capacity * element);
+    if (array == NULL) {
+        printf("Error: memoria insuficiente para ensamblar\n");
+        exit(1);
+    }
+    return array;
+}
+
+static const char* arena_copy(Assembler* as, const char* text, int length) {
+    if (as->arena == NULL || as->arena->used + (size_t)length + 1 > ARENA_BLOCK) {
+        ArenaBlock* block = malloc(sizeof(ArenaBlock));
+        if (block == NULL) {
+            printf("Error: memoria insuficiente para ensamblar\n");
+            exit(1);
+        }
+        block->next = as->arena;
+        block->used = 0;
+        as->arena = block;
+    }
+    char* copy = as->arena->data + as->arena->used;
+    memcpy(copy, text, (size_t)length);
+    copy[length] = '\0';
+    as->arena->used += (size_t)length + 1;
+    return copy;
+}
+
+static void error_at(Assembler* as, int line, const char* format, ...) {
+    if (as->program->errors++ >= ASM_MAX_ERRORS) return;
+    va_list args;
+    va_start(args, format);
+    printf("%s:%d: error: ", as->name, line);
+    vprintf(format, args);
+    printf("\n");
+    va_end(args);
+}
+
+/*
+ * ============================================================================
+ * TABLAS HASH
+ * ============================================================================
+ */
+
+static unsigned int hash_name(const char* name, int length) {
+    unsigned int hash = 2166136261u;  // FNV-1a
+    for (int i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/*
+ * Función auxiliar: table_find (ESTÁTICA)
+ * Retorna: int - índice del símbolo, o -1 si no existe
+ */
+static int table_find(const SymbolTable* table, const char* name, int length, unsigned int hash) {
+    if (table->slots == NULL) return -1;
+    for (unsigned int slot = hash & table->slot_mask; ; slot = (slot + 1) & table->slot_mask) {
+        int entry = table->slots[slot];
+        if (entry == 0) return -1;
+        const Symbol* s = &table->list[entry - 1];
+        if (s->hash == hash && strncmp(s->name, name, (size_t)length) == 0 && s->name[length] == '\0') {
+            return entry - 1;
+        }
+    }
+}
+
+/*
+ * Función auxiliar: table_add (ESTÁTICA)
+ * Retorna: int - índice del nuevo símbolo (se supone que no existía)
+ * Propósito: La tabla se duplica al superar el 50% de ocupación.
+ */
+static int table_add(Assembler* as, SymbolTable* table, const char* name, int length,
+                     unsigned int hash, int kind, int value) {
+    if ((table->count + 1) * 2 > table->slot_mask + 1) {
+        int slots = table->slots ? (table->slot_mask + 1) * 2 : 256;
+        free(table->slots);
+        table->slots = calloc((size_t)slots, sizeof(int));
+        if (table->slots == NULL) {
+            printf("Error: memoria insuficiente para ensamblar\n");
+            exit(1);
+        }
+        table->slot_mask = slots - 1;
+        for (int i = 0; i < table->count; i++) {
+            unsigned int slot = table->list[i].hash & table->slot_mask;
+            while (table->slots[slot] != 0) slot = (slot + 1) & table->slot_mask;
+            table->slots[slot] = i + 1;
+        }
+    }
+    table->list = grow(table->list, &table->capacity, table->count, sizeof(Symbol));
+    Symbol* s = &table->list[table->count];
+    s->name = arena_copy(as, name, length);
+    s->hash = hash;
+    s->kind = kind;
+    s->value = value;
+    s->fixups = -1;
+
+    unsigned int slot = hash & table->slot_mask;
+    while (table->slots[slot] != 0) slot = (slot + 1) & table->slot_mask;
+    table->slots[slot] = ++table->count;
+    return table->count - 1;
+}
+
+static int symbol_lookup(Assembler* as, const char* name, int length) {
+    unsigned int hash = hash_name(name, length);
+    int index = table_find(&as->symbols, name, length, hash);
+    return index >= 0 ? index : table_add(as, &as->symbols, name, length, hash, SYM_UNDEFINED, 0);
+}
+
+/*
+ * Función auxiliar: name_find (ESTÁTICA)
+ * Retorna: int - índice en la tabla de mnemónicos y macros, o -1
+ * Propósito: Búsqueda sin distinguir mayúsculas.
+ */
+static int name_find(Assembler* as, const char* name, int length) {
+    char upper[MAX_NAME];
+    if (length >= MAX_NAME) return -1;
+    for (int i = 0; i < length; i++) upper[i] = (char)toupper((unsigned char)name[i]);
+    return table_find(&as->names, upper, length, hash_name(upper, length));
+}
+
+static void add_name(Assembler* as, const char* name, int kind, int value) {
+    char upper[MAX_NAME];
+    int length = (int)strlen(name);
+    for (int i = 0; i < length; i++) upper[i] = (char)toupper((unsigned char)name[i]);
+    table_add(as, &as->names, upper, length, hash_name(upper, length), kind, value);
+}
+
+/*
+ * ============================================================================
+ * ANÁLISIS DE TEXTO
+ * ============================================================================
+ */
+
+static int is_name_start(char c) {
+    return isalpha((unsigned char)c) || c == '_' || c == '.';
+}
+
+static int is_name_char(char c) {
+    return isalnum((unsigned char)c) || c == '_' || c == '.';
+}
+
+static char* skip_spaces(const char* p) {
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    return (char*)p;
+}
+
+static void trim_end(char* text) {
+    size_t length = strlen(text);
+    while (length > 0 && isspace((unsigned char)text[length - 1])) text[--length] = '\0';
+}
+
+/*
+ * Función auxiliar: parse_expression (ESTÁTICA)
+ * Parámetros:
+ *   text    - expresión: [+|-] término {(+|-) término}; término = número,
+ *             símbolo o '$' (dirección actual)
+ *   here    - valor de '$': dirección de la palabra que se ensambla (o la
+ *             siguiente libre en directivas que no emiten)
+ *   value   - salida: valor (sin el símbolo pendiente, si lo hay)
+ *   pending - salida: símbolo aún no definido que falta sumar, o -1.
+ *             Solo se admite uno y sumado; el resto debe estar definido.
+ * Retorna: int - 0 si la expresión es válida, -1 si no (ya reportado)
+ */
+static int parse_expression(Assembler* as, const char* text, int here, int line, int* value, int* pending) {
+    const char* p = skip_spaces(text);
+    long long total = 0;
+    int sign = 1;
+    *pending = -1;
+    if (*p == '+' || *p == '-') {
+        sign = (*p == '-') ? -1 : 1;
+        p++;
+    }
+    for (;;) {
+        p = skip_spaces(p);
+        if (isdigit((unsigned char)*p)) {
+            long long number = 0;
+            while (isdigit((unsigned char)*p)) {
+                number = number * 10 + (*p++ - '0');
+                if (number > 999999999) {
+                    error_at(as, line, "número demasiado grande");
+                    return -1;
+                }
+            }
+            total += sign * number;
+        } else if (*p == '$') {
+            total += sign * here;
+            p++;
+        } else if (is_name_start(*p)) {
+            const char* start = p;
+            while (is_name_char(*p)) p++;
+            int index = symbol_lookup(as, start, (int)(p - start));
+            const Symbol* s = &as->symbols.list[index];
+            if (s->kind != SYM_UNDEFINED) {
+                total += sign * (long long)s->value;
+            } else if (sign > 0 && *pending < 0) {
+                *pending = index;
+            } else {
+                error_at(as, line, "'%s' debe definirse antes de usarse en esta expresión", s->name);
+                return -1;
+            }
+        } else {
+            error_at(as, line, "se esperaba un número o un símbolo en '%s'", text);
+            return -1;
+        }
+        p = skip_spaces(p);
+        if (*p == '\0') break;
+        if (*p != '+' && *p != '-') {
+            error_at(as, line, "carácter inesperado '%c' en '%s'", *p, text);
+            return -1;
+        }
+        sign = (*p++ == '-') ? -1 : 1;
+        if (total > 999999999 || total < -999999999) {
+            error_at(as, line, "valor fuera de rango en '%s'", text);
+            return -1;
+        }
+    }
+    if (total > 999999999 || total < -999999999) {
+        error_at(as, line, "valor fuera de rango en '%s'", text);
+        return -1;
+    }
+    *value = (int)total;
+    return 0;
+}
+
+/*
+ * Función auxiliar: split_arguments (ESTÁTICA)
+ * Retorna: int - cantidad de argumentos separados por comas (0 si está vacío)
+ * Propósito: Corta 'text' en el lugar; los argumentos quedan sin espacios.
+ */
+static int split_arguments(char* text, char** args, int max) {
+    int count = 0;
+    char* p = skip_spaces(text);
+    if (*p == '\0') return 0;
+    while (count < max) {
+        char* comma = strchr(p, ',');
+        if (comma) *comma = '\0';
+        trim_end(p);
+        args[count++] = p;
+        if (!comma) return count;
+        p = skip_spaces(comma + 1);
+    }
+    return max + 1;  // Demasiados argumentos
+}
+
+/*
+ * ============================================================================
+ * GENERACIÓN DE PALABRAS
+ * ============================================================================
+ */
+
+static void put_digits(char* out, int value, int count) {
+    for (int i = count - 1; i >= 0; i--) {
+        out[i] = (char)('0' + value % 10);
+        value /= 10;
+    }
+}
+
+static void set_operand(Word* w, int value) {
+    put_digits(w->data + 3, value, 5);
+}
+
+static void set_data(Word* w, int value) {
+    w->data[0] = value < 0 ? '1' : '0';
+    put_digits(w->data + 1, value < 0 ? -value : value, 7);
+    w->data[8] = '\0';
+}
+
+/*
+ * Función auxiliar: emit (ESTÁTICA)
+ * Retorna: int - dirección de la palabra agregada, o -1 si el programa
+ *          supera ASM_MAX_WORDS
+ */
+static int emit(Assembler* as, int line, int is_data) {
+    AsmProgram* program = as->program;
+    if (program->count >= ASM_MAX_WORDS) {
+        if (program->count == ASM_MAX_WORDS) error_at(as, line, "el programa supera %d palabras", ASM_MAX_WORDS);
+        return -1;
+    }
+    if (program->count == program->capacity) {
+        int capacity = program->capacity;
+        program->words = grow(program->words, &capacity, program->count, sizeof(Word));
+        capacity = program->capacity;
+        program->lines = grow(program->lines, &capacity, program->count, sizeof(int));
+        capacity = program->capacity;
+        program->is_data = grow(program->is_data, &capacity, program->count, 1);
+        capacity = program->capacity;
+        program->labels = grow(program->labels, &capacity, program->count, sizeof(char*));
+        program->capacity = capacity;
+    }
+    int address = program->count++;
+    set_data(&program->words[address], 0);
+    program->lines[address] = line;
+    program->is_data[address] = (unsigned char)is_data;
+    program->labels[address] = NULL;
+    if (as->pending_label && as->pending_address == address) {
+        program->labels[address] = as->pending_label;
+        as->pending_label = NULL;
+    }
+    return address;
+}
+
+/*
+ * Función auxiliar: patch (ESTÁTICA)
+ * Propósito: Escribir el valor final de una referencia (inmediata o pendiente).
+ */
+static void patch(Assembler* as, int address, int value, int data, int line) {
+    Word* w = &as->program->words[address];
+    if (data) {
+        if (value > 9999999 || value < -9999999) {
+            error_at(as, line, "el valor %d no cabe en una palabra (7 dígitos)", value);
+            return;
+        }
+        set_data(w, value);
+    } else {
+        if (value < 0 || value > MAX_OPERAND) {
+            error_at(as, line, "el operando %d está fuera de rango (0-%d)", value, MAX_OPERAND);
+            return;
+        }
+        set_operand(w, value);
+    }
+}
+
+/*
+ * Función auxiliar: reference (ESTÁTICA)
+ * Propósito: Completar una palabra ahora o, si la expresión usa una etiqueta
+ *            aún no definida, anotarla en la lista de pendientes del símbolo.
+ */
+static void reference(Assembler* as, int address, int value, int pending, int data, int line) {
+    if (pending < 0) {
+        patch(as, address, value, data, line);
+        return;
+    }
+    as->fixups = grow(as->fixups, &as->fixup_capacity, as->fixup_count, sizeof(Fixup));
+    Fixup* f = &as->fixups[as->fixup_count];
+    f->address = address;
+    f->addend = value;
+    f->line = line;
+    f->data = data;
+    f->next = as->symbols.list[pending].fixups;
+    as->symbols.list[pending].fixups = as->fixup_count++;
+}
+
+static void define_symbol(Assembler* as, const char* name, int length, int kind, int value, int line) {
+    int index = symbol_lookup(as, name, length);
+    Symbol* s = &as->symbols.list[index];
+    if (s->kind != SYM_UNDEFINED) {
+        error_at(as, line, "'%s' ya está definido", s->name);
+        return;
+    }
+    s->kind = kind;
+    s->value = value;
+    for (int f = s->fixups; f >= 0; f = as->fixups[f].next) {
+        const Fixup* fix = &as->fixups[f];
+        patch(as, fix->address, value + fix->addend, fix->data, fix->line);
+    }
+    s->fixups = -1;
+    if (kind == SYM_LABEL && (as->pending_label == NULL || as->pending_address != value)) {
+        as->pending_label = s->name;
+        as->pending_address = value;
+    }
+}
+
+/*
+ * ============================================================================
+ * INSTRUCCIONES Y DIRECTIVAS
+ * ============================================================================
+ */
+
+static void assemble_instruction(Assembler* as, int opcode, char* operand, int line) {
+    int address = emit(as, line, 0);
+    if (address < 0) return;
+    Word* w = &as->program->words[address];
+    put_digits(w->data, opcode, 2);
+
+    AddressingMode mode = ADDR_DIRECT;
+    if (*operand == '\0') return;  // Sin operando: modo directo, valor 0
+    if (!isa_has_operand(opcode)) {
+        error_at(as, line, "%s no lleva operando", isa_mnemonic(opcode));
+        return;
+    }
+    if (*operand == '#') {
+        mode = ADDR_IMMEDIATE;
+        operand++;
+    } else {
+        char* open = strrchr(operand, '(');
+        if (open != NULL) {
+            char* reg = skip_spaces(open + 1);
+            if ((reg[0] != 'A' && reg[0] != 'a') || (reg[1] != 'C' && reg[1] != 'c') ||
+                *skip_spaces(reg + 2) != ')' || *skip_spaces(skip_spaces(reg + 2) + 1) != '\0') {
+                error_at(as, line, "el único registro índice es AC: '%s'", operand);
+                return;
+            }
+            mode = ADDR_INDEXED;
+            *open = '\0';
+        }
+    }
+    w->data[2] = (char)('0' + mode);
+    int value, pending;
+    if (parse_expression(as, operand, address, line, &value, &pending) == 0) {
+        reference(as, address, value, pending, 0, line);
+    }
+}
+
+static int directive_is(const char* name, int length, const char* directive) {
+    if ((int)strlen(directive) != length) return 0;
+    for (int i = 0; i < length; i++) {
+        if (tolower((unsigned char)name[i]) != directive[i]) return 0;
+    }
+    return 1;
+}
+
+static void directive_macro(Assembler* as, char* args, int line) {
+    char* p = skip_spaces(args);
+    char* start = p;
+    while (is_name_char(*p)) p++;
+    int length = (int)(p - start);
+    if (length == 0 || length >= MAX_NAME || !is_name_start(*start)) {
+        error_at(as, line, ".macro necesita un nombre");
+        return;
+    }
+    if (name_find(as, start, length) >= 0) {
+        error_at(as, line, "'%.*s' ya es una instrucción o macro", length, start);
+        return;
+    }
+    as->macros = grow(as->macros, &as->macro_capacity, as->macro_count, sizeof(Macro));
+    Macro* m = &as->macros[as->macro_count];
+    memset(m, 0, sizeof(*m));
+    m->line = line;
+    char name[MAX_NAME];
+    memcpy(name, start, (size_t)length);
+    name[length] = '\0';
+
+    char* params[MAX_MACRO_PARAMS + 1];
+    int count = split_arguments(p, params, MAX_MACRO_PARAMS);
+    if (count > MAX_MACRO_PARAMS) {
+        error_at(as, line, "una macro admite como máximo %d parámetros", MAX_MACRO_PARAMS);
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        int n = (int)strlen(params[i]);
+        for (int k = 0; k < n; k++) {
+            if (!is_name_char(params[i][k])) {
+                error_at(as, line, "parámetro inválido '%s'", params[i]);
+                return;
+            }
+        }
+        m->params[i] = arena_copy(as, params[i], n);
+    }
+    m->param_count = count;
+    add_name(as, name, SYM_MACRO, as->macro_count);
+    as->open_macro = as->macro_count++;
+}
+
+static void assemble_line(Assembler* as, char* text, int line, int depth);
+
+/*
+ * Función auxiliar: expand_macro (ESTÁTICA)
+ * Propósito: Ensamblar el cuerpo de la macro sustituyendo \parámetro por el
+ *            argumento correspondiente y \@ por el número de expansión.
+ */
+static void expand_macro(Assembler* as, const Macro* m, char* args_text, int line, int depth) {
+    if (depth >= ASM_MAX_MACRO_DEPTH) {
+        error_at(as, line, "demasiados niveles de macros (¿recursión?)");
+        return;
+    }
+    char* args[MAX_MACRO_PARAMS + 1];
+    int count = split_arguments(args_text, args, MAX_MACRO_PARAMS);
+    if (count != m->param_count) {
+        error_at(as, line, "la macro espera %d argumentos y recibió %d", m->param_count, count);
+        return;
+    }
+    int expansion = ++as->expansions;
+    for (int b = 0; b < m->lines; b++) {
+        char expanded[ASM_MAX_LINE];
+        int out = 0;
+        int ok = 1;
+        for (const char* p = m->body[b]; *p && ok; ) {
+            char piece[16];
+            const char* insert = NULL;
+            if (*p == '\\' && p[1] == '@') {
+                snprintf(piece, sizeof(piece), "%d", expansion);
+                insert = piece;
+                p += 2;
+            } else if (*p == '\\' && is_name_start(p[1])) {
+                const char* start = ++p;
+                while (is_name_char(*p)) p++;
+                for (int i = 0; i < m->param_count; i++) {
+                    if ((int)strlen(m->params[i]) == p - start && strncmp(m->params[i], start, (size_t)(p - start)) == 0) {
+                        insert = args[i];
+                    }
+                }
+                if (insert == NULL) {
+                    error_at(as, line, "parámetro de macro desconocido '\\%.*s'", (int)(p - start), start);
+                    ok = 0;
+                    break;
+                }
+            } else {
+                piece[0] = *p++;
+                piece[1] = '\0';
+                insert = piece;
+            }
+            int length = (int)strlen(insert);
+            if (out + length >= ASM_MAX_LINE) {
+                error_at(as, line, "línea demasiado larga al expandir la macro");
+                ok = 0;
+                break;
+            }
+            memcpy(expanded + out, insert, (size_t)length);
+            out += length;
+        }
+        if (!ok) return;
+        expanded[out] = '\0';
+        assemble_line(as, expanded, line, depth + 1);
+    }
+}
+
+static void assemble_directive(Assembler* as, const char* name, int length, char* args, int line) {
+    if (directive_is(name, length, "word")) {
+        char* values[ASM_MAX_LINE / 2];
+        int count = split_arguments(args, values, ASM_MAX_LINE / 2 - 1);
+        if (count == 0) error_at(as, line, ".word necesita al menos un valor");
+        for (int i = 0; i < count; i++) {
+            int address = emit(as, line, 1);
+            int value, pending;
+            if (address >= 0 && parse_expression(as, values[i], address, line, &value, &pending) == 0) {
+                reference(as, address, value, pending, 1, line);
+            }
+        }
+    } else if (directive_is(name, length, "space") || directive_is(name, length, "org")) {
+        int value, pending;
+        if (parse_expression(as, args, as->program->count, line, &value, &pending) != 0) return;
+        if (pending >= 0) {
+            error_at(as, line, "'%s' debe definirse antes de .%.*s", as->symbols.list[pending].name, length, name);
+            return;
+        }
+        int target = directive_is(name, length, "org") ? value : as->program->count + value;
+        if (target < as->program->count || target > ASM_MAX_WORDS) {
+            error_at(as, line, ".%.*s no puede retroceder ni superar %d palabras", length, name, ASM_MAX_WORDS);
+            return;
+        }
+        while (as->program->count < target) emit(as, line, 1);
+    } else if (directive_is(name, length, "equ")) {
+        char* parts[3];
+        if (split_arguments(args, parts, 2) != 2 || !is_name_start(parts[0][0]) ||
+            parts[0][strspn(parts[0], "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789_.")] != '\0') {
+            error_at(as, line, "uso: .equ NOMBRE, expresión");
+            return;
+        }
+        int value, pending;
+        if (parse_expression(as, parts[1], as->program->count, line, &value, &pending) != 0) return;
+        if (pending >= 0) {
+            error_at(as, line, "'%s' debe definirse antes de .equ", as->symbols.list[pending].name);
+            return;
+        }
+        define_symbol(as, parts[0], (int)strlen(parts[0]), SYM_CONST, value, line);
+    } else if (directive_is(name, length, "macro")) {
+        directive_macro(as, args, line);
+    } else if (directive_is(name, length, "endm")) {
+        error_at(as, line, ".endm sin .macro");
+    } else {
+        error_at(as, line, "directiva desconocida '.%.*s'", length, name);
+    }
+}
+
+/*
+ * Función auxiliar: assemble_line (ESTÁTICA)
+ * Parámetros: text - línea (se modifica), line - número de línea, depth - macros anidadas
+ */
+static void assemble_line(Assembler* as, char* text, int line, int depth) {
+    char* comment = strchr(text, ';');
+    if (comment) *comment = '\0';
+    char* p = skip_spaces(text);
+
+    // Cuerpo de una macro: guardar sin ensamblar hasta .endm
+    if (as->open_macro >= 0) {
+        char* q = p;
+        while (is_name_char(*q)) q++;
+        if (directive_is(p, (int)(q - p), ".endm")) {
+            as->open_macro = -1;
+        } else if (directive_is(p, (int)(q - p), ".macro")) {
+            error_at(as, line, "no se puede definir una macro dentro de otra");
+        } else if (*p != '\0') {
+            Macro* m = &as->macros[as->open_macro];
+            m->body = grow(m->body, &m->capacity, m->lines, sizeof(char*));
+            m->body[m->lines++] = arena_copy(as, text, (int)strlen(text));
+        }
+        return;
+    }
+
+    // Etiquetas ("nombre:"), puede haber varias
+    while (is_name_start(*p) && *p != '.') {
+        char* q = p;
+        while (is_name_char(*q)) q++;
+        if (*q != ':') break;
+        define_symbol(as, p, (int)(q - p), SYM_LABEL, as->program->count, line);
+        p = skip_spaces(q + 1);
+    }
+    if (*p == '\0') return;
+
+    char* name = p;
+    while (is_name_char(*p)) p++;
+    int length = (int)(p - name);
+    if (length == 0) {
+        error_at(as, line, "se esperaba una instrucción en '%s'", name);
+        return;
+    }
+    if (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+        error_at(as, line, "se esperaba una instrucción en '%s'", name);
+        return;
+    }
+    char* args = skip_spaces(p);
+    trim_end(args);
+
+    if (name[0] == '.') {
+        assemble_directive(as, name + 1, length - 1, args, line);
+        return;
+    }
+    int index = name_find(as, name, length);
+    if (index < 0) {
+        error_at(as, line, "instrucción desconocida '%.*s'", length, name);
+        return;
+    }
+    const Symbol* s = &as->names.list[index];
+    if (s->kind == SYM_MACRO) {
+        expand_macro(as, &as->macros[s->value], args, line, depth);
+    } else {
+        assemble_instruction(as, s->value, args, line);
+    }
+}
+
+/*
+ * ============================================================================
+ * INTERFAZ PÚBLICA
+ * ============================================================================
+ */
+
+/*
+ * Función: asm_assemble_source
+ * Propósito: Ver assembler.h.
+ */
+int asm_assemble_source(char* text, const char* name, AsmProgram* program) {
+    static const struct { const char* alias; int opcode; } aliases[] = {
+        { "ADD", 0 }, { "SUB", 1 }, { "MUL", 2 }, { "DIV", 3 }, { "JMP", 27 }
+    };
+    Assembler as;
+    memset(&as, 0, sizeof(as));
+    memset(program, 0, sizeof(*program));
+    as.program = program;
+    as.name = name;
+    as.open_macro = -1;
+
+    for (int opcode = 0; opcode < ISA_MAX_OPCODES; opcode++) {
+        if (isa_is_implemented(opcode)) add_name(&as, isa_mnemonic(opcode), SYM_OPCODE, opcode);
+    }
+    for (size_t i = 0; i < sizeof(aliases) / sizeof(aliases[0]); i++) {
+        add_name(&as, aliases[i].alias, SYM_OPCODE, aliases[i].opcode);
+    }
+
+    int line = 0;
+    for (char* p = text; *p; ) {
+        char* end = strchr(p, '\n');
+        if (end) *end = '\0';
+        line++;
+        if (strlen(p) >= ASM_MAX_LINE) {
+            error_at(&as, line, "línea demasiado larga (máximo %d caracteres)", ASM_MAX_LINE - 1);
+        } else {
+            assemble_line(&as, p, line, 0);
+        }
+        if (!end) break;
+        p = end + 1;
+    }
+
+    if (as.open_macro >= 0) {
+        error_at(&as, as.macros[as.open_macro].line, "falta .endm");
+    }
+    for (int i = 0; i < as.symbols.count; i++) {
+        const Symbol* s = &as.symbols.list[i];
+        if (s->kind != SYM_UNDEFINED) continue;
+        for (int f = s->fixups; f >= 0; f = as.fixups[f].next) {
+            error_at(&as, as.fixups[f].line, "símbolo no definido '%s'", s->name);
+        }
+    }
+    if (program->errors > ASM_MAX_ERRORS) {
+        printf("%s: %d errores más no mostrados\n", name, program->errors - ASM_MAX_ERRORS);
+    }
+
+    // Los nombres de las etiquetas siguen en uso (program->labels): la arena pasa al programa
+    program->arena = as.arena;
+    for (int i = 0; i < as.macro_count; i++) free(as.macros[i].body);
+    free(as.macros);
+    free(as.fixups);
+    free(as.symbols.list);
+    free(as.symbols.slots);
+    free(as.names.list);
+    free(as.names.slots);
+    return program->errors ? -1 : 0;
+}
+
+/*
+ * Función: asm_assemble_file
+ * Propósito: Leer el archivo completo y ensamblarlo.
+ */
+int asm_assemble_file(const char* filename, AsmProgram* program) {
+    memset(program, 0, sizeof(*program));
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        printf("Error: no se pudo abrir el archivo '%s'\n", filename);
+        program->errors = 1;
+        return -1;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* text = malloc((size_t)size + 1);
+    if (text == NULL || fread(text, 1, (size_t)size, file) != (size_t)size) {
+        printf("Error: no se pudo leer '%s'\n", filename);
+        free(text);
+        fclose(file);
+        program->errors = 1;
+        return -1;
+    }
+    fclose(file);
+    text[size] = '\0';
+    int result = asm_assemble_source(text, filename, program);
+    free(text);
+    return result;
+}
+
+/*
+ * Función: asm_write_text
+ * Propósito: Ver assembler.h.
+ */
+int asm_write_text(const AsmProgram* program, const char* filename, const char* source) {
+    FILE* out = fopen(filename, "w");
+    if (!out) {
+        printf("Error: no se pudo crear '%s'\n", filename);
+        return -1;
+    }
+    fprintf(out, "# Ensamblado desde %s\n", source);
+    for (int i = 0; i < program->count; i++) {
+        const char* data = program->words[i].data;
+        DisasmLine decoded;
+        char comment[DISASM_TEXT_SIZE];
+        disasm_decode(&program->words[i], &decoded);
+        if (program->is_data[i]) decoded.is_instruction = 0;
+        disasm_format(&decoded, comment);
+        if (program->labels[i]) {
+            fprintf(out, "%s    # %d: %-16s <- %s\n", data, i, comment, program->labels[i]);
+        } else {
+            fprintf(out, "%s    # %d: %s\n", data, i, comment);
+        }
+    }
+    if (fclose(out) != 0) {
+        printf("Error: no se pudo escribir '%s'\n", filename);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Función: asm_write_image
+ * Propósito: Ver assembler.h.
+ */
+int asm_write_image(const AsmProgram* program, const char* filename) {
+    FILE* out = fopen(filename, "wb");
+    if (!out) {
+        printf("Error: no se pudo crear '%s'\n", filename);
+        return -1;
+    }
+    fwrite(ASM_IMAGE_MAGIC, 1, 8, out);
+    for (int i = 0; i < program->count; i++) {
+        fwrite(program->words[i].data, 1, 8, out);
+    }
+    if (fclose(out) != 0) {
+        printf("Error: no se pudo escribir '%s'\n", filename);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Función: asm_free
+ */
+void asm_free(AsmProgram* program) {
+    ArenaBlock* block = program->arena;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(program->words);
+    free(program->lines);
+    free(program->is_data);
+    free(program->labels);
+    memset(program, 0, sizeof(*program));
+}
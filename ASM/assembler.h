@@ -0,0 +1,120 @@
+/*
+ * Archivo de cabecera del ensamblador del Sistema Operativo Virtual.
+ * Traduce código fuente con mnemónicos a las palabras de 8 dígitos que
+ * ejecuta la CPU virtual. Lo usan la herramienta asm.exe y la consola
+ * (los programas '.asm' se ensamblan al cargarlos).
+ *
+ * Sintaxis (una instrucción o directiva por línea, comentarios desde ';'):
+ *   etiqueta:  LOAD #5          ; inmediato
+ *              STR  dato        ; directo
+ *              LOAD 10(AC)      ; indexado
+ *              JLT  etiqueta+2  ; expresiones: números, símbolos, '$', + y -
+ *   dato:      .word 0, -3, 04100000
+ *              .space 10        ; 10 palabras en cero
+ *              .org 100         ; rellenar con ceros hasta la dirección 100
+ *              .equ LIMITE, 50  ; constante
+ *              .macro INC2 x    ; macro con parámetros (\x en el cuerpo,
+ *              LOAD \x          ;  \@ = número único de expansión)
+ *              SUM #2
+ *              STR \x
+ *              .endm
+ *
+ * Los mnemónicos son los de la tabla ISA (sin distinguir mayúsculas), más
+ * los alias ADD, SUB, MUL, DIV y JMP. Se ensambla en una sola pasada: las
+ * referencias a etiquetas aún no definidas se anotan en una lista por
+ * símbolo (tabla hash) y se completan cuando la etiqueta aparece.
+ */
+
+#ifndef ASSEMBLER_H
+#define ASSEMBLER_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../types.h"  // Para el tipo Word
+
+/*
+ * CONSTANTES DEL ENSAMBLADOR
+ * ASM_MAX_WORDS      - Palabras máximas de un programa ensamblado
+ * ASM_MAX_LINE       - Longitud máxima de una línea (también tras expandir macros)
+ * ASM_MAX_ERRORS     - Errores que se muestran antes de dejar de reportar
+ * ASM_MAX_MACRO_DEPTH - Anidamiento máximo de expansiones de macros
+ * ASM_IMAGE_MAGIC    - Cabecera de las imágenes binarias (8 bytes)
+ */
+#define ASM_MAX_WORDS (1 << 20)
+#define ASM_MAX_LINE 512
+#define ASM_MAX_ERRORS 20
+#define ASM_MAX_MACRO_DEPTH 16
+#define ASM_IMAGE_MAGIC "SOVIMG01"
+
+/*
+ * Estructura: AsmProgram
+ * Propósito: Resultado de ensamblar un fuente.
+ *
+ * Campos:
+ *   words   - palabras generadas (dirección lógica = índice)
+ *   lines   - línea del fuente que generó cada palabra
+ *   is_data - 1 si la palabra viene de .word/.space/.org
+ *   labels  - primera etiqueta definida en cada dirección (o NULL)
+ *   count   - palabras generadas
+ *   errors  - errores encontrados (si es distinto de 0 el programa no es usable)
+ *   arena   - memoria interna de los nombres (liberada por asm_free)
+ */
+typedef struct {
+    Word* words;
+    int* lines;
+    unsigned char* is_data;
+    const char** labels;
+    int count;
+    int capacity;
+    int errors;
+    void* arena;
+} AsmProgram;
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del ensamblador
+ */
+
+/*
+ * Función: asm_assemble_file
+ * Parámetros:
+ *   filename - archivo fuente
+ *   program  - resultado (inicializado por la función; liberar con asm_free)
+ * Retorna: int - 0 si se ensambló sin errores, -1 si hubo errores
+ *          (se muestran como "archivo:línea: error: ...")
+ */
+int asm_assemble_file(const char* filename, AsmProgram* program);
+
+/*
+ * Función: asm_assemble_source
+ * Parámetros:
+ *   text    - fuente completo (se modifica durante el ensamblado)
+ *   name    - nombre para los mensajes de error
+ *   program - resultado
+ * Retorna: int - 0 si no hubo errores, -1 en otro caso
+ */
+int asm_assemble_source(char* text, const char* name, AsmProgram* program);
+
+/*
+ * Función: asm_write_text
+ * Parámetros: program, filename, source - fuente original (para la cabecera)
+ * Retorna: int - 0 si se escribió, -1 si no se pudo crear el archivo
+ * Propósito: Formato de palabras de texto de load_program_file, una por línea
+ *            con la dirección y la instrucción como comentario.
+ */
+int asm_write_text(const AsmProgram* program, const char* filename, const char* source);
+
+/*
+ * Función: asm_write_image
+ * Parámetros: program, filename
+ * Retorna: int - 0 si se escribió, -1 si no
+ * Propósito: Imagen binaria: ASM_IMAGE_MAGIC seguido de los 8 caracteres de
+ *            cada palabra, sin separadores. load_program_file la reconoce
+ *            por la cabecera.
+ */
+int asm_write_image(const AsmProgram* program, const char* filename);
+
+void asm_free(AsmProgram* program);  // Liberar la memoria del resultado
+
+#endif /* ASSEMBLER_H */
@@ -0,0 +1,91 @@
+/*
+ * Herramienta disasm del Sistema Operativo Virtual (disasm.exe).
+ * Desensambla un programa o una imagen de memoria sin cargarla en el
+ * emulador: lee palabra por palabra y escribe cada una al leerla, por lo que
+ * la memoria usada no depende del tamaño de la imagen.
+ *
+ * Uso:
+ *   disasm.exe archivo [inicio] [fin]
+ * El archivo puede estar en el formato de texto de la consola (una palabra
+ * por línea, comentarios con '#' o ';') o ser una imagen binaria de asm.exe.
+ * Las direcciones son las lógicas del programa (índice de la palabra).
+ */
+
+/* Inclusión de cabeceras de otros módulos */
+#include "disassembler.h"
+#include "assembler.h"   // Para ASM_IMAGE_MAGIC
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf, fopen, fgets, fread
+#include <stdlib.h>   // Para atoi
+#include <string.h>   // Para strcspn, strtok, memcmp
+
+/*
+ * Función auxiliar: next_word (ESTÁTICA)
+ * Parámetros: file, image - 1 si es imagen binaria, w - salida, line - línea actual (texto)
+ * Retorna: int - 1 si se leyó una palabra, 0 al final, -1 si hay una palabra inválida
+ */
+static int next_word(FILE* file, int image, Word* w, int* line) {
+    if (image) {
+        size_t got = fread(w->data, 1, 8, file);
+        w->data[8] = '\0';
+        if (got == 0) return 0;
+        return got == 8 ? 1 : -1;
+    }
+    char text[200];
+    while (fgets(text, sizeof(text), file) != NULL) {
+        (*line)++;
+        text[strcspn(text, "#;")] = '\0';
+        char* token = strtok(text, " \t\r\n");
+        if (token == NULL) continue;
+        if (strlen(token) != 8) return -1;
+        memcpy(w->data, token, 9);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 4) {
+        printf("Uso: %s archivo [inicio] [fin]\n", argv[0]);
+        return 2;
+    }
+    int start = (argc > 2) ? atoi(argv[2]) : 0;
+    int end = (argc > 3) ? atoi(argv[3]) : -1;  // -1 = hasta el final
+
+    FILE* file = fopen(argv[1], "rb");
+    if (!file) {
+        printf("Error: no se pudo abrir el archivo '%s'\n", argv[1]);
+        return 1;
+    }
+    char magic[8];
+    int image = (fread(magic, 1, 8, file) == 8 && memcmp(magic, ASM_IMAGE_MAGIC, 8) == 0);
+    if (!image) rewind(file);
+
+    Word w;
+    int line = 0;
+    int result;
+    for (int address = 0; (result = next_word(file, image, &w, &line)) == 1; address++) {
+        if (address < start) continue;
+        if (end >= 0 && address > end) break;
+
+        DisasmLine decoded;
+        char text[DISASM_TEXT_SIZE];
+        disasm_decode(&w, &decoded);
+        disasm_format(&decoded, text);
+        if (decoded.target != DISASM_NO_TARGET) {
+            printf("%6d  %s  %-19s -> %d\n", address, w.data, text, decoded.target);
+        } else if (decoded.jumps) {
+            printf("%6d  %s  %-19s -> AC+%d\n", address, w.data, text, decoded.value);
+        } else {
+            printf("%6d  %s  %s\n", address, w.data, text);
+        }
+    }
+    fclose(file);
+    if (result < 0) {
+        if (image) printf("Error: imagen truncada\n");
+        else printf("Error: línea %d: palabra inválida\n", line);
+        return 1;
+    }
+    return 0;
+}
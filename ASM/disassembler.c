@@ -0,0 +1,85 @@
+/*
+ * Archivo de implementación del desensamblador del Sistema Operativo Virtual.
+ * No depende del estado de la máquina: solo de la tabla ISA, para poder
+ * usarse también desde las herramientas que leen imágenes de memoria.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "disassembler.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../ISA/isa.h"   // Mnemónicos y operandos de cada opcode
+#include "../CPU/cpu.h"   // Para los modos de direccionamiento
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para snprintf
+
+/*
+ * Función auxiliar: is_jump (ESTÁTICA)
+ * Retorna: int - 1 para las instrucciones que cambian el PC a su operando
+ */
+static int is_jump(int opcode) {
+    return isa_is_conditional_branch(opcode) || opcode == 14 || opcode == 27;  // CALL, J
+}
+
+/*
+ * Función: disasm_set
+ */
+void disasm_set(int opcode, int mode, int value, DisasmLine* line) {
+    line->opcode = opcode;
+    line->mode = mode;
+    line->value = value;
+    line->is_instruction = isa_is_implemented(opcode) && mode >= ADDR_DIRECT && mode <= ADDR_INDEXED;
+    line->data = opcode * 1000000 + mode * 100000 + value;
+    line->jumps = line->is_instruction && is_jump(opcode);
+    line->target = DISASM_NO_TARGET;
+    if (line->jumps && mode != ADDR_INDEXED) {
+        line->target = value;  // Directo e inmediato saltan al valor; indexado depende del AC
+    }
+}
+
+/*
+ * Función: disasm_decode
+ */
+void disasm_decode(const Word* w, DisasmLine* line) {
+    int digits[8];
+    int valid = (w->data[8] == '\0');
+    for (int i = 0; i < 8; i++) {
+        digits[i] = w->data[i] - '0';
+        if (digits[i] < 0 || digits[i] > 9) valid = 0;
+    }
+    if (!valid) {
+        disasm_set(-1, 0, 0, line);  // Ni siquiera es un número: dato 0
+        line->data = 0;
+        return;
+    }
+    int value = 0;
+    for (int i = 3; i < 8; i++) value = value * 10 + digits[i];
+    disasm_set(digits[0] * 10 + digits[1], digits[2], value, line);
+
+    // Como dato, la palabra es signo-magnitud
+    int magnitude = 0;
+    for (int i = 1; i < 8; i++) magnitude = magnitude * 10 + digits[i];
+    line->data = (digits[0] == 1) ? -magnitude : magnitude;
+}
+
+/*
+ * Función: disasm_format
+ */
+void disasm_format(const DisasmLine* line, char* text) {
+    if (!line->is_instruction) {
+        snprintf(text, DISASM_TEXT_SIZE, ".word %d", line->data);
+        return;
+    }
+    const char* mnemonic = isa_mnemonic(line->opcode);
+    if (!isa_has_operand(line->opcode) ||
+        (line->opcode == 40 && line->mode == ADDR_DIRECT && line->value == 0)) {  // HALT
+        snprintf(text, DISASM_TEXT_SIZE, "%s", mnemonic);
+    } else if (line->mode == ADDR_IMMEDIATE) {
+        snprintf(text, DISASM_TEXT_SIZE, "%s #%d", mnemonic, line->value);
+    } else if (line->mode == ADDR_INDEXED) {
+        snprintf(text, DISASM_TEXT_SIZE, "%s %d(AC)", mnemonic, line->value);
+    } else {
+        snprintf(text, DISASM_TEXT_SIZE, "%s %d", mnemonic, line->value);
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Archivo de cabecera del desensamblador del Sistema Operativo Virtual.
+ * Convierte palabras de memoria a la sintaxis del ensamblador ("LOAD #5",
+ * "STR 120", "CMP 4(AC)") y resuelve el destino de los saltos y CALL.
+ * Lo usan el comando 'disasm' de la consola, la herramienta disasm.exe y
+ * el listado que genera asm.exe.
+ */
+
+#ifndef DISASSEMBLER_H
+#define DISASSEMBLER_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../types.h"  // Para el tipo Word
+
+/*
+ * CONSTANTES DEL DESENSAMBLADOR
+ * DISASM_NO_TARGET - La instrucción no salta o su destino depende del AC
+ * DISASM_TEXT_SIZE - Tamaño suficiente para el texto de una instrucción
+ */
+#define DISASM_NO_TARGET -1
+#define DISASM_TEXT_SIZE 40
+
+/*
+ * Estructura: DisasmLine
+ * Propósito: Una palabra interpretada como instrucción o como dato.
+ *
+ * Campos:
+ *   is_instruction - 1 si el opcode está implementado y el modo es válido
+ *   opcode, mode, value - campos de la instrucción
+ *   data   - valor numérico de la palabra (para mostrarla como .word)
+ *   jumps  - 1 si es un salto (condicional o no) o un CALL
+ *   target - dirección lógica de destino, o DISASM_NO_TARGET si no salta o
+ *            el destino depende del AC (modo indexado)
+ */
+typedef struct {
+    int is_instruction;
+    int opcode;
+    int mode;
+    int value;
+    int data;
+    int jumps;
+    int target;
+} DisasmLine;
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del desensamblador
+ */
+
+/*
+ * Función: disasm_decode
+ * Parámetros: w - palabra de memoria, line - salida
+ * Propósito: Interpretar los dígitos de la palabra. Las palabras que no son
+ *            instrucciones válidas quedan como datos.
+ */
+void disasm_decode(const Word* w, DisasmLine* line);
+
+/*
+ * Función: disasm_set
+ * Parámetros: opcode, mode, value - instrucción ya decodificada (por ejemplo
+ *             por la caché de bloques); line - salida
+ */
+void disasm_set(int opcode, int mode, int value, DisasmLine* line);
+
+/*
+ * Función: disasm_format
+ * Parámetros: line - palabra interpretada, text - salida (DISASM_TEXT_SIZE bytes)
+ * Propósito: Texto en sintaxis del ensamblador; los datos como ".word N".
+ */
+void disasm_format(const DisasmLine* line, char* text);
+
+#endif /* DISASSEMBLER_H */
@@ -0,0 +1,863 @@
+/*
+ * Programa de benchmarks del Sistema Operativo Virtual (bench.exe).
+ * Mide el rendimiento del emulador en dos niveles:
+ *   - Microbenchmarks de las primitivas del camino rápido (conversión de
+ *     palabras, decodificación, memoria, disco, logger y DMA), en ns/op.
+ *   - Macrobenchmarks que ejecutan programas del invitado representativos
+ *     (bucle, memoria, llamadas y E/S) sin pausas, en MIPS del invitado,
+ *     un ping-pong entre buzones en mensajes por segundo, un envío de
+ *     tramas entre dos VMs por la red local en tramas por segundo y un
+ *     barrido de parámetros (una instancia por valor) ejecutado de a una y
+ *     con el intérprete en lockstep, en MIPS agregados.
+ * Los resultados se escriben en JSON y se pueden comparar contra una
+ * ejecución anterior para detectar regresiones.
+ *
+ * Uso:
+ *   bench.exe [-o resultados.json] [--quick]
+ *   bench.exe --compare base.json nuevo.json [--threshold porcentaje]
+ *   bench.exe --verify
+ *
+ * --verify ejecuta cada programa de los macrobenchmarks con el intérprete,
+ * con la caché de bloques y con el JIT, y compara registros y memoria finales;
+ * después compara instancia por instancia cada implementación del
+ * intérprete en lockstep contra ejecuciones normales.
+ */
+
+/* Macro necesaria para clock_gettime() con -std=c99 */
+#define _POSIX_C_SOURCE 199309L
+
+/* Inclusión de cabeceras de los módulos del sistema */
+#include "../types.h"
+#include "../LOGGER/logger.h"
+#include "../MEMORY/memory.h"
+#include "../REGISTERS/registers.h"
+#include "../INTERRUPTS/interrupts.h"
+#include "../DISK/disk.h"
+#include "../SYSCALL/syscall.h"
+#include "../FS/fs.h"
+#include "../SHM/shm.h"
+#include "../MSG/msg.h"
+#include "../TERMINAL/terminal.h"
+#include "../MMIO/mmio.h"
+#include "../NET/net.h"
+#include "../SIM/sim.h"
+#include "../DMA/dma.h"
+#include "../CPU/cpu.h"
+#include "../CONSOLE/console.h"
+#include "../CPU/blockcache.h"
+#include "../CPU/jit.h"
+#include "../CODEC/wordcodec.h"
+#include "../CPU/lockstep.h"
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf, fopen, fprintf
+#include <stdlib.h>   // Para atof, qsort
+#include <string.h>   // Para strcmp, strncpy
+#include <time.h>     // Para clock_gettime, nanosleep
+#include <unistd.h>   // Para fork, getpid, _exit
+#include <sys/wait.h> // Para waitpid
+
+/*
+ * CONSTANTES DE CONFIGURACIÓN DE LOS BENCHMARKS
+ * BENCH_REPEATS        - Repeticiones de cada medición (se reporta la mediana)
+ * BENCH_MAX_RESULTS    - Máximo de resultados por ejecución / archivo comparado
+ * BENCH_MAX_GUEST      - Tope de instrucciones por macrobenchmark (evita bucles infinitos)
+ * BENCH_DEFAULT_THRESHOLD - Porcentaje de empeoramiento considerado regresión
+ */
+#define BENCH_REPEATS 5
+#define BENCH_MAX_RESULTS 32
+#define BENCH_MAX_GUEST 10000000ULL
+#define BENCH_DEFAULT_THRESHOLD 5.0
+
+/*
+ * CONSTANTES DEL BARRIDO DE PARÁMETROS
+ * BENCH_SWEEP_PROGRAM   - Pasos de Collatz del valor en la palabra BENCH_SWEEP_ADDRESS
+ * BENCH_SWEEP_INSTANCES - Instancias (valores 1, 2, ..., N)
+ */
+#define BENCH_SWEEP_PROGRAM "BENCH/programs/barrido.asm"
+#define BENCH_SWEEP_ADDRESS 1
+#define BENCH_SWEEP_INSTANCES 1024
+
+/*
+ * Estructura: BenchResult
+ * Propósito: Resultado de un benchmark (una línea del JSON).
+ *
+ * Campos:
+ *   name       - identificador estable del benchmark
+ *   unit       - "ns/op" (menor es mejor), "MIPS", "msg/s" o "frame/s" (mayor es mejor)
+ *   value      - mediana de las repeticiones
+ *   iterations - operaciones (o instrucciones del invitado) por repetición
+ */
+typedef struct {
+    char name[40];
+    char unit[8];
+    double value;
+    unsigned long long iterations;
+} BenchResult;
+
+/*
+ * VARIABLES GLOBALES ESTÁTICAS
+ */
+static BenchResult results[BENCH_MAX_RESULTS];  // Resultados de esta ejecución
+static int result_count = 0;
+static int repeats = BENCH_REPEATS;
+static volatile int sink;                       // Evita que el compilador elimine los bucles
+
+/*
+ * Función auxiliar: now_ns (ESTÁTICA)
+ * Retorna: unsigned long long - reloj monotónico del host en nanosegundos
+ */
+static unsigned long long now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+/*
+ * Función auxiliar: compare_doubles (ESTÁTICA)
+ * Propósito: Comparador para qsort (orden ascendente).
+ */
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Función auxiliar: median (ESTÁTICA)
+ * Parámetros: values - muestras (se ordenan en el lugar), count - cantidad
+ */
+static double median(double* values, int count) {
+    qsort(values, count, sizeof(double), compare_doubles);
+    return values[count / 2];
+}
+
+/*
+ * Función auxiliar: add_result (ESTÁTICA)
+ * Propósito: Guardar un resultado y mostrarlo en consola.
+ */
+static void add_result(const char* name, const char* unit, double value,
+                       unsigned long long iterations) {
+    if (result_count >= BENCH_MAX_RESULTS) return;
+    BenchResult* r = &results[result_count++];
+    strncpy(r->name, name, sizeof(r->name) - 1);
+    r->name[sizeof(r->name) - 1] = '\0';
+    strncpy(r->unit, unit, sizeof(r->unit) - 1);
+    r->unit[sizeof(r->unit) - 1] = '\0';
+    r->value = value;
+    r->iterations = iterations;
+    printf("  %-22s %12.2f %-6s (%llu iteraciones)\n", name, value, unit, iterations);
+}
+
+/*
+ * ============================================================================
+ * MICROBENCHMARKS
+ * Cada función ejecuta 'iterations' operaciones de la primitiva medida.
+ * ============================================================================
+ */
+
+static void micro_word_to_int(long iterations) {
+    Word w = int_to_word(1234567);
+    int total = 0;
+    for (long i = 0; i < iterations; i++) total += word_to_int(w);
+    sink = total;
+}
+
+static void micro_int_to_word(long iterations) {
+    int total = 0;
+    for (long i = 0; i < iterations; i++) total += int_to_word((int)(i & 0xFFFFF)).data[7];
+    sink = total;
+}
+
+/*
+ * Conversión en bloque: 'iterations' palabras en lotes de CODEC_BATCH
+ */
+#define CODEC_BATCH 1024
+static Word codec_words[CODEC_BATCH];
+static int codec_values[CODEC_BATCH];
+
+static void micro_codec_words_to_ints(long iterations) {
+    for (int i = 0; i < CODEC_BATCH; i++) codec_words[i] = int_to_word((i * 7919) % 19999999 - 9999999);
+    int total = 0;
+    for (long done = 0; done < iterations; done += CODEC_BATCH) {
+        int count = (iterations - done < CODEC_BATCH) ? (int)(iterations - done) : CODEC_BATCH;
+        total += codec_words_to_ints(codec_words, codec_values, count) + codec_values[0];
+    }
+    sink = total;
+}
+
+static void micro_codec_ints_to_words(long iterations) {
+    for (int i = 0; i < CODEC_BATCH; i++) codec_values[i] = (i * 7919) % 19999999 - 9999999;
+    int total = 0;
+    for (long done = 0; done < iterations; done += CODEC_BATCH) {
+        int count = (iterations - done < CODEC_BATCH) ? (int)(iterations - done) : CODEC_BATCH;
+        total += codec_ints_to_words(codec_values, codec_words, count) + codec_words[0].data[7];
+    }
+    sink = total;
+}
+
+static void micro_decode_instruction(long iterations) {
+    Word w;
+    strcpy(w.data, "04200200");  // LOAD 200(AC)
+    int total = 0;
+    for (long i = 0; i < iterations; i++) total += decode_instruction(w).value;
+    sink = total;
+}
+
+static void micro_read_memory(long iterations) {
+    int total = 0;
+    for (long i = 0; i < iterations; i++) {
+        total += read_memory(OS_RESERVED + (int)(i % 500)).data[7];
+    }
+    sink = total;
+}
+
+static void micro_write_memory(long iterations) {
+    Word w = int_to_word(42);
+    for (long i = 0; i < iterations; i++) write_memory(OS_RESERVED + (int)(i % 500), w);
+}
+
+static void micro_read_sector(long iterations) {
+    char buffer[SECTOR_SIZE];
+    int total = 0;
+    for (long i = 0; i < iterations; i++) {
+        read_sector(0, 0, (int)(i % SECTORS_PER_CYLINDER), buffer);
+        total += buffer[7];
+    }
+    sink = total;
+}
+
+static void micro_write_sector(long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        write_sector(0, 0, (int)(i % SECTORS_PER_CYLINDER), "00000042");
+    }
+}
+
+static void micro_log_event(long iterations) {
+    for (long i = 0; i < iterations; i++) log_event(LOG_DEBUG, "bench %ld", i);
+}
+
+static void micro_dma_round_trip(long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        dma_set_memory_address(OS_RESERVED);
+        dma_set_disk_location(0, 0, 0);
+        dma_set_io_operation((int)(i & 1));  // Alternar lectura / escritura
+        dma_set_transfer_size(1);
+        dma_start_transfer();
+        dma_wait_completion();
+    }
+}
+
+/*
+ * Función auxiliar: run_micro (ESTÁTICA)
+ * Parámetros:
+ *   name       - nombre del benchmark
+ *   fn         - función que ejecuta las operaciones
+ *   iterations - operaciones por repetición
+ * Propósito: Medir 'repeats' veces y registrar la mediana en ns/op.
+ */
+static void run_micro(const char* name, void (*fn)(long), long iterations) {
+    double samples[BENCH_REPEATS];
+    fn(iterations / 10 + 1);  // Calentamiento (cachés, páginas del log)
+    for (int r = 0; r < repeats; r++) {
+        unsigned long long start = now_ns();
+        fn(iterations);
+        samples[r] = (double)(now_ns() - start) / iterations;
+    }
+    add_result(name, "ns/op", median(samples, repeats), iterations);
+}
+
+/*
+ * ============================================================================
+ * MACROBENCHMARKS
+ * Ejecutan un programa del invitado completo sin pausas entre ciclos.
+ * ============================================================================
+ */
+
+/*
+ * Función auxiliar: run_guest (ESTÁTICA)
+ * Parámetros:
+ *   filename - programa del invitado (formato de load_program_file)
+ *   executed - salida: instrucciones del invitado ejecutadas
+ * Retorna: unsigned long long - tiempo de pared en ns (al menos 1), o 0 si
+ *          no se pudo cargar
+ */
+static unsigned long long run_guest(const char* filename, unsigned long long* executed) {
+    reset_cpu();  // Estado de registros idéntico en cada repetición
+    int start_address = load_program_file(filename);
+    if (start_address < 0) return 0;
+
+    cpu_registers.PSW.PC_psw = start_address;
+    set_PC_int(start_address);
+    set_cpu_state(CPU_RUNNING);
+
+    unsigned long long first = cpu_instructions_retired;
+    unsigned long long start = now_ns();
+    while (get_cpu_state() == CPU_RUNNING &&
+           cpu_instructions_retired - first < BENCH_MAX_GUEST) {
+        cpu_cycle_block(BENCH_MAX_GUEST - (cpu_instructions_retired - first));
+    }
+    unsigned long long elapsed = now_ns() - start;
+
+    *executed = cpu_instructions_retired - first;
+    return elapsed > 0 ? elapsed : 1;
+}
+
+/*
+ * Función auxiliar: run_macro (ESTÁTICA)
+ * Parámetros:
+ *   name     - nombre del benchmark
+ *   filename - programa del invitado (formato de load_program_file)
+ * Propósito: Cargar y ejecutar el programa 'repeats' veces, registrando la
+ *            mediana de instrucciones del invitado por segundo (MIPS).
+ */
+static void run_macro(const char* name, const char* filename) {
+    double samples[BENCH_REPEATS];
+    unsigned long long executed = 0;
+
+    for (int r = 0; r < repeats; r++) {
+        unsigned long long elapsed = run_guest(filename, &executed);
+        if (elapsed == 0) {
+            printf("  %-22s no se pudo cargar %s\n", name, filename);
+            return;
+        }
+        samples[r] = executed * 1000.0 / elapsed;
+    }
+    add_result(name, "MIPS", median(samples, repeats), executed);
+}
+
+/*
+ * Función auxiliar: run_messages (ESTÁTICA)
+ * Parámetros: como run_macro
+ * Propósito: Igual que run_macro, pero registrando mensajes entregados por
+ *            segundo (programas de ping-pong entre buzones).
+ */
+static void run_messages(const char* name, const char* filename) {
+    double samples[BENCH_REPEATS];
+    unsigned long long executed = 0, messages = 0;
+
+    for (int r = 0; r < repeats; r++) {
+        unsigned long long first = msg_delivered();
+        unsigned long long elapsed = run_guest(filename, &executed);
+        if (elapsed == 0) {
+            printf("  %-22s no se pudo cargar %s\n", name, filename);
+            return;
+        }
+        messages = msg_delivered() - first;
+        samples[r] = messages * 1e9 / elapsed;
+    }
+    add_result(name, "msg/s", median(samples, repeats), messages);
+}
+
+/*
+ * Función auxiliar: run_network (ESTÁTICA)
+ * Parámetros:
+ *   name     - nombre del benchmark
+ *   sender   - programa de la VM emisora (puerto 0)
+ *   receiver - programa de la VM receptora (puerto 1); termina con el AC en 0
+ *              si todas las tramas llegaron bien
+ *   frames   - tramas que envía el emisor
+ * Propósito: Medir la red entre dos VMs de verdad: bench.exe crea un
+ *            segmento propio y ejecuta el switch; en cada repetición un
+ *            proceso hijo hace de VM receptora y este proceso de emisora.
+ *            El tiempo va desde que el emisor arranca hasta que el receptor
+ *            terminó.
+ */
+static void run_network(const char* name, const char* sender, const char* receiver, int frames) {
+    double samples[BENCH_REPEATS];
+    char segment_name[64];
+    snprintf(segment_name, sizeof(segment_name), "%s.bench.%d", NET_SEGMENT_NAME, (int)getpid());
+    NetSegment* segment = net_segment_create(segment_name);
+    if (segment == NULL || net_switch_start(segment) != 0) {
+        printf("  %-22s no se pudo crear la red\n", name);
+        if (segment != NULL) net_segment_destroy(segment_name);
+        return;
+    }
+
+    int failed = 0;
+    for (int r = 0; r < repeats && !failed; r++) {
+        fflush(stdout);  // El hijo no debe repetir la salida pendiente
+        pid_t child = fork();
+        if (child == 0) {
+            unsigned long long executed;
+            int ok = net_attach(segment_name, 1) == 1 && run_guest(receiver, &executed) > 0 &&
+                     get_cpu_state() == CPU_HALTED && word_to_int(cpu_registers.AC) == 0;
+            net_detach();
+            _exit(ok ? 0 : 1);
+        }
+        if (child < 0 || net_attach(segment_name, 0) != 0) {
+            failed = 1;
+            break;
+        }
+        struct timespec pause = { 0, 100000 };
+        while (segment->ports[1].owner == 0) nanosleep(&pause, NULL);  // Receptor conectado
+
+        unsigned long long executed;
+        unsigned long long start = now_ns();
+        if (run_guest(sender, &executed) == 0) failed = 1;
+        int status = 0;
+        waitpid(child, &status, 0);
+        unsigned long long elapsed = now_ns() - start;
+        net_detach();
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) failed = 1;
+        samples[r] = frames * 1e9 / (elapsed > 0 ? elapsed : 1);
+    }
+
+    net_switch_stop();
+    net_segment_close(segment);
+    net_segment_destroy(segment_name);
+    if (failed) {
+        printf("  %-22s falló (tramas perdidas o fuera de orden)\n", name);
+        return;
+    }
+    add_result(name, "frame/s", median(samples, repeats), (unsigned long long)frames);
+}
+
+/*
+ * Función auxiliar: run_sweep_instance (ESTÁTICA)
+ * Parámetros:
+ *   start_address - PC inicial del programa cargado
+ *   value         - valor de la palabra BENCH_SWEEP_ADDRESS (-1 = no tocarla)
+ *   result        - salida, en el formato del intérprete en lockstep
+ * Propósito: Ejecutar una instancia del barrido con la CPU normal sobre la
+ *            memoria y los registros que dejó la carga (el llamador los
+ *            restaura antes de cada instancia).
+ */
+static void run_sweep_instance(int start_address, int value, LockstepResult* result) {
+    if (value >= 0) write_memory(BENCH_SWEEP_ADDRESS, int_to_word(value));
+    cpu_registers.PSW.PC_psw = start_address;
+    set_PC_int(start_address);
+    set_cpu_state(CPU_RUNNING);
+
+    unsigned long long first = cpu_instructions_retired;
+    while (get_cpu_state() == CPU_RUNNING &&
+           cpu_instructions_retired - first < BENCH_MAX_GUEST) {
+        cpu_cycle_block(BENCH_MAX_GUEST - (cpu_instructions_retired - first));
+    }
+    result->halted = (get_cpu_state() != CPU_RUNNING);
+    result->exit_code = result->halted ? get_cpu_exit_status() : 0;
+    result->ac = word_to_int(cpu_registers.AC);
+    result->scalar = 1;
+    result->retired = cpu_instructions_retired - first;
+    set_cpu_state(CPU_HALTED);
+}
+
+/*
+ * Función auxiliar: run_sweep (ESTÁTICA)
+ * Parámetros:
+ *   name     - nombre del barrido de a una instancia
+ *   lockstep - nombre del mismo barrido con el intérprete en lockstep
+ * Propósito: Medir el barrido BENCH_SWEEP_PROGRAM de las dos formas, en
+ *            MIPS agregados del invitado (instrucciones de todas las
+ *            instancias sobre el tiempo total).
+ */
+static void run_sweep(const char* name, const char* lockstep) {
+    static Word saved_memory[MEMORY_SIZE];
+    static LockstepResult sweep[BENCH_SWEEP_INSTANCES];
+    double samples[BENCH_REPEATS], lane_samples[BENCH_REPEATS];
+    unsigned long long executed = 0;
+
+    for (int r = 0; r < repeats; r++) {
+        reset_cpu();
+        int start_address = load_program_file(BENCH_SWEEP_PROGRAM);
+        if (start_address < 0) {
+            printf("  %-22s no se pudo cargar %s\n", name, BENCH_SWEEP_PROGRAM);
+            return;
+        }
+        memcpy(saved_memory, memory, sizeof(saved_memory));
+        CPU_Registers saved_registers = cpu_registers;
+
+        executed = 0;
+        unsigned long long start = now_ns();
+        for (int i = 0; i < BENCH_SWEEP_INSTANCES; i++) {
+            memcpy(memory, saved_memory, sizeof(saved_memory));  // Solo cambian datos
+            cpu_registers = saved_registers;
+            run_sweep_instance(start_address, i + 1, &sweep[i]);
+            executed += sweep[i].retired;
+        }
+        unsigned long long elapsed = now_ns() - start;
+        samples[r] = executed * 1000.0 / (elapsed > 0 ? elapsed : 1);
+
+        memcpy(memory, saved_memory, sizeof(saved_memory));
+        blockcache_flush();
+        cpu_registers = saved_registers;
+        LockstepStats stats;
+        start = now_ns();
+        lockstep_run(start_address, BENCH_SWEEP_INSTANCES, BENCH_SWEEP_ADDRESS, 1, 1,
+                     BENCH_MAX_GUEST, sweep, &stats);
+        elapsed = now_ns() - start;
+        lane_samples[r] = (stats.lane_instructions + stats.scalar_instructions) * 1000.0 /
+                          (elapsed > 0 ? elapsed : 1);
+    }
+    add_result(name, "MIPS", median(samples, repeats), executed);
+    add_result(lockstep, "MIPS", median(lane_samples, repeats), executed);
+}
+
+/*
+ * ============================================================================
+ * VERIFICACIÓN DIFERENCIAL
+ * Los niveles de ejecución (intérprete, caché de bloques, JIT) deben dejar
+ * exactamente el mismo estado visible en los programas de los benchmarks.
+ * ============================================================================
+ */
+
+/*
+ * Estructura: GuestSnapshot
+ * Propósito: Estado visible al terminar un programa del invitado.
+ */
+typedef struct {
+    CPU_Registers registers;
+    Word psw;
+    Word memory[MEMORY_SIZE];
+    unsigned long long retired;
+} GuestSnapshot;
+
+/*
+ * Función auxiliar: run_tier (ESTÁTICA)
+ * Parámetros:
+ *   filename - programa del invitado
+ *   cache    - 1 para usar la caché de bloques
+ *   native   - 1 para usar además el JIT
+ *   snapshot - estado final (salida)
+ * Retorna: int - 0 si se ejecutó, -1 si no se pudo cargar
+ */
+static int run_tier(const char* filename, int cache, int native, GuestSnapshot* snapshot) {
+    blockcache_enabled = cache;
+    jit_enabled = native;
+    init_memory();
+    msg_reset();  // init_memory deja "OS_RESERVED" en las cabeceras de los buzones
+    reset_cpu();
+    init_sim();   // Sin eventos ni reloj heredados de la ejecución anterior
+    dma_reset();  // El costo de búsqueda depende de dónde quedó el cabezal
+    int start_address = load_program_file(filename);
+    if (start_address < 0) return -1;
+
+    cpu_registers.PSW.PC_psw = start_address;
+    set_PC_int(start_address);
+    set_cpu_state(CPU_RUNNING);
+
+    unsigned long long first = cpu_instructions_retired;
+    while (get_cpu_state() == CPU_RUNNING &&
+           cpu_instructions_retired - first < BENCH_MAX_GUEST) {
+        cpu_cycle_block(BENCH_MAX_GUEST - (cpu_instructions_retired - first));
+    }
+    snapshot->registers = cpu_registers;
+    snapshot->psw = psw_to_word(cpu_registers.PSW);
+    memcpy(snapshot->memory, memory, sizeof(snapshot->memory));
+    snapshot->retired = cpu_instructions_retired - first;
+    return 0;
+}
+
+/*
+ * Función auxiliar: same_state (ESTÁTICA)
+ * Retorna: int - 1 si ambos estados coinciden; si no, muestra la primera diferencia
+ */
+static int same_state(const GuestSnapshot* a, const GuestSnapshot* b) {
+    static const char* names[] = { "AC", "MAR", "MDR", "IR", "RB", "RL", "RX", "SP", "PC" };
+    const Word* ra[] = { &a->registers.AC, &a->registers.MAR, &a->registers.MDR, &a->registers.IR,
+                         &a->registers.RB, &a->registers.RL, &a->registers.RX, &a->registers.SP,
+                         &a->registers.PC };
+    const Word* rb[] = { &b->registers.AC, &b->registers.MAR, &b->registers.MDR, &b->registers.IR,
+                         &b->registers.RB, &b->registers.RL, &b->registers.RX, &b->registers.SP,
+                         &b->registers.PC };
+    if (a->retired != b->retired) {
+        printf("    instrucciones: %llu vs %llu\n", a->retired, b->retired);
+        return 0;
+    }
+    for (int i = 0; i < 9; i++) {
+        if (strcmp(ra[i]->data, rb[i]->data) != 0) {
+            printf("    %s: %s vs %s\n", names[i], ra[i]->data, rb[i]->data);
+            return 0;
+        }
+    }
+    if (strcmp(a->psw.data, b->psw.data) != 0) {
+        printf("    PSW: %s vs %s\n", a->psw.data, b->psw.data);
+        return 0;
+    }
+    for (int i = 0; i < MEMORY_SIZE; i++) {
+        if (strcmp(a->memory[i].data, b->memory[i].data) != 0) {
+            printf("    memoria[%d]: %s vs %s\n", i, a->memory[i].data, b->memory[i].data);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Función auxiliar: verify_program (ESTÁTICA)
+ * Retorna: int - cantidad de niveles que no coinciden con el intérprete
+ */
+static int verify_program(const char* filename) {
+    static GuestSnapshot reference, tier;
+    static const char* tier_names[] = { "caché de bloques", "JIT" };
+    if (run_tier(filename, 0, 0, &reference) != 0) {
+        printf("  %-32s no se pudo cargar\n", filename);
+        return 1;
+    }
+    int failures = 0;
+    for (int t = 0; t < 2; t++) {
+        run_tier(filename, 1, t == 1, &tier);
+        int ok = same_state(&reference, &tier);
+        printf("  %-32s %-18s %s (%llu instrucciones)\n", filename, tier_names[t],
+               ok ? "OK" : "DIFIERE", tier.retired);
+        failures += !ok;
+    }
+    return failures;
+}
+
+/*
+ * Función auxiliar: verify_lockstep (ESTÁTICA)
+ * Parámetros:
+ *   filename  - programa del invitado
+ *   address   - palabra que cambia en cada instancia (-1 = ninguna)
+ *   instances - cantidad de instancias (valores 1, 2, ...)
+ * Retorna: int - cantidad de implementaciones que no coinciden con la CPU normal
+ * Propósito: Comparar AC, código de salida e instrucciones de cada instancia
+ *            del intérprete en lockstep, con cada implementación que soporte
+ *            el host, contra la misma instancia ejecutada de a una.
+ */
+static int verify_lockstep(const char* filename, int address, int instances) {
+    static const char* backends[] = { "escalar", "avx2", "avx512" };
+    static Word saved_memory[MEMORY_SIZE];
+    static LockstepResult reference[BENCH_SWEEP_INSTANCES], lanes[BENCH_SWEEP_INSTANCES];
+
+    init_memory();
+    msg_reset();  // init_memory deja "OS_RESERVED" en las cabeceras de los buzones
+    reset_cpu();
+    int start_address = load_program_file(filename);
+    if (start_address < 0) {
+        printf("  %-32s no se pudo cargar\n", filename);
+        return 1;
+    }
+    memcpy(saved_memory, memory, sizeof(saved_memory));
+    CPU_Registers saved_registers = cpu_registers;
+    for (int i = 0; i < instances; i++) {
+        memcpy(memory, saved_memory, sizeof(saved_memory));
+        blockcache_flush();
+        cpu_registers = saved_registers;
+        run_sweep_instance(start_address, address >= 0 ? i + 1 : -1, &reference[i]);
+    }
+    memcpy(memory, saved_memory, sizeof(saved_memory));
+    blockcache_flush();
+    cpu_registers = saved_registers;
+
+    int failures = 0;
+    for (int b = 0; b < 3; b++) {
+        if (lockstep_set_backend(backends[b]) != 0) continue;
+        LockstepStats stats;
+        lockstep_run(start_address, instances, address, 1, 1, BENCH_MAX_GUEST, lanes, &stats);
+        int ok = 1;
+        for (int i = 0; i < instances && ok; i++) {
+            const LockstepResult* a = &reference[i];
+            const LockstepResult* l = &lanes[i];
+            if (a->halted != l->halted || a->exit_code != l->exit_code ||
+                a->ac != l->ac || a->retired != l->retired) {
+                printf("    instancia %d: AC %d/%d, salida %d/%d, instrucciones %llu/%llu\n",
+                       i, a->ac, l->ac, a->exit_code, l->exit_code, a->retired, l->retired);
+                ok = 0;
+            }
+        }
+        printf("  %-32s lockstep %-9s %s (%d en el intérprete normal)\n", filename, backends[b],
+               ok ? "OK" : "DIFIERE", stats.scalar_instances);
+        failures += !ok;
+    }
+    lockstep_set_backend("auto");
+    return failures;
+}
+
+/*
+ * ============================================================================
+ * SALIDA Y COMPARACIÓN DE RESULTADOS
+ * El JSON se escribe con un benchmark por línea para que la comparación
+ * pueda leerlo sin un parser completo.
+ * ============================================================================
+ */
+
+/*
+ * Función auxiliar: write_json (ESTÁTICA)
+ * Retorna: int - 0 si se escribió, -1 si no se pudo abrir el archivo
+ */
+static int write_json(const char* filename) {
+    FILE* out = fopen(filename, "w");
+    if (!out) {
+        printf("Error: no se pudo crear %s\n", filename);
+        return -1;
+    }
+    fprintf(out, "{\n  \"benchmarks\": [\n");
+    for (int i = 0; i < result_count; i++) {
+        fprintf(out, "    {\"name\": \"%s\", \"unit\": \"%s\", \"value\": %.4f, \"iterations\": %llu}%s\n",
+                results[i].name, results[i].unit, results[i].value, results[i].iterations,
+                i + 1 < result_count ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+    fclose(out);
+    printf("Resultados escritos en %s\n", filename);
+    return 0;
+}
+
+/*
+ * Función auxiliar: read_json (ESTÁTICA)
+ * Parámetros:
+ *   filename - archivo generado por write_json
+ *   list     - arreglo de salida (BENCH_MAX_RESULTS elementos)
+ * Retorna: int - cantidad de resultados leídos, o -1 si no se pudo abrir
+ */
+static int read_json(const char* filename, BenchResult* list) {
+    FILE* in = fopen(filename, "r");
+    if (!in) {
+        printf("Error: no se pudo abrir %s\n", filename);
+        return -1;
+    }
+    char line[256];
+    int count = 0;
+    while (count < BENCH_MAX_RESULTS && fgets(line, sizeof(line), in) != NULL) {
+        BenchResult* r = &list[count];
+        if (sscanf(line, " {\"name\": \"%39[^\"]\", \"unit\": \"%7[^\"]\", \"value\": %lf, \"iterations\": %llu",
+                   r->name, r->unit, &r->value, &r->iterations) == 4) {
+            count++;
+        }
+    }
+    fclose(in);
+    return count;
+}
+
+/*
+ * Función auxiliar: compare_files (ESTÁTICA)
+ * Parámetros:
+ *   base_file - resultados de referencia
+ *   new_file  - resultados a evaluar
+ *   threshold - porcentaje de empeoramiento tolerado
+ * Retorna: int - código de salida: 0 sin regresiones, 1 con regresiones, 2 error
+ * Propósito: Mostrar la variación de cada benchmark presente en ambos archivos.
+ *            En ns/op un aumento es peor; en MIPS una disminución es peor.
+ */
+static int compare_files(const char* base_file, const char* new_file, double threshold) {
+    BenchResult base[BENCH_MAX_RESULTS], current[BENCH_MAX_RESULTS];
+    int base_count = read_json(base_file, base);
+    int current_count = read_json(new_file, current);
+    if (base_count < 0 || current_count < 0) return 2;
+
+    int regressions = 0;
+    printf("%-22s %12s %12s %9s\n", "benchmark", "base", "nuevo", "cambio");
+    for (int i = 0; i < current_count; i++) {
+        for (int j = 0; j < base_count; j++) {
+            if (strcmp(current[i].name, base[j].name) != 0) continue;
+            if (base[j].value <= 0.0) break;
+
+            double change = 100.0 * (current[i].value - base[j].value) / base[j].value;
+            double worse = (strcmp(current[i].unit, "ns/op") == 0) ? change : -change;
+            int regressed = worse > threshold;
+            regressions += regressed;
+
+            printf("%-22s %12.2f %12.2f %+8.1f%% %s\n", current[i].name,
+                   base[j].value, current[i].value, change,
+                   regressed ? "REGRESION" : "");
+            break;
+        }
+    }
+    printf("%d regresion(es) por encima de %.1f%%\n", regressions, threshold);
+    return regressions > 0 ? 1 : 0;
+}
+
+/*
+ * Función: main
+ * Propósito: Interpretar opciones, inicializar el sistema sin consola y
+ *            ejecutar todos los benchmarks (o comparar dos archivos).
+ */
+int main(int argc, char* argv[]) {
+    const char* output = "bench.json";
+    const char* compare_base = NULL;
+    const char* compare_new = NULL;
+    double threshold = BENCH_DEFAULT_THRESHOLD;
+    long scale = 1;
+    int verify = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "--quick") == 0) {
+            scale = 10;
+            repeats = 3;
+        } else if (strcmp(argv[i], "--compare") == 0 && i + 2 < argc) {
+            compare_base = argv[++i];
+            compare_new = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--verify") == 0) {
+            verify = 1;
+        } else {
+            printf("Uso: %s [-o archivo.json] [--quick]\n", argv[0]);
+            printf("     %s --compare base.json nuevo.json [--threshold %%]\n", argv[0]);
+            printf("     %s --verify\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (compare_base != NULL) {
+        return compare_files(compare_base, compare_new, threshold);
+    }
+
+    // Inicializar componentes en el mismo orden que sistema.exe
+    init_logger();
+    init_memory();
+    init_registers();
+    init_interrupts();
+    init_disk();
+    init_syscalls();
+    init_fs();
+    init_shm();
+    init_msg();
+    init_mmio();
+    init_terminal();
+    terminal_output_enabled = 0;  // es.txt escribe en el terminal: medir sin mostrar
+    init_net();
+    init_sim();
+    init_dma();
+    init_cpu();
+
+    if (verify) {
+        static const char* programs[] = {
+            "BENCH/programs/bucle.txt", "BENCH/programs/memoria.txt",
+            "BENCH/programs/llamadas.txt", "BENCH/programs/es.txt",
+            "BENCH/programs/mensajes.asm",
+            "BENCH/programs/comparar.asm",  // Solo verificación: CMP/TST con operando en memoria
+            "BENCH/programs/dma.asm"        // Solo verificación: evento agendado dentro de un bloque
+        };
+        int count = (int)(sizeof(programs) / sizeof(programs[0]));
+        int failures = 0;
+        printf("=== VERIFICACIÓN DIFERENCIAL (contra el intérprete) ===\n");
+        for (int i = 0; i < count; i++) failures += verify_program(programs[i]);
+        // Los programas de los benchmarks usan SVC: prueban el paso al intérprete normal
+        failures += verify_lockstep(BENCH_SWEEP_PROGRAM, BENCH_SWEEP_ADDRESS, BENCH_SWEEP_INSTANCES);
+        for (int i = 0; i < count; i++) failures += verify_lockstep(programs[i], -1, 3);
+        printf("%d diferencia(s)\n", failures);
+        close_logger();
+        return failures > 0 ? 1 : 0;
+    }
+
+    printf("=== MICROBENCHMARKS (mediana de %d repeticiones) ===\n", repeats);
+    run_micro("word_to_int", micro_word_to_int, 2000000 / scale);
+    run_micro("int_to_word", micro_int_to_word, 2000000 / scale);
+    printf("  (códec en bloque: %s)\n", codec_backend());
+    run_micro("codec_words_to_ints", micro_codec_words_to_ints, 20000000 / scale);
+    run_micro("codec_ints_to_words", micro_codec_ints_to_words, 20000000 / scale);
+    run_micro("decode_instruction", micro_decode_instruction, 2000000 / scale);
+    run_micro("read_memory", micro_read_memory, 1000000 / scale);
+    run_micro("write_memory", micro_write_memory, 1000000 / scale);
+    run_micro("read_sector", micro_read_sector, 200000 / scale);
+    run_micro("write_sector", micro_write_sector, 200000 / scale);
+    run_micro("log_event", micro_log_event, 200000 / scale);
+    run_micro("dma_round_trip", micro_dma_round_trip, 200 / scale);
+
+    printf("=== MACROBENCHMARKS (MIPS del invitado; mensajes y tramas por segundo) ===\n");
+    run_macro("guest_loop", "BENCH/programs/bucle.txt");
+    run_macro("guest_memory", "BENCH/programs/memoria.txt");
+    run_macro("guest_calls", "BENCH/programs/llamadas.txt");
+    run_macro("guest_io", "BENCH/programs/es.txt");
+    run_messages("guest_msg_pingpong", "BENCH/programs/mensajes.asm");
+    run_network("guest_net_stream", "BENCH/programs/red_tx.asm", "BENCH/programs/red_rx.asm", 20000);
+    printf("  (intérprete en lockstep: %s)\n", lockstep_backend());
+    run_sweep("guest_sweep", "guest_sweep_lockstep");
+
+    close_logger();
+    return write_json(output) == 0 ? 0 : 2;
+}
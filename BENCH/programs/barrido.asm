@@ -0,0 +1,31 @@
+; Barrido de parámetros: pasos de Collatz de n hasta llegar a 1. Con
+; 'lockstep barrido.asm 1024 1 1 1' cada instancia empieza con otro n
+; (palabra 1) y HALT sale con la cantidad de pasos.
+
+        J main
+n:      .word 27
+pasos:  .word 0
+mitad:  .word 0
+
+main:   LOAD n
+bucle:  CMP #1
+        JEQ fin
+        LOAD pasos
+        SUM #1
+        STR pasos
+        LOAD n
+        DIVI #2
+        STR mitad
+        MULT #2
+        CMP n                   ; 2 * (n / 2) = n si n es par
+        JEQ par
+        LOAD n                  ; impar: n = 3n + 1
+        MULT #3
+        SUM #1
+        STR n
+        J bucle
+par:    LOAD mitad              ; par: n = n / 2
+        STR n
+        J bucle
+fin:    LOAD pasos
+        HALT 0(AC)
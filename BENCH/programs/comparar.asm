@@ -0,0 +1,24 @@
+; Verificación (bench.exe --verify): CMP y TST con operando en memoria
+; dentro de un bucle caliente, para que el JIT los compile. Termina con el
+; AC en la cantidad de vueltas con el contador impar (5000).
+
+main:   LOAD #0
+        STR i
+bucle:  LOAD i
+        TST mascara             ; Bit 0 del contador
+        JEQ sigue
+        LOAD impares
+        SUM #1
+        STR impares
+sigue:  LOAD i
+        SUM #1
+        STR i
+        CMP lim                 ; Condición del bucle leída de memoria
+        JLT bucle
+        LOAD impares
+        HALT
+
+i:       .word 0
+impares: .word 0
+mascara: .word 1
+lim:     .word 10000
@@ -0,0 +1,24 @@
+; Verificación (bench.exe --verify): una transferencia DMA iniciada a mitad
+; de un bloque traducido y un bucle que sondea el búfer hasta que llega. El
+; evento de fin debe atenderse en la misma instrucción en los tres niveles.
+; Termina con el AC en la cantidad de vueltas del sondeo.
+
+main:   DMA_CONFIG 50500        ; Cilindro 5, pista 5, sector 0
+        DMA_SIZE 1
+        LOAD #0
+        STR cnt
+        STR buf
+        SUM #1
+        SUM #1
+        DMA_READ buf
+sondeo: LOAD cnt
+        SUM #1
+        STR cnt
+        LOAD buf
+        CMP #0
+        JEQ sondeo
+        LOAD cnt
+        HALT
+
+cnt:    .word 0
+buf:    .word 0
@@ -0,0 +1,29 @@
+; Benchmark: 2000 idas y vueltas por buzones (4000 mensajes). El proceso
+; hace de cliente y de servidor: envía el ping al buzón 0, lo recibe, responde
+; con el valor incrementado por el buzón 1 y recibe la respuesta.
+
+main:   LOAD #0
+        STR ping
+bucle:  LOAD #p_ping
+        SVC                     ; send(0, ping, 2)
+        LOAD #p_serv
+        SVC                     ; receive(0, pedido, 3)
+        LOAD pedido
+        SUM #1
+        STR pedido
+        LOAD #p_pong
+        SVC                     ; send(1, pedido, 2)
+        LOAD #p_resp
+        SVC                     ; receive(1, ping, 3)
+        LOAD ping
+        CMP #2000
+        JLT bucle
+        HALT
+
+p_ping: .word 20, 0, ping, 2
+p_serv: .word 21, 0, pedido, 3
+p_pong: .word 20, 1, pedido, 2
+p_resp: .word 21, 1, ping, 3
+
+ping:   .word 0, 7, 0
+pedido: .space 3
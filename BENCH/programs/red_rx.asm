@@ -0,0 +1,47 @@
+; Benchmark de red (lado receptor, puerto 1): recibe TRAMAS tramas en un
+; anillo de RANURAS ranuras y comprueba que lleguen en orden. Termina con
+; el AC = tramas fuera de orden (0 si todo llegó bien).
+
+        .equ RED_RX_DIRECCION, 20035
+        .equ RED_RX_CAPACIDAD, 20036
+        .equ RED_RX_PRODUCTOR, 20037
+        .equ RED_RX_CONSUMIDOR, 20038
+        .equ RANURAS, 16
+        .equ RANURA, 18         ; Largo, origen y 16 datos (NET_SLOT_WORDS)
+        .equ TRAMAS, 20000
+
+main:   LOAD #anillo
+        STR RED_RX_DIRECCION
+        LOAD #RANURAS
+        STR RED_RX_CAPACIDAD    ; Anillo vacío: recepción encendida
+espera: LOAD RED_RX_PRODUCTOR
+        CMP cons
+        JEQ espera
+        LOAD recibidas
+        SUM #1
+        STR recibidas
+        LOAD cons
+        MULT #RANURA
+        LOAD anillo+2(AC)       ; Número de secuencia de la trama
+        CMP recibidas
+        JEQ libera
+        LOAD errores
+        SUM #1
+        STR errores
+libera: LOAD cons
+        SUM #1
+        CMP #RANURAS
+        JLT avanza
+        LOAD #0
+avanza: STR cons
+        STR RED_RX_CONSUMIDOR   ; La ranura vuelve a la placa
+        LOAD recibidas
+        CMP #TRAMAS
+        JLT espera
+        LOAD errores
+        HALT
+
+cons:      .word 0
+recibidas: .word 0
+errores:   .word 0
+anillo:    .space 288           ; RANURAS * RANURA
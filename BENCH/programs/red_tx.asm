@@ -0,0 +1,31 @@
+; Benchmark de red (lado emisor, puerto 0): envía TRAMAS tramas de 16
+; palabras al puerto 1 por la placa de red. El primer dato de cada trama es
+; su número de secuencia; si el anillo de transmisión está lleno, reintenta.
+
+        .equ RED_DESTINO, 20031
+        .equ RED_TX_DIRECCION, 20032
+        .equ RED_TX_LARGO, 20033
+        .equ RED_TX_COMANDO, 20034
+        .equ TRAMAS, 20000
+
+main:   LOAD #1
+        STR RED_DESTINO
+        LOAD #datos
+        STR RED_TX_DIRECCION
+        LOAD #16
+        STR RED_TX_LARGO
+sigue:  LOAD enviadas
+        SUM #1
+        STR enviadas
+        STR datos
+envia:  STR RED_TX_COMANDO      ; Cualquier valor: enviar
+        LOAD RED_TX_COMANDO     ; Resultado del envío
+        CMP #0
+        JLT envia               ; Anillo lleno: reintentar
+        LOAD enviadas
+        CMP #TRAMAS
+        JLT sigue
+        HALT
+
+enviadas: .word 0
+datos:    .space 16
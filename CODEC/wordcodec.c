@@ -0,0 +1,370 @@
+/*
+ * Archivo de implementación del códec de palabras en bloque del Sistema Operativo Virtual.
+ * Contiene el camino escalar y las versiones AVX2 / SSE4.1, elegidas en tiempo
+ * de ejecución según el procesador del host.
+ *
+ * Decodificación: los 8 caracteres de cada palabra se cargan como un entero
+ * de 64 bits, se les resta '0' y se validan todos a la vez (signo <= 1,
+ * dígitos <= 9). Los dígitos se combinan con multiplicaciones-suma en dos
+ * niveles (pares con pesos 10/1, luego grupos con 100/1) hasta obtener las
+ * partes alta (3 dígitos) y baja (4 dígitos) de la magnitud.
+ *
+ * Codificación: la magnitud se separa en alta/baja dividiendo por 10000 con
+ * un multiplicador exacto; cada parte se divide por 100 y por 10 en 16 bits
+ * con multiplicaciones altas, y un reordenamiento de bytes (pshufb) coloca
+ * los siete dígitos de cada palabra en su posición.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "wordcodec.h"
+
+/* Inclusión de bibliotecas estándar */
+#include <string.h>   // Para memcpy, strcpy
+#include <stdint.h>   // Para uint64_t
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>  // Intrínsecos SSE4.1 / AVX2 (habilitados por función con 'target')
+#define CODEC_SIMD 1
+#else
+#define CODEC_SIMD 0
+#endif
+
+/*
+ * Implementaciones disponibles
+ */
+#define BACKEND_SCALAR 0
+#define BACKEND_SSE41 1
+#define BACKEND_AVX2 2
+
+/*
+ * VARIABLES GLOBALES ESTÁTICAS
+ */
+static int backend = -1;        // -1 = aún no detectado
+static int force_scalar = 0;    // codec_force_scalar()
+
+/*
+ * Función auxiliar: select_backend (ESTÁTICA)
+ * Retorna: int - implementación a usar en esta llamada
+ */
+static int select_backend() {
+    if (backend < 0) {
+        backend = BACKEND_SCALAR;
+#if CODEC_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) backend = BACKEND_AVX2;
+        else if (__builtin_cpu_supports("sse4.1")) backend = BACKEND_SSE41;
+#endif
+    }
+    return force_scalar ? BACKEND_SCALAR : backend;
+}
+
+/*
+ * Función auxiliar: finish_word (ESTÁTICA)
+ * Propósito: Valor final de una palabra ya validada por el camino vectorial
+ *            (falta el terminador y el signo).
+ * Retorna: int - 1 si la palabra es válida
+ */
+static int finish_word(const Word* w, int digits_ok, int magnitude, int* value) {
+    if (!digits_ok || w->data[8] != '\0') {
+        *value = 0;
+        return 0;
+    }
+    *value = (w->data[0] == '1') ? -magnitude : magnitude;
+    return 1;
+}
+
+/*
+ * ============================================================================
+ * CAMINO ESCALAR
+ * ============================================================================
+ */
+
+static int decode_scalar(const Word* words, int* values, int start, int count) {
+    int first_invalid = CODEC_ALL_VALID;
+    for (int i = start; i < count; i++) {
+        const char* d = words[i].data;
+        int ok = (d[0] == '0' || d[0] == '1') && d[8] == '\0';
+        int magnitude = 0;
+        for (int k = 1; k < 8; k++) {
+            unsigned int digit = (unsigned int)(unsigned char)d[k] - '0';
+            ok &= (digit <= 9);
+            magnitude = magnitude * 10 + (int)digit;
+        }
+        if (!finish_word(&words[i], ok, magnitude, &values[i]) && first_invalid == CODEC_ALL_VALID) {
+            first_invalid = i;
+        }
+    }
+    return first_invalid;
+}
+
+/*
+ * Función auxiliar: encode_one (ESTÁTICA)
+ * Retorna: int - 1 si el valor cabe en 7 dígitos
+ */
+static int encode_one(int value, Word* w) {
+    if (value > CODEC_WORD_MAX || value < -CODEC_WORD_MAX) {
+        strcpy(w->data, "OVERFLOW");
+        return 0;
+    }
+    unsigned int magnitude = (unsigned int)(value < 0 ? -value : value);
+    w->data[0] = (value < 0) ? '1' : '0';
+    for (int k = 7; k >= 1; k--) {
+        w->data[k] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    }
+    w->data[8] = '\0';
+    return 1;
+}
+
+static int encode_scalar(const int* values, Word* words, int start, int count) {
+    int first_invalid = CODEC_ALL_VALID;
+    for (int i = start; i < count; i++) {
+        if (!encode_one(values[i], &words[i]) && first_invalid == CODEC_ALL_VALID) first_invalid = i;
+    }
+    return first_invalid;
+}
+
+#if CODEC_SIMD
+
+/*
+ * Función auxiliar: load_chars (ESTÁTICA)
+ * Retorna: long long - los 8 caracteres de la palabra (sin el terminador)
+ */
+static inline long long load_chars(const Word* w) {
+    uint64_t chars;
+    memcpy(&chars, w->data, sizeof(chars));
+    return (long long)chars;
+}
+
+/*
+ * ============================================================================
+ * SSE4.1 (2 palabras por iteración al decodificar, 4 al codificar)
+ * ============================================================================
+ */
+
+__attribute__((target("sse4.1")))
+static int decode_sse41(const Word* words, int* values, int count, int* done) {
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i limit = _mm_setr_epi8(1, 9, 9, 9, 9, 9, 9, 9, 1, 9, 9, 9, 9, 9, 9, 9);
+    const __m128i tens = _mm_setr_epi8(0, 1, 10, 1, 10, 1, 10, 1, 0, 1, 10, 1, 10, 1, 10, 1);
+    const __m128i hundreds = _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1);
+    const __m128i high = _mm_setr_epi32(10000, 1, 10000, 1);
+    int first_invalid = CODEC_ALL_VALID;
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128i d = _mm_sub_epi8(_mm_set_epi64x(load_chars(&words[i + 1]), load_chars(&words[i])), zero);
+        int valid = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(d, limit), limit));
+        __m128i parts = _mm_madd_epi16(_mm_maddubs_epi16(d, tens), hundreds);  // [alta0, baja0, alta1, baja1]
+        __m128i sums = _mm_hadd_epi32(_mm_mullo_epi32(parts, high), _mm_setzero_si128());
+        int magnitude[4];
+        _mm_storeu_si128((__m128i*)magnitude, sums);
+        for (int k = 0; k < 2; k++) {
+            int ok = ((valid >> (8 * k)) & 0xFF) == 0xFF;
+            if (!finish_word(&words[i + k], ok, magnitude[k], &values[i + k]) &&
+                first_invalid == CODEC_ALL_VALID) {
+                first_invalid = i + k;
+            }
+        }
+    }
+    *done = i;
+    return first_invalid;
+}
+
+/*
+ * Máscaras de pshufb para colocar los dígitos. Con X = (U1 | T2) y Z = (U2 | T1)
+ * empaquetados a bytes, la palabra i (0-3) usa:
+ *   d1 = X[i], d2 = X[8+i], d3 = Z[i], d4 = Z[12+i], d5 = X[4+i], d6 = X[12+i], d7 = Z[4+i]
+ * Cada máscara produce dos palabras (8 bytes cada una, el byte 0 es el signo).
+ */
+#define Z_ 0x80
+static const signed char shuffle_x[2][16] = {
+    { Z_, 0, 8, Z_, Z_, 4, 12, Z_,   Z_, 1, 9, Z_, Z_, 5, 13, Z_ },
+    { Z_, 2, 10, Z_, Z_, 6, 14, Z_,  Z_, 3, 11, Z_, Z_, 7, 15, Z_ }
+};
+static const signed char shuffle_z[2][16] = {
+    { Z_, Z_, Z_, 0, 12, Z_, Z_, 4,  Z_, Z_, Z_, 1, 13, Z_, Z_, 5 },
+    { Z_, Z_, Z_, 2, 14, Z_, Z_, 6,  Z_, Z_, Z_, 3, 15, Z_, Z_, 7 }
+};
+#undef Z_
+
+/*
+ * Función auxiliar: digits_sse41 (ESTÁTICA)
+ * Parámetros: magnitude - 4 magnitudes (< 10^7); out - 2 vectores de salida
+ * Propósito: Calcular los dígitos ASCII de 4 magnitudes (signo '0' en el byte 0).
+ */
+__attribute__((target("sse4.1")))
+static inline void digits_sse41(__m128i magnitude, __m128i out[2]) {
+    const __m128i inverse = _mm_set1_epi32((int)3518437209u);  // ceil(2^45 / 10000)
+    __m128i even = _mm_srli_epi64(_mm_mul_epu32(magnitude, inverse), 45);
+    __m128i odd = _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(magnitude, 32), inverse), 45);
+    __m128i high = _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC);          // magnitud / 10000
+    __m128i low = _mm_sub_epi32(magnitude, _mm_mullo_epi32(high, _mm_set1_epi32(10000)));
+
+    __m128i x = _mm_packus_epi32(high, low);                                      // [alta0..3, baja0..3]
+    __m128i c = _mm_srli_epi16(_mm_mulhi_epu16(x, _mm_set1_epi16(5243)), 3);     // x / 100
+    __m128i r = _mm_sub_epi16(x, _mm_mullo_epi16(c, _mm_set1_epi16(100)));       // x % 100
+    __m128i t1 = _mm_mulhi_epu16(c, _mm_set1_epi16(6554));                        // c / 10
+    __m128i u1 = _mm_sub_epi16(c, _mm_mullo_epi16(t1, _mm_set1_epi16(10)));
+    __m128i t2 = _mm_mulhi_epu16(r, _mm_set1_epi16(6554));                        // r / 10
+    __m128i u2 = _mm_sub_epi16(r, _mm_mullo_epi16(t2, _mm_set1_epi16(10)));
+
+    __m128i bx = _mm_packus_epi16(u1, t2);
+    __m128i bz = _mm_packus_epi16(u2, t1);
+    for (int p = 0; p < 2; p++) {
+        __m128i digits = _mm_or_si128(_mm_shuffle_epi8(bx, _mm_loadu_si128((const __m128i*)shuffle_x[p])),
+                                      _mm_shuffle_epi8(bz, _mm_loadu_si128((const __m128i*)shuffle_z[p])));
+        out[p] = _mm_add_epi8(digits, _mm_set1_epi8('0'));
+    }
+}
+
+/*
+ * Función auxiliar: store_words (ESTÁTICA)
+ * Propósito: Escribir 4 palabras codificadas, fijar signo y terminador y
+ *            reemplazar las fuera de rango por "OVERFLOW".
+ */
+__attribute__((target("sse4.1")))
+static inline int store_words(const int* values, Word* words, int i, __m128i out[2], int overflow) {
+    int first_invalid = CODEC_ALL_VALID;
+    for (int p = 0; p < 2; p++) {
+        _mm_storel_epi64((__m128i*)words[i + 2 * p].data, out[p]);
+        _mm_storel_epi64((__m128i*)words[i + 2 * p + 1].data, _mm_srli_si128(out[p], 8));
+    }
+    for (int k = 0; k < 4; k++) {
+        words[i + k].data[8] = '\0';
+        if (values[i + k] < 0) words[i + k].data[0] = '1';
+        if (overflow & (1 << k)) {
+            strcpy(words[i + k].data, "OVERFLOW");
+            if (first_invalid == CODEC_ALL_VALID) first_invalid = i + k;
+        }
+    }
+    return first_invalid;
+}
+
+__attribute__((target("sse4.1")))
+static int encode_sse41(const int* values, Word* words, int count, int* done) {
+    const __m128i word_max = _mm_set1_epi32(CODEC_WORD_MAX);
+    int first_invalid = CODEC_ALL_VALID;
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i magnitude = _mm_abs_epi32(_mm_loadu_si128((const __m128i*)&values[i]));
+        // INT_MIN sigue negativo tras abs: también es desbordamiento
+        __m128i bad = _mm_or_si128(_mm_cmpgt_epi32(magnitude, word_max),
+                                   _mm_cmplt_epi32(magnitude, _mm_setzero_si128()));
+        __m128i out[2];
+        digits_sse41(magnitude, out);
+        int result = store_words(values, words, i, out, _mm_movemask_ps(_mm_castsi128_ps(bad)));
+        if (first_invalid == CODEC_ALL_VALID) first_invalid = result;
+    }
+    *done = i;
+    return first_invalid;
+}
+
+/*
+ * ============================================================================
+ * AVX2 (4 palabras por iteración al decodificar, 8 al codificar)
+ * ============================================================================
+ */
+
+__attribute__((target("avx2")))
+static int decode_avx2(const Word* words, int* values, int count, int* done) {
+    const __m256i zero = _mm256_set1_epi8('0');
+    const __m256i limit = _mm256_set1_epi64x(0x0909090909090901LL);  // Signo <= 1, dígitos <= 9
+    const __m256i tens = _mm256_set1_epi64x(0x010A010A010A0100LL);   // 0,1,10,1,10,1,10,1
+    const __m256i hundreds = _mm256_set1_epi32(0x00010064);          // 100,1
+    const __m256i high = _mm256_set1_epi64x(0x0000000100002710LL);   // 10000,1
+    int first_invalid = CODEC_ALL_VALID;
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i d = _mm256_sub_epi8(_mm256_set_epi64x(load_chars(&words[i + 3]), load_chars(&words[i + 2]),
+                                                      load_chars(&words[i + 1]), load_chars(&words[i])), zero);
+        unsigned int valid = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(d, limit), limit));
+        __m256i parts = _mm256_madd_epi16(_mm256_maddubs_epi16(d, tens), hundreds);
+        __m256i sums = _mm256_hadd_epi32(_mm256_mullo_epi32(parts, high), _mm256_setzero_si256());
+        int magnitude[8];  // [m0, m1, 0, 0, m2, m3, 0, 0]
+        _mm256_storeu_si256((__m256i*)magnitude, sums);
+        for (int k = 0; k < 4; k++) {
+            int ok = ((valid >> (8 * k)) & 0xFF) == 0xFF;
+            if (!finish_word(&words[i + k], ok, magnitude[(k & 1) + 4 * (k >> 1)], &values[i + k]) &&
+                first_invalid == CODEC_ALL_VALID) {
+                first_invalid = i + k;
+            }
+        }
+    }
+    *done = i;
+    return first_invalid;
+}
+
+__attribute__((target("avx2")))
+static int encode_avx2(const int* values, Word* words, int count, int* done) {
+    const __m256i word_max = _mm256_set1_epi32(CODEC_WORD_MAX);
+    int first_invalid = CODEC_ALL_VALID;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i magnitude = _mm256_abs_epi32(_mm256_loadu_si256((const __m256i*)&values[i]));
+        __m256i bad = _mm256_or_si256(_mm256_cmpgt_epi32(magnitude, word_max),
+                                      _mm256_cmpgt_epi32(_mm256_setzero_si256(), magnitude));
+        int overflow = _mm256_movemask_ps(_mm256_castsi256_ps(bad));
+        // Las dos mitades de 128 bits se procesan con el mismo código que SSE4.1
+        __m128i out[2];
+        digits_sse41(_mm256_castsi256_si128(magnitude), out);
+        int result = store_words(values, words, i, out, overflow & 0xF);
+        if (first_invalid == CODEC_ALL_VALID) first_invalid = result;
+        digits_sse41(_mm256_extracti128_si256(magnitude, 1), out);
+        result = store_words(values, words, i + 4, out, overflow >> 4);
+        if (first_invalid == CODEC_ALL_VALID) first_invalid = result;
+    }
+    *done = i;
+    return first_invalid;
+}
+
+#endif /* CODEC_SIMD */
+
+/*
+ * Función: codec_words_to_ints
+ * Propósito: Ver wordcodec.h.
+ */
+int codec_words_to_ints(const Word* words, int* values, int count) {
+    int done = 0;
+    int first_invalid = CODEC_ALL_VALID;
+#if CODEC_SIMD
+    int selected = select_backend();
+    if (selected == BACKEND_AVX2) first_invalid = decode_avx2(words, values, count, &done);
+    else if (selected == BACKEND_SSE41) first_invalid = decode_sse41(words, values, count, &done);
+#endif
+    int tail = decode_scalar(words, values, done, count);  // Palabras restantes
+    return (first_invalid != CODEC_ALL_VALID) ? first_invalid : tail;
+}
+
+/*
+ * Función: codec_ints_to_words
+ * Propósito: Ver wordcodec.h.
+ */
+int codec_ints_to_words(const int* values, Word* words, int count) {
+    int done = 0;
+    int first_invalid = CODEC_ALL_VALID;
+#if CODEC_SIMD
+    int selected = select_backend();
+    if (selected == BACKEND_AVX2) first_invalid = encode_avx2(values, words, count, &done);
+    else if (selected == BACKEND_SSE41) first_invalid = encode_sse41(values, words, count, &done);
+#endif
+    int tail = encode_scalar(values, words, done, count);
+    return (first_invalid != CODEC_ALL_VALID) ? first_invalid : tail;
+}
+
+/*
+ * Función: codec_backend
+ */
+const char* codec_backend() {
+    switch (select_backend()) {
+        case BACKEND_AVX2: return "avx2";
+        case BACKEND_SSE41: return "sse4.1";
+        default: return "escalar";
+    }
+}
+
+/*
+ * Función: codec_force_scalar
+ */
+void codec_force_scalar(int scalar) {
+    force_scalar = scalar;
+}
@@ -0,0 +1,70 @@
+/*
+ * Archivo de cabecera del códec de palabras en bloque del Sistema Operativo Virtual.
+ * Convierte arreglos de palabras de 8 caracteres en signo-magnitud (Word) a
+ * enteros de 32 bits y viceversa, validando los dígitos en la misma pasada.
+ *
+ * Usa aritmética decimal en paralelo con AVX2 o SSE4.1 si el procesador del
+ * host las tiene (se detecta al primer uso) y un camino escalar en otro caso;
+ * los tres dan exactamente el mismo resultado. Para una sola palabra siguen
+ * siendo adecuadas word_to_int() / int_to_word().
+ */
+
+#ifndef WORDCODEC_H
+#define WORDCODEC_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../types.h"  // Para el tipo Word
+
+/*
+ * CONSTANTES DEL CÓDEC
+ * CODEC_WORD_MAX - Mayor magnitud representable (7 dígitos)
+ * CODEC_ALL_VALID - Retorno cuando ningún elemento es inválido
+ */
+#define CODEC_WORD_MAX 9999999
+#define CODEC_ALL_VALID -1
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del códec
+ */
+
+/*
+ * Función: codec_words_to_ints
+ * Parámetros:
+ *   words  - palabras de entrada
+ *   values - enteros de salida (count elementos)
+ *   count  - cantidad de palabras
+ * Retorna: int - índice de la primera palabra inválida, o CODEC_ALL_VALID
+ * Propósito: Una palabra es válida si tiene signo '0' o '1', siete dígitos y
+ *            el terminador en la posición 8. Las inválidas se convierten a 0
+ *            (igual que word_to_int) y la conversión continúa.
+ */
+int codec_words_to_ints(const Word* words, int* values, int count);
+
+/*
+ * Función: codec_ints_to_words
+ * Parámetros:
+ *   values - enteros de entrada
+ *   words  - palabras de salida (count elementos)
+ *   count  - cantidad de valores
+ * Retorna: int - índice del primer valor con más de 7 dígitos, o CODEC_ALL_VALID
+ * Propósito: Los valores fuera de rango producen "OVERFLOW" (igual que
+ *            int_to_word) y la conversión continúa.
+ */
+int codec_ints_to_words(const int* values, Word* words, int count);
+
+/*
+ * Función: codec_backend
+ * Retorna: const char* - implementación en uso: "avx2", "sse4.1" o "escalar"
+ */
+const char* codec_backend();
+
+/*
+ * Función: codec_force_scalar
+ * Parámetros: scalar - 1 para usar siempre el camino escalar (comparaciones, bench)
+ */
+void codec_force_scalar(int scalar);
+
+#endif /* WORDCODEC_H */
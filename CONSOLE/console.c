@@ -3,6 +3,9 @@
  * Contiene la lógica completa para la interfaz de línea de comandos interactiva.
  */
 
+/* Macro necesaria para clock_gettime() con -std=c99 */
+#define _POSIX_C_SOURCE 199309L
+
 /* Inclusión de cabeceras propias del módulo */
 #include "console.h"
 
@@ -12,24 +15,32 @@
 #include "../REGISTERS/registers.h" // Para manejar registros
 #include "../DISK/disk.h"         // Para operaciones de disco
 #include "../LOGGER/logger.h"     // Para registro de eventos
+#include "../PROFILER/profiler.h" // Para el comando 'profile'
+#include "../PROFILER/callgraph.h" // Para el comando 'callgraph'
+#include "../PROFILER/coverage.h" // Para el comando 'coverage' y el mapa de líneas
+#include "../PROFILER/perfstat.h" // Para el comando 'perfstat'
+#include "../PROFILER/trace.h"    // Para el comando 'trace'
+#include "../METRICS/metrics.h"   // Para el comando 'stats'
+#include "../DEBUGGER/gdbstub.h"  // Para el comando 'gdb'
+#include "../CPU/blockcache.h"    // Para el comando 'bbcache'
+#include "../CPU/jit.h"           // Para el comando 'jit'
+#include "../ASM/assembler.h"     // Para cargar fuentes '.asm' e imágenes binarias
+#include "../ASM/disassembler.h"  // Para el comando 'disasm'
+#include "../FS/fs.h"             // Para el comando 'fs' y cargar programas del disco
+#include "../SHM/shm.h"           // Para el comando 'shm' y soltar segmentos al cargar
+#include "../MSG/msg.h"           // Para el comando 'msg'
+#include "../MMIO/mmio.h"         // Para el comando 'mmio'
+#include "../NET/net.h"           // Para el comando 'net'
+#include "../CPU/lockstep.h"      // Para el comando 'lockstep'
+#include "../DMA/dma.h"           // Para terminar la transferencia pendiente al cargar
+#include "../SIM/sim.h"           // Para el comando 'sim'
 
 /* Inclusión de bibliotecas estándar */
 #include <stdio.h>    // Entrada/salida estándar
 #include <string.h>   // Manipulación de cadenas
 #include <stdlib.h>   // Funciones generales
 #include <ctype.h>    // Funciones de caracteres
-
-/*
- * MACROS PARA COMPATIBILIDAD MULTIPLATAFORMA
- * Define macros para manejar diferencias entre Windows y sistemas Unix-like
- */
-#ifdef _WIN32
-    #include <windows.h>          // API de Windows para Sleep()
-    #define CONSOLE_SLEEP(ms) Sleep(ms)  // Dormir en milisegundos (Windows)
-#else
-    #include <unistd.h>           // API POSIX para usleep()
-    #define CONSOLE_SLEEP(ms) usleep(ms * 1000)  // Dormir en microsegundos (Unix)
-#endif
+#include <time.h>     // Para clock_gettime (tiempo del modo por lotes)
 
 /*
  * VARIABLES GLOBALES ESTÁTICAS
@@ -39,12 +50,35 @@ static ExecutionMode current_mode = MODE_NORMAL;  // Modo de ejecución actual
 static int debug_step_count = 0;                   // Contador de pasos en modo depuración
 static int program_loaded = 0;                     // Flag que indica si hay programa cargado
 
+/*
+ * CONSTANTES DEL COMANDO 'bench'
+ * BENCH_DEFAULT_ITERATIONS - Ejecuciones si no se indica N
+ * BENCH_MAX_ITERATIONS     - Máximo de ejecuciones (tamaño del arreglo de muestras)
+ * BENCH_MAX_INSTRUCTIONS   - Tope por ejecución para programas que no terminan
+ */
+#define BENCH_DEFAULT_ITERATIONS 10
+#define BENCH_MAX_ITERATIONS 10000
+#define BENCH_MAX_INSTRUCTIONS 10000000
+
+/*
+ * CONSTANTES DEL COMANDO 'lockstep'
+ * LOCKSTEP_SHOWN - Instancias que se listan una por una (el resto, en el resumen)
+ */
+#define LOCKSTEP_SHOWN 32
+
+/*
+ * CONSTANTES DEL SISTEMA DE ARCHIVOS EN LA CONSOLA
+ * DISK_PROGRAM_PREFIX - Prefijo de los programas guardados en el disco virtual
+ * IMPORT_MAX_WORDS    - Tamaño máximo de un archivo del disco
+ */
+#define DISK_PROGRAM_PREFIX "disk:"
+#define IMPORT_MAX_WORDS (FS_MAX_FILE_BLOCKS * FS_BLOCK_WORDS)
+
 /*
  * PROTOTIPOS DE FUNCIONES INTERNAS
  * Funciones auxiliares no expuestas en la cabecera
  */
 void debug_step();                                // Ejecutar un paso de depuración
-int load_program_file(const char* filename);      // Cargar programa desde archivo
 void show_detailed_registers();                   // Mostrar registros con formato detallado
 
 // Declaración de función externa (si existe en otro módulo)
@@ -66,8 +100,29 @@ void init_console() {
     printf("  continue           - Continuar ejecución (debug)\n");
     printf("  registers          - Mostrar registros\n");
     printf("  memory [inicio] [fin] - Mostrar memoria\n");
-    printf("  disk               - Información del disco\n");
-    printf("  load <archivo>     - Cargar programa sin ejecutar\n");
+    printf("  disasm [inicio] [fin] - Desensamblar memoria (con perfil y cobertura)\n");
+    printf("  disk [save|load <imagen>] - Información del disco o guardarlo en el host\n");
+    printf("  fs [status|ls|format|frag|defrag|import <archivo> [nombre]|export <nombre> <archivo>|rm <nombre>]\n");
+    printf("                     - Sistema de archivos del disco virtual\n");
+    printf("  shm [status|rm <id>] - Segmentos de memoria compartida\n");
+    printf("  msg                - Ocupación de los buzones de mensajes\n");
+    printf("  mmio               - Dispositivos de la ventana de E/S mapeada en memoria\n");
+    printf("  net [status|attach [puerto] [segmento]|detach] - Placa de red (requiere netswitch.exe)\n");
+    printf("  sim [status|timer <ciclos>|throttle <ms>] - Reloj virtual, INT_TIMER y pausa de 'run'\n");
+    printf("  load <archivo>     - Cargar programa sin ejecutar (.txt, fuente .asm, imagen o disk:<nombre>)\n");
+    printf("  profile [on|off|reset|report [N]|export <archivo>] - Profiler\n");
+    printf("  callgraph [on|off|reset|report [N]|export <archivo>] - Grafo de llamadas\n");
+    printf("  coverage [on|off|reset|summary|report [archivo]] - Cobertura de código\n");
+    printf("  perfstat [archivo] - Ejecutar midiendo contadores del host (IPC, fallos)\n");
+    printf("  trace [start|stop|status|export <archivo.json>] - Traza para Perfetto\n");
+    printf("  bench <archivo> [N] - Ejecutar N veces sin pausas (min/mediana/p99, MIPS)\n");
+    printf("  lockstep <archivo> <N> [dirección [inicio [paso]]] - N instancias en carriles SIMD,\n");
+    printf("                     la palabra 'dirección' vale inicio + i * paso en la instancia i\n");
+    printf("  lockstep simd [auto|avx512|avx2|escalar] - Implementación de los carriles\n");
+    printf("  stats              - Estadísticas de la sesión\n");
+    printf("  gdb <archivo> [puerto|socket] - Depurar desde GDB (target remote :1234)\n");
+    printf("  bbcache [on|off|flush|status] - Caché de bloques básicos traducidos\n");
+    printf("  jit [on|off|status] - Compilación a x86-64 de los bloques calientes\n");
     printf("  help               - Mostrar ayuda\n");
     printf("  exit               - Salir del sistema\n");
     printf("========================================\n\n");
@@ -101,14 +156,15 @@ ParsedCommand parse_command(const char* input) {
     cmd.param1 = -1;         // -1 indica parámetro no especificado
     cmd.param2 = -1;         // -1 indica parámetro no especificado
     cmd.filename[0] = '\0';  // Cadena vacía para nombre de archivo
+    cmd.subcommand[0] = '\0'; // Cadena vacía para subcomando
+    cmd.argument[0] = '\0';  // Cadena vacía para argumento adicional
     
     char buffer[200];  // Buffer temporal para procesar la entrada
     strcpy(buffer, input);  // Copiar la entrada al buffer
     
-    // Normalización de la entrada: convertir a minúsculas y eliminar saltos de línea
+    // Normalización de la entrada: eliminar saltos de línea
     for (int i = 0; buffer[i]; i++) {
-        buffer[i] = tolower(buffer[i]);  // Convertir a minúsculas
-        if (buffer[i] == '\n') buffer[i] = '\0';  // Eliminar newline
+        if (buffer[i] == '\n' || buffer[i] == '\r') buffer[i] = '\0';  // Eliminar newline
     }
     
     // Tokenización: dividir la cadena en palabras usando espacios y tabs como delimitadores
@@ -118,6 +174,12 @@ ParsedCommand parse_command(const char* input) {
         return cmd;  // Entrada vacía, retorna comando desconocido
     }
     
+    // Solo el nombre del comando se convierte a minúsculas; los nombres de
+    // archivo conservan mayúsculas (ej: PROGRAMS/suma.txt)
+    for (int i = 0; token[i]; i++) {
+        token[i] = tolower((unsigned char)token[i]);
+    }
+    
     /*
      * IDENTIFICACIÓN DE COMANDOS
      * Compara el primer token con cada comando posible
@@ -157,8 +219,39 @@ ParsedCommand parse_command(const char* input) {
         token = strtok(NULL, " \t");
         if (token) cmd.param2 = atoi(token);
     }
-    else if (strcmp(token, "disk") == 0 || strcmp(token, "d") == 0) {
-        cmd.cmd = CMD_DISK;  // Comando abreviado 'd' también válido
+    else if (strcmp(token, "disasm") == 0 || strcmp(token, "dis") == 0) {
+        cmd.cmd = CMD_DISASM;
+        token = strtok(NULL, " \t");
+        if (token) cmd.param1 = atoi(token);
+        token = strtok(NULL, " \t");
+        if (token) cmd.param2 = atoi(token);
+    }
+    else if (strcmp(token, "disk") == 0 || strcmp(token, "d") == 0 || strcmp(token, "fs") == 0 ||
+             strcmp(token, "shm") == 0 || strcmp(token, "msg") == 0 || strcmp(token, "net") == 0 ||
+             strcmp(token, "sim") == 0) {
+        // Comando abreviado 'd' también válido
+        cmd.cmd = (token[0] == 'f') ? CMD_FS : (strcmp(token, "shm") == 0) ? CMD_SHM :
+                  (token[0] == 's') ? CMD_SIM : (token[0] == 'm') ? CMD_MSG :
+                  (token[0] == 'n') ? CMD_NET : CMD_DISK;
+        // Subcomando opcional y hasta dos argumentos (archivo del host / nombre en el disco)
+        token = strtok(NULL, " \t");
+        if (token) {
+            strncpy(cmd.subcommand, token, sizeof(cmd.subcommand) - 1);
+            cmd.subcommand[sizeof(cmd.subcommand) - 1] = '\0';
+            for (int i = 0; cmd.subcommand[i]; i++) {
+                cmd.subcommand[i] = tolower((unsigned char)cmd.subcommand[i]);
+            }
+            token = strtok(NULL, " \t");
+            if (token) {
+                strncpy(cmd.filename, token, sizeof(cmd.filename) - 1);
+                cmd.filename[sizeof(cmd.filename) - 1] = '\0';
+                token = strtok(NULL, " \t");
+                if (token) {
+                    strncpy(cmd.argument, token, sizeof(cmd.argument) - 1);
+                    cmd.argument[sizeof(cmd.argument) - 1] = '\0';
+                }
+            }
+        }
     }
     else if (strcmp(token, "load") == 0) {
         cmd.cmd = CMD_LOAD;
@@ -168,6 +261,127 @@ ParsedCommand parse_command(const char* input) {
             cmd.filename[sizeof(cmd.filename) - 1] = '\0';
         }
     }
+    else if (strcmp(token, "profile") == 0 || strcmp(token, "prof") == 0 ||
+             strcmp(token, "callgraph") == 0 || strcmp(token, "cg") == 0 ||
+             strcmp(token, "coverage") == 0 || strcmp(token, "cov") == 0) {
+        if (token[0] == 'p') cmd.cmd = CMD_PROFILE;
+        else if (strncmp(token, "cov", 3) == 0) cmd.cmd = CMD_COVERAGE;
+        else cmd.cmd = CMD_CALLGRAPH;
+        // Subcomando opcional (por defecto: report)
+        token = strtok(NULL, " \t");
+        if (token) {
+            strncpy(cmd.subcommand, token, sizeof(cmd.subcommand) - 1);
+            cmd.subcommand[sizeof(cmd.subcommand) - 1] = '\0';
+            for (int i = 0; cmd.subcommand[i]; i++) {
+                cmd.subcommand[i] = tolower((unsigned char)cmd.subcommand[i]);
+            }
+            // Argumento del subcomando: N para 'report', archivo para 'export'
+            token = strtok(NULL, " \t");
+            if (token) {
+                strncpy(cmd.filename, token, sizeof(cmd.filename) - 1);
+                cmd.filename[sizeof(cmd.filename) - 1] = '\0';
+                cmd.param1 = atoi(token);
+            }
+        }
+    }
+    else if (strcmp(token, "perfstat") == 0) {
+        cmd.cmd = CMD_PERFSTAT;
+        token = strtok(NULL, " \t");  // Archivo opcional (sin archivo: último reporte)
+        if (token) {
+            strncpy(cmd.filename, token, sizeof(cmd.filename) - 1);
+            cmd.filename[sizeof(cmd.filename) - 1] = '\0';
+        }
+    }
+    else if (strcmp(token, "trace") == 0) {
+        cmd.cmd = CMD_TRACE;
+        // Subcomando opcional (por defecto: status) y archivo para 'export'
+        token = strtok(NULL, " \t");
+        if (token) {
+            strncpy(cmd.subcommand, token, sizeof(cmd.subcommand) - 1);
+            cmd.subcommand[sizeof(cmd.subcommand) - 1] = '\0';
+            for (int i = 0; cmd.subcommand[i]; i++) {
+                cmd.subcommand[i] = tolower((unsigned char)cmd.subcommand[i]);
+            }
+            token = strtok(NULL, " \t");
+            if (token) {
+                strncpy(cmd.filename, token, sizeof(cmd.filename) - 1);
+                cmd.filename[sizeof(cmd.filename) - 1] = '\0';
+            }
+        }
+    }
+    else if (strcmp(token, "bench") == 0) {
+        cmd.cmd = CMD_BENCH;
+        token = strtok(NULL, " \t");
+        if (token) {
+            strncpy(cmd.filename, token, sizeof(cmd.filename) - 1);
+            cmd.filename[sizeof(cmd.filename) - 1] = '\0';
+            token = strtok(NULL, " \t");
+            if (token) cmd.param1 = atoi(token);  // Iteraciones (opcional)
+        }
+    }
+    else if (strcmp(token, "lockstep") == 0) {
+        cmd.cmd = CMD_LOCKSTEP;
+        token = strtok(NULL, " \t");
+        if (token && strcmp(token, "simd") == 0) {
+            strcpy(cmd.subcommand, "simd");
+            token = strtok(NULL, " \t");  // Implementación (opcional)
+            if (token) {
+                strncpy(cmd.argument, token, sizeof(cmd.argument) - 1);
+                cmd.argument[sizeof(cmd.argument) - 1] = '\0';
+            }
+        } else if (token) {
+            strncpy(cmd.filename, token, sizeof(cmd.filename) - 1);
+            cmd.filename[sizeof(cmd.filename) - 1] = '\0';
+            token = strtok(NULL, " \t");
+            if (token) cmd.param1 = atoi(token);  // Instancias
+            token = strtok(NULL, "");            // Barrido: dirección, inicio y paso
+            if (token) {
+                strncpy(cmd.argument, token, sizeof(cmd.argument) - 1);
+                cmd.argument[sizeof(cmd.argument) - 1] = '\0';
+            }
+        }
+    }
+    else if (strcmp(token, "stats") == 0) {
+        cmd.cmd = CMD_STATS;
+    }
+    else if (strcmp(token, "mmio") == 0) {
+        cmd.cmd = CMD_MMIO;
+    }
+    else if (strcmp(token, "bbcache") == 0) {
+        cmd.cmd = CMD_BBCACHE;
+        token = strtok(NULL, " \t");
+        if (token) {
+            strncpy(cmd.subcommand, token, sizeof(cmd.subcommand) - 1);
+            cmd.subcommand[sizeof(cmd.subcommand) - 1] = '\0';
+            for (int i = 0; cmd.subcommand[i]; i++) {
+                cmd.subcommand[i] = tolower((unsigned char)cmd.subcommand[i]);
+            }
+        }
+    }
+    else if (strcmp(token, "jit") == 0) {
+        cmd.cmd = CMD_JIT;
+        token = strtok(NULL, " \t");
+        if (token) {
+            strncpy(cmd.subcommand, token, sizeof(cmd.subcommand) - 1);
+            cmd.subcommand[sizeof(cmd.subcommand) - 1] = '\0';
+            for (int i = 0; cmd.subcommand[i]; i++) {
+                cmd.subcommand[i] = tolower((unsigned char)cmd.subcommand[i]);
+            }
+        }
+    }
+    else if (strcmp(token, "gdb") == 0) {
+        cmd.cmd = CMD_GDB;
+        token = strtok(NULL, " \t");
+        if (token) {
+            strncpy(cmd.filename, token, sizeof(cmd.filename) - 1);
+            cmd.filename[sizeof(cmd.filename) - 1] = '\0';
+            token = strtok(NULL, " \t");
+            if (token) {  // Puerto TCP o ruta de socket Unix (opcional)
+                strncpy(cmd.argument, token, sizeof(cmd.argument) - 1);
+                cmd.argument[sizeof(cmd.argument) - 1] = '\0';
+            }
+        }
+    }
     else if (strcmp(token, "help") == 0 || strcmp(token, "?") == 0 || strcmp(token, "h") == 0) {
         cmd.cmd = CMD_HELP;  // Múltiples formas de pedir ayuda
     }
@@ -178,48 +392,541 @@ ParsedCommand parse_command(const char* input) {
     return cmd;  // Retornar comando parseado
 }
 
+/*
+ * Función auxiliar: finish_load (ESTÁTICA)
+ * Parámetros: filename - archivo cargado, words - palabras escritas desde OS_RESERVED
+ * Retorna: int - dirección lógica de inicio del programa (0)
+ * Propósito: Pasos comunes a los tres formatos una vez escrita la memoria.
+ */
+static int finish_load(const char* filename, int words) {
+    blockcache_flush();  // La memoria se escribió directamente: descartar bloques traducidos
+    shm_release();       // El proceso anterior terminó: soltar su segmento compartido
+    net_release();       // ...y apagar el anillo de recepción que apuntaba a su memoria
+    
+    /*
+     * CONFIGURACIÓN DE LA REGIÓN DE MEMORIA PARA EL PROCESO
+     * El proceso ocupa todo el espacio de usuario: RB = OS_RESERVED y
+     * RL = MEMORY_SIZE - OS_RESERVED. La pila comienza al final de la región.
+     */
+    cpu_registers.RB = int_to_word(OS_RESERVED);
+    cpu_registers.RL = int_to_word(MEMORY_SIZE - OS_RESERVED);
+    cpu_registers.SP = int_to_word(MEMORY_SIZE - OS_RESERVED - 1);
+    
+    log_event(LOG_INFO, "Programa %s cargado: %d palabras en dirección física %d",
+              filename, words, OS_RESERVED);
+    
+    program_loaded = 1;  // Marcar que hay un programa cargado
+    return 0;  // Dirección lógica de inicio (relativa a RB)
+}
+
+/*
+ * Función auxiliar: load_assembly (ESTÁTICA)
+ * Retorna: int - dirección lógica de inicio, o -1 si el fuente tiene errores
+ * Propósito: Ensamblar un fuente '.asm' en memoria y cargarlo. El mapa de
+ *            cobertura apunta a las líneas del fuente.
+ */
+static int load_assembly(const char* filename) {
+    AsmProgram program;
+    if (asm_assemble_file(filename, &program) != 0) {
+        asm_free(&program);
+        return -1;
+    }
+    if (program.count > MEMORY_SIZE - OS_RESERVED) {
+        printf("Error: el programa no cabe en memoria (máximo %d palabras)\n",
+               MEMORY_SIZE - OS_RESERVED);
+        asm_free(&program);
+        return -1;
+    }
+    coverage_set_source(filename);
+    for (int i = 0; i < program.count; i++) {
+        memory[OS_RESERVED + i] = program.words[i];
+        coverage_map_line(i, program.lines[i]);
+    }
+    int words = program.count;
+    asm_free(&program);
+    return finish_load(filename, words);
+}
+
+/*
+ * Función auxiliar: load_image (ESTÁTICA)
+ * Parámetros: file - abierto y posicionado tras la cabecera ASM_IMAGE_MAGIC
+ * Retorna: int - dirección lógica de inicio, o -1 si hay error
+ * Propósito: Cargar una imagen binaria de asm.exe. No tiene líneas de
+ *            fuente, por lo que no hay mapa de cobertura.
+ */
+static int load_image(FILE* file, const char* filename) {
+    char word[8];
+    int address = OS_RESERVED;
+    size_t got;
+    coverage_set_source(filename);
+    while ((got = fread(word, 1, sizeof(word), file)) == sizeof(word)) {
+        for (int i = 0; i < 8; i++) {
+            if (!isdigit((unsigned char)word[i])) {
+                printf("Error: imagen dañada en la palabra %d\n", address - OS_RESERVED);
+                return -1;
+            }
+        }
+        if (address >= MEMORY_SIZE) {
+            printf("Error: el programa no cabe en memoria (máximo %d palabras)\n",
+                   MEMORY_SIZE - OS_RESERVED);
+            return -1;
+        }
+        memcpy(memory[address].data, word, sizeof(word));
+        memory[address].data[8] = '\0';
+        address++;
+    }
+    if (got != 0) {
+        printf("Error: imagen truncada (%zu bytes sobrantes)\n", got);
+        return -1;
+    }
+    return finish_load(filename, address - OS_RESERVED);
+}
+
+/*
+ * Función auxiliar: load_from_disk (ESTÁTICA)
+ * Parámetros: filename - "disk:<nombre>" (nombre en el sistema de archivos)
+ * Retorna: int - dirección lógica de inicio, o -1 si hay error
+ * Propósito: Cargar un programa guardado en el disco virtual ('fs import').
+ */
+static int load_from_disk(const char* filename) {
+    const char* name = filename + strlen(DISK_PROGRAM_PREFIX);
+    int inode = fs_lookup(name);
+    if (inode < 0) {
+        printf("Error: %s: %s\n", name, fs_error_text(inode));
+        return -1;
+    }
+    int size = fs_size(inode);
+    if (size > MEMORY_SIZE - OS_RESERVED) {
+        printf("Error: el programa no cabe en memoria (máximo %d palabras)\n",
+               MEMORY_SIZE - OS_RESERVED);
+        return -1;
+    }
+    coverage_set_source(filename);
+    fs_read(inode, 0, &memory[OS_RESERVED], size);
+    return finish_load(filename, size);
+}
+
 /*
  * Función: load_program_file (INTERNA)
  * Parámetros: filename - nombre del archivo con el programa
- * Retorna: int - dirección de inicio del programa en memoria, o -1 si hay error
- * Propósito: Carga un programa desde archivo a memoria. Actualmente simula la carga
- *            de un programa de ejemplo. En una implementación real leería del archivo.
+ * Retorna: int - dirección lógica de inicio del programa, o -1 si hay error
+ * Propósito: Carga un programa desde archivo a memoria.
+ * 
+ * Formato del archivo: una palabra de 8 dígitos por línea (ej: "04100005").
+ * Las líneas vacías y el texto desde '#' o ';' hasta el fin de línea se ignoran.
+ * También se aceptan fuentes con mnemónicos (extensión '.asm', se ensamblan
+ * al cargar) e imágenes binarias de asm.exe (reconocidas por la cabecera).
+ * Con el prefijo "disk:" el programa se lee del sistema de archivos del disco.
+ * El programa se carga a partir de la dirección física OS_RESERVED y se le
+ * asigna como región de memoria todo el espacio de usuario.
  */
 int load_program_file(const char* filename) {
     printf("Cargando programa: %s\n", filename);
+    dma_wait_completion();  // La transferencia del programa anterior no debe pisar al nuevo
     
-    /*
-     * SIMULACIÓN DE CARGA DE PROGRAMA
-     * En una implementación real, se leería el archivo y se cargarían
-     * las instrucciones reales. Aquí se simula con un programa de ejemplo.
-     */
+    if (strncmp(filename, DISK_PROGRAM_PREFIX, strlen(DISK_PROGRAM_PREFIX)) == 0) {
+        return load_from_disk(filename);
+    }
     
-    // Programa de ejemplo: suma 5 + 3 y almacena el resultado
-    // Cada instrucción es una Word de 8 dígitos
+    size_t name_length = strlen(filename);
+    if (name_length > 4 && strcmp(filename + name_length - 4, ".asm") == 0) {
+        return load_assembly(filename);
+    }
     
-    // 00050000 = LOAD inmediato 5 (carga el valor 5 en el acumulador)
-    write_memory(300, (Word){"00050000"});
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        printf("Error: no se pudo abrir el archivo '%s'\n", filename);
+        log_event(LOG_ERROR, "No se pudo abrir el programa %s", filename);
+        return -1;
+    }
     
-    // 01030000 = ADD inmediato 3 (suma 3 al acumulador)
-    write_memory(301, (Word){"01030000"});
+    char line[200];            // Línea leída del archivo
+    int line_number = 0;       // Número de línea (para mensajes de error)
+    int address = OS_RESERVED; // Dirección física donde se carga la siguiente palabra
     
-    // 05001200 = STORE en dirección 312 (guarda resultado en memoria)
-    write_memory(302, (Word){"05001200"});
+    // Imagen binaria: empieza con la cabecera del ensamblador
+    if (fread(line, 1, 8, file) == 8 && memcmp(line, ASM_IMAGE_MAGIC, 8) == 0) {
+        int result = load_image(file, filename);
+        fclose(file);
+        return result;
+    }
+    rewind(file);
     
-    // 45000000 = HALT (detiene la ejecución)
-    write_memory(303, (Word){"45000000"});
+    // Preparar el mapa dirección -> línea para los reportes de cobertura
+    coverage_set_source(filename);
     
-    /*
-     * CONFIGURACIÓN DE LA REGIÓN DE MEMORIA PARA EL PROCESO
-     * Define el espacio de memoria que el proceso puede usar
-     */
-    // Configurar registro base (RB) a 300
-    cpu_registers.RB = int_to_word(300);
-    // Configurar registro límite (RL) a 100 (tamaño de la región)
-    cpu_registers.RL = int_to_word(100);
+    while (fgets(line, sizeof(line), file) != NULL) {
+        line_number++;
+        
+        // Eliminar comentarios
+        line[strcspn(line, "#;")] = '\0';
+        
+        // Obtener la palabra (ignora espacios y saltos de línea)
+        char* token = strtok(line, " \t\r\n");
+        if (token == NULL) continue;  // Línea vacía o solo comentario
+        
+        // Validar que sean exactamente 8 dígitos decimales
+        int valid = (strlen(token) == 8);
+        for (int i = 0; valid && i < 8; i++) {
+            valid = isdigit((unsigned char)token[i]);
+        }
+        if (!valid) {
+            printf("Error: línea %d: palabra inválida '%s'\n", line_number, token);
+            fclose(file);
+            return -1;
+        }
+        
+        if (address >= MEMORY_SIZE) {
+            printf("Error: el programa no cabe en memoria (máximo %d palabras)\n",
+                   MEMORY_SIZE - OS_RESERVED);
+            fclose(file);
+            return -1;
+        }
+        
+        // Escribir directamente en memoria física (la carga la hace el SO)
+        strcpy(memory[address].data, token);
+        coverage_map_line(address - OS_RESERVED, line_number);  // Dirección lógica
+        address++;
+    }
+    fclose(file);
+    return finish_load(filename, address - OS_RESERVED);
+}
+
+/*
+ * Función auxiliar: show_disassembly (ESTÁTICA)
+ * Parámetros: start, end - rango de direcciones físicas (como 'memory')
+ * Propósito: Listado desensamblado del rango. Por cada palabra muestra la
+ *            dirección física y la lógica del proceso, la palabra, la
+ *            instrucción y el destino de los saltos, y si hay datos:
+ *            ejecuciones según el profiler (y % del total), '*' si la
+ *            cobertura la marcó como ejecutada y [bb]/[jit] si está en un
+ *            bloque traducido (la decodificación se toma de la caché).
+ *            Las direcciones destino de algún salto del rango llevan '>'.
+ */
+static void show_disassembly(int start, int end) {
+    if (start < 0) start = 0;
+    if (end >= MEMORY_SIZE) end = MEMORY_SIZE - 1;
+    if (end < start) return;
     
-    program_loaded = 1;  // Marcar que hay un programa cargado
-    return 300;  // Retornar dirección de inicio del programa
+    int rb = word_to_int(cpu_registers.RB);
+    int rl = word_to_int(cpu_registers.RL);
+    unsigned long long total = profiler_total_instructions();
+    static DisasmLine lines[MEMORY_SIZE];
+    static unsigned char cached[MEMORY_SIZE];   // 0 = decodificada aquí, 1 = caché, 2 = JIT
+    static unsigned char target[MEMORY_SIZE];   // 1 = destino de un salto del rango
+    memset(target, 0, sizeof(target));
+    
+    // Primera pasada: decodificar y marcar destinos
+    for (int p = start; p <= end; p++) {
+        MicroPart part;
+        int native;
+        if (blockcache_lookup(p, &part, &native)) {
+            disasm_set(part.opcode, part.mode, part.value, &lines[p]);
+            cached[p] = (unsigned char)(1 + native);
+        } else {
+            disasm_decode(&memory[p], &lines[p]);
+            cached[p] = 0;
+        }
+        int to = lines[p].target;
+        if (to != DISASM_NO_TARGET) {
+            int physical = (rb == 0 && rl == 0) ? to : to + rb;
+            if (physical >= start && physical <= end) target[physical] = 1;
+        }
+    }
+    
+    printf("\nDESENSAMBLADO [%d - %d] (RB=%d):\n", start, end, rb);
+    printf("  FÍSICA LÓG.  PALABRA   INSTRUCCIÓN         DESTINO    %s\n",
+           total ? "EJECUCIONES" : "");
+    for (int p = start; p <= end; p++) {
+        int flat = (rb == 0 && rl == 0);  // Sin región: lógica = física
+        int logical = flat ? p : p - rb;
+        int in_process = flat || (logical >= 0 && logical < rl);
+        char text[DISASM_TEXT_SIZE];
+        char where[8] = "";
+        char jump[16] = "";
+        disasm_format(&lines[p], text);
+        if (in_process) snprintf(where, sizeof(where), "%d", logical);
+        if (lines[p].target != DISASM_NO_TARGET) {
+            snprintf(jump, sizeof(jump), "-> %04d", flat ? lines[p].target : lines[p].target + rb);
+        } else if (lines[p].jumps) {  // Indexado: el destino depende del AC
+            snprintf(jump, sizeof(jump), "-> AC+%d", lines[p].value);
+        }
+        
+        printf("%c %04d  %5s  %s  %-19s %-10s", target[p] ? '>' : ' ', p, where, memory[p].data, text, jump);
+        if (in_process && total) {
+            unsigned long long count = profiler_pc_count(logical);
+            if (count) printf(" %10llu %5.1f%%", count, 100.0 * count / total);
+            else printf(" %17s", "");
+        }
+        if (in_process && logical < MEMORY_SIZE &&
+            (coverage_executed[logical >> 5] & (1u << (logical & 31)))) {
+            printf(" *");
+        }
+        if (cached[p]) printf(" %s", cached[p] == 2 ? "[jit]" : "[bb]");
+        printf("\n");
+    }
+}
+
+/*
+ * Función auxiliar: compare_durations (ESTÁTICA)
+ * Propósito: Comparador para qsort (orden ascendente de tiempos).
+ */
+static int compare_durations(const void* a, const void* b) {
+    unsigned long long x = *(const unsigned long long*)a;
+    unsigned long long y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Función auxiliar: bench_program (ESTÁTICA)
+ * Parámetros:
+ *   filename   - programa a medir
+ *   iterations - cantidad de ejecuciones
+ * Propósito: Cargar el programa una vez y ejecutarlo 'iterations' veces sin
+ *            pausas entre ciclos, restaurando antes de cada ejecución la
+ *            memoria y los registros que dejó la carga (así cada iteración
+ *            parte del mismo estado). Reporta tiempo de pared mínimo, mediana
+ *            y p99, y los MIPS del invitado con la mediana.
+ */
+static void bench_program(const char* filename, int iterations) {
+    if (iterations > BENCH_MAX_ITERATIONS) iterations = BENCH_MAX_ITERATIONS;
+    
+    int start_addr = load_program_file(filename);
+    if (start_addr == -1) return;
+    
+    static Word saved_memory[MEMORY_SIZE];        // Estático: no cabe cómodo en la pila
+    static unsigned long long samples[BENCH_MAX_ITERATIONS];
+    memcpy(saved_memory, memory, sizeof(saved_memory));
+    CPU_Registers saved_registers = cpu_registers;
+    
+    unsigned long long instructions = 0;  // Instrucciones por ejecución (la última)
+    int truncated = 0;                    // 1 si alguna ejecución superó el tope
+    for (int i = 0; i < iterations; i++) {
+        memcpy(memory, saved_memory, sizeof(saved_memory));
+        blockcache_flush();
+        cpu_registers = saved_registers;
+        cpu_registers.PSW.PC_psw = start_addr;
+        set_PC_int(start_addr);
+        set_cpu_state(CPU_RUNNING);
+        
+        struct timespec start, end;
+        unsigned long long first = cpu_instructions_retired;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        while (get_cpu_state() == CPU_RUNNING) {
+            if (cpu_instructions_retired - first >= BENCH_MAX_INSTRUCTIONS) {
+                set_cpu_state(CPU_HALTED);
+                truncated = 1;
+                break;
+            }
+            cpu_cycle_block(BENCH_MAX_INSTRUCTIONS - (cpu_instructions_retired - first));
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        
+        samples[i] = (unsigned long long)(end.tv_sec - start.tv_sec) * 1000000000ULL +
+                     (end.tv_nsec - start.tv_nsec);
+        instructions = cpu_instructions_retired - first;
+    }
+    
+    qsort(samples, iterations, sizeof(samples[0]), compare_durations);
+    unsigned long long min = samples[0];
+    unsigned long long median = samples[iterations / 2];
+    unsigned long long p99 = samples[(iterations * 99 + 99) / 100 - 1];  // Percentil 99 (rango más cercano)
+    
+    printf("\n=== BENCH %s (%d iteraciones, %llu instrucciones c/u) ===\n",
+           filename, iterations, instructions);
+    if (truncated) {
+        printf("Aviso: ejecuciones cortadas en %d instrucciones (¿el programa termina?)\n",
+               BENCH_MAX_INSTRUCTIONS);
+    }
+    printf("Tiempo mínimo:  %10.3f ms\n", min / 1e6);
+    printf("Tiempo mediana: %10.3f ms\n", median / 1e6);
+    printf("Tiempo p99:     %10.3f ms\n", p99 / 1e6);
+    printf("MIPS invitado:  %10.4f (con la mediana)\n",
+           median > 0 ? instructions * 1000.0 / median : 0.0);
+    printf("============================================\n");
+}
+
+/*
+ * Función auxiliar: lockstep_command (ESTÁTICA)
+ * Parámetros: cmd - comando 'lockstep' (archivo, instancias y barrido)
+ * Propósito: Cargar el programa y ejecutarlo una vez por instancia con el
+ *            intérprete en lockstep. Muestra el resultado de las primeras
+ *            instancias y un resumen con los MIPS agregados y qué parte de
+ *            los carriles SIMD se aprovechó.
+ */
+static void lockstep_command(const ParsedCommand* cmd) {
+    static LockstepResult results[LOCKSTEP_MAX_INSTANCES];
+    int address = -1, first = 0, step = 1;
+    if (sscanf(cmd->argument, "%d %d %d", &address, &first, &step) < 1) address = -1;
+    if (cmd->param1 > LOCKSTEP_MAX_INSTANCES) {
+        printf("Error: como máximo %d instancias\n", LOCKSTEP_MAX_INSTANCES);
+        return;
+    }
+    
+    int start_addr = load_program_file(cmd->filename);
+    if (start_addr == -1) return;
+    
+    LockstepStats stats;
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int status = lockstep_run(start_addr, cmd->param1, address, first, step,
+                              LOCKSTEP_DEFAULT_LIMIT, results, &stats);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (status != 0) return;
+    unsigned long long elapsed = (unsigned long long)(end.tv_sec - start.tv_sec) * 1000000000ULL +
+                                 (end.tv_nsec - start.tv_nsec);
+    
+    printf("\n  INSTANCIA %10s %8s %10s %14s\n", "VALOR", "SALIDA", "AC", "INSTRUCCIONES");
+    unsigned long long instructions = 0;
+    int shown = cmd->param1 < LOCKSTEP_SHOWN ? cmd->param1 : LOCKSTEP_SHOWN;
+    for (int i = 0; i < cmd->param1; i++) {
+        const LockstepResult* r = &results[i];
+        instructions += r->retired;
+        if (i >= shown) continue;
+        char value[16] = "-", exit_code[16] = "tope";  // Sin HALT: llegó al tope
+        if (address >= 0) snprintf(value, sizeof(value), "%d", first + i * step);
+        if (r->halted) snprintf(exit_code, sizeof(exit_code), "%d", r->exit_code);
+        printf("  %9d %10s %8s %10d %14llu%s\n", i, value, exit_code, r->ac, r->retired,
+               r->scalar ? "  (intérprete)" : "");
+    }
+    if (shown < cmd->param1) printf("  ... (%d instancias más)\n", cmd->param1 - shown);
+    
+    double utilization = stats.steps > 0 ?
+        100.0 * stats.lane_instructions / (stats.steps * (double)LOCKSTEP_LANES) : 0.0;
+    printf("\n=== LOCKSTEP %s (%d instancias, carriles %s) ===\n",
+           cmd->filename, cmd->param1, lockstep_backend());
+    printf("En los carriles:       %d instancias, %llu instrucciones\n",
+           cmd->param1 - stats.scalar_instances, stats.lane_instructions);
+    printf("Intérprete normal:     %d instancias, %llu instrucciones\n",
+           stats.scalar_instances, stats.scalar_instructions);
+    printf("Uso de los carriles:   %.1f%% (%llu pasos de %d carriles)\n",
+           utilization, stats.steps, LOCKSTEP_LANES);
+    printf("Tiempo:                %.3f ms\n", elapsed / 1e6);
+    printf("MIPS agregados:        %.2f\n", elapsed > 0 ? instructions * 1000.0 / elapsed : 0.0);
+    printf("============================================\n");
+}
+
+/*
+ * Función auxiliar: read_host_words (ESTÁTICA)
+ * Parámetros: filename - archivo del host; words - salida (IMPORT_MAX_WORDS)
+ * Retorna: int - palabras leídas, o -1 si hay error
+ * Propósito: Leer un archivo en cualquiera de los formatos que acepta 'load'
+ *            (palabras en texto, fuente '.asm' o imagen de asm.exe).
+ */
+static int read_host_words(const char* filename, Word* words) {
+    size_t name_length = strlen(filename);
+    if (name_length > 4 && strcmp(filename + name_length - 4, ".asm") == 0) {
+        AsmProgram program;
+        int count = -1;
+        if (asm_assemble_file(filename, &program) == 0 && program.count <= IMPORT_MAX_WORDS) {
+            memcpy(words, program.words, (size_t)program.count * sizeof(Word));
+            count = program.count;
+        }
+        asm_free(&program);
+        return count;
+    }
+    
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        printf("Error: no se pudo abrir el archivo '%s'\n", filename);
+        return -1;
+    }
+    char line[200];
+    int count = 0;
+    int image = (fread(line, 1, 8, file) == 8 && memcmp(line, ASM_IMAGE_MAGIC, 8) == 0);
+    if (!image) rewind(file);
+    while (count < IMPORT_MAX_WORDS) {
+        if (image) {
+            if (fread(words[count].data, 1, 8, file) != 8) break;
+        } else {
+            if (fgets(line, sizeof(line), file) == NULL) break;
+            line[strcspn(line, "#;")] = '\0';
+            char* token = strtok(line, " \t\r\n");
+            if (token == NULL) continue;
+            if (strlen(token) != 8) count = -1;
+            else memcpy(words[count].data, token, 8);
+        }
+        int valid = (count >= 0);
+        for (int i = 0; valid && i < 8; i++) valid = isdigit((unsigned char)words[count].data[i]);
+        if (!valid) {
+            printf("Error: palabra inválida en '%s'\n", filename);
+            fclose(file);
+            return -1;
+        }
+        words[count++].data[8] = '\0';
+    }
+    fclose(file);
+    return count;
+}
+
+/*
+ * Función auxiliar: fs_command (ESTÁTICA)
+ * Parámetros: cmd - comando 'fs' con subcomando y argumentos
+ * Propósito: Herramientas del host para el sistema de archivos del disco:
+ *            formatear, listar, importar y exportar archivos, borrarlos y
+ *            medir o corregir la fragmentación.
+ */
+static void fs_command(const ParsedCommand* cmd) {
+    static Word words[IMPORT_MAX_WORDS];
+    const char* sub = cmd->subcommand;
+    
+    if (sub[0] == '\0' || strcmp(sub, "status") == 0) {
+        fs_status();
+    } else if (strcmp(sub, "ls") == 0) {
+        fs_list();
+    } else if (strcmp(sub, "format") == 0) {
+        fs_format();
+        printf("Sistema de archivos creado en el disco\n");
+    } else if (strcmp(sub, "frag") == 0) {
+        fs_fragmentation_report();
+    } else if (strcmp(sub, "defrag") == 0) {
+        int moved = fs_defragment();
+        if (moved < 0) {
+            printf("Error: %s\n", fs_error_text(moved));
+            return;
+        }
+        printf("Desfragmentación terminada: %d bloques movidos\n", moved);
+        fs_fragmentation_report();
+    } else if (strcmp(sub, "import") == 0 && cmd->filename[0] != '\0') {
+        // Nombre en el disco: el indicado o el del archivo sin directorios
+        const char* name = cmd->argument;
+        if (name[0] == '\0') {
+            const char* slash = strrchr(cmd->filename, '/');
+            name = slash ? slash + 1 : cmd->filename;
+        }
+        int count = read_host_words(cmd->filename, words);
+        if (count < 0) return;
+        int inode = fs_lookup(name);
+        if (inode == FS_ERR_NOT_FOUND) inode = fs_create(name);
+        else if (inode >= 0) fs_truncate(inode);
+        int written = (inode < 0) ? inode : fs_write(inode, 0, words, count);
+        if (written < 0 || written < count) {
+            printf("Error: %s: %s\n", name, fs_error_text(written < 0 ? written : FS_ERR_NO_SPACE));
+        } else {
+            printf("%s -> %s: %d palabras\n", cmd->filename, name, count);
+        }
+    } else if (strcmp(sub, "export") == 0 && cmd->argument[0] != '\0') {
+        int inode = fs_lookup(cmd->filename);
+        int count = (inode < 0) ? inode : fs_read(inode, 0, words, IMPORT_MAX_WORDS);
+        if (count < 0) {
+            printf("Error: %s: %s\n", cmd->filename, fs_error_text(count));
+            return;
+        }
+        FILE* file = fopen(cmd->argument, "w");
+        if (!file) {
+            printf("Error: no se pudo crear '%s'\n", cmd->argument);
+            return;
+        }
+        fprintf(file, "# %s (%d palabras, exportado del disco virtual)\n", cmd->filename, count);
+        for (int i = 0; i < count; i++) fprintf(file, "%s\n", words[i].data);
+        fclose(file);
+        printf("%s -> %s: %d palabras\n", cmd->filename, cmd->argument, count);
+    } else if (strcmp(sub, "rm") == 0 && cmd->filename[0] != '\0') {
+        int result = fs_remove(cmd->filename);
+        if (result < 0) printf("Error: %s: %s\n", cmd->filename, fs_error_text(result));
+    } else {
+        printf("Uso: fs [status|ls|format|frag|defrag|import <archivo> [nombre]|export <nombre> <archivo>|rm <nombre>]\n");
+    }
 }
 
 /*
@@ -252,6 +959,7 @@ void execute_command(ParsedCommand cmd) {
                     cpu_registers.PSW.PC_psw = start_addr;  // Poner PC en inicio
                     set_PC_int(start_addr);  // Configurar contador de programa
                     set_cpu_state(CPU_RUNNING);  // Poner CPU en estado de ejecución
+                    if (callgraph_enabled) callgraph_reset_stack();  // Nueva pila sombra
                     printf("Programa cargado en dirección %d. Use 'step' para ejecutar paso a paso.\n", start_addr);
                 }
             }
@@ -274,10 +982,9 @@ void execute_command(ParsedCommand cmd) {
             if (current_mode == MODE_DEBUGGER) {
                 printf("Continuando ejecución automática...\n");
                 current_mode = MODE_NORMAL;  // Cambiar a modo normal
-                // Ejecutar ciclos de CPU hasta que la CPU se detenga (HALT)
+                // Ejecutar hasta que la CPU se detenga (HALT), sin pausas
                 while (get_cpu_state() == CPU_RUNNING) {
-                    cpu_cycle();  // Ejecutar un ciclo de CPU
-                    CONSOLE_SLEEP(100);  // Pequeña pausa para visibilidad
+                    cpu_cycle_block(0);
                 }
                 printf("Ejecución completada.\n");
                 dump_registers();  // Mostrar estado final de registros
@@ -304,14 +1011,271 @@ void execute_command(ParsedCommand cmd) {
             }
             break;
             
+        case CMD_DISASM:
+            // Mismos parámetros que 'memory'; sin ellos, el inicio del programa
+            if (cmd.param1 == -1) {
+                int base = word_to_int(cpu_registers.RB);
+                show_disassembly(base, base + 20);
+            } else {
+                show_disassembly(cmd.param1, cmd.param2 == -1 ? cmd.param1 + 20 : cmd.param2);
+            }
+            break;
+            
         case CMD_DISK:
-            disk_info();  // Mostrar información del disco
+            if (cmd.subcommand[0] == '\0') {
+                disk_info();  // Mostrar información del disco
+            } else if (strcmp(cmd.subcommand, "save") == 0 && cmd.filename[0] != '\0') {
+                if (disk_save(cmd.filename) == 0) printf("Disco guardado en %s\n", cmd.filename);
+            } else if (strcmp(cmd.subcommand, "load") == 0 && cmd.filename[0] != '\0') {
+                if (disk_load(cmd.filename) == 0) {
+                    printf("Disco cargado desde %s (%s)\n", cmd.filename,
+                           fs_mount() == 0 ? "sistema de archivos montado" : "sin sistema de archivos");
+                }
+            } else {
+                printf("Uso: disk [save <imagen>|load <imagen>]\n");
+            }
+            break;
+            
+        case CMD_FS:
+            fs_command(&cmd);
+            break;
+            
+        case CMD_SHM:
+            if (cmd.subcommand[0] == '\0' || strcmp(cmd.subcommand, "status") == 0) {
+                shm_status();
+            } else if (strcmp(cmd.subcommand, "rm") == 0 && cmd.filename[0] != '\0') {
+                int result = shm_remove(atoi(cmd.filename));
+                if (result < 0) printf("Error: %s\n", shm_error_text(result));
+            } else {
+                printf("Uso: shm [status|rm <id>]\n");
+            }
+            break;
+            
+        case CMD_MSG:
+            msg_status();
+            break;
+            
+        case CMD_MMIO:
+            mmio_status();
+            break;
+            
+        case CMD_NET:
+            if (cmd.subcommand[0] == '\0' || strcmp(cmd.subcommand, "status") == 0) {
+                net_status();
+            } else if (strcmp(cmd.subcommand, "attach") == 0) {
+                int port = (cmd.filename[0] != '\0') ? atoi(cmd.filename) : -1;
+                int result = net_attach(cmd.argument[0] != '\0' ? cmd.argument : NULL, port);
+                if (result < 0) printf("Error: %s\n", net_error_text(result));
+                else printf("Conectada al puerto %d\n", result);
+            } else if (strcmp(cmd.subcommand, "detach") == 0) {
+                net_detach();
+            } else {
+                printf("Uso: net [status|attach [puerto] [segmento]|detach]\n");
+            }
+            break;
+            
+        case CMD_SIM:
+            if (cmd.subcommand[0] == '\0' || strcmp(cmd.subcommand, "status") == 0) {
+                sim_status();
+            } else if (strcmp(cmd.subcommand, "timer") == 0 && cmd.filename[0] != '\0') {
+                sim_set_timer(strtoull(cmd.filename, NULL, 10));
+            } else if (strcmp(cmd.subcommand, "throttle") == 0 && cmd.filename[0] != '\0') {
+                set_cpu_throttle(atoi(cmd.filename));
+                printf("Pausa entre ciclos de 'run': %d ms\n", get_cpu_throttle());
+            } else {
+                printf("Uso: sim [status|timer <ciclos>|throttle <ms>]\n");
+            }
             break;
             
         case CMD_LOAD:
             printf("Cargando programa: %s\n", cmd.filename);
-            load_program_file(cmd.filename);  // Solo cargar, no ejecutar
-            printf("Programa cargado. Use 'run' o 'debug' para ejecutar.\n");
+            if (load_program_file(cmd.filename) != -1) {  // Solo cargar, no ejecutar
+                printf("Programa cargado. Use 'run' o 'debug' para ejecutar.\n");
+            }
+            break;
+            
+        case CMD_PROFILE:
+            if (cmd.subcommand[0] == '\0' || strcmp(cmd.subcommand, "report") == 0) {
+                profiler_report(cmd.param1);  // -1 => cantidad por defecto
+            } else if (strcmp(cmd.subcommand, "on") == 0) {
+                profiler_set_enabled(1);
+                printf("Profiler habilitado.\n");
+            } else if (strcmp(cmd.subcommand, "off") == 0) {
+                profiler_set_enabled(0);
+                printf("Profiler deshabilitado.\n");
+            } else if (strcmp(cmd.subcommand, "reset") == 0) {
+                profiler_reset();
+                printf("Contadores del profiler reiniciados.\n");
+            } else if (strcmp(cmd.subcommand, "export") == 0) {
+                if (cmd.filename[0] == '\0') {
+                    printf("Uso: profile export <archivo>\n");
+                } else if (profiler_export_folded(cmd.filename) == 0) {
+                    printf("Perfil exportado a %s (formato folded-stack)\n", cmd.filename);
+                }
+            } else {
+                printf("Uso: profile [on|off|reset|report [N]|export <archivo>]\n");
+            }
+            break;
+            
+        case CMD_CALLGRAPH:
+            if (cmd.subcommand[0] == '\0' || strcmp(cmd.subcommand, "report") == 0) {
+                callgraph_report(cmd.param1);  // -1 => cantidad por defecto
+            } else if (strcmp(cmd.subcommand, "on") == 0) {
+                callgraph_set_enabled(1);
+                printf("Call graph habilitado.\n");
+            } else if (strcmp(cmd.subcommand, "off") == 0) {
+                callgraph_set_enabled(0);
+                printf("Call graph deshabilitado.\n");
+            } else if (strcmp(cmd.subcommand, "reset") == 0) {
+                callgraph_reset();
+                printf("Call graph reiniciado.\n");
+            } else if (strcmp(cmd.subcommand, "export") == 0) {
+                if (cmd.filename[0] == '\0') {
+                    printf("Uso: callgraph export <archivo>\n");
+                } else if (callgraph_export_folded(cmd.filename) == 0) {
+                    printf("Call graph exportado a %s (formato folded-stack)\n", cmd.filename);
+                }
+            } else {
+                printf("Uso: callgraph [on|off|reset|report [N]|export <archivo>]\n");
+            }
+            break;
+            
+        case CMD_COVERAGE:
+            if (cmd.subcommand[0] == '\0' || strcmp(cmd.subcommand, "summary") == 0) {
+                coverage_summary();
+            } else if (strcmp(cmd.subcommand, "on") == 0) {
+                coverage_set_enabled(1);
+                printf("Cobertura habilitada.\n");
+            } else if (strcmp(cmd.subcommand, "off") == 0) {
+                coverage_set_enabled(0);
+                printf("Cobertura deshabilitada.\n");
+            } else if (strcmp(cmd.subcommand, "reset") == 0) {
+                coverage_reset();
+                printf("Cobertura reiniciada.\n");
+            } else if (strcmp(cmd.subcommand, "report") == 0) {
+                // Sin archivo: listado en consola
+                if (coverage_write_report(cmd.filename[0] ? cmd.filename : NULL) == 0 &&
+                    cmd.filename[0]) {
+                    printf("Listado de cobertura escrito en %s\n", cmd.filename);
+                }
+            } else {
+                printf("Uso: coverage [on|off|reset|summary|report [archivo]]\n");
+            }
+            break;
+            
+        case CMD_PERFSTAT:
+            if (cmd.filename[0] != '\0') {
+                current_mode = MODE_NORMAL;
+                int start_addr = load_program_file(cmd.filename);
+                if (start_addr != -1) {
+                    // Medir sin pausas entre ciclos: solo interesa el costo del emulador
+                    int throttle = get_cpu_throttle();
+                    set_cpu_throttle(0);
+                    perfstat_start();
+                    execute_program(start_addr);
+                    perfstat_stop();
+                    set_cpu_throttle(throttle);
+                }
+            }
+            perfstat_report();
+            break;
+            
+        case CMD_TRACE:
+            if (cmd.subcommand[0] == '\0' || strcmp(cmd.subcommand, "status") == 0) {
+                trace_status();
+            } else if (strcmp(cmd.subcommand, "start") == 0) {
+                trace_start();
+                printf("Traza iniciada.\n");
+            } else if (strcmp(cmd.subcommand, "stop") == 0) {
+                trace_stop();
+                printf("Traza detenida.\n");
+            } else if (strcmp(cmd.subcommand, "export") == 0) {
+                if (cmd.filename[0] == '\0') {
+                    printf("Uso: trace export <archivo.json>\n");
+                } else if (trace_export(cmd.filename) == 0) {
+                    printf("Traza exportada a %s (abrir en ui.perfetto.dev o chrome://tracing)\n",
+                           cmd.filename);
+                }
+            } else {
+                printf("Uso: trace [start|stop|status|export <archivo.json>]\n");
+            }
+            break;
+            
+        case CMD_BENCH:
+            if (cmd.filename[0] == '\0') {
+                printf("Uso: bench <archivo> [iteraciones]\n");
+            } else {
+                current_mode = MODE_NORMAL;
+                bench_program(cmd.filename, cmd.param1 > 0 ? cmd.param1 : BENCH_DEFAULT_ITERATIONS);
+            }
+            break;
+            
+        case CMD_LOCKSTEP:
+            if (strcmp(cmd.subcommand, "simd") == 0) {
+                if (cmd.argument[0] != '\0' && lockstep_set_backend(cmd.argument) != 0) {
+                    printf("Error: '%s' no está disponible en este procesador\n", cmd.argument);
+                }
+                printf("Carriles: %s\n", lockstep_backend());
+            } else if (cmd.filename[0] == '\0' || cmd.param1 < 1) {
+                printf("Uso: lockstep <archivo> <instancias> [dirección [inicio [paso]]]\n");
+                printf("     lockstep simd [auto|avx512|avx2|escalar]\n");
+            } else {
+                current_mode = MODE_NORMAL;
+                lockstep_command(&cmd);
+            }
+            break;
+            
+        case CMD_STATS:
+            metrics_report();
+            break;
+            
+        case CMD_GDB:
+            if (cmd.filename[0] == '\0') {
+                printf("Uso: gdb <archivo> [puerto|socket]\n");
+                break;
+            }
+            current_mode = MODE_NORMAL;
+            {
+                int start_addr = load_program_file(cmd.filename);
+                if (start_addr != -1) {
+                    // Igual que 'debug': CPU lista en la primera instrucción
+                    cpu_registers.PSW.PC_psw = start_addr;
+                    set_PC_int(start_addr);
+                    set_cpu_state(CPU_RUNNING);
+                    if (callgraph_enabled) callgraph_reset_stack();
+                    if (gdb_serve(cmd.argument[0] ? cmd.argument : NULL) != 0) {
+                        printf("No se pudo abrir el servidor GDB (ver log).\n");
+                    }
+                }
+            }
+            break;
+            
+        case CMD_BBCACHE:
+            if (cmd.subcommand[0] == '\0' || strcmp(cmd.subcommand, "status") == 0) {
+                blockcache_status();
+            } else if (strcmp(cmd.subcommand, "on") == 0 || strcmp(cmd.subcommand, "off") == 0) {
+                // Sin el gancho de write_memory los bloques podrían quedar obsoletos
+                blockcache_flush();
+                blockcache_enabled = (strcmp(cmd.subcommand, "on") == 0);
+                printf("Caché de bloques %s.\n", blockcache_enabled ? "habilitada" : "deshabilitada");
+            } else if (strcmp(cmd.subcommand, "flush") == 0) {
+                blockcache_flush();
+                printf("Caché de bloques vaciada.\n");
+            } else {
+                printf("Uso: bbcache [on|off|flush|status]\n");
+            }
+            break;
+            
+        case CMD_JIT:
+            if (cmd.subcommand[0] == '\0' || strcmp(cmd.subcommand, "status") == 0) {
+                jit_status();
+            } else if (strcmp(cmd.subcommand, "on") == 0 || strcmp(cmd.subcommand, "off") == 0) {
+                jit_reset();
+                jit_enabled = (strcmp(cmd.subcommand, "on") == 0);
+                printf("Compilador JIT %s.\n", jit_enabled ? "habilitado" : "deshabilitado");
+            } else {
+                printf("Uso: jit [on|off|status]\n");
+            }
             break;
             
         case CMD_HELP:
@@ -352,6 +1316,8 @@ void show_detailed_registers() {
     printf("MDR: %s\n", cpu_registers.MDR.data);
     printf("RB:  %s (int: %d) - Registro Base\n", cpu_registers.RB.data, word_to_int(cpu_registers.RB));
     printf("RL:  %s (int: %d) - Registro Límite\n", cpu_registers.RL.data, word_to_int(cpu_registers.RL));
+    printf("RBS: %s (int: %d) - Base del segmento compartido\n", cpu_registers.RBS.data, word_to_int(cpu_registers.RBS));
+    printf("RLS: %s (int: %d) - Límite del segmento compartido\n", cpu_registers.RLS.data, word_to_int(cpu_registers.RLS));
     printf("SP:  %s (int: %d) - Stack Pointer\n", cpu_registers.SP.data, word_to_int(cpu_registers.SP));
     printf("RX:  %s - Base de pila\n", cpu_registers.RX.data);
     
@@ -408,6 +1374,110 @@ void run_console() {
     }
 }
 
+/*
+ * Función auxiliar: print_batch_summary (ESTÁTICA)
+ * Parámetros:
+ *   status     - código de salida del proceso
+ *   reason     - "halt", "limit" o "error"
+ *   elapsed_ns - tiempo de pared del trabajo
+ * Propósito: Imprimir el resumen final en una sola línea JSON para que el
+ *            planificador de trabajos lo procese sin interpretar el resto
+ *            de la salida.
+ */
+static void print_batch_summary(int status, const char* reason, unsigned long long elapsed_ns) {
+    printf("{\"status\": %d, \"reason\": \"%s\", \"retired\": %llu, \"elapsed_ms\": %.3f, "
+           "\"registers\": {\"AC\": %d, \"MAR\": %d, \"MDR\": %d, \"IR\": %d, "
+           "\"RB\": %d, \"RL\": %d, \"RX\": %d, \"SP\": %d, \"PC\": %d, "
+           "\"CC\": %d, \"mode\": %d, \"interrupts\": %d}}\n",
+           status, reason, cpu_instructions_retired, elapsed_ns / 1e6,
+           word_to_int(cpu_registers.AC), word_to_int(cpu_registers.MAR),
+           word_to_int(cpu_registers.MDR), word_to_int(cpu_registers.IR),
+           word_to_int(cpu_registers.RB), word_to_int(cpu_registers.RL),
+           word_to_int(cpu_registers.RX), word_to_int(cpu_registers.SP),
+           cpu_registers.PSW.PC_psw, cpu_registers.PSW.condition_code,
+           cpu_registers.PSW.operation_mode, cpu_registers.PSW.interrupt_enabled);
+    fflush(stdout);
+}
+
+/*
+ * Función: run_batch
+ * Parámetros:
+ *   script  - archivo de comandos (uno por línea, '#' inicia un comentario)
+ *   program - programa a ejecutar directamente si no hay script
+ * Retorna: int - código de salida:
+ *   - operando del último HALT (módulo 256) si todo terminó normalmente,
+ *   - BATCH_EXIT_LIMIT si se alcanzó el límite de instrucciones,
+ *   - BATCH_EXIT_ERROR si un archivo o comando es inválido (se aborta el script).
+ * Propósito: Ejecutar trabajos sin intervención: sin prompt, sin pausas
+ *            entre ciclos, y con un resumen final legible por máquina.
+ */
+int run_batch(const char* script, const char* program) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    set_cpu_throttle(0);  // Sin pausas: el rendimiento importa más que la visualización
+    
+    int error = 0;
+    if (script != NULL) {
+        FILE* file = fopen(script, "r");
+        if (!file) {
+            printf("Error: no se pudo abrir el script '%s'\n", script);
+            error = 1;
+        } else {
+            char input[200];
+            int line_number = 0;
+            while (!error && fgets(input, sizeof(input), file) != NULL) {
+                line_number++;
+                input[strcspn(input, "#\r\n")] = '\0';  // Comentarios y fin de línea
+                if (strspn(input, " \t") == strlen(input)) continue;  // Línea vacía
+                
+                ParsedCommand cmd = parse_command(input);
+                if (cmd.cmd == CMD_UNKNOWN) {
+                    printf("Error: %s:%d: comando desconocido '%s'\n", script, line_number, input);
+                    error = 1;
+                    break;
+                }
+                if (cmd.cmd == CMD_EXIT) break;
+                
+                // Un comando que carga un programa falla si no queda cargado
+                int loads = cmd.filename[0] != '\0' &&
+                            (cmd.cmd == CMD_RUN || cmd.cmd == CMD_DEBUG ||
+                             cmd.cmd == CMD_LOAD || cmd.cmd == CMD_PERFSTAT);
+                if (loads) program_loaded = 0;
+                execute_command(cmd);
+                if (loads && !program_loaded) error = 1;
+                if (cpu_instruction_limit_reached()) break;
+            }
+            fclose(file);
+        }
+    } else {
+        int start_addr = load_program_file(program);
+        if (start_addr == -1) {
+            error = 1;
+        } else {
+            execute_program(start_addr);
+        }
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    unsigned long long elapsed = (unsigned long long)(end.tv_sec - start.tv_sec) * 1000000000ULL +
+                                 (end.tv_nsec - start.tv_nsec);
+    
+    int status;
+    const char* reason;
+    if (error) {
+        status = BATCH_EXIT_ERROR;
+        reason = "error";
+    } else if (cpu_instruction_limit_reached()) {
+        status = BATCH_EXIT_LIMIT;
+        reason = "limit";
+    } else {
+        status = get_cpu_exit_status() & 0xFF;
+        reason = "halt";
+    }
+    print_batch_summary(status, reason, elapsed);
+    return status;
+}
+
 /*
  * Función: get_current_mode
  * Retorna: ExecutionMode - modo de ejecución actual
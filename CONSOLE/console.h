@@ -42,6 +42,24 @@ typedef enum {
  *   CMD_EXIT     - Salir del sistema
  *   CMD_UNKNOWN  - Comando no reconocido (valor por defecto)
  *   CMD_LOAD     - Cargar un programa sin ejecutarlo
+ *   CMD_PROFILE  - Controlar el profiler de instrucciones (on/off/reset/report/export)
+ *   CMD_CALLGRAPH- Controlar el profiler de llamadas CALL/RET (on/off/reset/report/export)
+ *   CMD_COVERAGE - Controlar la cobertura de código (on/off/reset/summary/report)
+ *   CMD_PERFSTAT - Ejecutar un programa midiendo contadores de hardware del host
+ *   CMD_TRACE    - Controlar la traza de eventos (start/stop/status/export)
+ *   CMD_BENCH    - Ejecutar un programa repetidamente y reportar tiempos y MIPS
+ *   CMD_STATS    - Mostrar estadísticas de la sesión
+ *   CMD_GDB      - Cargar un programa y depurarlo desde GDB (protocolo remoto)
+ *   CMD_BBCACHE  - Controlar la caché de bloques básicos (on/off/flush/status)
+ *   CMD_JIT      - Controlar el compilador JIT de bloques calientes (on/off/status)
+ *   CMD_DISASM   - Desensamblar un rango de memoria con anotaciones del profiler
+ *   CMD_FS       - Sistema de archivos del disco (format/ls/import/export/rm/status)
+ *   CMD_SHM      - Segmentos de memoria compartida (status/rm)
+ *   CMD_MSG      - Ocupación de los buzones de mensajes
+ *   CMD_MMIO     - Dispositivos de la ventana de E/S mapeada en memoria
+ *   CMD_NET      - Placa de red entre VMs (status/attach/detach)
+ *   CMD_LOCKSTEP - Ejecutar muchas instancias de un programa en carriles SIMD
+ *   CMD_SIM      - Reloj virtual y cola de eventos (status/timer/throttle)
  */
 typedef enum {
     CMD_RUN,
@@ -54,7 +72,25 @@ typedef enum {
     CMD_HELP,
     CMD_EXIT,
     CMD_UNKNOWN,
-    CMD_LOAD
+    CMD_LOAD,
+    CMD_PROFILE,
+    CMD_CALLGRAPH,
+    CMD_COVERAGE,
+    CMD_PERFSTAT,
+    CMD_TRACE,
+    CMD_BENCH,
+    CMD_STATS,
+    CMD_GDB,
+    CMD_BBCACHE,
+    CMD_JIT,
+    CMD_DISASM,
+    CMD_FS,
+    CMD_SHM,
+    CMD_MSG,
+    CMD_MMIO,
+    CMD_NET,
+    CMD_LOCKSTEP,
+    CMD_SIM
 } ConsoleCommand;
 
 /*
@@ -62,17 +98,21 @@ typedef enum {
  * Propósito: Almacena un comando parseado con todos sus parámetros
  * Campos:
  *   cmd      - Tipo de comando (ConsoleCommand)
+ *   subcommand - Subcomando (ej: "on", "report" en 'profile report')
  *   filename - Nombre del archivo a cargar/ejecutar (si aplica)
  *   mode     - Modo de ejecución en el que se ejecutará el comando
  *   param1   - Primer parámetro numérico (ej: dirección de memoria inicial)
  *   param2   - Segundo parámetro numérico (ej: dirección de memoria final)
+ *   argument - Segundo argumento de texto (ej: puerto o socket de 'gdb')
  */
 typedef struct {
     ConsoleCommand cmd;       // Tipo de comando
+    char subcommand[20];      // Subcomando (para comandos con subcomandos)
     char filename[100];       // Nombre de archivo (para comandos que lo requieran)
     ExecutionMode mode;       // Modo de ejecución asociado
     int param1;               // Parámetro numérico 1
     int param2;               // Parámetro numérico 2
+    char argument[100];       // Argumento de texto adicional
 } ParsedCommand;
 
 /*
@@ -91,6 +131,25 @@ void init_console();
  */
 void run_console();
 
+/*
+ * CÓDIGOS DE SALIDA DEL MODO POR LOTES (además del código del HALT del invitado)
+ * BATCH_EXIT_ERROR - Archivo inexistente, programa inválido o comando desconocido
+ * BATCH_EXIT_LIMIT - Se alcanzó --max-instructions (mismo código que timeout(1))
+ */
+#define BATCH_EXIT_ERROR 2
+#define BATCH_EXIT_LIMIT 124
+
+/* 
+ * Función: run_batch
+ * Parámetros:
+ *   script  - archivo de comandos de consola (NULL para ejecutar 'program')
+ *   program - programa a ejecutar directamente (NULL si se usa 'script')
+ * Retorna: int - código de salida para el proceso
+ * Propósito: Modo no interactivo: sin prompt ni pausas entre ciclos; al final
+ *            imprime un resumen en una línea JSON
+ */
+int run_batch(const char* script, const char* program);
+
 /* 
  * Función: parse_command
  * Parámetros: input - cadena de texto con el comando del usuario
@@ -106,6 +165,14 @@ ParsedCommand parse_command(const char* input);
  */
 void execute_command(ParsedCommand cmd);
 
+/* 
+ * Función: load_program_file
+ * Parámetros: filename - archivo de texto con una palabra de 8 dígitos por línea
+ * Retorna: int - dirección lógica de inicio del programa, o -1 si hay error
+ * Propósito: Carga un programa en la región de usuario y configura RB, RL y SP
+ */
+int load_program_file(const char* filename);
+
 /* 
  * Función: show_help
  * Propósito: Muestra la ayuda de comandos disponibles
@@ -0,0 +1,674 @@
+/*
+ * Archivo de implementación de la caché de bloques básicos del Sistema Operativo Virtual.
+ * Contiene la traducción de bloques a micro-operaciones, la fusión de pares
+ * en superinstrucciones, el ejecutor del camino rápido y la invalidación de
+ * bloques cuando se escribe sobre sus palabras.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "blockcache.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "cpu.h"                    // Para execute_instruction y decode_instruction
+#include "../MEMORY/memory.h"       // Para el arreglo memory[]
+#include "../REGISTERS/registers.h" // Para cpu_registers y update_condition_code
+#include "../METRICS/metrics.h"     // Para aciertos/fallos y accesos a memoria
+#include "../ISA/isa.h"             // Para descartar opcodes no implementados
+#include "jit.h"                    // Para compilar los bloques calientes
+#include "../SIM/sim.h"             // Para cortar el bloque ante un evento nuevo
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf
+#include <string.h>   // Para memset
+
+/*
+ * CONSTANTES INTERNAS
+ * WORD_MAX      - Mayor magnitud representable en una palabra (7 dígitos)
+ * BLOCK_LAST_PC - Última dirección lógica que se traduce (PC_psw tiene 10 bits:
+ *                 la instrucción en 1023 haría desbordar el PC y va por el camino lento)
+ */
+#define WORD_MAX 9999999
+#define BLOCK_LAST_PC 1022
+
+/*
+ * Estructura: Block
+ * Propósito: Bloque traducido. Se guarda por dirección física de inicio y se
+ *            reutiliza solo si el PC lógico, RB, RL y el modo coinciden.
+ */
+typedef struct {
+    int valid;
+    int logical, rb, rl, user;   // Contexto de la traducción
+    int length;                  // Instrucciones del invitado
+    int nops;                    // Micro-operaciones
+    int hits;                    // Ejecuciones desde la traducción (-1 = no compilable)
+    JitCode native;              // Código nativo, válido si generation == jit_generation
+    unsigned int generation;
+    MicroOp ops[BLOCK_MAX_INSTRUCTIONS];
+} Block;
+
+/*
+ * VARIABLE GLOBAL - Bandera consultada por la CPU y el módulo de memoria
+ */
+int blockcache_enabled = 1;
+volatile int blockcache_dirty_pending = 0;
+int blockcache_in_flight = 0;
+
+/*
+ * VARIABLES GLOBALES ESTÁTICAS
+ * code_refs - bloques válidos que cubren cada palabra física (solo la CPU lo modifica)
+ * dirty     - palabras de código escritas desde la última ejecución; el hilo
+ *             del DMA también puede marcarlas, por eso la invalidación real
+ *             se hace en la CPU al comienzo del siguiente bloque
+ */
+static Block blocks[MEMORY_SIZE];
+static unsigned short code_refs[MEMORY_SIZE];
+static volatile unsigned char dirty[MEMORY_SIZE];
+
+static unsigned long translations = 0;    // Bloques traducidos
+static unsigned long invalidations = 0;   // Bloques descartados por escrituras
+static unsigned long fused = 0;           // Superinstrucciones generadas
+
+/*
+ * Estado del bloque en ejecución: contexto de traducción de direcciones, el
+ * AC como entero y la bandera para cortar el bloque tras la micro-operación.
+ */
+static int cur_rb, cur_rl, cur_user;
+static int cur_rbs, cur_rls;   // Segmento secundario (RBS/RLS)
+static int ac;
+static int ac_dirty;
+static int stop;
+static int block_pc;             // PC lógico de la primera instrucción del bloque
+
+/*
+ * Función auxiliar: parse_word (ESTÁTICA)
+ * Retorna: int - 0 si la palabra es un número canónico (signo 0/1 y 7 dígitos,
+ *          sin "-0"), -1 en otro caso (la instrucción va por el camino lento)
+ */
+static int parse_word(const Word* w, int* out) {
+    const char* d = w->data;
+    if (d[8] != '\0' || (d[0] != '0' && d[0] != '1')) return -1;
+    int v = 0;
+    for (int i = 1; i < 8; i++) {
+        if (d[i] < '0' || d[i] > '9') return -1;
+        v = v * 10 + (d[i] - '0');
+    }
+    if (d[0] == '1') {
+        if (v == 0) return -1;
+        v = -v;
+    }
+    *out = v;
+    return 0;
+}
+
+/*
+ * Función auxiliar: format_word (ESTÁTICA)
+ * Propósito: Equivalente de int_to_word para |value| <= WORD_MAX, sin snprintf.
+ */
+static Word format_word(int value) {
+    Word w;
+    unsigned int magnitude = (value < 0) ? (unsigned int)-value : (unsigned int)value;
+    w.data[0] = (value < 0) ? '1' : '0';
+    for (int i = 7; i >= 1; i--) {
+        w.data[i] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    }
+    w.data[8] = '\0';
+    return w;
+}
+
+/*
+ * Función auxiliar: data_address (ESTÁTICA)
+ * Retorna: int - dirección física, o -1 si read_memory/write_memory rechazaría
+ *          el acceso (fuera de RB/RL, fuera de memoria o área del SO en modo usuario)
+ * La ventana del segmento secundario solo se mira cuando la dirección ya
+ * quedó fuera de la región, así que no cuesta nada en los accesos normales.
+ */
+static int segment_address(int logical) {
+    int offset = logical - SEGMENT_WINDOW;
+    return (offset >= 0 && offset < cur_rls) ? cur_rbs + offset : -1;
+}
+
+static int data_address(int logical) {
+    int physical;
+    if (cur_rb == 0 && cur_rl == 0) {
+        physical = logical;
+    } else {
+        if (logical < 0 || logical >= cur_rl) return segment_address(logical);
+        physical = logical + cur_rb;
+    }
+    if (physical < 0 || physical >= MEMORY_SIZE) return segment_address(logical);
+    if (cur_user && physical < OS_RESERVED) return -1;
+    return physical;
+}
+
+/*
+ * Función auxiliar: invalidate (ESTÁTICA)
+ */
+static void invalidate(int start) {
+    Block* b = &blocks[start];
+    if (!b->valid) return;
+    b->valid = 0;
+    for (int i = 0; i < b->length; i++) code_refs[start + i]--;
+}
+
+/*
+ * Función auxiliar: process_dirty (ESTÁTICA)
+ * Propósito: Invalidar los bloques que cubren alguna palabra escrita.
+ */
+static void process_dirty() {
+    blockcache_dirty_pending = 0;
+    for (int p = 0; p < MEMORY_SIZE; p++) {
+        if (!dirty[p]) continue;
+        dirty[p] = 0;
+        for (int s = (p >= BLOCK_MAX_INSTRUCTIONS) ? p - BLOCK_MAX_INSTRUCTIONS + 1 : 0; s <= p; s++) {
+            if (blocks[s].valid && s + blocks[s].length > p) {
+                invalidate(s);
+                invalidations++;
+            }
+        }
+    }
+}
+
+/*
+ * Función auxiliar: classify (ESTÁTICA)
+ * Retorna: int - MicroOpKind de una instrucción, o -1 si el opcode no está
+ *          implementado (el bloque termina antes y el camino lento dispara
+ *          la interrupción de instrucción inválida)
+ */
+static int classify(int opcode, int mode) {
+    if (!isa_is_implemented(opcode)) return -1;
+    int simple_mode = (mode <= ADDR_INDEXED);
+    switch (opcode) {
+        case 0: case 1: case 2: case 3:
+            return simple_mode ? UOP_ARITH : UOP_GENERIC;
+        case 4:
+            return simple_mode ? UOP_LOAD : UOP_GENERIC;
+        case 5:
+            return simple_mode ? UOP_STORE : UOP_GENERIC;
+        case 6: case 7: case 8:
+            return simple_mode ? UOP_COMPARE : UOP_GENERIC;
+        case 9: case 10: case 11: case 12:
+            return simple_mode ? UOP_BRANCH : UOP_EXIT;
+        case 27:
+            return simple_mode ? UOP_JUMP : UOP_EXIT;
+        case 25: case 26:
+            return UOP_GENERIC;
+        case 41:
+            return UOP_NOP;
+        default:
+            return UOP_EXIT;  // SVC, CALL, RET, LDR..STRL, DMA, E/S, HALT, EI/DI, cambios de modo
+    }
+}
+
+/*
+ * Función auxiliar: fuse (ESTÁTICA)
+ * Propósito: Combinar pares adyacentes LOAD+aritmética, aritmética+STR y
+ *            CMP+salto condicional (de izquierda a derecha, sin solaparse).
+ */
+static void fuse(Block* b) {
+    int out = 0;
+    for (int i = 0; i < b->nops; i++) {
+        MicroOp op = b->ops[i];
+        if (i + 1 < b->nops) {
+            const MicroOp* next = &b->ops[i + 1];
+            int kind = -1;
+            if (op.kind == UOP_LOAD && next->kind == UOP_ARITH) kind = UOP_LOAD_ARITH;
+            else if (op.kind == UOP_ARITH && next->kind == UOP_STORE) kind = UOP_ARITH_STORE;
+            else if (op.kind == UOP_COMPARE && op.part[0].opcode == 6 && next->kind == UOP_BRANCH) kind = UOP_COMPARE_BRANCH;
+            if (kind >= 0) {
+                op.kind = (unsigned char)kind;
+                op.count = 2;
+                op.part[1] = next->part[0];
+                i++;
+                fused++;
+            }
+        }
+        b->ops[out++] = op;
+    }
+    b->nops = out;
+}
+
+/*
+ * Función auxiliar: translate_block (ESTÁTICA)
+ * Propósito: Decodificar desde 'pc' hasta el primer fin de bloque.
+ * Retorna: int - instrucciones traducidas (0 si la primera no es traducible)
+ */
+static int translate_block(Block* b, int start, int pc) {
+    b->nops = 0;
+    b->length = 0;
+    while (b->length < BLOCK_MAX_INSTRUCTIONS && pc + b->length <= BLOCK_LAST_PC) {
+        int physical = data_address(pc + b->length);
+        if (physical != start + b->length) break;  // Fin de la región del proceso
+
+        const char* d = memory[physical].data;
+        int digits = (d[8] == '\0');
+        for (int i = 0; i < 8 && digits; i++) digits = (d[i] >= '0' && d[i] <= '9');
+        if (!digits) break;
+
+        int opcode = (d[0] - '0') * 10 + (d[1] - '0');
+        int mode = d[2] - '0';
+        int kind = classify(opcode, mode);
+        if (kind < 0) break;
+
+        MicroOp* op = &b->ops[b->nops++];
+        op->kind = (unsigned char)kind;
+        op->count = 1;
+        op->pc = (short)(pc + b->length);
+        op->part[0].opcode = (unsigned char)opcode;
+        op->part[0].mode = (unsigned char)mode;
+        op->part[0].value = (d[3] - '0') * 10000 + (d[4] - '0') * 1000 + (d[5] - '0') * 100 +
+                            (d[6] - '0') * 10 + (d[7] - '0');
+        op->part[0].word = memory[physical];
+        b->length++;
+
+        if (kind >= UOP_BRANCH) break;  // Salto o instrucción de sistema: fin de bloque
+    }
+    if (b->length == 0) return 0;
+
+    fuse(b);
+    b->valid = 1;
+    b->hits = 0;
+    b->native = NULL;
+    b->logical = pc;
+    b->rb = cur_rb;
+    b->rl = cur_rl;
+    b->user = cur_user;
+    for (int i = 0; i < b->length; i++) code_refs[start + i]++;
+    translations++;
+    return b->length;
+}
+
+/*
+ * Función auxiliar: run_generic (ESTÁTICA)
+ * Propósito: Camino lento de una instrucción dentro del bloque: sincroniza
+ *            AC, PC, MAR, MDR e IR como lo habría hecho el FETCH y llama a
+ *            execute_instruction(). Corta el bloque si el AC queda sin un
+ *            valor numérico, si la instrucción escribió sobre código traducido
+ *            o si agendó un evento (el presupuesto del bloque ya no vale).
+ */
+static void run_generic(const MicroPart* p, int pc) {
+    if (ac_dirty) {
+        cpu_registers.AC = format_word(ac);
+        ac_dirty = 0;
+    }
+    cpu_registers.PSW.PC_psw = pc + 1;
+    cpu_registers.PC = format_word(pc + 1);
+    cpu_registers.MAR = format_word(pc);
+    cpu_registers.MDR = p->word;
+    cpu_registers.IR = p->word;
+    unsigned long long deadline = sim_next_deadline;
+    blockcache_in_flight = pc - block_pc;
+    execute_instruction(decode_instruction(p->word));
+    blockcache_in_flight = 0;
+    if (parse_word(&cpu_registers.AC, &ac) != 0) stop = 1;
+    if (blockcache_dirty_pending) stop = 1;
+    if (sim_next_deadline < deadline) stop = 1;
+}
+
+/*
+ * Funciones auxiliares del camino rápido (ESTÁTICAS)
+ * Retornan 0 si la instrucción se ejecutó, -1 si hay que usar run_generic()
+ * (en ese caso no modificaron ningún estado).
+ */
+static int fast_operand(const MicroPart* p, int* out) {
+    if (p->mode == ADDR_IMMEDIATE) {
+        *out = p->value;
+        return 0;
+    }
+    int physical = data_address(p->mode == ADDR_INDEXED ? ac + p->value : p->value);
+    if (physical < 0 || parse_word(&memory[physical], out) != 0) return -1;
+    METRIC_INC(memory_reads);
+    return 0;
+}
+
+static int fast_load(const MicroPart* p) {
+    int value;
+    if (fast_operand(p, &value) != 0) return -1;
+    ac = value;
+    ac_dirty = 1;
+    return 0;
+}
+
+static int fast_arith(const MicroPart* p) {
+    int operand;
+    long long result;
+    int physical = -1;
+    if (p->mode != ADDR_IMMEDIATE) {
+        physical = data_address(p->mode == ADDR_INDEXED ? ac + p->value : p->value);
+        if (physical < 0 || parse_word(&memory[physical], &operand) != 0) return -1;
+    } else {
+        operand = p->value;
+    }
+    switch (p->opcode) {
+        case 0: result = (long long)ac + operand; break;
+        case 1: result = (long long)ac - operand; break;
+        case 2: result = (long long)ac * operand; break;
+        default: result = (operand != 0) ? ac / operand : 0; break;
+    }
+    // Fuera de rango: el camino lento reproduce el OVERFLOW y la interrupción
+    if (result < -WORD_MAX || result > WORD_MAX) return -1;
+    if (physical >= 0) METRIC_INC(memory_reads);
+    ac = (int)result;
+    ac_dirty = 1;
+    update_condition_code(ac);
+    return 0;
+}
+
+static int fast_store(const MicroPart* p) {
+    int result = blockcache_store(p->mode == ADDR_INDEXED ? ac + p->value : p->value, ac);
+    if (result < 0) return -1;
+    if (result > 0) stop = 1;  // Código automodificable: cortar el bloque
+    return 0;
+}
+
+static int fast_compare(const MicroPart* p) {
+    int operand;
+    if (fast_operand(p, &operand) != 0) return -1;
+    if (p->opcode == 6) {
+        update_condition_code(ac - operand);          // CMP
+    } else if (p->opcode == 7) {
+        update_condition_code(ac & operand);          // TST
+    } else {
+        ac = operand;                                 // MOV
+        ac_dirty = 1;
+    }
+    return 0;
+}
+
+/*
+ * Función auxiliar: branch_target (ESTÁTICA)
+ * Retorna: int - destino del salto, o -1 si está fuera de 0..1023 (el camino
+ *          lento lo recorta como set_PC_int)
+ */
+static int branch_target(const MicroPart* p) {
+    int target = (p->mode == ADDR_INDEXED) ? ac + p->value : p->value;
+    return (target >= 0 && target <= 1023) ? target : -1;
+}
+
+static int branch_taken(int opcode) {
+    int condition = cpu_registers.PSW.condition_code;
+    return (opcode == 9 && condition == 0) || (opcode == 10 && condition == 2) ||
+           (opcode == 11 && condition == 1) || (opcode == 12 && condition == 3);
+}
+
+/*
+ * Función auxiliar: block_word (ESTÁTICA)
+ * Retorna: const Word* - palabra original de la instrucción 'pc' del bloque
+ */
+static const Word* block_word(const Block* b, int pc) {
+    for (int i = 0; i < b->nops; i++) {
+        const MicroOp* op = &b->ops[i];
+        if (pc >= op->pc && pc < op->pc + op->count) return &op->part[pc - op->pc].word;
+    }
+    return &b->ops[b->nops - 1].part[b->ops[b->nops - 1].count - 1].word;
+}
+
+/*
+ * Función auxiliar: run_native (ESTÁTICA)
+ * Retorna: int - instrucciones ejecutadas por el código nativo del bloque; 0
+ *          si salió antes de la primera (cpu_cycle() la ejecuta)
+ * Propósito: Entrar al código compilado y volcar su estado en los registros
+ *            como al final de un bloque interpretado.
+ */
+static int run_native(const Block* b, unsigned long long budget) {
+    JitFrame frame;
+    frame.ac = ac;
+    frame.cc = cpu_registers.PSW.condition_code;
+    frame.retired = 0;
+    frame.limit = (budget == 0 || budget > JIT_SLICE) ? JIT_SLICE : budget;
+    b->native(&frame);
+    jit_count_entry();
+    if (frame.retired == 0) return 0;
+
+    cpu_registers.AC = format_word(frame.ac);
+    cpu_registers.PSW.condition_code = frame.cc;
+    cpu_registers.PSW.PC_psw = frame.pc;
+    cpu_registers.PC = format_word(frame.pc);
+    cpu_registers.MAR = format_word(frame.last);
+    cpu_registers.MDR = *block_word(b, frame.last);
+    cpu_registers.IR = cpu_registers.MDR;
+    METRIC_ADD(memory_reads, frame.retired);  // Lecturas del FETCH de cada instrucción
+    return (int)frame.retired;
+}
+
+/*
+ * Función: blockcache_execute
+ * Propósito: Ver blockcache.h.
+ */
+int blockcache_execute(unsigned long long budget) {
+    if (blockcache_dirty_pending) process_dirty();
+
+    int pc = cpu_registers.PSW.PC_psw;
+    if (pc > BLOCK_LAST_PC) return 0;
+    if (parse_word(&cpu_registers.RB, &cur_rb) != 0 || parse_word(&cpu_registers.RL, &cur_rl) != 0 ||
+        parse_word(&cpu_registers.RBS, &cur_rbs) != 0 || parse_word(&cpu_registers.RLS, &cur_rls) != 0 ||
+        parse_word(&cpu_registers.AC, &ac) != 0) {
+        return 0;
+    }
+    cur_user = (cpu_registers.PSW.operation_mode == USER_MODE);
+    int start = data_address(pc);
+    if (start < 0) return 0;
+
+    Block* b = &blocks[start];
+    if (b->valid && b->logical == pc && b->rb == cur_rb && b->rl == cur_rl && b->user == cur_user) {
+        METRIC_INC(cache_hits[METRICS_CACHE_DECODE]);
+    } else {
+        METRIC_INC(cache_misses[METRICS_CACHE_DECODE]);
+        invalidate(start);
+        if (translate_block(b, start, pc) == 0) return 0;
+    }
+    if (budget > 0 && (unsigned long long)b->length > budget) return 0;
+
+    // Segundo nivel: código nativo para los bloques calientes
+    if (jit_enabled) {
+        if (b->native && b->generation == jit_generation) return run_native(b, budget);
+        if (b->hits >= 0 && ++b->hits >= JIT_THRESHOLD) {
+            b->native = jit_compile(b->ops, b->nops, b->logical, b->length);
+            b->generation = jit_generation;
+            if (b->native) return run_native(b, budget);
+            b->hits = -1;
+        }
+    }
+
+    ac_dirty = 0;
+    stop = 0;
+    block_pc = pc;
+    int retired = 0;       // Instrucciones ejecutadas
+    int next_pc = pc;      // PC tras la última micro-operación
+    int exited = 0;        // 1 si el camino lento ya fijó el PC (fin de bloque)
+    const MicroPart* last = NULL;
+    int last_pc = pc;
+
+    for (int i = 0; i < b->nops && !stop; i++) {
+        const MicroOp* op = &b->ops[i];
+        const MicroPart* p0 = &op->part[0];
+        const MicroPart* p1 = &op->part[1];
+        int at = op->pc;
+        int done = op->count;
+        int target;
+        next_pc = at + op->count;
+
+        switch (op->kind) {
+            case UOP_LOAD:
+                if (fast_load(p0) != 0) run_generic(p0, at);
+                break;
+            case UOP_STORE:
+                if (fast_store(p0) != 0) run_generic(p0, at);
+                break;
+            case UOP_ARITH:
+                if (fast_arith(p0) != 0) run_generic(p0, at);
+                break;
+            case UOP_COMPARE:
+                if (fast_compare(p0) != 0) run_generic(p0, at);
+                break;
+            case UOP_NOP:
+                break;
+            case UOP_GENERIC:
+                run_generic(p0, at);
+                break;
+            case UOP_LOAD_ARITH:
+                if (fast_load(p0) != 0) run_generic(p0, at);
+                if (stop) { done = 1; next_pc = at + 1; break; }
+                if (fast_arith(p1) != 0) run_generic(p1, at + 1);
+                break;
+            case UOP_ARITH_STORE:
+                if (fast_arith(p0) != 0) run_generic(p0, at);
+                if (stop) { done = 1; next_pc = at + 1; break; }
+                if (fast_store(p1) != 0) run_generic(p1, at + 1);
+                break;
+            case UOP_COMPARE_BRANCH:
+                if (fast_compare(p0) != 0) run_generic(p0, at);
+                if (stop) { done = 1; next_pc = at + 1; break; }
+                target = branch_target(p1);
+                if (target < 0) {
+                    run_generic(p1, at + 1);
+                    exited = 1;
+                } else if (branch_taken(p1->opcode)) {
+                    next_pc = target;
+                }
+                break;
+            case UOP_BRANCH:
+                target = branch_target(p0);
+                if (target < 0) {
+                    run_generic(p0, at);
+                    exited = 1;
+                } else if (branch_taken(p0->opcode)) {
+                    next_pc = target;
+                }
+                break;
+            case UOP_JUMP:
+                target = branch_target(p0);
+                if (target < 0) {
+                    run_generic(p0, at);
+                    exited = 1;
+                } else {
+                    next_pc = target;
+                }
+                break;
+            default:  // UOP_EXIT
+                run_generic(p0, at);
+                exited = 1;
+                break;
+        }
+        retired += done;
+        last = &op->part[done - 1];
+        last_pc = at + done - 1;
+    }
+
+    if (ac_dirty) cpu_registers.AC = format_word(ac);
+    if (!exited) {
+        cpu_registers.PSW.PC_psw = next_pc;
+        cpu_registers.PC = format_word(next_pc);
+        cpu_registers.MAR = format_word(last_pc);
+        cpu_registers.MDR = last->word;
+        cpu_registers.IR = last->word;
+    }
+    METRIC_ADD(memory_reads, retired);  // Lecturas del FETCH de cada instrucción
+    return retired;
+}
+
+/*
+ * Función: blockcache_flush
+ * Propósito: Descartar todos los bloques (tras cargar un programa o escribir
+ *            la memoria sin pasar por write_memory).
+ */
+void blockcache_flush() {
+    jit_reset();
+    for (int s = 0; s < MEMORY_SIZE; s++) blocks[s].valid = 0;
+    memset(code_refs, 0, sizeof(code_refs));
+    for (int p = 0; p < MEMORY_SIZE; p++) dirty[p] = 0;
+    blockcache_dirty_pending = 0;
+}
+
+/*
+ * Función: blockcache_on_write
+ * Parámetros: physical - palabra física escrita por write_memory (CPU o DMA)
+ */
+void blockcache_on_write(int physical) {
+    if (code_refs[physical]) {
+        dirty[physical] = 1;
+        blockcache_dirty_pending = 1;
+    }
+}
+
+/*
+ * Función: blockcache_lookup
+ * Propósito: Buscar el bloque que cubre la palabra: empieza como mucho
+ *            BLOCK_MAX_INSTRUCTIONS palabras antes.
+ */
+int blockcache_lookup(int physical, MicroPart* part, int* native) {
+    if (physical < 0 || physical >= MEMORY_SIZE || code_refs[physical] == 0 || dirty[physical]) return 0;
+    for (int start = physical; start >= 0 && start > physical - BLOCK_MAX_INSTRUCTIONS; start--) {
+        const Block* b = &blocks[start];
+        if (!b->valid || start + b->length <= physical) continue;
+        int logical = b->logical + (physical - start);
+        for (int i = 0; i < b->nops; i++) {
+            const MicroOp* op = &b->ops[i];
+            if (logical >= op->pc && logical < op->pc + op->count) {
+                *part = op->part[logical - op->pc];
+                *native = (b->native != NULL && b->generation == jit_generation);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Función: blockcache_status
+ * Propósito: Mostrar el estado de la caché de bloques.
+ */
+void blockcache_status() {
+    int valid = 0, instructions = 0, ops = 0;
+    for (int s = 0; s < MEMORY_SIZE; s++) {
+        if (!blocks[s].valid) continue;
+        valid++;
+        instructions += blocks[s].length;
+        ops += blocks[s].nops;
+    }
+    unsigned long long hits = metrics.cache_hits[METRICS_CACHE_DECODE];
+    unsigned long long misses = metrics.cache_misses[METRICS_CACHE_DECODE];
+
+    printf("\n=== CACHÉ DE BLOQUES (%s) ===\n", blockcache_enabled ? "habilitada" : "deshabilitada");
+    printf("Bloques válidos:      %d (%d instrucciones en %d micro-operaciones)\n", valid, instructions, ops);
+    printf("Traducciones:         %lu (%lu superinstrucciones)\n", translations, fused);
+    printf("Invalidaciones:       %lu\n", invalidations);
+    if (hits + misses > 0) {
+        printf("Aciertos:             %llu de %llu (%.1f%%)\n", hits, hits + misses, 100.0 * hits / (hits + misses));
+    }
+    printf("Solo se usa sin pausas entre ciclos y sin profiler, callgraph, coverage, trace ni perfstat.\n");
+    printf("===============================\n");
+}
+
+/*
+ * Función: blockcache_load
+ * Parámetros: logical - dirección lógica a leer
+ * Retorna: int - valor de la palabra, o BLOCK_FAULT (ver blockcache.h)
+ */
+int blockcache_load(int logical) {
+    int physical = data_address(logical);
+    int value;
+    if (physical < 0 || parse_word(&memory[physical], &value) != 0) return BLOCK_FAULT;
+    return value;
+}
+
+/*
+ * Función: blockcache_store
+ * Parámetros:
+ *   logical - dirección lógica a escribir
+ *   value   - valor (|value| <= 9999999)
+ * Retorna: int - 0, 1 si se escribió sobre código traducido, -1 si el acceso
+ *          sería rechazado
+ */
+int blockcache_store(int logical, int value) {
+    int physical = data_address(logical);
+    if (physical < 0) return -1;
+    memory[physical] = format_word(value);
+    METRIC_INC(memory_writes);
+    if (code_refs[physical]) {  // Los bloques que la cubren se invalidan al comenzar el siguiente
+        dirty[physical] = 1;
+        blockcache_dirty_pending = 1;
+        return 1;
+    }
+    return 0;
+}
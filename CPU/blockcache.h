@@ -0,0 +1,153 @@
+/*
+ * Archivo de cabecera de la caché de bloques básicos del Sistema Operativo Virtual.
+ * Traduce secuencias lineales de instrucciones (hasta un salto, CALL/RET, SVC,
+ * DMA, E/S, HALT o un cambio de registros de sistema) a micro-operaciones
+ * pre-decodificadas que se guardan por dirección física de inicio. Los pares
+ * frecuentes LOAD+aritmética, aritmética+STR y CMP+salto condicional se
+ * fusionan en superinstrucciones.
+ *
+ * El camino rápido mantiene el AC como entero durante el bloque, accede a la
+ * memoria con las mismas reglas de RB/RL y protección del SO que el módulo de
+ * memoria y no escribe las líneas DEBUG por instrucción en system.log. Ante
+ * cualquier caso poco común (operando que no es una palabra de 8 dígitos,
+ * violación de memoria, resultado fuera de rango) la instrucción se ejecuta
+ * con execute_instruction(), así que el resultado visible es el mismo.
+ */
+
+#ifndef BLOCKCACHE_H
+#define BLOCKCACHE_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../types.h"  // Para el tipo Word
+
+/*
+ * CONSTANTES DE CONFIGURACIÓN DE LA CACHÉ
+ * BLOCK_MAX_INSTRUCTIONS - Instrucciones del invitado por bloque como máximo
+ */
+#define BLOCK_MAX_INSTRUCTIONS 32
+
+/*
+ * BLOCK_FAULT - Valor de blockcache_load() cuando el acceso no puede hacerse
+ *               por el camino rápido (nunca es el valor de una palabra)
+ */
+#define BLOCK_FAULT (-2147483647 - 1)
+
+/*
+ * FORMATO DE LAS MICRO-OPERACIONES
+ * Compartido con el compilador JIT (jit.c), que traduce los bloques calientes
+ * a código nativo a partir de esta misma representación.
+ */
+
+/*
+ * Enum: MicroOpKind
+ * Propósito: Tipos de micro-operación. Los tres últimos grupos terminan el bloque.
+ */
+typedef enum {
+    UOP_LOAD,            // LOAD
+    UOP_STORE,           // STR
+    UOP_ARITH,           // SUM, RES, MULT, DIVI
+    UOP_COMPARE,         // CMP, TST, MOV
+    UOP_NOP,             // NOP
+    UOP_GENERIC,         // Cualquier otra instrucción que no cambia el flujo (PUSH, POP, modos raros)
+    UOP_LOAD_ARITH,      // Superinstrucción LOAD + aritmética
+    UOP_ARITH_STORE,     // Superinstrucción aritmética + STR
+    UOP_COMPARE_BRANCH,  // Superinstrucción CMP + JEQ/JGT/JLT/JOV (fin de bloque)
+    UOP_BRANCH,          // JEQ, JGT, JLT, JOV (fin de bloque)
+    UOP_JUMP,            // J (fin de bloque)
+    UOP_EXIT             // CALL, RET, SVC, DMA, E/S, HALT, registros de sistema (fin de bloque)
+} MicroOpKind;
+
+/*
+ * Estructura: MicroPart
+ * Propósito: Una instrucción del invitado ya decodificada.
+ */
+typedef struct {
+    unsigned char opcode;
+    unsigned char mode;
+    int value;
+    Word word;             // Palabra original (para IR y para el camino lento)
+} MicroPart;
+
+/*
+ * Estructura: MicroOp
+ * Propósito: Micro-operación; las superinstrucciones usan las dos partes.
+ */
+typedef struct {
+    unsigned char kind;    // MicroOpKind
+    unsigned char count;   // Instrucciones del invitado que representa (1 o 2)
+    short pc;              // Dirección lógica de la primera instrucción
+    MicroPart part[2];
+} MicroOp;
+
+/*
+ * DECLARACIÓN DE VARIABLE GLOBAL EXTERNA
+ * blockcache_enabled - cpu_cycle_block() solo usa la caché si está activa
+ *                      (por defecto sí; 'bbcache off' vuelve a la
+ *                      ejecución instrucción por instrucción)
+ */
+extern int blockcache_enabled;
+
+/*
+ * blockcache_dirty_pending - 1 si alguna palabra de código traducido fue
+ *                            escrita (por la CPU o el DMA) y aún no se
+ *                            invalidaron sus bloques; el código nativo la
+ *                            consulta antes de repetir un bucle
+ */
+extern volatile int blockcache_dirty_pending;
+
+/*
+ * blockcache_in_flight - instrucciones del bloque en curso ya ejecutadas y
+ *                        todavía no sumadas a cpu_instructions_retired
+ *                        (distinto de 0 solo mientras una instrucción del
+ *                        bloque pasa por execute_instruction, p. ej. un
+ *                        acceso a la ventana MMIO)
+ */
+extern int blockcache_in_flight;
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública de la caché de bloques
+ */
+
+/*
+ * Función: blockcache_execute
+ * Parámetros: budget - instrucciones que aún pueden retirarse (0 = sin tope)
+ * Retorna: int - instrucciones del invitado ejecutadas; 0 si en el PC actual
+ *          no hay un bloque ejecutable (el llamador usa cpu_cycle())
+ * Propósito: Ejecutar el bloque que comienza en el PC, traduciéndolo si no
+ *            está en la caché. No atiende interrupciones: lo hace el llamador
+ *            al final del bloque.
+ */
+int blockcache_execute(unsigned long long budget);
+
+void blockcache_flush();                   // Descartar todos los bloques (código cargado de nuevo)
+void blockcache_on_write(int physical);    // Gancho de write_memory: invalida bloques que cubren la palabra
+void blockcache_status();                  // Mostrar estado, bloques, aciertos y superinstrucciones
+
+/*
+ * Función: blockcache_lookup
+ * Parámetros:
+ *   physical - dirección física de una palabra
+ *   part     - salida: la instrucción tal como la decodificó la traducción
+ *   native   - salida: 1 si el bloque que la contiene tiene código del JIT
+ * Retorna: int - 1 si la palabra pertenece a un bloque traducido vigente,
+ *          0 si no (o si fue escrita después de traducirse)
+ * Propósito: Reutilizar las decodificaciones de la caché (desensamblador).
+ */
+int blockcache_lookup(int physical, MicroPart* part, int* native);
+
+/*
+ * Accesos a memoria del camino rápido, llamados también desde el código nativo
+ * del JIT. Usan el contexto (RB, RL, modo) del bloque en ejecución.
+ *   blockcache_load  - valor de la palabra lógica, o BLOCK_FAULT si no es una
+ *                      palabra canónica o el acceso sería rechazado (no modifica nada)
+ *   blockcache_store - escribe 'value'; retorna 0, 1 si la palabra era código
+ *                      traducido (hay que cortar el bloque) o -1 si el acceso
+ *                      sería rechazado (no modifica nada)
+ */
+int blockcache_load(int logical);
+int blockcache_store(int logical, int value);
+
+#endif /* BLOCKCACHE_H */
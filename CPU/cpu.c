@@ -13,6 +13,17 @@
 #include "../INTERRUPTS/interrupts.h" // Para manejo de interrupciones
 #include "../DMA/dma.h"           // Para operaciones de DMA
 #include "../LOGGER/logger.h"     // Para registro de eventos del sistema
+#include "../PROFILER/profiler.h" // Para el profiler opcional de instrucciones
+#include "../PROFILER/callgraph.h" // Para el profiler opcional de llamadas (CALL/RET)
+#include "../PROFILER/coverage.h" // Para la cobertura opcional de código
+#include "../PROFILER/perfstat.h" // Para el desglose por fases con contadores del host
+#include "../METRICS/metrics.h"   // Para las métricas en vivo (cambios de contexto)
+#include "../PROFILER/trace.h"    // Para la pista de la CPU en la traza
+#include "../ISA/isa.h"           // Para los nombres de las instrucciones en la traza
+#include "../DEBUGGER/gdbstub.h"  // Para no saltear los watchpoints con la caché de bloques
+#include "../TERMINAL/terminal.h" // Para el dispositivo de IN/OUT/IO_STATUS
+#include "../SIM/sim.h"           // Para atender los eventos del reloj virtual
+#include "blockcache.h"           // Para la ejecución por bloques traducidos
 
 /* Inclusión de bibliotecas estándar */
 #include <stdio.h>    // Entrada/salida estándar
@@ -39,6 +50,33 @@
  */
 CPU_State cpu_state = CPU_HALTED;  // Inicialmente la CPU está detenida
 
+/*
+ * PAUSA ENTRE CICLOS (THROTTLE)
+ * Milisegundos de pausa tras cada ciclo en execute_program(), solo para
+ * seguir la ejecución a ojo ('sim throttle'). No afecta a la simulación: los
+ * dispositivos miden el tiempo con el reloj virtual (SIM/sim.h).
+ * 0 = ejecución sin pausas (por defecto).
+ */
+static int cpu_throttle_ms = 0;
+
+/*
+ * CONTADOR DE INSTRUCCIONES RETIRADAS
+ * Instrucciones ejecutadas desde el inicio del sistema (base de las
+ * mediciones de MIPS del invitado).
+ */
+unsigned long long cpu_instructions_retired = 0;
+
+/*
+ * LÍMITE DE INSTRUCCIONES Y CÓDIGO DE SALIDA (modo por lotes)
+ * cpu_instruction_limit - execute_program() se detiene cuando
+ *                         cpu_instructions_retired lo alcanza (0 = sin límite)
+ * cpu_limit_reached     - 1 si la última ejecución terminó por el límite
+ * cpu_exit_status       - Operando efectivo del último HALT ("HALT n" sale con n)
+ */
+static unsigned long long cpu_instruction_limit = 0;
+static int cpu_limit_reached = 0;
+static int cpu_exit_status = 0;
+
 /*
  * Función: init_cpu
  * Propósito: Inicializar la CPU, estableciéndola en estado de ejecución
@@ -73,6 +111,7 @@ void reset_cpu() {
  */
 Instruction fetch_instruction() {
     Instruction instr;  // Estructura para almacenar instrucción decodificada
+    int perf_prev = PERF_ENTER(PERF_PHASE_FETCH);  // Fase FETCH (perfstat)
     
     // FASE FETCH: Obtener instrucción de memoria
     // 1. Copiar PC a MAR (Memory Address Register)
@@ -85,6 +124,9 @@ Instruction fetch_instruction() {
     // 3. Copiar instrucción a IR (Instruction Register)
     cpu_registers.IR = cpu_registers.MDR;
     
+    // Marcar la dirección como ejecutada en el mapa de cobertura
+    if (coverage_enabled) COVERAGE_MARK(mar_value);
+    
     // 4. Incrementar PC para siguiente instrucción
     cpu_registers.PSW.PC_psw++;
     set_PC_int(cpu_registers.PSW.PC_psw);  // Actualizar también PC como Word
@@ -94,7 +136,9 @@ Instruction fetch_instruction() {
               mar_value, cpu_registers.IR.data);
     
     // Decodificar la instrucción y retornarla
+    PERF_ENTER(PERF_PHASE_DECODE);
     instr = decode_instruction(cpu_registers.IR);
+    PERF_LEAVE(perf_prev);
     return instr;
 }
 
@@ -183,15 +227,61 @@ void cpu_cycle() {
     // Verificar que la CPU esté en estado RUNNING
     if (cpu_state != CPU_RUNNING) return;
     
+    // Guardar PC de la instrucción (antes del incremento de FETCH) para el profiler
+    int pc = cpu_registers.PSW.PC_psw;
+    if (perfstat_active) perfstat_begin_instruction();
+    int traced = trace_enabled;
+    unsigned long long trace_ts = traced ? trace_now() : 0;
+    
     // CICLO DE INSTRUCCIÓN:
     // 1. FETCH: Obtener siguiente instrucción
     Instruction instr = fetch_instruction();
     
-    // 2. EXECUTE: Ejecutar la instrucción
+    // 2. EXECUTE: Ejecutar la instrucción (perfilada solo si está habilitado)
+    if (profiler_enabled) profiler_begin_instruction(pc, instr.opcode);
+    if (callgraph_enabled) callgraph_on_instruction(pc);
+    int perf_prev = PERF_ENTER(PERF_PHASE_EXECUTE);
     execute_instruction(instr);
+    PERF_LEAVE(perf_prev);
+    if (profiler_enabled) profiler_end_instruction();
+    if (traced) trace_complete(TRACE_TRACK_CPU, isa_mnemonic(instr.opcode), trace_ts, pc, 0, 0);
+    cpu_instructions_retired++;
+    if (SIM_NOW() >= sim_next_deadline) sim_run_due();  // Eventos de este ciclo (fin de DMA, reloj)
     
     // 3. CHECK INTERRUPTS: Verificar interrupciones pendientes
+    perf_prev = PERF_ENTER(PERF_PHASE_INTERRUPTS);
     handle_pending_interrupts();
+    PERF_LEAVE(perf_prev);
+}
+
+/*
+ * Función: cpu_cycle_block
+ * Parámetros: budget - instrucciones que aún pueden retirarse (0 = sin tope)
+ * Propósito: Ejecutar un bloque básico traducido y atender las interrupciones
+ * al final del bloque. Si la caché está deshabilitada, hay instrumentación por
+ * instrucción activa o en el PC no hay un bloque ejecutable, equivale a cpu_cycle().
+ * El bloque no pasa del próximo evento del reloj virtual: el evento se atiende
+ * siempre en la misma instrucción, con o sin caché de bloques y JIT.
+ */
+void cpu_cycle_block(unsigned long long budget) {
+    if (cpu_state != CPU_RUNNING) return;
+    
+    if (blockcache_enabled && !profiler_enabled && !callgraph_enabled && !coverage_enabled &&
+        !trace_enabled && !perfstat_active && !gdb_watch_enabled) {
+        if (sim_next_deadline != SIM_NEVER) {
+            // Vencimiento siempre en el futuro: cpu_cycle() atiende los eventos al llegar
+            unsigned long long remaining = sim_next_deadline - SIM_NOW();
+            if (budget == 0 || remaining < budget) budget = remaining;
+        }
+        int executed = blockcache_execute(budget);
+        if (executed > 0) {
+            cpu_instructions_retired += executed;
+            if (SIM_NOW() >= sim_next_deadline) sim_run_due();
+            handle_pending_interrupts();
+            return;
+        }
+    }
+    cpu_cycle();
 }
 
 /*
@@ -207,16 +297,112 @@ void cpu_cycle_step() {
     }
     
     // Obtener y mostrar información de la instrucción
+    int pc = cpu_registers.PSW.PC_psw;
     Instruction instr = fetch_instruction();
     printf("-> Ejecutando: %s (opcode: %02d)\n", cpu_registers.IR.data, instr.opcode);
     
     // Ejecutar instrucción
+    int traced = trace_enabled;
+    unsigned long long trace_ts = traced ? trace_now() : 0;
+    if (profiler_enabled) profiler_begin_instruction(pc, instr.opcode);
+    if (callgraph_enabled) callgraph_on_instruction(pc);
     execute_instruction(instr);
+    if (profiler_enabled) profiler_end_instruction();
+    if (traced) trace_complete(TRACE_TRACK_CPU, isa_mnemonic(instr.opcode), trace_ts, pc, 0, 0);
+    cpu_instructions_retired++;
+    if (SIM_NOW() >= sim_next_deadline) sim_run_due();  // Eventos de este ciclo, como en cpu_cycle()
     
     // Verificar interrupciones
     handle_pending_interrupts();
 }
 
+/*
+ * Función auxiliar: execute_block_operation (ESTÁTICA)
+ * Parámetros: instr - MOVB (37), FILL (38) o CMPB (39) ya decodificada
+ * Propósito: Ejecutar una instrucción de bloque. La dirección efectiva apunta
+ * a un descriptor de tres palabras:
+ *   MOVB: [origen, destino, cantidad]  - copia como memmove
+ *   FILL: [valor, destino, cantidad]   - escribe 'valor' en cada palabra
+ *   CMPB: [primero, segundo, cantidad] - compara hasta la primera diferencia
+ * Cada ejecución procesa como mucho BLOCK_OP_CHUNK palabras con una sola
+ * validación del rango, actualiza el descriptor (cantidad pendiente y, salvo
+ * en una copia hacia atrás, las direcciones avanzadas) y, si queda trabajo,
+ * retrocede el PC para repetirse después de atender las interrupciones.
+ * CMPB deja en el código de condición el resultado (0 iguales, 1 menor,
+ * 2 mayor) y en el AC las palabras pendientes desde la primera diferencia;
+ * el descriptor queda apuntando a ella.
+ */
+static void execute_block_operation(Instruction instr) {
+    if (instr.mode == ADDR_IMMEDIATE) {
+        log_event(LOG_ERROR, "Instrucción de bloque %d requiere un descriptor en memoria", instr.opcode);
+        trigger_interrupt(INT_INVALID_INSTRUCTION);
+        return;
+    }
+    int descriptor = instr.effective_address;
+    Word first_word = read_memory(descriptor);
+    Word second_word = read_memory(descriptor + 1);
+    Word count_word = read_memory(descriptor + 2);
+    if (first_word.data[0] > '9' || second_word.data[0] > '9' || count_word.data[0] > '9') {
+        return;  // Descriptor fuera de la región (read_memory ya disparó la interrupción)
+    }
+    int first = word_to_int(first_word);
+    int second = word_to_int(second_word);
+    int count = word_to_int(count_word);
+    if (count <= 0) {
+        if (instr.opcode == 39) {
+            update_condition_code(0);
+            cpu_registers.AC = int_to_word(0);
+        }
+        return;
+    }
+
+    int chunk = (count > BLOCK_OP_CHUNK) ? BLOCK_OP_CHUNK : count;
+    int status;
+    if (instr.opcode == 37) {
+        // Destino dentro del origen: copiar desde el final para no pisar lo que falta leer
+        int backward = (second > first && second < first + count);
+        int offset = backward ? count - chunk : 0;
+        status = copy_memory(second + offset, first + offset, chunk);
+        if (status == 0 && !backward) {
+            first += chunk;
+            second += chunk;
+        }
+    } else if (instr.opcode == 38) {
+        status = fill_memory(second, first_word, chunk);
+        if (status == 0) second += chunk;
+    } else {
+        int index;
+        status = compare_memory(first, second, chunk, &index);
+        if (status == 0) {
+            first += index;
+            second += index;
+            if (index < chunk) {
+                // Diferencia encontrada: el descriptor queda apuntando a ella
+                update_condition_code(word_to_int(read_memory(first)) - word_to_int(read_memory(second)));
+                cpu_registers.AC = int_to_word(count - index);
+                write_memory(descriptor, int_to_word(first));
+                write_memory(descriptor + 1, int_to_word(second));
+                write_memory(descriptor + 2, int_to_word(count - index));
+                return;
+            }
+        }
+    }
+    if (status != 0) return;  // Rango inválido: interrupción ya disparada, nada modificado
+
+    count -= chunk;
+    if (instr.opcode != 38) write_memory(descriptor, int_to_word(first));
+    write_memory(descriptor + 1, int_to_word(second));
+    write_memory(descriptor + 2, int_to_word(count));
+
+    if (count > 0) {
+        // Quedan palabras: repetir la instrucción tras atender las interrupciones
+        set_PC_int(cpu_registers.PSW.PC_psw - 1);
+    } else if (instr.opcode == 39) {
+        update_condition_code(0);
+        cpu_registers.AC = int_to_word(0);
+    }
+}
+
 /*
  * Función: execute_instruction
  * Parámetros: instr - instrucción decodificada a ejecutar
@@ -346,6 +532,14 @@ void execute_instruction(Instruction instr) {
                     case 12: should_jump = (condition == 3); break;  // Saltar si OVERFLOW
                 }
                 
+                // Registrar salto tomado/no tomado en el profiler
+                if (profiler_enabled) profiler_record_branch(instr.opcode, should_jump);
+                
+                // Registrar el sentido del salto para la cobertura (PC ya apunta a la siguiente)
+                if (coverage_enabled) {
+                    coverage_record_branch(cpu_registers.PSW.PC_psw - 1, should_jump);
+                }
+                
                 // Si condición se cumple, realizar salto
                 if (should_jump) {
                     cpu_registers.PSW.PC_psw = instr.effective_address;  // Cambiar PC
@@ -375,6 +569,11 @@ void execute_instruction(Instruction instr) {
                 // Saltar a la dirección de la subrutina
                 cpu_registers.PSW.PC_psw = instr.effective_address;
                 set_PC_int(instr.effective_address);
+                
+                // Registrar la llamada en la pila sombra del call graph
+                if (callgraph_enabled) {
+                    callgraph_on_call(instr.effective_address, word_to_int(return_addr));
+                }
             }
             break;
             
@@ -392,6 +591,9 @@ void execute_instruction(Instruction instr) {
                 // Establecer PC a dirección de retorno
                 cpu_registers.PSW.PC_psw = return_value;
                 set_PC_int(return_value);
+                
+                // Sacar el marco de la pila sombra (detecta retornos no estándar)
+                if (callgraph_enabled) callgraph_on_return(return_value);
             }
             break;
             
@@ -469,18 +671,34 @@ void execute_instruction(Instruction instr) {
             dma_set_transfer_size(instr.value);
             break;
             
-        // ========== CATEGORÍA: I/O (opcodes 34-39) ==========
-        case 34: // in (entrada desde dispositivo)
+        // ========== CATEGORÍA: I/O (opcodes 34-36) ==========
+        // El dispositivo es el terminal (TERMINAL/terminal.h); las interrupciones
+        // de E/S llegan por búfer entregado, no por instrucción.
+        case 34: // in (entrada desde dispositivo, sin esperar)
+            cpu_registers.AC = int_to_word(terminal_in());
+            break;
+            
         case 35: // out (salida a dispositivo)
-        case 36: // io_status (estado E/S)
-            // Actualmente solo loguea la operación
-            log_event(LOG_INFO, "Operación I/O %d solicitada", instr.opcode);
-            trigger_interrupt(INT_IO_COMPLETION);  // Disparar interrupción de E/S
+            terminal_out(instr.mode == ADDR_IMMEDIATE ? instr.value :
+                         word_to_int(read_memory(instr.effective_address)));
+            break;
+            
+        case 36: // io_status (comando del operando; AC = entrada disponible)
+            cpu_registers.AC = int_to_word(terminal_control(instr.value));
+            break;
+            
+        // ========== CATEGORÍA: BLOQUES DE MEMORIA (opcodes 37-39) ==========
+        case 37: // movb (copiar bloque)
+        case 38: // fill (llenar bloque)
+        case 39: // cmpb (comparar bloques)
+            execute_block_operation(instr);
             break;
             
         // ========== CATEGORÍA: SISTEMA (opcodes 40-45) ==========
         case 40: // halt (detener CPU)
             cpu_state = CPU_HALTED;  // Cambiar estado a HALTED
+            cpu_exit_status = instr.effective_address;  // Código de salida del invitado
+            terminal_flush();  // La salida del programa antes que el mensaje
             log_event(LOG_INFO, "CPU detenida por instrucción HALT");
             printf("CPU HALTED\n");  // Mensaje a consola
             break;
@@ -499,10 +717,12 @@ void execute_instruction(Instruction instr) {
             
         case 44: // switch_user (cambiar a modo usuario)
             cpu_registers.PSW.operation_mode = USER_MODE;
+            METRIC_INC(context_switches);
             break;
             
         case 45: // switch_kernel (cambiar a modo kernel)
             cpu_registers.PSW.operation_mode = KERNEL_MODE;
+            METRIC_INC(context_switches);
             break;
             
         // ========== INSTRUCCIÓN NO IMPLEMENTADA ==========
@@ -531,6 +751,49 @@ CPU_State get_cpu_state() {
     return cpu_state;
 }
 
+/*
+ * Función: set_cpu_throttle
+ * Parámetros: ms - milisegundos de pausa entre ciclos (0 = sin pausa)
+ * Propósito: Controlar la velocidad de execute_program().
+ */
+void set_cpu_throttle(int ms) {
+    cpu_throttle_ms = (ms < 0) ? 0 : ms;
+}
+
+/*
+ * Función: get_cpu_throttle
+ * Retorna: int - milisegundos de pausa entre ciclos
+ */
+int get_cpu_throttle() {
+    return cpu_throttle_ms;
+}
+
+/*
+ * Función: set_cpu_instruction_limit
+ * Parámetros: limit - total de instrucciones retiradas a partir del cual
+ *             execute_program() se detiene (0 = sin límite)
+ */
+void set_cpu_instruction_limit(unsigned long long limit) {
+    cpu_instruction_limit = limit;
+}
+
+/*
+ * Función: cpu_instruction_limit_reached
+ * Retorna: int - 1 si la última ejecución se detuvo por el límite de instrucciones
+ */
+int cpu_instruction_limit_reached() {
+    return cpu_limit_reached;
+}
+
+/*
+ * Función: get_cpu_exit_status
+ * Retorna: int - operando efectivo del último HALT (0 para "HALT" sin operando;
+ *          "HALT 0(AC)" devuelve el acumulador)
+ */
+int get_cpu_exit_status() {
+    return cpu_exit_status;
+}
+
 /*
  * Función: execute_program
  * Parámetros: start_address - dirección de memoria donde comienza el programa
@@ -544,15 +807,33 @@ void execute_program(int start_address) {
     
     // Establecer CPU en estado RUNNING
     cpu_state = CPU_RUNNING;
+    cpu_exit_status = 0;
+    cpu_limit_reached = 0;
+    
+    // Nuevo programa: la pila sombra del call graph comienza vacía
+    if (callgraph_enabled) callgraph_reset_stack();
     
     printf("Iniciando ejecución en dirección %d...\n", start_address);
     
     // Bucle principal de ejecución
     while (cpu_state == CPU_RUNNING) {
-        cpu_cycle();  // Ejecutar un ciclo de CPU
-        CPU_SLEEP(10);  // Pequeña pausa para controlar velocidad
+        if (cpu_instruction_limit > 0 && cpu_instructions_retired >= cpu_instruction_limit) {
+            cpu_limit_reached = 1;
+            cpu_state = CPU_HALTED;
+            log_event(LOG_WARNING, "Límite de %llu instrucciones alcanzado", cpu_instruction_limit);
+            break;
+        }
+        if (cpu_throttle_ms > 0) {
+            cpu_cycle();  // Ejecutar un ciclo de CPU
+            CPU_SLEEP(cpu_throttle_ms);  // Pequeña pausa para controlar velocidad
+        } else {
+            // Sin pausas: bloques traducidos, sin pasarse del límite de instrucciones
+            cpu_cycle_block(cpu_instruction_limit > 0 ?
+                            cpu_instruction_limit - cpu_instructions_retired : 0);
+        }
     }
     
+    terminal_flush();  // Salida pendiente si se cortó por el límite de instrucciones
     printf("Ejecución finalizada.\n");
 }
 
@@ -32,6 +32,14 @@ typedef enum {
     ADDR_INDEXED = 2    // Ejemplo: LOAD 100(AC) (carga contenido de AC+100)
 } AddressingMode;
 
+/*
+ * CONSTANTES DE LAS INSTRUCCIONES DE BLOQUE (MOVB, FILL, CMPB)
+ * BLOCK_OP_CHUNK - Palabras procesadas por ejecución. Si quedan más, la
+ *                  instrucción actualiza su descriptor y se vuelve a ejecutar,
+ *                  así las interrupciones se atienden entre trozos.
+ */
+#define BLOCK_OP_CHUNK 64
+
 /*
  * Estructura: Instruction
  * Propósito: Representa una instrucción decodificada con todos sus componentes
@@ -76,6 +84,7 @@ typedef enum {
 void init_cpu();                           // Inicializar la CPU
 void cpu_cycle();                          // Ejecutar un ciclo completo de CPU
 void cpu_cycle_step();                     // Ejecutar un ciclo con información de depuración
+void cpu_cycle_block(unsigned long long budget); // Ejecutar un bloque básico traducido (0 = sin tope)
 void execute_instruction(Instruction instr); // Ejecutar una instrucción específica
 
 /* FUNCIONES DEL CICLO FETCH-DECODE-EXECUTE */
@@ -98,8 +107,14 @@ void set_cpu_state(CPU_State state);       // Establecer estado de la CPU
 CPU_State get_cpu_state();                 // Obtener estado actual de la CPU
 void reset_cpu();                          // Reiniciar CPU a estado inicial
 void execute_program(int start_address);   // Ejecutar programa desde dirección específica
+void set_cpu_throttle(int ms);             // Pausa entre ciclos en ms (0 = sin pausa)
+int get_cpu_throttle();                    // Obtener la pausa entre ciclos
+void set_cpu_instruction_limit(unsigned long long limit); // Tope de instrucciones retiradas (0 = sin tope)
+int cpu_instruction_limit_reached();       // 1 si la última ejecución se detuvo por el tope
+int get_cpu_exit_status();                 // Código de salida del último HALT
 
-/* VARIABLE GLOBAL EXTERNA */
+/* VARIABLES GLOBALES EXTERNAS */
 extern CPU_State cpu_state;  // Declaración externa del estado global de la CPU
+extern unsigned long long cpu_instructions_retired;  // Instrucciones ejecutadas desde el inicio
 
 #endif /* CPU_H */
\ No newline at end of file
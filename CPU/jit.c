@@ -0,0 +1,522 @@
+/*
+ * Archivo de implementación del compilador JIT del Sistema Operativo Virtual.
+ * Contiene el búfer de código ejecutable, un emisor mínimo de instrucciones
+ * x86-64 y la traducción de micro-operaciones a código nativo.
+ *
+ * Convención del código generado (System V, void fn(JitFrame* frame)):
+ *   rbx = frame, r12d = AC, r13d = código de condición,
+ *   r14 = instrucciones ejecutadas, r15 = tope para repetir el bucle.
+ * Son registros preservados por las llamadas, así que sobreviven a las
+ * llamadas a blockcache_load()/blockcache_store().
+ */
+
+/* Macro necesaria para MAP_ANONYMOUS con -std=c99 */
+#define _DEFAULT_SOURCE
+
+/* Inclusión de cabecera propia del módulo */
+#include "jit.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "cpu.h"                        // Para ADDR_IMMEDIATE / ADDR_INDEXED
+#include "../METRICS/metrics.h"         // Para contar las lecturas de datos
+#include "../INTERRUPTS/interrupts.h"   // Para interrupts_pending
+#include "../LOGGER/logger.h"           // Para registrar la reserva del búfer
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>      // Para printf
+#include <stddef.h>     // Para offsetof
+#include <stdint.h>     // Para uintptr_t
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <sys/mman.h>   // Para mmap, mprotect
+#include <unistd.h>     // Para sysconf (tamaño de página)
+#define JIT_NATIVE 1
+#else
+#define JIT_NATIVE 0
+#endif
+
+/*
+ * CONSTANTES INTERNAS
+ * WORD_MAX      - Mayor magnitud representable en una palabra (7 dígitos)
+ * MAX_EXITS     - Salidas al intérprete por bloque (tres por instrucción como máximo)
+ * MAX_BLOCK_CODE - Bytes que puede ocupar un bloque compilado (cota holgada)
+ */
+#define WORD_MAX 9999999
+#define MAX_EXITS (3 * BLOCK_MAX_INSTRUCTIONS + 8)
+#define MAX_BLOCK_CODE (BLOCK_MAX_INSTRUCTIONS * 160 + MAX_EXITS * 32 + 128)
+
+/*
+ * VARIABLES GLOBALES
+ */
+int jit_enabled = JIT_NATIVE;
+unsigned int jit_generation = 1;
+
+/*
+ * VARIABLES GLOBALES ESTÁTICAS
+ */
+static unsigned char* code_buffer = NULL;  // Búfer de código (se reserva al primer uso; W^X por páginas)
+static size_t code_used = 0;               // Bytes ocupados en la generación actual
+static unsigned long compiled = 0;         // Bloques compilados (todas las generaciones)
+static unsigned long rejected = 0;         // Bloques que no se pueden compilar
+static unsigned long resets = 0;           // Veces que se descartó el búfer
+static unsigned long long entries = 0;     // Entradas al código nativo
+
+#if JIT_NATIVE
+
+/*
+ * Estructura: Exit
+ * Propósito: Salida al intérprete pendiente de emitir. El salto condicional
+ *            (rel32 en 'patch') lleva a un trozo que suma 'add' instrucciones
+ *            a r14, guarda 'pc' y 'last' en el frame y va al epílogo.
+ */
+typedef struct {
+    size_t patch;
+    int pc;
+    int last;
+    int add;
+} Exit;
+
+/*
+ * Estado del bloque en compilación
+ */
+static unsigned char* out;     // Comienzo del código del bloque
+static size_t pos;             // Bytes emitidos
+static Exit exits[MAX_EXITS];
+static int exit_count;
+
+/*
+ * Funciones auxiliares del emisor (ESTÁTICAS)
+ */
+static void emit8(int byte) { out[pos++] = (unsigned char)byte; }
+
+static void emit32(int value) {
+    unsigned int v = (unsigned int)value;
+    for (int i = 0; i < 4; i++) emit8((int)((v >> (8 * i)) & 0xFF));
+}
+
+static void emit64(uintptr_t value) {
+    for (int i = 0; i < 8; i++) emit8((int)((value >> (8 * i)) & 0xFF));
+}
+
+static void emit_bytes(const char* bytes, int count) {
+    for (int i = 0; i < count; i++) emit8((unsigned char)bytes[i]);
+}
+
+static void patch32(size_t at, size_t target) {
+    int rel = (int)((long)target - (long)(at + 4));
+    for (int i = 0; i < 4; i++) out[at + i] = (unsigned char)(((unsigned int)rel >> (8 * i)) & 0xFF);
+}
+
+/* mov rax, imm64 */
+static void emit_mov_rax(const volatile void* address) {
+    emit_bytes("\x48\xB8", 2);
+    emit64((uintptr_t)address);
+}
+
+/* Salto condicional (0F cc) o incondicional (cc = 0) a una salida al intérprete */
+static void emit_exit_jump(int cc, int pc, int last, int add) {
+    if (cc) {
+        emit8(0x0F);
+        emit8(cc);
+    } else {
+        emit8(0xE9);
+    }
+    exits[exit_count].patch = pos;
+    exits[exit_count].pc = pc;
+    exits[exit_count].last = last;
+    exits[exit_count].add = add;
+    exit_count++;
+    emit32(0);
+}
+
+#define JCC_JE 0x84
+#define JCC_JNE 0x85
+#define JCC_JS 0x88
+#define JCC_JL 0x8C
+#define JCC_JG 0x8F
+#define JCC_JA 0x87
+
+/*
+ * Función auxiliar: emit_address (ESTÁTICA)
+ * Propósito: edi = dirección lógica del operando (directo o indexado por el AC).
+ */
+static void emit_address(const MicroPart* p) {
+    if (p->mode == ADDR_INDEXED) {
+        emit_bytes("\x41\x8D\xBC\x24", 4);   // lea edi, [r12 + value]
+    } else {
+        emit8(0xBF);                         // mov edi, value
+    }
+    emit32(p->value);
+}
+
+/*
+ * Función auxiliar: emit_operand (ESTÁTICA)
+ * Propósito: ecx = operando de la instrucción. Si está en memoria llama a
+ *            blockcache_load() y sale al intérprete antes de la instrucción
+ *            (sin efectos) si el acceso no es posible.
+ * Retorna: int - 1 si leyó memoria (hay que contar la lectura al confirmar)
+ */
+static int emit_operand(const MicroPart* p, int pc, int last, int add) {
+    if (p->mode == ADDR_IMMEDIATE) {
+        emit8(0xB9);                         // mov ecx, value
+        emit32(p->value);
+        return 0;
+    }
+    emit_address(p);
+    emit_mov_rax((const void*)(uintptr_t)&blockcache_load);
+    emit_bytes("\xFF\xD0", 2);               // call rax
+    emit_bytes("\x3D\x00\x00\x00\x80", 5);   // cmp eax, BLOCK_FAULT
+    emit_exit_jump(JCC_JE, pc, last, add);
+    emit_bytes("\x89\xC1", 2);               // mov ecx, eax
+    return 1;
+}
+
+/* metrics.memory_reads++ */
+static void emit_count_read() {
+    emit_mov_rax(&metrics.memory_reads);
+    emit_bytes("\x48\xFF\x00", 3);           // inc qword [rax]
+}
+
+/* r13d = 0 / 1 / 2 según el signo de r12d (from_ac = 1) o de eax (from_ac = 0) */
+static void emit_condition_code(int from_ac) {
+    if (from_ac) emit_bytes("\x45\x85\xE4", 3);   // test r12d, r12d
+    else emit_bytes("\x85\xC0", 2);               // test eax, eax
+    emit_bytes("\x0F\x9F\xC0", 3);                // setg al
+    emit_bytes("\x0F\x9C\xC1", 3);                // setl cl
+    emit_bytes("\x0F\xB6\xC0", 3);                // movzx eax, al
+    emit_bytes("\x0F\xB6\xC9", 3);                // movzx ecx, cl
+    emit_bytes("\x44\x8D\x2C\x41", 4);            // lea r13d, [rcx + rax*2]
+}
+
+/*
+ * Funciones de traducción por tipo de instrucción (ESTÁTICAS)
+ * pc   - dirección de la instrucción
+ * done - instrucciones ya ejecutadas en esta vuelta del bloque
+ * prev - última instrucción ejecutada antes de esta (para 'last' en la salida)
+ */
+static void compile_load(const MicroPart* p, int pc, int done, int prev) {
+    if (p->mode == ADDR_IMMEDIATE) {
+        emit_bytes("\x41\xBC", 2);            // mov r12d, value
+        emit32(p->value);
+        return;
+    }
+    emit_operand(p, pc, prev, done);
+    emit_bytes("\x41\x89\xCC", 3);            // mov r12d, ecx
+    emit_count_read();
+}
+
+static void compile_arith(const MicroPart* p, int pc, int done, int prev) {
+    int read = emit_operand(p, pc, prev, done);
+    switch (p->opcode) {
+        case 0:
+        case 1:
+        case 2:
+            emit_bytes("\x49\x63\xC4", 3);    // movsxd rax, r12d
+            emit_bytes("\x48\x63\xC9", 3);    // movsxd rcx, ecx
+            if (p->opcode == 0) emit_bytes("\x48\x01\xC8", 3);           // add rax, rcx
+            else if (p->opcode == 1) emit_bytes("\x48\x29\xC8", 3);      // sub rax, rcx
+            else emit_bytes("\x48\x0F\xAF\xC1", 4);                      // imul rax, rcx
+            break;
+        default:
+            // Divisor 0 da 0, como execute_instruction()
+            emit_bytes("\x85\xC9", 2);        // test ecx, ecx
+            emit_bytes("\x75\x04", 2);        // jnz +4
+            emit_bytes("\x31\xC0", 2);        // xor eax, eax
+            emit_bytes("\xEB\x06", 2);        // jmp +6
+            emit_bytes("\x44\x89\xE0", 3);    // mov eax, r12d
+            emit8(0x99);                      // cdq
+            emit_bytes("\xF7\xF9", 2);        // idiv ecx
+            emit_bytes("\x48\x63\xC0", 3);    // movsxd rax, eax
+            break;
+    }
+    // Fuera de rango: el intérprete reproduce el OVERFLOW y la interrupción
+    emit_bytes("\x48\x3D", 2);                // cmp rax, WORD_MAX
+    emit32(WORD_MAX);
+    emit_exit_jump(JCC_JG, pc, prev, done);
+    emit_bytes("\x48\x3D", 2);                // cmp rax, -WORD_MAX
+    emit32(-WORD_MAX);
+    emit_exit_jump(JCC_JL, pc, prev, done);
+    emit_bytes("\x41\x89\xC4", 3);            // mov r12d, eax
+    if (read) emit_count_read();
+    emit_condition_code(1);
+}
+
+static void compile_store(const MicroPart* p, int pc, int done, int prev) {
+    emit_address(p);
+    emit_bytes("\x44\x89\xE6", 3);            // mov esi, r12d
+    emit_mov_rax((const void*)(uintptr_t)&blockcache_store);
+    emit_bytes("\xFF\xD0", 2);                // call rax
+    emit_bytes("\x85\xC0", 2);                // test eax, eax
+    emit_exit_jump(JCC_JS, pc, prev, done);           // Rechazado: intérprete
+    emit_exit_jump(JCC_JNE, pc + 1, pc, done + 1);    // Escribió código: cortar el bloque
+}
+
+static void compile_compare(const MicroPart* p, int pc, int done, int prev) {
+    // Contar antes de calcular: emit_count_read() pisa eax
+    if (emit_operand(p, pc, prev, done)) emit_count_read();
+    if (p->opcode == 8) {
+        emit_bytes("\x41\x89\xCC", 3);        // MOV: mov r12d, ecx
+    } else {
+        emit_bytes("\x44\x89\xE0", 3);        // mov eax, r12d
+        if (p->opcode == 6) emit_bytes("\x29\xC8", 2);   // CMP: sub eax, ecx
+        else emit_bytes("\x21\xC8", 2);                  // TST: and eax, ecx
+    }
+    if (p->opcode != 8) emit_condition_code(0);
+}
+
+/*
+ * Función auxiliar: compile_transfer (ESTÁTICA)
+ * Propósito: Salto condicional (opcodes 9-12) o incondicional (27) al final del
+ *            bloque. Si el destino es el inicio del propio bloque, repite el
+ *            bloque en código nativo mientras haya presupuesto y no haya
+ *            interrupciones ni escrituras sobre código pendientes.
+ */
+static void compile_transfer(const MicroPart* p, int pc, int done, int logical, int length, size_t top) {
+    if (p->opcode != 27) {
+        static const int condition[] = { 0, 2, 1, 3 };  // JEQ, JGT, JLT, JOV
+        emit_bytes("\x41\x83\xFD", 3);        // cmp r13d, condición
+        emit8(condition[p->opcode - 9]);
+        emit_exit_jump(JCC_JNE, pc + 1, pc, done + 1);   // No se toma: sigue el intérprete
+    }
+    if (p->value != logical) {
+        emit_exit_jump(0, p->value, pc, done + 1);
+        return;
+    }
+
+    emit_bytes("\x49\x81\xC6", 3);            // add r14, length
+    emit32(length);
+    emit_bytes("\x49\x8D\x86", 3);            // lea rax, [r14 + length]
+    emit32(length);
+    emit_bytes("\x4C\x39\xF8", 3);            // cmp rax, r15
+    emit_exit_jump(JCC_JA, logical, pc, 0);
+    emit_mov_rax(&interrupts_pending);
+    emit_bytes("\x83\x38\x00", 3);            // cmp dword [rax], 0
+    emit_exit_jump(JCC_JNE, logical, pc, 0);
+    emit_mov_rax(&blockcache_dirty_pending);
+    emit_bytes("\x83\x38\x00", 3);            // cmp dword [rax], 0
+    emit_exit_jump(JCC_JNE, logical, pc, 0);
+    emit8(0xE9);                              // jmp top
+    emit32(0);
+    patch32(pos - 4, top);
+}
+
+/*
+ * Función auxiliar: compilable (ESTÁTICA)
+ * Retorna: int - 1 si el bloque se puede compilar: solo instrucciones del
+ *          camino rápido, saltos a destinos fijos válidos y, como mucho, una
+ *          instrucción de sistema al final (se deja al intérprete)
+ */
+static int compilable(const MicroOp* ops, int nops) {
+    for (int i = 0; i < nops; i++) {
+        const MicroOp* op = &ops[i];
+        const MicroPart* branch = NULL;
+        switch (op->kind) {
+            case UOP_GENERIC:
+                return 0;
+            case UOP_EXIT:
+                if (i == 0 || i != nops - 1) return 0;
+                break;
+            case UOP_BRANCH:
+            case UOP_JUMP:
+                branch = &op->part[0];
+                break;
+            case UOP_COMPARE_BRANCH:
+                branch = &op->part[1];
+                break;
+            default:
+                break;
+        }
+        if (branch && (branch->mode == ADDR_INDEXED || branch->value > 1023)) return 0;
+    }
+    return 1;
+}
+
+/*
+ * Función auxiliar: reserve (ESTÁTICA)
+ * Retorna: int - 0 si hay búfer de código, -1 si no se pudo reservar
+ * Propósito: Reservar el búfer solo con lectura y escritura; protect() hace
+ *            ejecutable cada rango ya compilado (nunca escribible y
+ *            ejecutable a la vez).
+ */
+static int reserve() {
+    if (code_buffer) return 0;
+    void* p = mmap(NULL, JIT_CODE_SIZE, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        log_event(LOG_WARNING, "JIT: no se pudo reservar memoria ejecutable; se usa el intérprete");
+        jit_enabled = 0;
+        return -1;
+    }
+    code_buffer = (unsigned char*)p;
+    log_event(LOG_INFO, "JIT: búfer de código de %d bytes reservado", JIT_CODE_SIZE);
+    return 0;
+}
+
+/*
+ * Función auxiliar: protect (ESTÁTICA)
+ * Parámetros:
+ *   from, to - rango de bytes del búfer (se extiende a páginas completas)
+ *   prot     - PROT_READ | PROT_WRITE para emitir, PROT_READ | PROT_EXEC para ejecutar
+ * Retorna: int - 0 si se cambió la protección, -1 si no (el JIT queda apagado)
+ */
+static int protect(size_t from, size_t to, int prot) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t start = from & ~(page - 1);
+    size_t end = (to + page - 1) & ~(page - 1);
+    if (mprotect(code_buffer + start, end - start, prot) == 0) return 0;
+    log_event(LOG_WARNING, "JIT: no se pudo cambiar la protección del búfer; se usa el intérprete");
+    jit_enabled = 0;
+    return -1;
+}
+
+#endif /* JIT_NATIVE */
+
+/*
+ * Función: jit_compile
+ * Propósito: Ver jit.h.
+ */
+JitCode jit_compile(const MicroOp* ops, int nops, int logical, int length) {
+#if JIT_NATIVE
+    if (!compilable(ops, nops)) {
+        rejected++;
+        return NULL;
+    }
+    if (reserve() != 0) return NULL;
+    if (code_used + MAX_BLOCK_CODE > JIT_CODE_SIZE) jit_reset();  // Búfer lleno: empezar otra generación
+    // La página inicial puede tener código ya sellado: se vuelve a abrir solo para escribir
+    if (protect(code_used, code_used + MAX_BLOCK_CODE, PROT_READ | PROT_WRITE) != 0) return NULL;
+
+    out = code_buffer + code_used;
+    pos = 0;
+    exit_count = 0;
+
+    // Prólogo: push rbx, r12-r15 (deja la pila alineada a 16 para las llamadas)
+    emit_bytes("\x53\x41\x54\x41\x55\x41\x56\x41\x57", 9);
+    emit_bytes("\x48\x89\xFB", 3);                                   // mov rbx, rdi
+    emit_bytes("\x44\x8B\x63", 3); emit8(offsetof(JitFrame, ac));    // mov r12d, [rbx+ac]
+    emit_bytes("\x44\x8B\x6B", 3); emit8(offsetof(JitFrame, cc));    // mov r13d, [rbx+cc]
+    emit_bytes("\x45\x31\xF6", 3);                                   // xor r14d, r14d
+    emit_bytes("\x4C\x8B\x7B", 3); emit8(offsetof(JitFrame, limit)); // mov r15, [rbx+limit]
+    size_t top = pos;
+
+    int done = 0;  // Instrucciones ejecutadas en la vuelta actual antes de la micro-operación
+    int ended = 0;
+    for (int i = 0; i < nops && !ended; i++) {
+        const MicroOp* op = &ops[i];
+        int pc = op->pc;
+        int prev = (done > 0) ? pc - 1 : logical + length - 1;
+        switch (op->kind) {
+            case UOP_LOAD:
+                compile_load(&op->part[0], pc, done, prev);
+                break;
+            case UOP_STORE:
+                compile_store(&op->part[0], pc, done, prev);
+                break;
+            case UOP_ARITH:
+                compile_arith(&op->part[0], pc, done, prev);
+                break;
+            case UOP_COMPARE:
+                compile_compare(&op->part[0], pc, done, prev);
+                break;
+            case UOP_NOP:
+                break;
+            case UOP_LOAD_ARITH:
+                compile_load(&op->part[0], pc, done, prev);
+                compile_arith(&op->part[1], pc + 1, done + 1, pc);
+                break;
+            case UOP_ARITH_STORE:
+                compile_arith(&op->part[0], pc, done, prev);
+                compile_store(&op->part[1], pc + 1, done + 1, pc);
+                break;
+            case UOP_COMPARE_BRANCH:
+                compile_compare(&op->part[0], pc, done, prev);
+                compile_transfer(&op->part[1], pc + 1, done + 1, logical, length, top);
+                ended = 1;
+                break;
+            case UOP_BRANCH:
+            case UOP_JUMP:
+                compile_transfer(&op->part[0], pc, done, logical, length, top);
+                ended = 1;
+                break;
+            default:  // UOP_EXIT: la instrucción de sistema la ejecuta el intérprete
+                emit_exit_jump(0, pc, prev, done);
+                ended = 1;
+                break;
+        }
+        done += op->count;
+    }
+    if (!ended) emit_exit_jump(0, logical + length, logical + length - 1, length);  // Sin salto final
+
+    // Salidas al intérprete
+    size_t epilogue_jumps[MAX_EXITS];
+    for (int e = 0; e < exit_count; e++) {
+        patch32(exits[e].patch, pos);
+        if (exits[e].add > 0) {
+            emit_bytes("\x49\x81\xC6", 3);                            // add r14, add
+            emit32(exits[e].add);
+        }
+        emit_bytes("\xC7\x43", 2); emit8(offsetof(JitFrame, pc));    // mov dword [rbx+pc], pc
+        emit32(exits[e].pc);
+        emit_bytes("\xC7\x43", 2); emit8(offsetof(JitFrame, last));  // mov dword [rbx+last], last
+        emit32(exits[e].last);
+        emit8(0xE9);                                                  // jmp epílogo
+        epilogue_jumps[e] = pos;
+        emit32(0);
+    }
+
+    // Epílogo
+    for (int e = 0; e < exit_count; e++) patch32(epilogue_jumps[e], pos);
+    emit_bytes("\x44\x89\x63", 3); emit8(offsetof(JitFrame, ac));       // mov [rbx+ac], r12d
+    emit_bytes("\x44\x89\x6B", 3); emit8(offsetof(JitFrame, cc));       // mov [rbx+cc], r13d
+    emit_bytes("\x4C\x89\x73", 3); emit8(offsetof(JitFrame, retired));  // mov [rbx+retired], r14
+    emit_bytes("\x41\x5F\x41\x5E\x41\x5D\x41\x5C\x5B\xC3", 10);         // pop r15..rbx; ret
+
+    size_t begin = code_used;
+    code_used += (pos + 15) & ~(size_t)15;
+    if (protect(begin, code_used, PROT_READ | PROT_EXEC) != 0) return NULL;
+    compiled++;
+    return (JitCode)(uintptr_t)out;
+#else
+    (void)ops; (void)nops; (void)logical; (void)length;
+    rejected++;
+    return NULL;
+#endif
+}
+
+/*
+ * Función: jit_reset
+ * Propósito: Descartar todo el código nativo. Los bloques guardan la
+ *            generación en la que se compilaron, así que no hace falta recorrerlos.
+ */
+void jit_reset() {
+#if JIT_NATIVE
+    // El código viejo ya no se ejecuta: todo el búfer vuelve a ser solo escribible
+    if (code_buffer) protect(0, JIT_CODE_SIZE, PROT_READ | PROT_WRITE);
+#endif
+    code_used = 0;
+    jit_generation++;
+    resets++;
+}
+
+/*
+ * Función: jit_count_entry
+ */
+void jit_count_entry() {
+    entries++;
+}
+
+/*
+ * Función: jit_status
+ * Propósito: Mostrar el estado del JIT.
+ */
+void jit_status() {
+    printf("\n=== COMPILADOR JIT (%s) ===\n", jit_enabled ? "habilitado" : "deshabilitado");
+    if (!JIT_NATIVE) printf("Esta plataforma no es Linux/x86-64: solo se usa el intérprete.\n");
+    printf("Umbral:               %d ejecuciones de un bloque\n", JIT_THRESHOLD);
+    printf("Bloques compilados:   %lu (%lu no compilables)\n", compiled, rejected);
+    printf("Código:               %lu de %d bytes (búfer descartado %lu veces)\n",
+           (unsigned long)code_used, JIT_CODE_SIZE, resets);
+    printf("Entradas nativas:     %llu\n", entries);
+    printf("Requiere la caché de bloques ('bbcache on').\n");
+    printf("===========================\n");
+}
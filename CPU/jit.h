@@ -0,0 +1,87 @@
+/*
+ * Archivo de cabecera del compilador JIT del Sistema Operativo Virtual.
+ * Segundo nivel de la caché de bloques: los bloques que se ejecutan más de
+ * JIT_THRESHOLD veces se compilan a código máquina x86-64 en un búfer
+ * ejecutable. Dentro del código nativo el AC y el código de condición viven
+ * en registros del host; los bucles cuyo salto vuelve al inicio del propio
+ * bloque se repiten sin salir al intérprete.
+ *
+ * El código nativo vuelve al intérprete (micro-operaciones o cpu_cycle) ante
+ * cualquier caso poco común: acceso a memoria rechazado u operando que no es
+ * una palabra canónica, resultado fuera de rango, escritura sobre código
+ * traducido, interrupción pendiente o fin del presupuesto de instrucciones.
+ * Solo hay generador para Linux/x86-64; en otras plataformas jit_compile()
+ * no compila nada y la caché de bloques sigue funcionando igual.
+ */
+
+#ifndef JIT_H
+#define JIT_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "blockcache.h"  // Para MicroOp
+
+/*
+ * CONSTANTES DE CONFIGURACIÓN DEL JIT
+ * JIT_THRESHOLD  - Ejecuciones de un bloque antes de compilarlo
+ * JIT_CODE_SIZE  - Bytes del búfer de código (al llenarse se descarta todo)
+ * JIT_SLICE      - Instrucciones máximas por entrada al código nativo, para
+ *                  que la consola y las métricas vean avanzar la ejecución
+ */
+#define JIT_THRESHOLD 64
+#define JIT_CODE_SIZE (1024 * 1024)
+#define JIT_SLICE 65536ULL
+
+/*
+ * Estructura: JitFrame
+ * Propósito: Estado que el código nativo recibe y devuelve.
+ *
+ * Campos:
+ *   ac, cc   - AC y código de condición (entrada y salida)
+ *   pc       - PC lógico con el que continuar (salida)
+ *   last     - dirección de la última instrucción ejecutada (salida; para MAR/IR)
+ *   retired  - instrucciones ejecutadas (salida; 0 si salió antes de la primera)
+ *   limit    - tope de 'retired' para repetir un bucle (entrada)
+ */
+typedef struct {
+    int ac;
+    int cc;
+    int pc;
+    int last;
+    unsigned long long retired;
+    unsigned long long limit;
+} JitFrame;
+
+typedef void (*JitCode)(JitFrame* frame);
+
+/*
+ * DECLARACIÓN DE VARIABLES GLOBALES EXTERNAS
+ * jit_enabled    - la caché de bloques solo compila si está activa ('jit on|off')
+ * jit_generation - cambia cada vez que se descarta el búfer; el código de un
+ *                  bloque solo es válido si se compiló en la generación actual
+ */
+extern int jit_enabled;
+extern unsigned int jit_generation;
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del JIT
+ */
+
+/*
+ * Función: jit_compile
+ * Parámetros:
+ *   ops, nops - micro-operaciones del bloque
+ *   logical   - dirección lógica de inicio del bloque
+ *   length    - instrucciones del invitado en el bloque
+ * Retorna: JitCode - código nativo, o NULL si el bloque no se puede compilar
+ *          (contiene instrucciones que siempre van por el camino lento)
+ */
+JitCode jit_compile(const MicroOp* ops, int nops, int logical, int length);
+
+void jit_reset();                      // Descartar todo el código nativo (nueva generación)
+void jit_count_entry();                // Contabilizar una entrada al código nativo
+void jit_status();                     // Mostrar estado, bloques compilados y bytes usados
+
+#endif /* JIT_H */
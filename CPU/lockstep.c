@@ -0,0 +1,857 @@
+/*
+ * Archivo de implementación del intérprete en lockstep del Sistema Operativo Virtual.
+ * Contiene la decodificación compartida, el planificador de cada grupo
+ * (PC más bajo primero, turnos y paso al intérprete normal) y las tres
+ * implementaciones de un paso: escalar, AVX2 y AVX-512.
+ *
+ * Cada implementación ofrece tres operaciones sobre el grupo:
+ *   select  - máscara de los carriles con el PC más bajo entre los dados
+ *   match   - carriles cuya palabra de código sigue siendo la de la carga
+ *   execute - aplicar una instrucción a los carriles de la máscara; retorna
+ *             los que deben seguir en el intérprete normal (sin modificarlos)
+ * Las multiplicaciones y divisiones se hacen en doble precisión: con
+ * operandos de 7 dígitos el producto es exacto y el cociente truncado
+ * coincide con la división entera de C.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "lockstep.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "cpu.h"                    // Para cpu_cycle_block y el estado de la CPU
+#include "blockcache.h"             // Para invalidar bloques al restaurar la memoria
+#include "../MEMORY/memory.h"       // Para el arreglo memory[]
+#include "../REGISTERS/registers.h" // Para cpu_registers
+#include "../CODEC/wordcodec.h"     // Para convertir la región del proceso en bloque
+#include "../LOGGER/logger.h"       // Para el resumen en el registro de eventos
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf
+#include <string.h>   // Para memcpy, memcmp, strcmp
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>  // Intrínsecos AVX2 / AVX-512 (habilitados por función con 'target')
+#define LOCKSTEP_SIMD 1
+#else
+#define LOCKSTEP_SIMD 0
+#endif
+
+/*
+ * CONSTANTES INTERNAS
+ * WORD_MAX     - Mayor magnitud representable en una palabra (7 dígitos)
+ * LANE_INVALID - Valor de una palabra que no es un número canónico (nunca
+ *                es el valor de una palabra): leerla lleva al intérprete normal
+ * LAST_PC      - Última dirección que se ejecuta en lockstep (PC_psw tiene 10 bits)
+ */
+#define WORD_MAX 9999999
+#define LANE_INVALID (-2147483647 - 1)
+#define LAST_PC 1022
+
+/*
+ * Enum: LaneOpKind
+ * Propósito: Instrucciones que se ejecutan en los carriles. Las que leen un
+ *            operando van primero (hasta LOP_TST).
+ */
+typedef enum {
+    LOP_LOAD,     // LOAD, MOV
+    LOP_ADD,      // SUM
+    LOP_SUB,      // RES
+    LOP_MUL,      // MULT
+    LOP_DIV,      // DIVI
+    LOP_CMP,      // CMP
+    LOP_TST,      // TST
+    LOP_STORE,    // STR
+    LOP_BRANCH,   // JEQ, JGT, JLT, JOV
+    LOP_JUMP,     // J
+    LOP_NOP,      // NOP
+    LOP_HALT,     // HALT
+    LOP_SCALAR    // Cualquier otra: intérprete normal
+} LaneOpKind;
+
+/*
+ * Estructura: LaneOp
+ * Propósito: Instrucción decodificada una vez para todas las instancias.
+ */
+typedef struct {
+    unsigned char kind;        // LaneOpKind
+    unsigned char mode;        // ADDR_DIRECT, ADDR_IMMEDIATE o ADDR_INDEXED
+    unsigned char condition;   // Código de condición que toma el salto
+    int value;
+} LaneOp;
+
+/*
+ * Estructura: LaneFile
+ * Propósito: Registros de los carriles de un grupo, un arreglo por campo.
+ */
+typedef struct {
+    int ac[LOCKSTEP_LANES];
+    int pc[LOCKSTEP_LANES];
+    int cc[LOCKSTEP_LANES];
+    int retired[LOCKSTEP_LANES];
+} LaneFile;
+
+/*
+ * Estructura: LaneBackend
+ * Propósito: Una implementación del paso (ver el comentario del archivo).
+ */
+typedef struct {
+    const char* name;
+    unsigned int (*select)(unsigned int running, int* pc);
+    unsigned int (*match)(const int* row, int value, unsigned int mask);
+    unsigned int (*execute)(const LaneOp* op, unsigned int mask);
+} LaneBackend;
+
+/*
+ * VARIABLES GLOBALES ESTÁTICAS
+ * lanes       - registros del grupo en ejecución
+ * lane_memory - región del proceso de cada carril: [palabra lógica][carril]
+ * image       - valor de cada palabra lógica tras la carga
+ * code        - decodificación de la imagen (solo hasta LAST_PC)
+ */
+static LaneFile lanes __attribute__((aligned(64)));
+static int lane_memory[MEMORY_SIZE][LOCKSTEP_LANES] __attribute__((aligned(64)));
+static const int lane_index[LOCKSTEP_LANES] __attribute__((aligned(64))) = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+};
+static int image[MEMORY_SIZE];
+static LaneOp code[LAST_PC + 1];
+static const LaneOp scalar_op = { LOP_SCALAR, 0, 0, 0 };
+
+/*
+ * Contexto de la ejecución: región del proceso, estado inicial de cada
+ * instancia, barrido y lo necesario para restaurar la máquina al final.
+ */
+static int region_base, region_limit;
+static int start_pc, start_ac, start_cc;
+static int sweep_address, sweep_first, sweep_step;
+static int lane_limit;
+static Word saved_memory[MEMORY_SIZE];
+static CPU_Registers saved_registers;
+
+/*
+ * Implementaciones disponibles
+ */
+#define BACKEND_SCALAR 0
+#define BACKEND_AVX2 1
+#define BACKEND_AVX512 2
+
+static int detected = -1;   // -1 = aún no detectado
+static int forced = -1;     // lockstep_set_backend(); -1 = la mejor disponible
+
+/*
+ * Función auxiliar: canonical_value (ESTÁTICA)
+ * Retorna: int - valor de la palabra, o LANE_INVALID si no es un número
+ *          canónico (el códec convierte las inválidas y "-0" a 0)
+ */
+static int canonical_value(const Word* w, int value) {
+    if (value == 0 && strcmp(w->data, "00000000") != 0) return LANE_INVALID;
+    return value;
+}
+
+/*
+ * Función auxiliar: decode_lane_op (ESTÁTICA)
+ * Propósito: Decodificar una palabra de la imagen como instrucción.
+ */
+static LaneOp decode_lane_op(const Word* w) {
+    static const unsigned char conditions[] = { 0, 2, 1, 3 };  // JEQ, JGT, JLT, JOV
+    LaneOp op = scalar_op;
+    const char* d = w->data;
+    if (d[8] != '\0') return op;
+    for (int i = 0; i < 8; i++) {
+        if (d[i] < '0' || d[i] > '9') return op;
+    }
+    int opcode = (d[0] - '0') * 10 + (d[1] - '0');
+    op.mode = (unsigned char)(d[2] - '0');
+    op.value = (d[3] - '0') * 10000 + (d[4] - '0') * 1000 + (d[5] - '0') * 100 +
+               (d[6] - '0') * 10 + (d[7] - '0');
+    if (op.mode > ADDR_INDEXED) return op;
+    switch (opcode) {
+        case 0: op.kind = LOP_ADD; break;
+        case 1: op.kind = LOP_SUB; break;
+        case 2: op.kind = LOP_MUL; break;
+        case 3: op.kind = LOP_DIV; break;
+        case 4: case 8: op.kind = LOP_LOAD; break;
+        case 5: op.kind = LOP_STORE; break;
+        case 6: op.kind = LOP_CMP; break;
+        case 7: op.kind = LOP_TST; break;
+        case 9: case 10: case 11: case 12:
+            op.kind = LOP_BRANCH;
+            op.condition = conditions[opcode - 9];
+            break;
+        case 27: op.kind = LOP_JUMP; break;
+        case 40: op.kind = LOP_HALT; break;
+        case 41: op.kind = LOP_NOP; break;
+        default: break;
+    }
+    return op;
+}
+
+/*
+ * ============================================================================
+ * CAMINO ESCALAR
+ * ============================================================================
+ */
+
+static int sign_of(int value) {
+    return (value > 0) ? 2 : (value < 0) ? 1 : 0;
+}
+
+static unsigned int select_scalar(unsigned int running, int* pc) {
+    int lowest = LAST_PC + 2;
+    for (int l = 0; l < LOCKSTEP_LANES; l++) {
+        if (((running >> l) & 1) && lanes.pc[l] < lowest) lowest = lanes.pc[l];
+    }
+    unsigned int mask = 0;
+    for (int l = 0; l < LOCKSTEP_LANES; l++) {
+        if (((running >> l) & 1) && lanes.pc[l] == lowest) mask |= 1u << l;
+    }
+    *pc = lowest;
+    return mask;
+}
+
+static unsigned int match_scalar(const int* row, int value, unsigned int mask) {
+    unsigned int same = 0;
+    for (int l = 0; l < LOCKSTEP_LANES; l++) {
+        if (((mask >> l) & 1) && row[l] == value) same |= 1u << l;
+    }
+    return same;
+}
+
+static unsigned int execute_scalar(const LaneOp* op, unsigned int mask) {
+    unsigned int faulted = 0;
+    for (int l = 0; l < LOCKSTEP_LANES; l++) {
+        if (!((mask >> l) & 1)) continue;
+        int ac = lanes.ac[l];
+        int cc = lanes.cc[l];
+        int next = lanes.pc[l] + 1;
+        int address = (op->mode == ADDR_INDEXED) ? ac + op->value : op->value;
+        int operand = op->value;
+        long long result = 0;
+
+        if (op->kind <= LOP_TST && op->mode != ADDR_IMMEDIATE) {
+            if (address < 0 || address >= region_limit || lane_memory[address][l] == LANE_INVALID) {
+                faulted |= 1u << l;
+                continue;
+            }
+            operand = lane_memory[address][l];
+        }
+        switch (op->kind) {
+            case LOP_LOAD:
+                ac = operand;
+                break;
+            case LOP_ADD: case LOP_SUB: case LOP_MUL: case LOP_DIV:
+                if (op->kind == LOP_ADD) result = (long long)ac + operand;
+                else if (op->kind == LOP_SUB) result = (long long)ac - operand;
+                else if (op->kind == LOP_MUL) result = (long long)ac * operand;
+                else result = (operand != 0) ? ac / operand : 0;
+                if (result < -WORD_MAX || result > WORD_MAX) {
+                    faulted |= 1u << l;
+                    continue;
+                }
+                ac = (int)result;
+                cc = sign_of(ac);
+                break;
+            case LOP_CMP:
+                cc = sign_of(ac - operand);
+                break;
+            case LOP_TST:
+                cc = sign_of(ac & operand);
+                break;
+            case LOP_STORE:
+                if (address < 0 || address >= region_limit) {
+                    faulted |= 1u << l;
+                    continue;
+                }
+                lane_memory[address][l] = ac;
+                break;
+            case LOP_BRANCH: case LOP_JUMP:
+                if (op->kind == LOP_JUMP || cc == op->condition) {
+                    if (address < 0 || address > 1023) {
+                        faulted |= 1u << l;
+                        continue;
+                    }
+                    next = address;
+                }
+                break;
+            default:  // LOP_NOP
+                break;
+        }
+        lanes.ac[l] = ac;
+        lanes.cc[l] = cc;
+        lanes.pc[l] = next;
+        lanes.retired[l]++;
+    }
+    return faulted;
+}
+
+#if LOCKSTEP_SIMD
+
+/*
+ * ============================================================================
+ * AVX2 (dos mitades de 8 carriles; sin scatter: STR indexado por carril)
+ * ============================================================================
+ */
+
+__attribute__((target("avx2")))
+static inline __m256i lanes_to_vector(unsigned int bits) {
+    const __m256i bit = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32((int)bits), bit), bit);
+}
+
+__attribute__((target("avx2")))
+static inline unsigned int vector_to_lanes(__m256i v) {
+    return (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(v));
+}
+
+/*
+ * Función auxiliar: outside_avx2 (ESTÁTICA)
+ * Retorna: __m256i - carriles con x fuera de [low, high]
+ */
+__attribute__((target("avx2")))
+static inline __m256i outside_avx2(__m256i x, int low, int high) {
+    return _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(low), x),
+                           _mm256_cmpgt_epi32(x, _mm256_set1_epi32(high)));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i sign_avx2(__m256i r) {
+    __m256i zero = _mm256_setzero_si256();
+    return _mm256_or_si256(_mm256_and_si256(_mm256_cmpgt_epi32(r, zero), _mm256_set1_epi32(2)),
+                           _mm256_and_si256(_mm256_cmpgt_epi32(zero, r), _mm256_set1_epi32(1)));
+}
+
+/*
+ * Función auxiliar: muldiv_avx2 (ESTÁTICA)
+ * Parámetros: in_range - salida: carriles cuyo resultado cabe en una palabra
+ * Retorna: __m256i - a * b o a / b truncado (8 carriles, 4 por vector doble)
+ */
+__attribute__((target("avx2")))
+static inline __m256i muldiv_avx2(__m256i a, __m256i b, int divide, __m256i* in_range) {
+    __m256d a_lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(a));
+    __m256d a_hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(a, 1));
+    __m256d b_lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(b));
+    __m256d b_hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(b, 1));
+    __m256d lo = divide ? _mm256_div_pd(a_lo, b_lo) : _mm256_mul_pd(a_lo, b_lo);
+    __m256d hi = divide ? _mm256_div_pd(a_hi, b_hi) : _mm256_mul_pd(a_hi, b_hi);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d word_max = _mm256_set1_pd(WORD_MAX);
+    int ok_lo = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_andnot_pd(sign, lo), word_max, _CMP_LE_OQ));
+    int ok_hi = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_andnot_pd(sign, hi), word_max, _CMP_LE_OQ));
+    *in_range = lanes_to_vector((unsigned int)(ok_lo | (ok_hi << 4)));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm256_cvttpd_epi32(lo)), _mm256_cvttpd_epi32(hi), 1);
+}
+
+__attribute__((target("avx2")))
+static unsigned int select_avx2(unsigned int running, int* pc) {
+    const __m256i idle = _mm256_set1_epi32(LAST_PC + 2);
+    __m256i lo = _mm256_blendv_epi8(idle, _mm256_load_si256((const __m256i*)&lanes.pc[0]), lanes_to_vector(running & 0xFF));
+    __m256i hi = _mm256_blendv_epi8(idle, _mm256_load_si256((const __m256i*)&lanes.pc[8]), lanes_to_vector(running >> 8));
+    __m256i m = _mm256_min_epi32(lo, hi);
+    m = _mm256_min_epi32(m, _mm256_permute2x128_si256(m, m, 1));
+    m = _mm256_min_epi32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm256_min_epi32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    int lowest = _mm_cvtsi128_si32(_mm256_castsi256_si128(m));
+    __m256i target = _mm256_set1_epi32(lowest);
+    *pc = lowest;
+    return (vector_to_lanes(_mm256_cmpeq_epi32(lo, target)) |
+            (vector_to_lanes(_mm256_cmpeq_epi32(hi, target)) << 8)) & running;
+}
+
+__attribute__((target("avx2")))
+static unsigned int match_avx2(const int* row, int value, unsigned int mask) {
+    __m256i target = _mm256_set1_epi32(value);
+    unsigned int lo = vector_to_lanes(_mm256_cmpeq_epi32(_mm256_load_si256((const __m256i*)row), target));
+    unsigned int hi = vector_to_lanes(_mm256_cmpeq_epi32(_mm256_load_si256((const __m256i*)(row + 8)), target));
+    return (lo | (hi << 8)) & mask;
+}
+
+__attribute__((target("avx2")))
+static unsigned int execute_avx2(const LaneOp* op, unsigned int mask) {
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i zero = _mm256_setzero_si256();
+    unsigned int faulted = 0;
+    for (int h = 0; h < LOCKSTEP_LANES; h += 8) {
+        unsigned int bits = (mask >> h) & 0xFF;
+        if (bits == 0) continue;
+        __m256i ok = lanes_to_vector(bits);
+        __m256i ac = _mm256_load_si256((const __m256i*)&lanes.ac[h]);
+        __m256i cc = _mm256_load_si256((const __m256i*)&lanes.cc[h]);
+        __m256i pc = _mm256_load_si256((const __m256i*)&lanes.pc[h]);
+        __m256i value = _mm256_set1_epi32(op->value);
+        __m256i address = (op->mode == ADDR_INDEXED) ? _mm256_add_epi32(ac, value) : value;
+        __m256i index = _mm256_add_epi32(_mm256_slli_epi32(address, 4),        // palabra * 16 + carril
+                                         _mm256_load_si256((const __m256i*)&lane_index[h]));
+        __m256i next = _mm256_add_epi32(pc, one);
+        __m256i operand = value;
+        __m256i result, in_range, taken;
+        int direct_ok = (op->value < region_limit);
+
+        if (op->kind <= LOP_TST && op->mode != ADDR_IMMEDIATE) {
+            if (op->mode == ADDR_DIRECT) {
+                // Misma palabra en todos los carriles: una fila contigua
+                if (!direct_ok) ok = zero;
+                else operand = _mm256_load_si256((const __m256i*)&lane_memory[op->value][h]);
+            } else {
+                ok = _mm256_andnot_si256(outside_avx2(address, 0, region_limit - 1), ok);
+                operand = _mm256_mask_i32gather_epi32(zero, &lane_memory[0][0], index, ok, 4);
+            }
+            ok = _mm256_andnot_si256(_mm256_cmpeq_epi32(operand, _mm256_set1_epi32(LANE_INVALID)), ok);
+        }
+        switch (op->kind) {
+            case LOP_LOAD:
+                ac = _mm256_blendv_epi8(ac, operand, ok);
+                break;
+            case LOP_ADD: case LOP_SUB: case LOP_MUL: case LOP_DIV:
+                if (op->kind == LOP_ADD || op->kind == LOP_SUB) {
+                    result = (op->kind == LOP_ADD) ? _mm256_add_epi32(ac, operand) : _mm256_sub_epi32(ac, operand);
+                    in_range = _mm256_andnot_si256(outside_avx2(result, -WORD_MAX, WORD_MAX), _mm256_set1_epi32(-1));
+                } else if (op->kind == LOP_MUL) {
+                    result = muldiv_avx2(ac, operand, 0, &in_range);
+                } else {
+                    __m256i by_zero = _mm256_cmpeq_epi32(operand, zero);   // DIVI por 0 da 0
+                    result = _mm256_andnot_si256(by_zero, muldiv_avx2(ac, operand, 1, &in_range));
+                    in_range = _mm256_or_si256(in_range, by_zero);
+                }
+                ok = _mm256_and_si256(ok, in_range);
+                ac = _mm256_blendv_epi8(ac, result, ok);
+                cc = _mm256_blendv_epi8(cc, sign_avx2(result), ok);
+                break;
+            case LOP_CMP:
+                cc = _mm256_blendv_epi8(cc, sign_avx2(_mm256_sub_epi32(ac, operand)), ok);
+                break;
+            case LOP_TST:
+                cc = _mm256_blendv_epi8(cc, sign_avx2(_mm256_and_si256(ac, operand)), ok);
+                break;
+            case LOP_STORE:
+                ok = _mm256_andnot_si256(outside_avx2(address, 0, region_limit - 1), ok);
+                if (op->mode != ADDR_INDEXED) {
+                    if (direct_ok) _mm256_maskstore_epi32(&lane_memory[op->value][h], ok, ac);
+                } else {
+                    int where[8], values[8];
+                    _mm256_storeu_si256((__m256i*)where, address);
+                    _mm256_storeu_si256((__m256i*)values, ac);
+                    unsigned int store = vector_to_lanes(ok);
+                    for (int l = 0; l < 8; l++) {
+                        if ((store >> l) & 1) lane_memory[where[l]][h + l] = values[l];
+                    }
+                }
+                break;
+            case LOP_BRANCH: case LOP_JUMP:
+                taken = (op->kind == LOP_JUMP) ? ok :
+                        _mm256_and_si256(ok, _mm256_cmpeq_epi32(cc, _mm256_set1_epi32(op->condition)));
+                ok = _mm256_andnot_si256(_mm256_and_si256(taken, outside_avx2(address, 0, 1023)), ok);
+                next = _mm256_blendv_epi8(next, address, _mm256_and_si256(taken, ok));
+                break;
+            default:  // LOP_NOP
+                break;
+        }
+        _mm256_store_si256((__m256i*)&lanes.ac[h], ac);
+        _mm256_store_si256((__m256i*)&lanes.cc[h], cc);
+        _mm256_store_si256((__m256i*)&lanes.pc[h], _mm256_blendv_epi8(pc, next, ok));
+        // ok vale -1 en los carriles que ejecutaron: restarlo suma 1
+        __m256i retired = _mm256_load_si256((const __m256i*)&lanes.retired[h]);
+        _mm256_store_si256((__m256i*)&lanes.retired[h], _mm256_sub_epi32(retired, ok));
+        faulted |= (bits & ~vector_to_lanes(ok)) << h;
+    }
+    return faulted;
+}
+
+/*
+ * ============================================================================
+ * AVX-512 (los 16 carriles en un registro, máscaras nativas)
+ * ============================================================================
+ */
+
+__attribute__((target("avx512f")))
+static inline __mmask16 inside_avx512(__m512i x, int low, int high) {
+    return _mm512_cmpge_epi32_mask(x, _mm512_set1_epi32(low)) &
+           _mm512_cmple_epi32_mask(x, _mm512_set1_epi32(high));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i sign_avx512(__m512i r) {
+    __m512i zero = _mm512_setzero_si512();
+    return _mm512_or_si512(_mm512_maskz_mov_epi32(_mm512_cmpgt_epi32_mask(r, zero), _mm512_set1_epi32(2)),
+                           _mm512_maskz_mov_epi32(_mm512_cmplt_epi32_mask(r, zero), _mm512_set1_epi32(1)));
+}
+
+/*
+ * Función auxiliar: muldiv_avx512 (ESTÁTICA)
+ * Propósito: Como muldiv_avx2, con 8 carriles por vector doble.
+ */
+__attribute__((target("avx512f")))
+static inline __m512i muldiv_avx512(__m512i a, __m512i b, int divide, __mmask16* in_range) {
+    __m512d a_lo = _mm512_cvtepi32_pd(_mm512_castsi512_si256(a));
+    __m512d a_hi = _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(a, 1));
+    __m512d b_lo = _mm512_cvtepi32_pd(_mm512_castsi512_si256(b));
+    __m512d b_hi = _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(b, 1));
+    __m512d lo = divide ? _mm512_div_pd(a_lo, b_lo) : _mm512_mul_pd(a_lo, b_lo);
+    __m512d hi = divide ? _mm512_div_pd(a_hi, b_hi) : _mm512_mul_pd(a_hi, b_hi);
+    const __m512d word_max = _mm512_set1_pd(WORD_MAX);
+    __mmask8 ok_lo = _mm512_cmp_pd_mask(_mm512_abs_pd(lo), word_max, _CMP_LE_OQ);
+    __mmask8 ok_hi = _mm512_cmp_pd_mask(_mm512_abs_pd(hi), word_max, _CMP_LE_OQ);
+    *in_range = (__mmask16)(ok_lo | (ok_hi << 8));
+    return _mm512_inserti64x4(_mm512_castsi256_si512(_mm512_cvttpd_epi32(lo)), _mm512_cvttpd_epi32(hi), 1);
+}
+
+__attribute__((target("avx512f")))
+static unsigned int select_avx512(unsigned int running, int* pc) {
+    __m512i pcs = _mm512_load_si512(lanes.pc);
+    int lowest = _mm512_mask_reduce_min_epi32((__mmask16)running, pcs);
+    *pc = lowest;
+    return _mm512_mask_cmpeq_epi32_mask((__mmask16)running, pcs, _mm512_set1_epi32(lowest));
+}
+
+__attribute__((target("avx512f")))
+static unsigned int match_avx512(const int* row, int value, unsigned int mask) {
+    return _mm512_mask_cmpeq_epi32_mask((__mmask16)mask, _mm512_load_si512(row), _mm512_set1_epi32(value));
+}
+
+__attribute__((target("avx512f")))
+static unsigned int execute_avx512(const LaneOp* op, unsigned int mask) {
+    const __m512i one = _mm512_set1_epi32(1);
+    const __m512i zero = _mm512_setzero_si512();
+    __mmask16 ok = (__mmask16)mask;
+    __m512i ac = _mm512_load_si512(lanes.ac);
+    __m512i cc = _mm512_load_si512(lanes.cc);
+    __m512i pc = _mm512_load_si512(lanes.pc);
+    __m512i value = _mm512_set1_epi32(op->value);
+    __m512i address = (op->mode == ADDR_INDEXED) ? _mm512_add_epi32(ac, value) : value;
+    __m512i index = _mm512_add_epi32(_mm512_slli_epi32(address, 4), _mm512_load_si512(lane_index));
+    __m512i next = _mm512_add_epi32(pc, one);
+    __m512i operand = value;
+    __m512i result;
+    __mmask16 in_range, taken;
+    int direct_ok = (op->value < region_limit);
+
+    if (op->kind <= LOP_TST && op->mode != ADDR_IMMEDIATE) {
+        if (op->mode == ADDR_DIRECT) {
+            if (!direct_ok) ok = 0;
+            else operand = _mm512_load_si512(lane_memory[op->value]);
+        } else {
+            ok &= inside_avx512(address, 0, region_limit - 1);
+            operand = _mm512_mask_i32gather_epi32(zero, ok, index, &lane_memory[0][0], 4);
+        }
+        ok &= _mm512_cmpneq_epi32_mask(operand, _mm512_set1_epi32(LANE_INVALID));
+    }
+    switch (op->kind) {
+        case LOP_LOAD:
+            ac = _mm512_mask_mov_epi32(ac, ok, operand);
+            break;
+        case LOP_ADD: case LOP_SUB: case LOP_MUL: case LOP_DIV:
+            if (op->kind == LOP_ADD || op->kind == LOP_SUB) {
+                result = (op->kind == LOP_ADD) ? _mm512_add_epi32(ac, operand) : _mm512_sub_epi32(ac, operand);
+                in_range = inside_avx512(result, -WORD_MAX, WORD_MAX);
+            } else if (op->kind == LOP_MUL) {
+                result = muldiv_avx512(ac, operand, 0, &in_range);
+            } else {
+                __mmask16 by_zero = _mm512_cmpeq_epi32_mask(operand, zero);
+                result = _mm512_maskz_mov_epi32((__mmask16)~by_zero, muldiv_avx512(ac, operand, 1, &in_range));
+                in_range |= by_zero;
+            }
+            ok &= in_range;
+            ac = _mm512_mask_mov_epi32(ac, ok, result);
+            cc = _mm512_mask_mov_epi32(cc, ok, sign_avx512(result));
+            break;
+        case LOP_CMP:
+            cc = _mm512_mask_mov_epi32(cc, ok, sign_avx512(_mm512_sub_epi32(ac, operand)));
+            break;
+        case LOP_TST:
+            cc = _mm512_mask_mov_epi32(cc, ok, sign_avx512(_mm512_and_si512(ac, operand)));
+            break;
+        case LOP_STORE:
+            ok &= inside_avx512(address, 0, region_limit - 1);
+            if (op->mode == ADDR_INDEXED) _mm512_mask_i32scatter_epi32(&lane_memory[0][0], ok, index, ac, 4);
+            else if (direct_ok) _mm512_mask_store_epi32(lane_memory[op->value], ok, ac);
+            break;
+        case LOP_BRANCH: case LOP_JUMP:
+            taken = (op->kind == LOP_JUMP) ? ok :
+                    _mm512_mask_cmpeq_epi32_mask(ok, cc, _mm512_set1_epi32(op->condition));
+            ok &= (__mmask16)~(taken & ~inside_avx512(address, 0, 1023));
+            next = _mm512_mask_mov_epi32(next, taken & ok, address);
+            break;
+        default:  // LOP_NOP
+            break;
+    }
+    _mm512_store_si512(lanes.ac, ac);
+    _mm512_store_si512(lanes.cc, cc);
+    _mm512_store_si512(lanes.pc, _mm512_mask_mov_epi32(pc, ok, next));
+    __m512i retired = _mm512_load_si512(lanes.retired);
+    _mm512_store_si512(lanes.retired, _mm512_mask_add_epi32(retired, ok, retired, one));
+    return mask & ~(unsigned int)ok;
+}
+
+#endif /* LOCKSTEP_SIMD */
+
+/*
+ * Tabla de implementaciones (las SIMD solo en x86-64 con GCC)
+ */
+static const LaneBackend backends[] = {
+    { "escalar", select_scalar, match_scalar, execute_scalar },
+#if LOCKSTEP_SIMD
+    { "avx2", select_avx2, match_avx2, execute_avx2 },
+    { "avx512", select_avx512, match_avx512, execute_avx512 },
+#endif
+};
+
+/*
+ * Función auxiliar: select_backend (ESTÁTICA)
+ * Retorna: int - implementación a usar (BACKEND_*)
+ */
+static int select_backend() {
+    if (detected < 0) {
+        detected = BACKEND_SCALAR;
+#if LOCKSTEP_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) detected = BACKEND_AVX512;
+        else if (__builtin_cpu_supports("avx2")) detected = BACKEND_AVX2;
+#endif
+    }
+    return (forced >= 0) ? forced : detected;
+}
+
+/*
+ * Función auxiliar: restore_memory (ESTÁTICA)
+ * Parámetros: words - contenido que debe quedar en toda la memoria
+ * Propósito: Escribir solo las palabras que cambian y avisar a la caché de
+ *            bloques de cada una, como write_memory: los bloques de código
+ *            que no cambió siguen traducidos entre instancias.
+ */
+static void restore_memory(const Word* words) {
+    for (int p = 0; p < MEMORY_SIZE; p++) {
+        if (memcmp(memory[p].data, words[p].data, sizeof(Word)) == 0) continue;
+        memory[p] = words[p];
+        blockcache_on_write(p);
+    }
+}
+
+/*
+ * Función auxiliar: run_scalar (ESTÁTICA)
+ * Parámetros: l - carril; result - salida
+ * Propósito: Terminar una instancia en el intérprete normal a partir del
+ *            estado de su carril (registros y columna de memoria).
+ */
+static void run_scalar(int l, LockstepResult* result) {
+    static Word words[MEMORY_SIZE];
+    static int column[MEMORY_SIZE];
+    memcpy(words, saved_memory, sizeof(words));
+    for (int a = 0; a < region_limit; a++) column[a] = lane_memory[a][l];
+    codec_ints_to_words(column, &words[region_base], region_limit);
+    for (int a = 0; a < region_limit; a++) {
+        if (column[a] == LANE_INVALID) words[region_base + a] = saved_memory[region_base + a];
+    }
+    restore_memory(words);
+
+    cpu_registers = saved_registers;
+    if (lanes.retired[l] > 0) {  // Sin instrucciones ejecutadas: registros de la carga
+        cpu_registers.AC = int_to_word(lanes.ac[l]);
+        cpu_registers.PSW.condition_code = lanes.cc[l];
+    }
+    cpu_registers.PSW.PC_psw = lanes.pc[l];
+    set_PC_int(lanes.pc[l]);
+    set_cpu_state(CPU_RUNNING);
+
+    unsigned long long budget = (unsigned long long)(lane_limit - lanes.retired[l]);
+    unsigned long long first = cpu_instructions_retired;
+    while (get_cpu_state() == CPU_RUNNING && cpu_instructions_retired - first < budget) {
+        cpu_cycle_block(budget - (cpu_instructions_retired - first));
+    }
+    result->halted = (get_cpu_state() != CPU_RUNNING);
+    result->exit_code = result->halted ? get_cpu_exit_status() : 0;
+    result->ac = word_to_int(cpu_registers.AC);
+    result->scalar = 1;
+    result->retired = (unsigned long long)lanes.retired[l] + (cpu_instructions_retired - first);
+    set_cpu_state(CPU_HALTED);
+}
+
+/*
+ * Función auxiliar: run_group (ESTÁTICA)
+ * Parámetros:
+ *   backend - implementación del paso
+ *   base    - primera instancia del grupo
+ *   count   - instancias del grupo (1..LOCKSTEP_LANES)
+ *   results - resultados de todas las instancias
+ *   stats   - resumen (acumula)
+ * Propósito: Ejecutar un grupo hasta que todos sus carriles terminen o
+ *            pasen al intérprete normal, y terminar luego estos últimos.
+ */
+static void run_group(const LaneBackend* backend, int base, int count,
+                      LockstepResult* results, LockstepStats* stats) {
+    unsigned int running = (1u << count) - 1;
+    unsigned int spilled = 0;
+    int divergent = 0;      // Pasos seguidos con el grupo dividido
+    int steps = 0;
+
+    for (int a = 0; a < region_limit; a++) {
+        for (int l = 0; l < LOCKSTEP_LANES; l++) lane_memory[a][l] = image[a];
+    }
+    if (sweep_address >= 0) {
+        for (int l = 0; l < count; l++) lane_memory[sweep_address][l] = sweep_first + (base + l) * sweep_step;
+    }
+    for (int l = 0; l < LOCKSTEP_LANES; l++) {
+        lanes.ac[l] = start_ac;
+        lanes.pc[l] = start_pc;
+        lanes.cc[l] = start_cc;
+        lanes.retired[l] = 0;
+    }
+    if (start_ac == LANE_INVALID) {  // AC sin un número: todo al intérprete normal
+        spilled = running;
+        running = 0;
+    }
+
+    while (running) {
+        int pc;
+        unsigned int mask = backend->select(running, &pc);
+        if (mask == running) {
+            divergent = 0;
+        } else if (++divergent >= LOCKSTEP_DIVERGENCE_LIMIT) {
+            spilled |= running & ~mask;   // Los que esperan no van a reunirse
+            running = mask;
+            divergent = 0;
+        } else if (divergent % LOCKSTEP_STARVATION_STEPS == 0) {
+            mask = backend->select(running & ~mask, &pc);  // Turno de los que esperan
+        }
+
+        const LaneOp* op = (pc < region_limit && pc <= LAST_PC) ? &code[pc] : &scalar_op;
+        if (op->kind != LOP_SCALAR) {
+            // Carriles que escribieron sobre esta instrucción: ya no es la decodificada
+            unsigned int same = backend->match(lane_memory[pc], image[pc], mask);
+            spilled |= mask & ~same;
+            running &= ~(mask & ~same);
+            mask = same;
+        }
+        if (op->kind == LOP_SCALAR) {
+            spilled |= mask;
+            running &= ~mask;
+            continue;
+        }
+        if (mask == 0) continue;
+
+        steps++;
+        if (op->kind == LOP_HALT) {
+            for (int l = 0; l < count; l++) {
+                if (!((mask >> l) & 1)) continue;
+                LockstepResult* result = &results[base + l];
+                result->halted = 1;
+                result->exit_code = (op->mode == ADDR_INDEXED) ? lanes.ac[l] + op->value : op->value;
+                result->ac = lanes.ac[l];
+                result->scalar = 0;
+                result->retired = (unsigned long long)lanes.retired[l] + 1;
+            }
+            running &= ~mask;
+            stats->lane_instructions += (unsigned long long)__builtin_popcount(mask);
+            continue;
+        }
+        unsigned int faulted = backend->execute(op, mask);
+        spilled |= faulted;
+        running &= ~faulted;
+        stats->lane_instructions += (unsigned long long)__builtin_popcount(mask & ~faulted);
+
+        if (steps >= lane_limit) {  // Ningún carril ejecutó más instrucciones que pasos
+            for (int l = 0; l < count; l++) {
+                if (!((running >> l) & 1) || lanes.retired[l] < lane_limit) continue;
+                LockstepResult* result = &results[base + l];
+                result->halted = 0;
+                result->exit_code = 0;
+                result->ac = lanes.ac[l];
+                result->scalar = 0;
+                result->retired = (unsigned long long)lanes.retired[l];
+                running &= ~(1u << l);
+            }
+        }
+    }
+    stats->steps += (unsigned long long)steps;
+
+    for (int l = 0; l < count; l++) {
+        if (!((spilled >> l) & 1)) continue;
+        run_scalar(l, &results[base + l]);
+        stats->scalar_instances++;
+        stats->scalar_instructions += results[base + l].retired - (unsigned long long)lanes.retired[l];
+    }
+}
+
+/*
+ * Función: lockstep_run
+ * Propósito: Ver lockstep.h.
+ */
+int lockstep_run(int start_address, int instances, int address, int first, int step,
+                 unsigned long long limit, LockstepResult* results, LockstepStats* stats) {
+    int rb = word_to_int(cpu_registers.RB);
+    int rl = word_to_int(cpu_registers.RL);
+    if (rl <= 0 || rb < 0 || rb + rl > MEMORY_SIZE) {
+        printf("Error: lockstep necesita un programa cargado en una región RB/RL\n");
+        return -1;
+    }
+    if (instances < 1 || instances > LOCKSTEP_MAX_INSTANCES) {
+        printf("Error: instancias fuera de rango (1-%d)\n", LOCKSTEP_MAX_INSTANCES);
+        return -1;
+    }
+    if (address >= rl) {
+        printf("Error: la dirección %d está fuera del programa (0-%d)\n", address, rl - 1);
+        return -1;
+    }
+    long long last = (long long)first + (long long)(instances - 1) * step;
+    if (address >= 0 && (first < -WORD_MAX || first > WORD_MAX || last < -WORD_MAX || last > WORD_MAX)) {
+        printf("Error: los valores del barrido no caben en una palabra\n");
+        return -1;
+    }
+
+    const LaneBackend* backend = &backends[select_backend()];
+    CPU_State saved_state = get_cpu_state();
+    memcpy(saved_memory, memory, sizeof(saved_memory));
+    saved_registers = cpu_registers;
+
+    region_base = rb;
+    region_limit = rl;
+    codec_words_to_ints(&memory[rb], image, rl);
+    for (int a = 0; a < rl; a++) image[a] = canonical_value(&memory[rb + a], image[a]);
+    for (int pc = 0; pc < rl && pc <= LAST_PC; pc++) code[pc] = decode_lane_op(&memory[rb + pc]);
+    codec_words_to_ints(&cpu_registers.AC, &start_ac, 1);
+    start_ac = canonical_value(&cpu_registers.AC, start_ac);
+    start_pc = start_address;
+    start_cc = cpu_registers.PSW.condition_code;
+    sweep_address = address;
+    sweep_first = first;
+    sweep_step = step;
+    lane_limit = (limit == 0 || limit > 0x7FFFFFFF) ? 0x7FFFFFFF : (int)limit;
+
+    memset(stats, 0, sizeof(*stats));
+    for (int base = 0; base < instances; base += LOCKSTEP_LANES) {
+        int count = instances - base;
+        if (count > LOCKSTEP_LANES) count = LOCKSTEP_LANES;
+        run_group(backend, base, count, results, stats);
+    }
+
+    // La máquina queda como tras la carga
+    restore_memory(saved_memory);
+    cpu_registers = saved_registers;
+    set_cpu_state(saved_state);
+    log_event(LOG_INFO, "Lockstep (%s): %d instancias, %llu pasos, %d al intérprete normal",
+              backend->name, instances, stats->steps, stats->scalar_instances);
+    return 0;
+}
+
+/*
+ * Función: lockstep_backend
+ */
+const char* lockstep_backend() {
+    return backends[select_backend()].name;
+}
+
+/*
+ * Función: lockstep_set_backend
+ */
+int lockstep_set_backend(const char* name) {
+    select_backend();  // Detectar antes de validar
+    if (strcmp(name, "auto") == 0) {
+        forced = -1;
+        return 0;
+    }
+    for (int b = 0; b < (int)(sizeof(backends) / sizeof(backends[0])); b++) {
+        if (strcmp(name, backends[b].name) == 0 && b <= detected) {
+            forced = b;
+            return 0;
+        }
+    }
+    return -1;
+}
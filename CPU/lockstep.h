@@ -0,0 +1,110 @@
+/*
+ * Archivo de cabecera del intérprete en lockstep del Sistema Operativo Virtual.
+ * Ejecuta muchas instancias del mismo programa con datos distintos (barridos
+ * de parámetros) en grupos de LOCKSTEP_LANES carriles que avanzan juntos:
+ * cada paso decodifica una sola instrucción y la aplica a todos los carriles
+ * del grupo que están en ese PC.
+ *
+ * Los registros de los carriles se guardan por campo (todos los AC juntos,
+ * todos los PC juntos, ...) y la memoria de cada instancia es una columna
+ * de una matriz [palabra][carril], así que una palabra de las 16 instancias
+ * es un solo vector. Con AVX-512 un grupo es un registro de 16 enteros; con
+ * AVX2, dos de 8; sin SIMD, un bucle escalar. Se elige en tiempo de
+ * ejecución como en el códec de palabras y los tres dan el mismo resultado.
+ *
+ * Cuando los carriles de un grupo divergen (un salto tomado solo por
+ * algunos) se ejecuta con máscara el grupo con el PC más bajo; los demás
+ * esperan, y si esperan demasiado reciben un turno. Un carril pasa al
+ * intérprete normal (el de siempre, con caché de bloques y JIT) y termina
+ * ahí si:
+ *   - la instrucción no es LOAD, STR, SUM, RES, MULT, DIVI, CMP, TST, MOV,
+ *     saltos, J, NOP o HALT en modo directo, inmediato o indexado,
+ *   - el acceso sale de la región RB/RL, el operando no es un número o el
+ *     resultado no cabe en una palabra (el intérprete reproduce el error),
+ *   - escribió sobre el código que iba a ejecutar, o
+ *   - su grupo siguió dividido LOCKSTEP_DIVERGENCE_LIMIT pasos seguidos.
+ * Así cualquier programa da, instancia por instancia, el mismo AC, código de
+ * salida e instrucciones ejecutadas que con 'run'.
+ */
+
+#ifndef LOCKSTEP_H
+#define LOCKSTEP_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+/*
+ * CONSTANTES DEL INTÉRPRETE EN LOCKSTEP
+ * LOCKSTEP_LANES             - Instancias por grupo (un vector AVX-512 de enteros)
+ * LOCKSTEP_MAX_INSTANCES     - Instancias por ejecución como máximo
+ * LOCKSTEP_STARVATION_STEPS  - Pasos con el grupo dividido antes de darle un
+ *                              turno a los carriles que esperan
+ * LOCKSTEP_DIVERGENCE_LIMIT  - Pasos seguidos con el grupo dividido antes de
+ *                              pasar al intérprete normal a los que esperan
+ * LOCKSTEP_DEFAULT_LIMIT     - Tope de instrucciones por instancia
+ */
+#define LOCKSTEP_LANES 16
+#define LOCKSTEP_MAX_INSTANCES 4096
+#define LOCKSTEP_STARVATION_STEPS 16
+#define LOCKSTEP_DIVERGENCE_LIMIT 4096
+#define LOCKSTEP_DEFAULT_LIMIT 10000000ULL
+
+/*
+ * Estructura: LockstepResult
+ * Propósito: Estado final de una instancia.
+ */
+typedef struct {
+    int halted;                   // 1 si terminó con HALT, 0 si llegó al tope
+    int exit_code;                // Operando efectivo del HALT
+    int ac;                       // AC final
+    int scalar;                   // 1 si terminó en el intérprete normal
+    unsigned long long retired;   // Instrucciones ejecutadas
+} LockstepResult;
+
+/*
+ * Estructura: LockstepStats
+ * Propósito: Resumen de una ejecución.
+ */
+typedef struct {
+    unsigned long long steps;                 // Instrucciones decodificadas (una por grupo y paso)
+    unsigned long long lane_instructions;     // Instrucciones ejecutadas en los carriles
+    unsigned long long scalar_instructions;   // Instrucciones ejecutadas en el intérprete normal
+    int scalar_instances;                     // Instancias que terminaron en el intérprete normal
+} LockstepStats;
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del intérprete en lockstep
+ */
+
+/*
+ * Función: lockstep_run
+ * Parámetros:
+ *   start_address - PC inicial (el que retornó load_program_file)
+ *   instances     - cantidad de instancias (1..LOCKSTEP_MAX_INSTANCES)
+ *   address       - palabra lógica que cambia en cada instancia (-1 = ninguna)
+ *   first, step   - la instancia i la empieza valiendo first + i * step
+ *   limit         - tope de instrucciones por instancia
+ *   results       - salida: un resultado por instancia
+ *   stats         - salida: resumen
+ * Retorna: int - 0, o -1 si no hay un programa cargado o los parámetros son inválidos
+ * Propósito: Ejecutar el programa cargado en memoria una vez por instancia.
+ *            Al terminar, la memoria y los registros quedan como tras la carga.
+ */
+int lockstep_run(int start_address, int instances, int address, int first, int step,
+                 unsigned long long limit, LockstepResult* results, LockstepStats* stats);
+
+/*
+ * Función: lockstep_backend
+ * Retorna: const char* - implementación en uso: "avx512", "avx2" o "escalar"
+ */
+const char* lockstep_backend();
+
+/*
+ * Función: lockstep_set_backend
+ * Parámetros: name - "auto", "avx512", "avx2" o "escalar"
+ * Retorna: int - 0, o -1 si el procesador del host no la soporta
+ */
+int lockstep_set_backend(const char* name);
+
+#endif /* LOCKSTEP_H */
@@ -0,0 +1,640 @@
+/*
+ * Archivo de implementación del servidor GDB (gdbstub) del Sistema Operativo Virtual.
+ * Contiene el socket de escucha, la lectura y escritura de paquetes RSP
+ * (con checksum y acuses '+'/'-') y los manejadores de cada paquete.
+ */
+
+/* Macro necesaria para sockets y poll() con -std=c99 */
+#define _POSIX_C_SOURCE 200809L
+
+/* Inclusión de cabecera propia del módulo */
+#include "gdbstub.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../CPU/cpu.h"             // Para cpu_cycle y el estado de la CPU
+#include "../MEMORY/memory.h"       // Para leer y escribir la memoria sin efectos
+#include "../REGISTERS/registers.h" // Para cpu_registers y las conversiones de Word
+#include "../LOGGER/logger.h"       // Para registrar la sesión
+#include "../CPU/blockcache.h"      // Para descartar bloques tras escribir memoria
+#include "../CODEC/wordcodec.h"     // Para convertir bloques de palabras en 'm'
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>        // Para printf, snprintf, sscanf
+#include <stdlib.h>       // Para strtoul, atoi
+#include <string.h>       // Para strncmp, strlen, memset
+#include <ctype.h>        // Para isdigit
+#include <errno.h>        // Para errno
+#include <unistd.h>       // Para close, unlink
+#include <poll.h>         // Para poll (Ctrl-C durante 'continue')
+#include <sys/socket.h>   // Para socket, bind, listen, accept
+#include <sys/un.h>       // Para sockets Unix
+#include <netinet/in.h>   // Para sockaddr_in
+#include <netinet/tcp.h>  // Para TCP_NODELAY
+#include <arpa/inet.h>    // Para htonl, htons
+
+/*
+ * VARIABLE GLOBAL - Bandera consultada por el módulo de memoria
+ */
+int gdb_watch_enabled = 0;
+
+/*
+ * MARCAS DE LOS MAPAS DE PUNTOS DE RUPTURA Y WATCHPOINTS (por palabra lógica)
+ */
+#define BP_SOFTWARE 1     // Z0
+#define BP_HARDWARE 2     // Z1
+#define WATCH_WRITE 1     // Z2 (y Z4)
+#define WATCH_READ 2      // Z3 (y Z4)
+
+/*
+ * Registros expuestos a GDB (orden del paquete 'g')
+ */
+#define GDB_REGISTERS 10
+#define GDB_REG_PC 8
+#define GDB_REG_PSW 9
+
+/*
+ * Descripción de registros enviada con qXfer:features:read
+ */
+static const char target_xml[] =
+    "<?xml version=\"1.0\"?>"
+    "<!DOCTYPE target SYSTEM \"gdb-target.dtd\">"
+    "<target version=\"1.0\"><feature name=\"org.sistema.cpu\">"
+    "<reg name=\"ac\" bitsize=\"32\" type=\"int32\" regnum=\"0\"/>"
+    "<reg name=\"mar\" bitsize=\"32\" type=\"int32\"/>"
+    "<reg name=\"mdr\" bitsize=\"32\" type=\"int32\"/>"
+    "<reg name=\"ir\" bitsize=\"32\" type=\"int32\"/>"
+    "<reg name=\"rb\" bitsize=\"32\" type=\"int32\"/>"
+    "<reg name=\"rl\" bitsize=\"32\" type=\"int32\"/>"
+    "<reg name=\"rx\" bitsize=\"32\" type=\"int32\"/>"
+    "<reg name=\"sp\" bitsize=\"32\" type=\"data_ptr\"/>"
+    "<reg name=\"pc\" bitsize=\"32\" type=\"code_ptr\"/>"
+    "<reg name=\"psw\" bitsize=\"32\" type=\"uint32\"/>"
+    "</feature></target>";
+
+/*
+ * VARIABLES GLOBALES ESTÁTICAS
+ * Solo accesibles dentro de este archivo (encapsulación)
+ */
+static int client = -1;                          // Socket de la sesión (-1 = sin conexión)
+static int no_ack = 0;                           // 1 tras QStartNoAckMode
+static unsigned char breakpoints[MEMORY_SIZE];   // BP_* por dirección lógica
+static unsigned char watchpoints[MEMORY_SIZE];   // WATCH_* por dirección lógica
+static int watch_count = 0;                      // Palabras con algún watchpoint
+static int watch_hit = -1;                       // Dirección del último acceso vigilado
+static int watch_hit_write = 0;                  // 1 si ese acceso fue una escritura
+static int fetch_address = -1;                   // Lectura del FETCH (no dispara watchpoints)
+static char rx_buffer[GDB_PACKET_SIZE];          // Bytes recibidos aún sin procesar
+static int rx_length = 0, rx_pos = 0;
+
+/*
+ * Función auxiliar: read_byte (ESTÁTICA)
+ * Retorna: int - siguiente byte del socket, o -1 si la conexión se cerró
+ */
+static int read_byte() {
+    if (rx_pos == rx_length) {
+        ssize_t n = recv(client, rx_buffer, sizeof(rx_buffer), 0);
+        if (n <= 0) return -1;
+        rx_length = (int)n;
+        rx_pos = 0;
+    }
+    return (unsigned char)rx_buffer[rx_pos++];
+}
+
+/*
+ * Función auxiliar: send_all (ESTÁTICA)
+ */
+static void send_all(const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t n = send(client, data, length, 0);
+        if (n <= 0) return;
+        data += n;
+        length -= (size_t)n;
+    }
+}
+
+static int hex_value(int c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/*
+ * Función auxiliar: get_packet (ESTÁTICA)
+ * Parámetros: packet - buffer de salida (GDB_PACKET_SIZE bytes)
+ * Retorna: int - longitud del paquete, o -1 si la conexión se cerró
+ * Propósito: Leer "$datos#cs", verificar el checksum y enviar el acuse.
+ *            Los Ctrl-C (0x03) fuera de un paquete se ignoran: la CPU ya está detenida.
+ */
+static int get_packet(char* packet) {
+    for (;;) {
+        int c;
+        do {
+            c = read_byte();
+            if (c < 0) return -1;
+        } while (c != '$');
+
+        int length = 0;
+        unsigned char sum = 0;
+        while ((c = read_byte()) >= 0 && c != '#') {
+            if (length < GDB_PACKET_SIZE - 1) packet[length++] = (char)c;
+            sum += (unsigned char)c;
+        }
+        int high = read_byte(), low = read_byte();
+        if (c < 0 || high < 0 || low < 0) return -1;
+        packet[length] = '\0';
+
+        if (no_ack) return length;
+        if (hex_value(high) * 16 + hex_value(low) == sum) {
+            send_all("+", 1);
+            return length;
+        }
+        send_all("-", 1);  // Checksum incorrecto: GDB retransmite
+    }
+}
+
+/*
+ * Función auxiliar: put_packet (ESTÁTICA)
+ * Propósito: Enviar "$datos#cs" y, salvo en modo sin acuses, esperar el '+'
+ *            (reenviando ante un '-').
+ */
+static void put_packet(const char* data) {
+    static char frame[GDB_PACKET_SIZE + 4];
+    size_t length = strlen(data);
+    unsigned char sum = 0;
+    for (size_t i = 0; i < length; i++) sum += (unsigned char)data[i];
+    int size = snprintf(frame, sizeof(frame), "$%s#%02x", data, sum);
+
+    for (int attempt = 0; attempt < 3; attempt++) {
+        send_all(frame, (size_t)size);
+        if (no_ack) return;
+        int c;
+        do { c = read_byte(); } while (c >= 0 && c != '+' && c != '-');
+        if (c != '-') return;
+    }
+}
+
+/*
+ * Función auxiliar: interrupt_requested (ESTÁTICA)
+ * Retorna: int - 1 si llegó un Ctrl-C (o se cerró la conexión) sin bloquear
+ */
+static int interrupt_requested() {
+    if (rx_pos == rx_length) {
+        struct pollfd pfd = { client, POLLIN, 0 };
+        if (poll(&pfd, 1, 0) <= 0) return 0;
+    }
+    int c = read_byte();
+    return c < 0 || c == 0x03;
+}
+
+/*
+ * Función auxiliar: translate (ESTÁTICA)
+ * Retorna: int - dirección física de una dirección lógica, o -1 si está fuera
+ *          de [RB, RB+RL). Igual que el módulo de memoria pero sin registrar
+ *          errores ni disparar interrupciones: GDB explora direcciones libremente.
+ */
+static int translate(int logical) {
+    int rb = word_to_int(cpu_registers.RB);
+    int rl = word_to_int(cpu_registers.RL);
+    int physical = (rb == 0 && rl == 0) ? logical : logical + rb;
+    if (logical < 0 || (rl != 0 && logical >= rl) || physical >= MEMORY_SIZE) return -1;
+    return physical;
+}
+
+/*
+ * Función auxiliar: word_value (ESTÁTICA)
+ * Retorna: int - valor de una palabra de memoria (0 si no contiene 8 dígitos,
+ *          como las marcas del área del SO)
+ */
+static int word_value(const Word* w) {
+    for (int i = 0; i < 8; i++) {
+        if (!isdigit((unsigned char)w->data[i])) return 0;
+    }
+    return w->data[8] == '\0' ? word_to_int(*w) : 0;
+}
+
+/*
+ * Funciones auxiliares: word_register / register_value / set_register (ESTÁTICAS)
+ * Propósito: Traducir entre el número de registro de GDB y CPU_Registers.
+ */
+static Word* word_register(int n) {
+    Word* regs[] = { &cpu_registers.AC, &cpu_registers.MAR, &cpu_registers.MDR,
+                     &cpu_registers.IR, &cpu_registers.RB, &cpu_registers.RL,
+                     &cpu_registers.RX, &cpu_registers.SP };
+    return (n >= 0 && n < GDB_REG_PC) ? regs[n] : NULL;
+}
+
+static int register_value(int n) {
+    if (n == GDB_REG_PC) return cpu_registers.PSW.PC_psw * GDB_WORD_BYTES;
+    if (n == GDB_REG_PSW) return word_to_int(psw_to_word(cpu_registers.PSW));
+    return word_value(word_register(n));
+}
+
+static int set_register(int n, int value) {
+    if (n == GDB_REG_PC) {
+        set_PC_int(value / GDB_WORD_BYTES);
+    } else if (n == GDB_REG_PSW) {
+        cpu_registers.PSW = word_to_psw(int_to_word(value));
+    } else if (n >= 0 && n < GDB_REG_PC && value >= -9999999 && value <= 9999999) {
+        *word_register(n) = int_to_word(value);
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Funciones auxiliares: put_hex32 / get_hex32 (ESTÁTICAS)
+ * Propósito: Codificar un entero como 4 bytes little-endian en hexadecimal.
+ */
+static char* put_hex32(char* out, int value) {
+    unsigned int v = (unsigned int)value;
+    for (int b = 0; b < 4; b++) out += sprintf(out, "%02x", (v >> (8 * b)) & 0xFF);
+    return out;
+}
+
+static int get_hex32(const char* in, int* value) {
+    unsigned int v = 0;
+    for (int b = 0; b < 4; b++) {
+        int high = hex_value(in[2 * b]), low = hex_value(in[2 * b + 1]);
+        if (high < 0 || low < 0) return -1;
+        v |= (unsigned int)(high * 16 + low) << (8 * b);
+    }
+    *value = (int)v;
+    return 0;
+}
+
+/*
+ * Función auxiliar: read_memory_packet (ESTÁTICA)
+ * Propósito: 'm addr,len' - bytes de las palabras lógicas que cubren el rango.
+ */
+static void read_memory_packet(const char* args, char* reply) {
+    unsigned long addr, length;
+    if (sscanf(args, "%lx,%lx", &addr, &length) != 2 || length * 2 >= GDB_PACKET_SIZE) {
+        strcpy(reply, "E01");
+        return;
+    }
+    // Las palabras accesibles del rango son contiguas en memoria física:
+    // se convierten todas de una vez con el códec en bloque
+    int first = (int)(addr / GDB_WORD_BYTES);
+    int physical = translate(first);
+    int count = 0;
+    while (count < GDB_PACKET_SIZE / GDB_WORD_BYTES &&
+           (unsigned long)(first + count) * GDB_WORD_BYTES < addr + length &&
+           translate(first + count) >= 0) {
+        count++;
+    }
+    int values[GDB_PACKET_SIZE / GDB_WORD_BYTES];
+    if (count > 0) codec_words_to_ints(&memory[physical], values, count);
+
+    char* out = reply;
+    for (unsigned long i = 0; i < length; i++) {
+        int index = (int)((addr + i) / GDB_WORD_BYTES) - first;
+        if (index >= count) break;
+        unsigned int v = (unsigned int)values[index];
+        out += sprintf(out, "%02x", (v >> (8 * ((addr + i) % GDB_WORD_BYTES))) & 0xFF);
+    }
+    if (out == reply) strcpy(reply, "E14");  // EFAULT: ni un byte accesible
+}
+
+/*
+ * Función auxiliar: write_memory_packet (ESTÁTICA)
+ * Propósito: 'M addr,len:XX...' - lectura-modificación-escritura por palabra,
+ *            rechazando valores que no caben en 7 dígitos más signo.
+ */
+static void write_memory_packet(const char* args, char* reply) {
+    unsigned long addr, length;
+    const char* data = strchr(args, ':');
+    if (sscanf(args, "%lx,%lx", &addr, &length) != 2 || data == NULL ||
+        strlen(data + 1) < length * 2) {
+        strcpy(reply, "E01");
+        return;
+    }
+    data++;
+    for (unsigned long i = 0; i < length; ) {
+        int logical = (int)((addr + i) / GDB_WORD_BYTES);
+        int physical = translate(logical);
+        if (physical < 0) {
+            strcpy(reply, "E14");
+            return;
+        }
+        unsigned int v = (unsigned int)word_value(&memory[physical]);
+        for (; i < length && (addr + i) / GDB_WORD_BYTES == (unsigned long)logical; i++) {
+            int shift = 8 * ((addr + i) % GDB_WORD_BYTES);
+            int byte = hex_value(data[2 * i]) * 16 + hex_value(data[2 * i + 1]);
+            v = (v & ~(0xFFu << shift)) | ((unsigned int)byte << shift);
+        }
+        int value = (int)v;
+        if (value < -9999999 || value > 9999999) {
+            strcpy(reply, "E22");  // EINVAL: no cabe en una palabra
+            return;
+        }
+        memory[physical] = int_to_word(value);
+    }
+    blockcache_flush();  // Escritura directa: puede haber modificado código traducido
+    strcpy(reply, "OK");
+}
+
+/*
+ * Función auxiliar: breakpoint_packet (ESTÁTICA)
+ * Parámetros: insert - 1 para 'Z', 0 para 'z'
+ * Propósito: 'Z/z tipo,addr,kind'. Tipos 0-1 marcan la dirección de la
+ *            instrucción; 2-4 vigilan las palabras de [addr, addr+kind).
+ */
+static void breakpoint_packet(const char* args, int insert, char* reply) {
+    int type;
+    unsigned long addr, kind;
+    if (sscanf(args, "%d,%lx,%lx", &type, &addr, &kind) != 3 || type < 0 || type > 4) {
+        strcpy(reply, "");  // Tipo no soportado
+        return;
+    }
+    unsigned long first = addr / GDB_WORD_BYTES;
+    unsigned long last = (type <= 1 || kind == 0) ? first : (addr + kind - 1) / GDB_WORD_BYTES;
+    if (last >= MEMORY_SIZE) {
+        strcpy(reply, "E22");
+        return;
+    }
+
+    for (unsigned long a = first; a <= last; a++) {
+        if (type <= 1) {
+            unsigned char bit = (type == 0) ? BP_SOFTWARE : BP_HARDWARE;
+            breakpoints[a] = insert ? (breakpoints[a] | bit) : (breakpoints[a] & ~bit);
+        } else {
+            unsigned char bits = (type == 2) ? WATCH_WRITE : (type == 3) ? WATCH_READ
+                                                          : (WATCH_WRITE | WATCH_READ);
+            int before = watchpoints[a] != 0;
+            watchpoints[a] = insert ? (watchpoints[a] | bits) : (watchpoints[a] & ~bits);
+            watch_count += (watchpoints[a] != 0) - before;
+        }
+    }
+    gdb_watch_enabled = watch_count > 0;
+    strcpy(reply, "OK");
+}
+
+/*
+ * Función: gdb_on_memory_access
+ * Parámetros:
+ *   logical_address - dirección accedida por la CPU o el DMA
+ *   is_write        - 1 escritura, 0 lectura
+ * Propósito: Anotar el acceso si hay un watchpoint; resume() detiene la
+ *            ejecución al terminar la instrucción. La lectura del FETCH de la
+ *            instrucción en curso no cuenta como acceso a datos.
+ */
+void gdb_on_memory_access(int logical_address, int is_write) {
+    if (logical_address < 0 || logical_address >= MEMORY_SIZE) return;
+    if (!is_write && logical_address == fetch_address) {
+        fetch_address = -1;
+        return;
+    }
+    if (watchpoints[logical_address] & (is_write ? WATCH_WRITE : WATCH_READ)) {
+        watch_hit = logical_address;
+        watch_hit_write = is_write;
+    }
+}
+
+/*
+ * Función auxiliar: stop_reply (ESTÁTICA)
+ * Propósito: Respuesta de parada: 'W' si el programa terminó (HALT), o
+ *            'T05' con el motivo (swbreak, hwbreak, watch/rwatch/awatch).
+ */
+static void stop_reply(char* reply, int signal) {
+    if (get_cpu_state() != CPU_RUNNING) {
+        sprintf(reply, "W%02x", get_cpu_exit_status() & 0xFF);
+        return;
+    }
+    int pc = cpu_registers.PSW.PC_psw;
+    if (watch_hit >= 0) {
+        const char* kind = watch_hit_write ? "watch"
+                         : (watchpoints[watch_hit] & WATCH_WRITE) ? "awatch" : "rwatch";
+        sprintf(reply, "T%02x%s:%x;", signal, kind, watch_hit * GDB_WORD_BYTES);
+    } else if (signal == 5 && (breakpoints[pc] & BP_SOFTWARE)) {
+        sprintf(reply, "T%02xswbreak:;", signal);
+    } else if (signal == 5 && (breakpoints[pc] & BP_HARDWARE)) {
+        sprintf(reply, "T%02xhwbreak:;", signal);
+    } else {
+        sprintf(reply, "S%02x", signal);
+    }
+}
+
+/*
+ * Función auxiliar: resume (ESTÁTICA)
+ * Parámetros: single_step - 1 para 's', 0 para 'c'
+ * Propósito: Ejecutar ciclos de CPU hasta un punto de ruptura, un watchpoint,
+ *            el fin del programa, Ctrl-C o (en 's') una instrucción. Los
+ *            puntos de ruptura se comprueban aquí y no en execute_program(),
+ *            así que la ejecución normal no paga nada por ellos.
+ */
+static void resume(int single_step, char* reply) {
+    unsigned long executed = 0;
+    watch_hit = -1;
+    while (get_cpu_state() == CPU_RUNNING) {
+        fetch_address = cpu_registers.PSW.PC_psw;
+        cpu_cycle();
+        fetch_address = -1;
+        if (single_step || watch_hit >= 0 || breakpoints[cpu_registers.PSW.PC_psw]) break;
+        if (++executed % GDB_POLL_INTERVAL == 0 && interrupt_requested()) {
+            stop_reply(reply, 2);  // SIGINT
+            return;
+        }
+    }
+    stop_reply(reply, 5);  // SIGTRAP
+}
+
+/*
+ * Función auxiliar: handle_query (ESTÁTICA)
+ * Propósito: Paquetes 'q'/'Q' generales. Los no soportados responden vacío.
+ */
+static void handle_query(const char* packet, char* reply) {
+    unsigned long offset, length;
+    if (strncmp(packet, "qSupported", 10) == 0) {
+        sprintf(reply, "PacketSize=%x;qXfer:features:read+;QStartNoAckMode+;swbreak+;hwbreak+",
+                GDB_PACKET_SIZE);
+    } else if (strcmp(packet, "QStartNoAckMode") == 0) {
+        put_packet("OK");   // El acuse de este paquete todavía se espera
+        no_ack = 1;
+        reply[0] = '\0';
+        return;
+    } else if (sscanf(packet, "qXfer:features:read:target.xml:%lx,%lx", &offset, &length) == 2) {
+        size_t total = strlen(target_xml);
+        if (offset >= total) {
+            strcpy(reply, "l");
+        } else {
+            if (length > GDB_PACKET_SIZE - 8) length = GDB_PACKET_SIZE - 8;
+            size_t n = (total - offset < length) ? total - offset : length;
+            reply[0] = (offset + n < total) ? 'm' : 'l';
+            memcpy(reply + 1, target_xml + offset, n);
+            reply[n + 1] = '\0';
+        }
+    } else if (strcmp(packet, "qAttached") == 0) {
+        strcpy(reply, "1");
+    } else if (strcmp(packet, "qC") == 0) {
+        strcpy(reply, "QC1");
+    } else if (strcmp(packet, "qfThreadInfo") == 0) {
+        strcpy(reply, "m1");
+    } else if (strcmp(packet, "qsThreadInfo") == 0) {
+        strcpy(reply, "l");
+    } else if (strncmp(packet, "qSymbol", 7) == 0) {
+        strcpy(reply, "OK");
+    } else {
+        reply[0] = '\0';
+    }
+    put_packet(reply);
+}
+
+/*
+ * Función auxiliar: handle_packet (ESTÁTICA)
+ * Retorna: int - 0 para seguir atendiendo, 1 si la sesión terminó ('D' o 'k')
+ */
+static int handle_packet(const char* packet, char* reply) {
+    int n, value;
+    char* out;
+    reply[0] = '\0';
+
+    switch (packet[0]) {
+        case '?':
+            stop_reply(reply, 5);
+            break;
+        case 'g':
+            out = reply;
+            for (int r = 0; r < GDB_REGISTERS; r++) out = put_hex32(out, register_value(r));
+            break;
+        case 'G':
+            strcpy(reply, "OK");
+            for (int r = 0; r < GDB_REGISTERS; r++) {
+                if (get_hex32(packet + 1 + 8 * r, &value) != 0 || set_register(r, value) != 0) {
+                    strcpy(reply, "E01");
+                    break;
+                }
+            }
+            break;
+        case 'p':
+            n = (int)strtoul(packet + 1, NULL, 16);
+            if (n < GDB_REGISTERS) put_hex32(reply, register_value(n));
+            else strcpy(reply, "E01");
+            break;
+        case 'P': {
+            const char* eq = strchr(packet, '=');
+            n = (int)strtoul(packet + 1, NULL, 16);
+            if (eq && get_hex32(eq + 1, &value) == 0 && set_register(n, value) == 0) strcpy(reply, "OK");
+            else strcpy(reply, "E01");
+            break;
+        }
+        case 'm':
+            read_memory_packet(packet + 1, reply);
+            break;
+        case 'M':
+            write_memory_packet(packet + 1, reply);
+            break;
+        case 'c':
+        case 's':
+            if (packet[1] != '\0') set_PC_int((int)(strtoul(packet + 1, NULL, 16) / GDB_WORD_BYTES));
+            resume(packet[0] == 's', reply);
+            break;
+        case 'Z':
+        case 'z':
+            breakpoint_packet(packet + 1, packet[0] == 'Z', reply);
+            break;
+        case 'H':
+        case 'T':
+            strcpy(reply, "OK");   // Un solo hilo
+            break;
+        case 'q':
+        case 'Q':
+            handle_query(packet, reply);
+            return 0;
+        case 'D':
+            put_packet("OK");
+            return 1;
+        case 'k':
+            return 1;
+        default:
+            break;                 // Paquete no soportado: respuesta vacía
+    }
+    put_packet(reply);
+    return 0;
+}
+
+/*
+ * Función auxiliar: open_listener (ESTÁTICA)
+ * Parámetros: endpoint - puerto TCP o ruta de socket Unix (NULL = puerto por defecto)
+ * Retorna: int - socket de escucha, o -1 si hay error
+ */
+static int open_listener(const char* endpoint) {
+    int tcp = (endpoint == NULL || isdigit((unsigned char)endpoint[0]));
+    int fd = socket(tcp ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    int ok;
+    if (tcp) {
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);  // Solo conexiones locales
+        addr.sin_port = htons(endpoint ? atoi(endpoint) : GDB_DEFAULT_PORT);
+        ok = bind(fd, (struct sockaddr*)&addr, sizeof(addr));
+    } else {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, endpoint, sizeof(addr.sun_path) - 1);
+        unlink(endpoint);  // Socket de una sesión anterior
+        ok = bind(fd, (struct sockaddr*)&addr, sizeof(addr));
+    }
+    if (ok != 0 || listen(fd, 1) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*
+ * Función: gdb_serve
+ * Propósito: Ver gdbstub.h. Al terminar se eliminan los puntos de ruptura y
+ *            watchpoints; la CPU queda en el estado en que la dejó GDB.
+ */
+int gdb_serve(const char* endpoint) {
+    int listener = open_listener(endpoint);
+    if (listener < 0) {
+        log_event(LOG_ERROR, "GDB: no se pudo escuchar en %s (%s)",
+                  endpoint ? endpoint : "el puerto por defecto", strerror(errno));
+        return -1;
+    }
+    if (endpoint == NULL || isdigit((unsigned char)endpoint[0])) {
+        printf("Esperando a GDB en 127.0.0.1:%d (target remote :%d)...\n",
+               endpoint ? atoi(endpoint) : GDB_DEFAULT_PORT, endpoint ? atoi(endpoint) : GDB_DEFAULT_PORT);
+    } else {
+        printf("Esperando a GDB en el socket %s (target remote %s)...\n", endpoint, endpoint);
+    }
+    fflush(stdout);
+
+    client = accept(listener, NULL, NULL);
+    close(listener);
+    if (client < 0) {
+        if (endpoint && !isdigit((unsigned char)endpoint[0])) unlink(endpoint);
+        return -1;
+    }
+    int nodelay = 1;
+    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));  // Falla sin efecto en Unix
+    log_event(LOG_INFO, "GDB conectado");
+
+    no_ack = 0;
+    rx_length = rx_pos = 0;
+    static char packet[GDB_PACKET_SIZE];
+    static char reply[GDB_PACKET_SIZE];
+    while (get_packet(packet) >= 0) {
+        if (handle_packet(packet, reply)) break;
+    }
+
+    close(client);
+    client = -1;
+    if (endpoint && !isdigit((unsigned char)endpoint[0])) unlink(endpoint);
+    memset(breakpoints, 0, sizeof(breakpoints));
+    memset(watchpoints, 0, sizeof(watchpoints));
+    watch_count = 0;
+    gdb_watch_enabled = 0;
+    log_event(LOG_INFO, "GDB desconectado");
+    printf("Sesión GDB finalizada.\n");
+    return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * Archivo de cabecera del servidor GDB (gdbstub) del Sistema Operativo Virtual.
+ * Implementa el protocolo remoto serie de GDB (RSP) sobre un socket local TCP
+ * o Unix, para depurar programas largos desde herramientas estándar (gdb,
+ * scripts) en lugar de los comandos 'step'/'continue' de la consola.
+ *
+ * Convenciones del protocolo en este sistema:
+ *   - La memoria se expone con direcciones en bytes: la palabra lógica N ocupa
+ *     los bytes 4N..4N+3 y su valor (signo-magnitud) se envía como entero de
+ *     32 bits little-endian.
+ *   - Registros (orden del paquete 'g'): AC, MAR, MDR, IR, RB, RL, RX, SP, PC,
+ *     PSW. El PC se reporta en bytes (PC_psw * 4) para que coincida con las
+ *     direcciones de memoria; el PSW con el formato de psw_to_word().
+ *   - Z0/Z1: puntos de ruptura software/hardware; Z2/Z3/Z4: watchpoints de
+ *     escritura/lectura/acceso sobre palabras de memoria.
+ */
+
+#ifndef GDBSTUB_H
+#define GDBSTUB_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+/*
+ * CONSTANTES DE CONFIGURACIÓN DEL SERVIDOR
+ * GDB_DEFAULT_PORT    - Puerto TCP (en 127.0.0.1) si no se indica otro
+ * GDB_PACKET_SIZE     - Tamaño máximo de un paquete (anunciado en qSupported)
+ * GDB_POLL_INTERVAL   - Instrucciones entre consultas de Ctrl-C durante 'continue'
+ * GDB_WORD_BYTES      - Bytes por palabra en las direcciones de GDB
+ */
+#define GDB_DEFAULT_PORT 1234
+#define GDB_PACKET_SIZE 4096
+#define GDB_POLL_INTERVAL 1024
+#define GDB_WORD_BYTES 4
+
+/*
+ * DECLARACIÓN DE VARIABLE GLOBAL EXTERNA
+ * gdb_watch_enabled - 1 mientras haya watchpoints; el módulo de memoria solo
+ *                     llama a gdb_on_memory_access() si está activa, así que
+ *                     sin depurador conectado el costo es una comparación
+ */
+extern int gdb_watch_enabled;
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del servidor GDB
+ */
+
+/*
+ * Función: gdb_serve
+ * Parámetros: endpoint - NULL o un número de puerto TCP, o la ruta de un socket Unix
+ * Retorna: int - 0 al terminar la sesión, -1 si no se pudo abrir el socket
+ * Propósito: Esperar una conexión y atender paquetes hasta que GDB se
+ *            desconecte ('D', 'k' o cierre del socket). La CPU solo avanza
+ *            cuando GDB lo pide ('s' / 'c').
+ */
+int gdb_serve(const char* endpoint);
+
+/* Gancho del módulo de memoria (llamar solo si gdb_watch_enabled) */
+void gdb_on_memory_access(int logical_address, int is_write);
+
+#endif /* GDBSTUB_H */
@@ -0,0 +1,207 @@
+/*
+ * Archivo de implementación de la caché de buffers del disco del Sistema Operativo Virtual.
+ * Cada ranura guarda un bloque completo; un índice directo bloque -> ranura
+ * da la búsqueda en O(1) y el reemplazo elige la ranura usada hace más tiempo.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "bcache.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../LOGGER/logger.h"     // Para registrar errores
+#include "../METRICS/metrics.h"   // Para aciertos/fallos de la caché de disco
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf
+#include <string.h>   // Para memcpy, strncpy
+
+/*
+ * Estructura: CacheSlot
+ * Propósito: Un bloque en memoria del host.
+ */
+typedef struct {
+    int block;                           // Bloque guardado, o -1 si la ranura está libre
+    int dirty;                           // 1 si hay cambios que no llegaron al disco
+    unsigned long last_use;              // Para el reemplazo LRU
+    Word words[BCACHE_BLOCK_SECTORS];
+} CacheSlot;
+
+/*
+ * VARIABLES GLOBALES DEL MÓDULO (privadas)
+ * slot_of - Ranura de cada bloque, o -1 si no está en la caché
+ */
+static CacheSlot slots[BCACHE_SLOTS];
+static int slot_of[BCACHE_TOTAL_BLOCKS];
+static unsigned long use_clock = 0;
+static unsigned long writebacks = 0;
+
+/*
+ * Función auxiliar: sector_of (ESTÁTICA)
+ * Parámetros: lba - sector lineal; track, cylinder, sector - salida
+ */
+static void sector_of(int lba, int* track, int* cylinder, int* sector) {
+    *sector = lba % SECTORS_PER_CYLINDER;
+    *cylinder = (lba / SECTORS_PER_CYLINDER) % CYLINDERS;
+    *track = lba / (SECTORS_PER_CYLINDER * CYLINDERS);
+}
+
+/*
+ * Función auxiliar: fill_slot (ESTÁTICA)
+ * Propósito: Leer del disco las palabras del bloque de la ranura.
+ */
+static void fill_slot(CacheSlot* slot) {
+    int first = slot->block * BCACHE_BLOCK_SECTORS;
+    char buffer[SECTOR_SIZE + 1];
+    for (int i = 0; i < BCACHE_BLOCK_SECTORS; i++) {
+        int track, cylinder, sector;
+        sector_of(first + i, &track, &cylinder, &sector);
+        read_sector(track, cylinder, sector, buffer);
+        strncpy(slot->words[i].data, buffer, SECTOR_SIZE - 1);
+        slot->words[i].data[SECTOR_SIZE - 1] = '\0';
+    }
+}
+
+/*
+ * Función auxiliar: flush_slot (ESTÁTICA)
+ * Propósito: Escribir en el disco el bloque de la ranura si tiene cambios.
+ */
+static void flush_slot(CacheSlot* slot) {
+    if (slot->block < 0 || !slot->dirty) return;
+    int first = slot->block * BCACHE_BLOCK_SECTORS;
+    for (int i = 0; i < BCACHE_BLOCK_SECTORS; i++) {
+        int track, cylinder, sector;
+        sector_of(first + i, &track, &cylinder, &sector);
+        write_sector(track, cylinder, sector, slot->words[i].data);
+    }
+    slot->dirty = 0;
+    writebacks++;
+}
+
+/*
+ * Función auxiliar: get_slot (ESTÁTICA)
+ * Parámetros: block - bloque válido
+ * Retorna: CacheSlot* - ranura con el bloque (leído del disco si hizo falta)
+ */
+static CacheSlot* get_slot(int block) {
+    int index = slot_of[block];
+    if (index >= 0) {
+        CacheSlot* slot = &slots[index];
+        METRIC_INC(cache_hits[METRICS_CACHE_DISK]);
+        slot->last_use = ++use_clock;
+        return slot;
+    }
+
+    METRIC_INC(cache_misses[METRICS_CACHE_DISK]);
+    CacheSlot* victim = &slots[0];
+    for (int i = 0; i < BCACHE_SLOTS; i++) {
+        if (slots[i].block < 0) { victim = &slots[i]; break; }
+        if (slots[i].last_use < victim->last_use) victim = &slots[i];
+    }
+    if (victim->block >= 0) {
+        flush_slot(victim);
+        slot_of[victim->block] = -1;
+    }
+    victim->block = block;
+    victim->dirty = 0;
+    victim->last_use = ++use_clock;
+    slot_of[block] = (int)(victim - slots);
+    fill_slot(victim);
+    return victim;
+}
+
+/*
+ * Función auxiliar: valid_range (ESTÁTICA)
+ */
+static int valid_range(int block, int offset, int count) {
+    if (block < 0 || block >= BCACHE_TOTAL_BLOCKS || offset < 0 || count < 0 ||
+        offset + count > BCACHE_BLOCK_SECTORS) {
+        log_event(LOG_ERROR, "Caché de disco: acceso inválido bloque=%d palabras %d..%d",
+                  block, offset, offset + count - 1);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Función: init_bcache
+ */
+void init_bcache() {
+    for (int i = 0; i < BCACHE_SLOTS; i++) {
+        slots[i].block = -1;
+        slots[i].dirty = 0;
+        slots[i].last_use = 0;
+    }
+    for (int b = 0; b < BCACHE_TOTAL_BLOCKS; b++) slot_of[b] = -1;
+}
+
+/*
+ * Función: bcache_read
+ */
+int bcache_read(int block, int offset, Word* words, int count) {
+    if (!valid_range(block, offset, count)) return -1;
+    CacheSlot* slot = get_slot(block);
+    memcpy(words, &slot->words[offset], (size_t)count * sizeof(Word));
+    return 0;
+}
+
+/*
+ * Función: bcache_write
+ */
+int bcache_write(int block, int offset, const Word* words, int count) {
+    if (!valid_range(block, offset, count)) return -1;
+    CacheSlot* slot = get_slot(block);
+    memcpy(&slot->words[offset], words, (size_t)count * sizeof(Word));
+    slot->dirty = 1;
+    return 0;
+}
+
+/*
+ * Función: bcache_sync
+ * Propósito: Escribir los bloques modificados en orden de bloque, para que
+ *            los bloques consecutivos se escriban sin búsquedas entre ellos.
+ */
+void bcache_sync() {
+    CacheSlot* dirty[BCACHE_SLOTS];
+    int count = 0;
+    for (int i = 0; i < BCACHE_SLOTS; i++) {
+        if (slots[i].block < 0 || !slots[i].dirty) continue;
+        int k = count++;
+        while (k > 0 && dirty[k - 1]->block > slots[i].block) {
+            dirty[k] = dirty[k - 1];
+            k--;
+        }
+        dirty[k] = &slots[i];
+    }
+    for (int i = 0; i < count; i++) flush_slot(dirty[i]);
+}
+
+/*
+ * Función: bcache_invalidate
+ * Propósito: Descartar todos los bloques, incluso los modificados: el disco
+ *            cambió por completo y su contenido manda.
+ */
+void bcache_invalidate() {
+    init_bcache();
+}
+
+/*
+ * Función: bcache_status
+ */
+void bcache_status() {
+    int used = 0, dirty = 0;
+    for (int i = 0; i < BCACHE_SLOTS; i++) {
+        if (slots[i].block < 0) continue;
+        used++;
+        dirty += slots[i].dirty;
+    }
+    unsigned long long hits = metrics.cache_hits[METRICS_CACHE_DISK];
+    unsigned long long misses = metrics.cache_misses[METRICS_CACHE_DISK];
+
+    printf("Caché de buffers:     %d de %d bloques de %d sectores (%d modificados)\n",
+           used, BCACHE_SLOTS, BCACHE_BLOCK_SECTORS, dirty);
+    printf("Escrituras al disco:  %lu bloques\n", writebacks);
+    if (hits + misses > 0) {
+        printf("Aciertos:             %llu de %llu (%.1f%%)\n", hits, hits + misses,
+               100.0 * hits / (hits + misses));
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * Archivo de cabecera de la caché de buffers del disco del Sistema Operativo Virtual.
+ * Guarda en memoria del host bloques de BCACHE_BLOCK_SECTORS sectores
+ * consecutivos (numeración lineal: pista, cilindro, sector) para que el
+ * sistema de archivos no pase por read_sector/write_sector en cada acceso.
+ *
+ * Las escrituras quedan en la caché (write-back) hasta bcache_sync(); el
+ * sistema de archivos sincroniza al terminar cada operación. Quien cambie
+ * el disco sin pasar por la caché (format_disk, disk_load) debe llamar a
+ * bcache_invalidate().
+ */
+
+#ifndef BCACHE_H
+#define BCACHE_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../types.h"  // Para el tipo Word
+#include "disk.h"      // Para la geometría del disco
+
+/*
+ * CONSTANTES DE CONFIGURACIÓN DE LA CACHÉ
+ * BCACHE_BLOCK_SECTORS - Sectores (palabras) por bloque
+ * BCACHE_TOTAL_BLOCKS  - Bloques del disco completo
+ * BCACHE_SLOTS         - Bloques que caben en la caché
+ */
+#define BCACHE_BLOCK_SECTORS 20
+#define BCACHE_TOTAL_BLOCKS (TRACKS * CYLINDERS * SECTORS_PER_CYLINDER / BCACHE_BLOCK_SECTORS)
+#define BCACHE_SLOTS 32
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública de la caché de buffers
+ */
+void init_bcache();                    // Vaciar la caché (sin escribir nada)
+
+/*
+ * Función: bcache_read
+ * Parámetros:
+ *   block  - número de bloque (0 a BCACHE_TOTAL_BLOCKS-1)
+ *   offset - primera palabra dentro del bloque
+ *   words  - salida
+ *   count  - cantidad de palabras (offset + count <= BCACHE_BLOCK_SECTORS)
+ * Retorna: int - 0, o -1 si el rango es inválido
+ */
+int bcache_read(int block, int offset, Word* words, int count);
+
+/*
+ * Función: bcache_write
+ * Parámetros: como bcache_read, con las palabras a escribir
+ * Retorna: int - 0, o -1 si el rango es inválido
+ * Propósito: Modificar el bloque en la caché; llega al disco en bcache_sync().
+ */
+int bcache_write(int block, int offset, const Word* words, int count);
+
+void bcache_sync();                    // Escribir al disco los bloques modificados
+void bcache_invalidate();              // Descartar todo (tras formatear o cargar el disco)
+void bcache_status();                  // Mostrar aciertos, fallos y ocupación
+
+#endif /* BCACHE_H */
@@ -9,10 +9,13 @@
 
 /* Inclusión de cabeceras de otros módulos */
 #include "../LOGGER/logger.h"  // Para registro de eventos del sistema
+#include "../METRICS/metrics.h" // Para contar operaciones de disco
+#include "../PROFILER/trace.h"  // Para la pista del cabezal en la traza
 
 /* Inclusión de bibliotecas estándar */
 #include <string.h>   // Para funciones de manipulación de cadenas (strcpy, strlen)
 #include <stdlib.h>   // Para funciones generales
+#include <stdio.h>    // Para printf y los archivos de imagen del disco
 
 /*
  * VARIABLE GLOBAL - Instancia del disco duro
@@ -65,6 +68,29 @@ void init_disk() {
               TRACKS, CYLINDERS, SECTORS_PER_CYLINDER);
 }
 
+/*
+ * Función auxiliar: move_head (ESTÁTICA)
+ * Parámetros: track, cylinder, sector - sector al que se accede
+ * Propósito: Posicionar el cabezal sobre el sector accedido y, si hay una
+ *            traza activa, registrar la nueva posición (sector lineal).
+ *
+ * Modelo de búsqueda: leer o escribir el sector lineal siguiente al último
+ * accedido es una transferencia secuencial (también al pasar de un cilindro
+ * al siguiente); cualquier otro acceso cuenta como una búsqueda.
+ */
+static void move_head(int track, int cylinder, int sector) {
+    int linear = (track * CYLINDERS + cylinder) * SECTORS_PER_CYLINDER + sector;
+    int current = (hard_disk.current_track * CYLINDERS + hard_disk.current_cylinder) *
+                  SECTORS_PER_CYLINDER + hard_disk.current_sector;
+    if (linear != current + 1) METRIC_INC(disk_seeks);
+    hard_disk.current_track = track;
+    hard_disk.current_cylinder = cylinder;
+    hard_disk.current_sector = sector;
+    if (trace_enabled) {
+        trace_counter(TRACE_TRACK_DISK, "posición del cabezal", linear);
+    }
+}
+
 /*
  * Función: read_sector
  * Parámetros:
@@ -103,7 +129,11 @@ void read_sector(int track, int cylinder, int sector, char* buffer) {
      * Copia el contenido del sector solicitado desde el disco al buffer proporcionado.
      * strcpy copia la cadena completa incluyendo el terminador nulo.
      */
+    unsigned long long trace_ts = trace_enabled ? trace_now() : 0;
+    move_head(track, cylinder, sector);
     strcpy(buffer, hard_disk.data[track][cylinder][sector]);
+    METRIC_INC(disk_reads);
+    if (trace_enabled) trace_complete(TRACE_TRACK_DISK, "lectura", trace_ts, track, cylinder, sector);
     
     /*
      * REGISTRO DE OPERACIÓN
@@ -164,7 +194,11 @@ void write_sector(int track, int cylinder, int sector, const char* data) {
      * Copia los datos proporcionados al sector especificado del disco.
      * strcpy copia la cadena completa incluyendo el terminador nulo.
      */
+    unsigned long long trace_ts = trace_enabled ? trace_now() : 0;
+    move_head(track, cylinder, sector);
     strcpy(hard_disk.data[track][cylinder][sector], data);
+    METRIC_INC(disk_writes);
+    if (trace_enabled) trace_complete(TRACE_TRACK_DISK, "escritura", trace_ts, track, cylinder, sector);
     
     /*
      * REGISTRO DE OPERACIÓN
@@ -201,6 +235,8 @@ void disk_info() {
            hard_disk.current_track,
            hard_disk.current_cylinder,
            hard_disk.current_sector);
+    printf("Búsquedas: %llu (%llu lecturas, %llu escrituras)\n",
+           metrics.disk_seeks, metrics.disk_reads, metrics.disk_writes);
 }
 
 /*
@@ -228,4 +264,66 @@ void format_disk() {
     
     // Registrar evento de formateo
     log_event(LOG_INFO, "Disco formateado");
-}
\ No newline at end of file
+}
+/*
+ * Función: disk_save
+ * Parámetros: filename - archivo de imagen a crear
+ * Retorna: int - 0, o -1 si no se pudo escribir
+ * Propósito: Guardar todos los sectores en un archivo del host (cabecera
+ *            DISK_IMAGE_MAGIC y 8 caracteres por sector, en orden de pista,
+ *            cilindro y sector) para conservar el disco entre sesiones.
+ */
+int disk_save(const char* filename) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        printf("Error: no se pudo crear '%s'\n", filename);
+        return -1;
+    }
+    int ok = fwrite(DISK_IMAGE_MAGIC, 1, 8, file) == 8;
+    for (int t = 0; ok && t < TRACKS; t++) {
+        for (int c = 0; ok && c < CYLINDERS; c++) {
+            for (int s = 0; ok && s < SECTORS_PER_CYLINDER; s++) {
+                ok = fwrite(hard_disk.data[t][c][s], 1, SECTOR_SIZE - 1, file) == SECTOR_SIZE - 1;
+            }
+        }
+    }
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) {
+        printf("Error: no se pudo escribir '%s'\n", filename);
+        return -1;
+    }
+    log_event(LOG_INFO, "Disco guardado en %s", filename);
+    return 0;
+}
+
+/*
+ * Función: disk_load
+ * Parámetros: filename - imagen creada por disk_save
+ * Retorna: int - 0, o -1 si el archivo no es una imagen válida (el disco no cambia)
+ */
+int disk_load(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        printf("Error: no se pudo abrir '%s'\n", filename);
+        return -1;
+    }
+    static char image[TRACKS][CYLINDERS][SECTORS_PER_CYLINDER][SECTOR_SIZE - 1];
+    char magic[8];
+    int ok = fread(magic, 1, 8, file) == 8 && memcmp(magic, DISK_IMAGE_MAGIC, 8) == 0 &&
+             fread(image, 1, sizeof(image), file) == sizeof(image);
+    fclose(file);
+    if (!ok) {
+        printf("Error: '%s' no es una imagen de disco\n", filename);
+        return -1;
+    }
+    for (int t = 0; t < TRACKS; t++) {
+        for (int c = 0; c < CYLINDERS; c++) {
+            for (int s = 0; s < SECTORS_PER_CYLINDER; s++) {
+                memcpy(hard_disk.data[t][c][s], image[t][c][s], SECTOR_SIZE - 1);
+                hard_disk.data[t][c][s][SECTOR_SIZE - 1] = '\0';
+            }
+        }
+    }
+    log_event(LOG_INFO, "Disco cargado desde %s", filename);
+    return 0;
+}
@@ -26,6 +26,7 @@
 #define CYLINDERS 10                // 10 cilindros
 #define SECTORS_PER_CYLINDER 100    // 100 sectores por cilindro
 #define SECTOR_SIZE 9               // 8 dígitos de datos + 1 para null terminator
+#define DISK_IMAGE_MAGIC "SOVDSK01" // Cabecera de las imágenes de disk_save
 
 /*
  * Estructura: HardDisk
@@ -105,6 +106,15 @@ void disk_info();
  */
 void format_disk();
 
+/*
+ * Función: disk_save / disk_load
+ * Parámetros: filename - imagen del disco en el host
+ * Retorna: int - 0, o -1 si hay error (disk_load no cambia el disco)
+ * Propósito: Conservar el contenido del disco entre sesiones.
+ */
+int disk_save(const char* filename);
+int disk_load(const char* filename);
+
 /*
  * DECLARACIÓN DE VARIABLE GLOBAL EXTERNA
  * Permite que otros módulos accedan al objeto del disco.
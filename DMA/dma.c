@@ -1,7 +1,9 @@
 /*
  * Archivo de implementación del módulo DMA del Sistema Operativo Virtual.
  * Contiene la lógica para realizar transferencias de datos entre memoria y disco
- * sin intervención de la CPU, utilizando hilos para operaciones asíncronas.
+ * sin intervención de la CPU. La transferencia es un evento del reloj virtual
+ * (SIM/sim.h): se agenda al iniciarla y se completa en el ciclo en que
+ * terminaría (posicionar el cabezal y mover cada palabra).
  */
 
 /* Inclusión de cabecera propia del módulo */
@@ -12,25 +14,16 @@
 #include "../DISK/disk.h"         // Para operaciones de disco
 #include "../INTERRUPTS/interrupts.h" // Para disparar interrupciones
 #include "../LOGGER/logger.h"     // Para registro de eventos
+#include "../METRICS/metrics.h"   // Para contar bytes y transferencias
+#include "../PROFILER/trace.h"    // Para la pista del DMA en la traza
+#include "../MMIO/mmio.h"         // Para registrar el canal mapeado en memoria
+#include "../SIM/sim.h"           // Para agendar el fin de la transferencia
 #include "../types.h"            // Para tipos globales
 
 /* Inclusión de bibliotecas estándar */
 #include <stdio.h>    // Para printf y snprintf
 #include <stdlib.h>   // Para funciones generales
 #include <string.h>   // Para manipulación de cadenas
-#include <unistd.h>   // Para usleep() en sistemas Unix
-
-/*
- * MACROS PARA COMPATIBILIDAD MULTIPLATAFORMA
- * Define macros para manejar diferencias entre Windows y sistemas Unix-like
- * para la función de pausa/sleep durante las transferencias.
- */
-#ifdef _WIN32
-    #include <windows.h>          // API de Windows para Sleep()
-    #define DMA_SLEEP(ms) Sleep(ms)  // Dormir en milisegundos (Windows)
-#else
-    #define DMA_SLEEP(ms) usleep(ms * 1000)  // Dormir en microsegundos (Unix)
-#endif
 
 /*
  * VARIABLE GLOBAL - Controlador DMA
@@ -38,6 +31,8 @@
  */
 DMA_Controller dma;  // Instancia global del controlador DMA
 
+static unsigned long long transfer_trace_ts;  // Inicio de la transferencia en curso (traza)
+
 /*
  * Función auxiliar: dma_disk_read
  * Parámetros:
@@ -94,10 +89,10 @@ static void dma_disk_write(int track, int cylinder, int sector, const char* data
 }
 
 /*
- * Función: transfer_thread (función auxiliar estática)
- * Parámetros: arg - argumentos del hilo (no utilizado)
- * Retorna: void* - siempre NULL
- * Propósito: Ejecutar la transferencia DMA en un hilo separado.
+ * Función: complete_transfer (función auxiliar estática)
+ * Parámetros: arg - argumento del evento (no utilizado)
+ * Propósito: Evento de fin de la transferencia DMA, en el ciclo del reloj
+ *            virtual en que termina.
  * 
  * Esta función implementa la lógica principal de transferencia:
  * 1. Solicita el bus del sistema
@@ -105,7 +100,9 @@ static void dma_disk_write(int track, int cylinder, int sector, const char* data
  * 3. Libera el bus
  * 4. Dispara interrupción de finalización
  */
-static void* transfer_thread(void* arg) {
+static void complete_transfer(int arg) {
+    (void)arg;
+    
     // PASO 1: Solicitar acceso exclusivo al bus del sistema
     dma_bus_request();  // Bloquea hasta obtener el bus
     
@@ -175,9 +172,7 @@ static void* transfer_thread(void* arg) {
             }
         }
         
-        // Pequeña pausa para simular tiempo real de transferencia
-        // En un sistema real, esto sería el tiempo de acceso a disco/memoria
-        DMA_SLEEP(1);  // 1ms por byte/sector transferido
+        METRIC_ADD(dma_bytes, SECTOR_SIZE - 1);  // Una palabra de 8 dígitos
     }
     
     // Verificar si la transferencia fue exitosa
@@ -185,6 +180,7 @@ static void* transfer_thread(void* arg) {
         // Transferencia exitosa
         dma.state = DMA_IDLE;  // Volver a estado inactivo
         dma.status = 0;        // Código de éxito
+        METRIC_INC(dma_transfers);
         log_event(LOG_INFO, "DMA: Transferencia completada exitosamente");
     } else {
         // Transferencia fallida
@@ -194,20 +190,58 @@ static void* transfer_thread(void* arg) {
     // PASO 3: Liberar el bus del sistema
     dma_bus_release();  // Libera el mutex
     
+    if (trace_enabled) {
+        trace_complete(TRACE_TRACK_DMA, dma.io_operation == 0 ? "lectura" : "escritura",
+                       transfer_trace_ts, dma.memory_address, dma.disk_sector, dma.bytes_to_transfer);
+    }
+    
     // PASO 4: Disparar interrupción para notificar a la CPU que la transferencia terminó
     trigger_interrupt(INT_IO_COMPLETION);
-    
-    return NULL;  // Valor de retorno del hilo (no utilizado)
 }
 
 /*
- * Función: init_dma
- * Propósito: Inicializar el controlador DMA con valores por defecto.
- * Configura todos los campos de la estructura DMA_Controller y
- * inicializa el mutex para control de acceso al bus.
+ * REGISTROS MAPEADOS EN MEMORIA (ESTÁTICOS, ver MMIO/mmio.h)
+ * Los mismos pasos que DMA_READ/DMA_WRITE/DMA_CONFIG/DMA_SIZE/DMA_WAIT/
+ * DMA_STATUS, pero con STORE/LOAD sobre el canal.
  */
-void init_dma() {
-    // Configurar valores por defecto
+static int mmio_read_register(int offset) {
+    switch (offset) {
+        case 0:  return dma.memory_address;
+        case 1:  return dma.disk_track * 10000 + dma.disk_cylinder * 100 + dma.disk_sector;
+        case 2:  return dma.bytes_to_transfer;
+        default: return dma_get_status();
+    }
+}
+
+static void mmio_write_register(int offset, int value) {
+    switch (offset) {
+        case 0:
+            dma_set_memory_address(value);
+            break;
+        case 1:
+            dma_set_disk_location(value / 10000, (value % 10000) / 100, value % 100);
+            break;
+        case 2:
+            dma_set_transfer_size(value);
+            break;
+        default:
+            if (value == 2) {
+                dma_wait_completion();
+            } else {
+                dma_set_io_operation(value);
+                if (value == 0 || value == 1) dma_start_transfer();
+            }
+            break;
+    }
+}
+
+/*
+ * Función: dma_reset
+ * Propósito: Dejar el controlador con los valores por defecto, sin tocar el
+ *            mutex del bus ni el registro MMIO (bench.exe --verify la usa
+ *            para que cada ejecución empiece con el cabezal en el mismo lugar).
+ */
+void dma_reset() {
     dma.memory_address = 0;        // Dirección de memoria inicial
     dma.disk_track = 0;            // Pista inicial
     dma.disk_cylinder = 0;         // Cilindro inicial
@@ -216,9 +250,21 @@ void init_dma() {
     dma.bytes_to_transfer = 1;     // Transferir 1 sector por defecto
     dma.state = DMA_IDLE;          // Estado inicial: inactivo
     dma.status = 0;                // Estado inicial: éxito
+    dma.head_cylinder = 0;         // Cabezal sobre el primer cilindro
+}
+
+/*
+ * Función: init_dma
+ * Propósito: Inicializar el controlador DMA con valores por defecto.
+ * Configura todos los campos de la estructura DMA_Controller y
+ * inicializa el mutex para control de acceso al bus.
+ */
+void init_dma() {
+    dma_reset();
     
     // Inicializar el mutex para control de acceso al bus
     pthread_mutex_init(&dma.bus_lock, NULL);
+    mmio_register("dma", MMIO_DMA_BASE, 4, mmio_read_register, mmio_write_register);
     
     // Registrar inicialización
     log_event(LOG_INFO, "DMA inicializado");
@@ -313,8 +359,9 @@ void dma_set_transfer_size(int size) {
 /*
  * Función: dma_start_transfer
  * Propósito: Iniciar una transferencia DMA de forma asíncrona.
- * Crea un hilo separado que ejecuta la transferencia mientras
- * la CPU puede continuar con otras tareas.
+ * Agenda su fin en el reloj virtual a DMA_SETUP_CYCLES, más DMA_SEEK_CYCLES
+ * por cilindro que se mueve el cabezal, más DMA_WORD_CYCLES por palabra;
+ * mientras tanto la CPU sigue ejecutando.
  */
 void dma_start_transfer() {
     // Verificar que el DMA no esté ya ocupado
@@ -331,29 +378,34 @@ void dma_start_transfer() {
         return;  // No iniciar transferencia con parámetros inválidos
     }
     
-    // Crear hilo para ejecutar la transferencia
-    if (pthread_create(&dma.thread, NULL, transfer_thread, NULL) != 0) {
-        log_event(LOG_ERROR, "DMA: No se pudo crear hilo de transferencia");
-        dma.status = 1;      // Establecer estado de error
-        dma.state = DMA_ERROR; // Cambiar a estado de error
-        return;  // Falló la creación del hilo
-    }
+    int seek = dma.disk_cylinder - dma.head_cylinder;
+    unsigned long long cycles = DMA_SETUP_CYCLES +
+                                (unsigned long long)(seek < 0 ? -seek : seek) * DMA_SEEK_CYCLES +
+                                (unsigned long long)dma.bytes_to_transfer * DMA_WORD_CYCLES;
     
     /*
-     * Desacoplar (detach) el hilo para que se limpie automáticamente
-     * cuando termine. Esto permite que la transferencia sea realmente asíncrona.
+     * Marcar el DMA como ocupado al agendar: quien consulte el estado justo
+     * después de esta llamada debe ver la transferencia en curso.
      */
-    pthread_detach(dma.thread);
+    dma.state = (dma.io_operation == 0) ? DMA_READING : DMA_WRITING;
+    if (sim_schedule(cycles, "dma", complete_transfer, 0) < 0) {
+        log_event(LOG_ERROR, "DMA: No se pudo agendar la transferencia");
+        dma.status = 1;      // Establecer estado de error
+        dma.state = DMA_ERROR; // Cambiar a estado de error
+        return;
+    }
+    dma.head_cylinder = dma.disk_cylinder;
+    transfer_trace_ts = trace_enabled ? trace_now() : 0;
     
     // Registrar inicio de transferencia
-    log_event(LOG_INFO, "DMA: Transferencia iniciada (asíncrono)");
+    log_event(LOG_INFO, "DMA: Transferencia iniciada (termina en %llu ciclos)", cycles);
 }
 
 /*
  * Función: dma_wait_completion
  * Propósito: Esperar a que termine la transferencia DMA actual.
- * Esta función bloquea hasta que el hilo de transferencia termine,
- * haciendo la operación síncrona.
+ * La CPU no tiene nada que hacer mientras tanto: el reloj virtual salta
+ * hasta el fin de la transferencia en lugar de dormir en el host.
  */
 void dma_wait_completion() {
     // Si el DMA está inactivo o en error, no hay nada que esperar
@@ -361,8 +413,10 @@ void dma_wait_completion() {
         return;
     }
     
-    // Esperar (bloquear) hasta que el hilo termine
-    pthread_join(dma.thread, NULL);
+    // Eventos anteriores (el reloj del sistema) se atienden en el camino
+    while (dma.state == DMA_READING || dma.state == DMA_WRITING) {
+        if (!sim_skip()) break;  // Sin eventos: la transferencia nunca se agendó
+    }
     
     // Registrar finalización de espera
     log_event(LOG_DEBUG, "DMA: Transferencia finalizada (síncrona)");
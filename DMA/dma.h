@@ -13,9 +13,19 @@
  * Garantiza que este archivo solo se incluya una vez durante la compilación.
  */
 
-#include <pthread.h>       // Para soporte de hilos (threads) y mutex
+#include <pthread.h>       // Para el mutex del bus
 #include "../types.h"      // Para tipos y constantes globales
 
+/*
+ * TIEMPOS DE UNA TRANSFERENCIA (ciclos del reloj virtual, ver SIM/sim.h)
+ * DMA_SETUP_CYCLES - Programar el canal y esperar el sector
+ * DMA_SEEK_CYCLES  - Por cada cilindro que se mueve el cabezal
+ * DMA_WORD_CYCLES  - Por cada palabra transferida
+ */
+#define DMA_SETUP_CYCLES 50
+#define DMA_SEEK_CYCLES 10
+#define DMA_WORD_CYCLES 20
+
 /*
  * Enum: DMA_State
  * Propósito: Define los posibles estados del controlador DMA durante una transferencia.
@@ -47,7 +57,7 @@ typedef enum {
  *   bytes_to_transfer - Cantidad de bytes (sectores) a transferir
  *   state             - Estado actual del DMA (DMA_State)
  *   status            - Estado de la última operación: 0 = éxito, 1 = error
- *   thread            - Identificador del hilo que ejecuta la transferencia
+ *   head_cylinder     - Cilindro donde quedó el cabezal (tiempo de posicionamiento)
  *   bus_lock          - Mutex para controlar acceso exclusivo al bus del sistema
  */
 typedef struct {
@@ -59,7 +69,7 @@ typedef struct {
     int bytes_to_transfer;   // Número de sectores/bytes a transferir
     DMA_State state;         // Estado actual del DMA (IDLE, READING, WRITING, ERROR)
     int status;              // Resultado: 0 = éxito, 1 = error
-    pthread_t thread;        // Hilo para ejecución asíncrona de transferencias
+    int head_cylinder;       // Cilindro actual del cabezal
     pthread_mutex_t bus_lock; // Mutex para acceso exclusivo al bus del sistema
 } DMA_Controller;
 
@@ -69,6 +79,7 @@ typedef struct {
 
 /* FUNCIONES DE INICIALIZACIÓN Y CONFIGURACIÓN */
 void init_dma();                           // Inicializar controlador DMA
+void dma_reset();                          // Volver a los valores iniciales (cabezal en el cilindro 0)
 void dma_set_memory_address(int address);  // Configurar dirección de memoria
 void dma_set_disk_location(int track, int cylinder, int sector);  // Configurar ubicación en disco
 void dma_set_io_operation(int operation);  // Configurar tipo de operación (lectura/escritura)
@@ -0,0 +1,987 @@
+/*
+ * Archivo de implementación del sistema de archivos del Sistema Operativo Virtual.
+ * Todo acceso al disco pasa por la caché de buffers; cada operación que
+ * modifica el disco termina con bcache_sync(), así que entre operaciones el
+ * disco está siempre actualizado (y el DMA puede leerlo directamente).
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "fs.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../MEMORY/memory.h"       // Para los búferes del invitado y MEMORY_SIZE
+#include "../SYSCALL/syscall.h"     // Para registrar los servicios SVC
+#include "../LOGGER/logger.h"       // Para registrar las operaciones
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf, snprintf
+#include <string.h>   // Para strlen, strchr, memcmp
+
+/*
+ * Estructura: Superblock
+ * Propósito: Copia en memoria del bloque 0 (una palabra por campo).
+ */
+typedef struct {
+    int magic;
+    int total_blocks;
+    int bitmap_start;
+    int inode_start;
+    int inodes;
+    int dir_start;
+    int dir_slots;
+    int data_start;
+    int free_blocks;
+    int files;
+} Superblock;
+
+#define SUPER_WORDS 10
+
+/*
+ * Estructura: Extent
+ * Propósito: Corrida de bloques consecutivos de un archivo.
+ */
+typedef struct {
+    int start;
+    int length;
+} Extent;
+
+/*
+ * Estructura: Inode
+ * Propósito: Inodo decodificado (FS_INODE_WORDS palabras en el disco más el
+ *            bloque de extensiones adicionales si lo tiene).
+ */
+typedef struct {
+    int type;                 // 0 = libre, 1 = archivo
+    int size;                 // Palabras
+    int count;                // Extensiones en uso
+    Extent extents[FS_MAX_EXTENTS];
+    int overflow;             // Bloque de extensiones adicionales (0 = no hay)
+} Inode;
+
+/*
+ * Estructura: OpenFile
+ * Propósito: Descriptor abierto por el invitado.
+ */
+typedef struct {
+    int used;
+    int inode;
+    int position;
+} OpenFile;
+
+/*
+ * VARIABLES GLOBALES DEL MÓDULO (privadas)
+ */
+static Superblock super;
+static int mounted = 0;
+static unsigned char block_used[FS_TOTAL_BLOCKS];  // Copia del mapa de bloques
+static OpenFile open_files[FS_MAX_OPEN];
+
+static const char name_alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789._-";
+
+/*
+ * FUNCIONES AUXILIARES DE CODIFICACIÓN (ESTÁTICAS)
+ * La metadata se guarda como números sin signo de 8 dígitos.
+ */
+static Word number_word(int value) {
+    Word w;
+    snprintf(w.data, sizeof(w.data), "%08d", value);
+    return w;
+}
+
+static int word_number(const Word* w) {
+    int value = 0;
+    for (int i = 0; i < 8; i++) {
+        if (w->data[i] < '0' || w->data[i] > '9') return 0;
+        value = value * 10 + (w->data[i] - '0');
+    }
+    return value;
+}
+
+static int read_number(int block, int offset) {
+    Word w;
+    if (bcache_read(block, offset, &w, 1) != 0) return 0;
+    return word_number(&w);
+}
+
+static void write_number(int block, int offset, int value) {
+    Word w = number_word(value);
+    bcache_write(block, offset, &w, 1);
+}
+
+/*
+ * Función auxiliar: write_super (ESTÁTICA)
+ */
+static void write_super() {
+    int fields[SUPER_WORDS] = {
+        super.magic, super.total_blocks, super.bitmap_start, super.inode_start, super.inodes,
+        super.dir_start, super.dir_slots, super.data_start, super.free_blocks, super.files
+    };
+    Word words[SUPER_WORDS];
+    for (int i = 0; i < SUPER_WORDS; i++) words[i] = number_word(fields[i]);
+    bcache_write(0, 0, words, SUPER_WORDS);
+}
+
+/*
+ * FUNCIONES AUXILIARES DEL MAPA DE BLOQUES (ESTÁTICAS)
+ * El bloque b es el dígito b % 8 de la palabra b / 8 del mapa. block_used
+ * es una copia en memoria del host (se carga al montar) para buscar
+ * corridas libres sin recorrer el disco; los cambios se escriben en ambos.
+ */
+static void set_used(int block, int used) {
+    if (block_used[block] == used) return;
+    block_used[block] = (unsigned char)used;
+    super.free_blocks += used ? -1 : 1;
+    int word = block / FS_BITS_PER_WORD;
+    Word w;
+    bcache_read(FS_BITMAP_START + word / FS_BLOCK_WORDS, word % FS_BLOCK_WORDS, &w, 1);
+    w.data[block % FS_BITS_PER_WORD] = used ? '1' : '0';
+    bcache_write(FS_BITMAP_START + word / FS_BLOCK_WORDS, word % FS_BLOCK_WORDS, &w, 1);
+}
+
+static void set_run(int start, int length, int used) {
+    for (int b = start; b < start + length; b++) set_used(b, used);
+}
+
+/*
+ * Función auxiliar: find_run (ESTÁTICA)
+ * Parámetros: need - bloques buscados; length - salida: largo de la corrida
+ * Retorna: int - inicio de la corrida libre más chica con al menos 'need'
+ *          bloques (best-fit) o, si no hay, de la más grande; -1 si no hay
+ *          bloques libres
+ */
+static int find_run(int need, int* length) {
+    int best = -1, best_length = 0;        // Menor corrida suficiente
+    int largest = -1, largest_length = 0;  // Mayor corrida
+    int b = FS_DATA_START;
+    while (b < FS_TOTAL_BLOCKS) {
+        if (block_used[b]) { b++; continue; }
+        int start = b;
+        while (b < FS_TOTAL_BLOCKS && !block_used[b]) b++;
+        int run = b - start;
+        if (run >= need && (best < 0 || run < best_length)) {
+            best = start;
+            best_length = run;
+        }
+        if (run > largest_length) {
+            largest = start;
+            largest_length = run;
+        }
+    }
+    if (best >= 0) {
+        *length = best_length;
+        return best;
+    }
+    *length = largest_length;
+    return largest;
+}
+
+/*
+ * FUNCIONES AUXILIARES DE INODOS (ESTÁTICAS)
+ */
+static Word extent_word(const Extent* extent) {
+    return number_word(extent->start * FS_EXTENT_SCALE + extent->length);
+}
+
+static void word_extent(const Word* w, Extent* extent) {
+    int value = word_number(w);
+    extent->start = value / FS_EXTENT_SCALE;
+    extent->length = value % FS_EXTENT_SCALE;
+}
+
+static void read_inode(int number, Inode* inode) {
+    Word words[FS_INODE_WORDS];
+    int word = number * FS_INODE_WORDS;
+    bcache_read(FS_INODE_START + word / FS_BLOCK_WORDS, word % FS_BLOCK_WORDS, words, FS_INODE_WORDS);
+    inode->type = word_number(&words[0]);
+    inode->size = word_number(&words[1]);
+    inode->overflow = word_number(&words[2 + FS_INODE_EXTENTS]);
+    for (int i = 0; i < FS_INODE_EXTENTS; i++) word_extent(&words[2 + i], &inode->extents[i]);
+    if (inode->overflow != 0) {
+        Word more[FS_BLOCK_WORDS];
+        bcache_read(inode->overflow, 0, more, FS_BLOCK_WORDS);
+        for (int i = 0; i < FS_BLOCK_WORDS; i++) {
+            word_extent(&more[i], &inode->extents[FS_INODE_EXTENTS + i]);
+        }
+    }
+    int limit = inode->overflow ? FS_MAX_EXTENTS : FS_INODE_EXTENTS;
+    inode->count = 0;
+    while (inode->count < limit && inode->extents[inode->count].length > 0) inode->count++;
+}
+
+/*
+ * Función auxiliar: write_inode (ESTÁTICA)
+ * Propósito: Guardar el inodo. El bloque de extensiones adicionales debe
+ *            estar asignado si count > FS_INODE_EXTENTS; si ya no hace
+ *            falta, se libera.
+ */
+static void write_inode(int number, Inode* inode) {
+    if (inode->count <= FS_INODE_EXTENTS && inode->overflow != 0) {
+        set_used(inode->overflow, 0);
+        inode->overflow = 0;
+    }
+    Extent none = {0, 0};
+    Word words[FS_INODE_WORDS];
+    int word = number * FS_INODE_WORDS;
+    words[0] = number_word(inode->type);
+    words[1] = number_word(inode->size);
+    for (int i = 0; i < FS_INODE_EXTENTS; i++) {
+        words[2 + i] = extent_word(i < inode->count ? &inode->extents[i] : &none);
+    }
+    words[2 + FS_INODE_EXTENTS] = number_word(inode->overflow);
+    bcache_write(FS_INODE_START + word / FS_BLOCK_WORDS, word % FS_BLOCK_WORDS, words, FS_INODE_WORDS);
+    if (inode->overflow != 0) {
+        Word more[FS_BLOCK_WORDS];
+        for (int i = 0; i < FS_BLOCK_WORDS; i++) {
+            int k = FS_INODE_EXTENTS + i;
+            more[i] = extent_word(k < inode->count ? &inode->extents[k] : &none);
+        }
+        bcache_write(inode->overflow, 0, more, FS_BLOCK_WORDS);
+    }
+}
+
+/*
+ * Función auxiliar: valid_file (ESTÁTICA)
+ * Retorna: int - 1 si el número es un inodo de archivo en uso
+ */
+static int valid_file(int number, Inode* inode) {
+    if (!mounted || number <= 0 || number >= FS_MAX_INODES) return 0;
+    read_inode(number, inode);
+    return inode->type == 1;
+}
+
+static int file_blocks(const Inode* inode) {
+    int blocks = 0;
+    for (int i = 0; i < inode->count; i++) blocks += inode->extents[i].length;
+    return blocks;
+}
+
+/*
+ * Función auxiliar: map_block (ESTÁTICA)
+ * Parámetros: index - bloque del archivo
+ * Retorna: int - bloque del disco, o 0 si el archivo no llega hasta ahí
+ */
+static int map_block(const Inode* inode, int index) {
+    for (int i = 0; i < inode->count; i++) {
+        if (index < inode->extents[i].length) return inode->extents[i].start + index;
+        index -= inode->extents[i].length;
+    }
+    return 0;
+}
+
+/*
+ * Función auxiliar: grow (ESTÁTICA)
+ * Parámetros: inode - se le agregan bloques (sin escribirlo); need - bloques
+ * Retorna: int - bloques agregados (menos que need si no hay espacio o se
+ *          llegó a FS_MAX_EXTENTS extensiones)
+ */
+static int grow(Inode* inode, int need) {
+    int added = 0;
+    if (inode->count > 0) {
+        // Extender la última extensión en el lugar
+        Extent* last = &inode->extents[inode->count - 1];
+        while (added < need && last->start + last->length < FS_TOTAL_BLOCKS &&
+               !block_used[last->start + last->length]) {
+            set_used(last->start + last->length, 1);
+            last->length++;
+            added++;
+        }
+    }
+    while (added < need && inode->count < FS_MAX_EXTENTS) {
+        int length;
+        if (inode->count == FS_INODE_EXTENTS && inode->overflow == 0) {
+            int block = find_run(1, &length);
+            if (block < 0) break;
+            set_used(block, 1);
+            inode->overflow = block;
+        }
+        int start = find_run(need - added, &length);
+        if (start < 0) break;
+        if (length > need - added) length = need - added;
+        set_run(start, length, 1);
+        inode->extents[inode->count].start = start;
+        inode->extents[inode->count].length = length;
+        inode->count++;
+        added += length;
+    }
+    return added;
+}
+
+/*
+ * FUNCIONES AUXILIARES DEL DIRECTORIO (ESTÁTICAS)
+ * Entrada: FS_NAME_WORDS palabras de nombre + número de inodo.
+ * Ranura vacía: nombre en ceros. Borrada: nombre presente e inodo 0 (el
+ * sondeo sigue de largo para no cortar las cadenas de otros nombres).
+ */
+static unsigned int name_hash(const Word* name) {
+    unsigned int hash = 2166136261u;  // FNV-1a
+    for (int i = 0; i < FS_NAME_WORDS; i++) {
+        for (int k = 0; k < 8; k++) {
+            hash ^= (unsigned char)name[i].data[k];
+            hash *= 16777619u;
+        }
+    }
+    return hash;
+}
+
+static void entry_location(int slot, int* block, int* offset) {
+    int word = slot * FS_DIR_ENTRY_WORDS;
+    *block = FS_DIR_START + word / FS_BLOCK_WORDS;
+    *offset = word % FS_BLOCK_WORDS;
+}
+
+/*
+ * Función auxiliar: dir_find (ESTÁTICA)
+ * Parámetros:
+ *   name      - nombre codificado
+ *   free_slot - salida opcional: primera ranura vacía o borrada (-1 si no hay)
+ * Retorna: int - ranura del nombre, o -1 si no está
+ */
+static int dir_find(const Word* name, int* free_slot) {
+    if (free_slot) *free_slot = -1;
+    int start = (int)(name_hash(name) % FS_DIR_SLOTS);
+    for (int k = 0; k < FS_DIR_SLOTS; k++) {
+        int slot = (start + k) % FS_DIR_SLOTS;
+        int block, offset;
+        Word entry[FS_DIR_ENTRY_WORDS];
+        entry_location(slot, &block, &offset);
+        bcache_read(block, offset, entry, FS_DIR_ENTRY_WORDS);
+
+        int empty = (word_number(&entry[0]) == 0);
+        int inode = word_number(&entry[FS_NAME_WORDS]);
+        if (empty || inode == 0) {
+            if (free_slot && *free_slot < 0) *free_slot = slot;
+            if (empty) return -1;  // Fin de la cadena de sondeo
+            continue;
+        }
+        if (memcmp(entry, name, FS_NAME_WORDS * sizeof(Word)) == 0) return slot;
+    }
+    return -1;
+}
+
+/*
+ * Función: fs_encode_name
+ * Retorna: int - 0, o FS_ERR_BAD_NAME
+ */
+int fs_encode_name(const char* name, Word* words) {
+    size_t length = strlen(name);
+    if (length == 0 || length > FS_NAME_MAX) return FS_ERR_BAD_NAME;
+    for (int i = 0; i < FS_NAME_WORDS; i++) {
+        int value = 0;
+        for (int k = 0; k < FS_NAME_CHARS_PER_WORD; k++) {
+            size_t at = (size_t)(i * FS_NAME_CHARS_PER_WORD + k);
+            int code = 0;
+            if (at < length) {
+                const char* found = strchr(name_alphabet, name[at]);
+                if (found == NULL || name[at] == '\0') return FS_ERR_BAD_NAME;
+                code = (int)(found - name_alphabet) + 1;
+            }
+            value = value * 100 + code;
+        }
+        words[i] = number_word(value);
+    }
+    return 0;
+}
+
+/*
+ * Función: fs_decode_name
+ * Retorna: int - 0, o FS_ERR_BAD_NAME si alguna palabra no es un nombre
+ */
+int fs_decode_name(const Word* words, char* name) {
+    int length = 0;
+    int ended = 0;
+    for (int i = 0; i < FS_NAME_WORDS; i++) {
+        int value = word_number(&words[i]);
+        if (value >= 1000000) return FS_ERR_BAD_NAME;
+        int codes[FS_NAME_CHARS_PER_WORD];
+        for (int k = FS_NAME_CHARS_PER_WORD - 1; k >= 0; k--) {
+            codes[k] = value % 100;
+            value /= 100;
+        }
+        for (int k = 0; k < FS_NAME_CHARS_PER_WORD; k++) {
+            if (codes[k] == 0) { ended = 1; continue; }
+            if (ended || codes[k] > (int)sizeof(name_alphabet) - 1) return FS_ERR_BAD_NAME;
+            name[length++] = name_alphabet[codes[k] - 1];
+        }
+    }
+    name[length] = '\0';
+    return length > 0 ? 0 : FS_ERR_BAD_NAME;
+}
+
+/*
+ * Función: fs_format
+ * Retorna: int - 0
+ * Propósito: Escribir superbloque, mapa, inodos y directorio vacíos. Los
+ *            bloques de datos no se tocan.
+ */
+int fs_format() {
+    bcache_invalidate();
+    Word zeros[FS_BLOCK_WORDS];
+    for (int i = 0; i < FS_BLOCK_WORDS; i++) zeros[i] = number_word(0);
+    for (int b = 0; b < FS_DATA_START; b++) bcache_write(b, 0, zeros, FS_BLOCK_WORDS);
+    memset(block_used, 0, sizeof(block_used));
+    super.free_blocks = FS_TOTAL_BLOCKS;
+    set_run(0, FS_DATA_START, 1);
+
+    super.magic = FS_MAGIC;
+    super.total_blocks = FS_TOTAL_BLOCKS;
+    super.bitmap_start = FS_BITMAP_START;
+    super.inode_start = FS_INODE_START;
+    super.inodes = FS_MAX_INODES;
+    super.dir_start = FS_DIR_START;
+    super.dir_slots = FS_DIR_SLOTS;
+    super.data_start = FS_DATA_START;
+    super.files = 0;
+    write_super();
+    bcache_sync();
+
+    mounted = 1;
+    for (int i = 0; i < FS_MAX_OPEN; i++) open_files[i].used = 0;
+    log_event(LOG_INFO, "Sistema de archivos formateado: %d bloques de datos libres", super.free_blocks);
+    return 0;
+}
+
+/*
+ * Función: fs_mount
+ * Retorna: int - 0, o FS_ERR_NOT_MOUNTED si el superbloque no corresponde
+ */
+int fs_mount() {
+    bcache_invalidate();
+    mounted = 0;
+    for (int i = 0; i < FS_MAX_OPEN; i++) open_files[i].used = 0;
+
+    Word words[SUPER_WORDS];
+    bcache_read(0, 0, words, SUPER_WORDS);
+    int fields[SUPER_WORDS];
+    for (int i = 0; i < SUPER_WORDS; i++) fields[i] = word_number(&words[i]);
+    if (fields[0] != FS_MAGIC || fields[1] != FS_TOTAL_BLOCKS || fields[3] != FS_INODE_START ||
+        fields[5] != FS_DIR_START || fields[7] != FS_DATA_START) {
+        return FS_ERR_NOT_MOUNTED;
+    }
+    super.magic = fields[0];
+    super.total_blocks = fields[1];
+    super.bitmap_start = fields[2];
+    super.inode_start = fields[3];
+    super.inodes = fields[4];
+    super.dir_start = fields[5];
+    super.dir_slots = fields[6];
+    super.data_start = fields[7];
+    super.free_blocks = fields[8];
+    super.files = fields[9];
+    for (int b = 0; b < FS_TOTAL_BLOCKS; b++) {
+        int word = b / FS_BITS_PER_WORD;
+        Word w;
+        bcache_read(FS_BITMAP_START + word / FS_BLOCK_WORDS, word % FS_BLOCK_WORDS, &w, 1);
+        block_used[b] = (w.data[b % FS_BITS_PER_WORD] == '1');
+    }
+    mounted = 1;
+    log_event(LOG_INFO, "Sistema de archivos montado: %d archivos, %d bloques libres",
+              super.files, super.free_blocks);
+    return 0;
+}
+
+/*
+ * Función: fs_is_mounted
+ */
+int fs_is_mounted() {
+    return mounted;
+}
+
+/*
+ * Función: fs_lookup
+ */
+int fs_lookup(const char* name) {
+    if (!mounted) return FS_ERR_NOT_MOUNTED;
+    Word encoded[FS_NAME_WORDS];
+    if (fs_encode_name(name, encoded) != 0) return FS_ERR_BAD_NAME;
+    int slot = dir_find(encoded, NULL);
+    if (slot < 0) return FS_ERR_NOT_FOUND;
+    int block, offset;
+    entry_location(slot, &block, &offset);
+    return read_number(block, offset + FS_NAME_WORDS);
+}
+
+/*
+ * Función: fs_create
+ */
+int fs_create(const char* name) {
+    if (!mounted) return FS_ERR_NOT_MOUNTED;
+    Word entry[FS_DIR_ENTRY_WORDS];
+    if (fs_encode_name(name, entry) != 0) return FS_ERR_BAD_NAME;
+    int free_slot;
+    if (dir_find(entry, &free_slot) >= 0) return FS_ERR_EXISTS;
+    if (free_slot < 0) return FS_ERR_NO_INODES;
+
+    Inode inode;
+    int number = 1;
+    for (; number < FS_MAX_INODES; number++) {
+        read_inode(number, &inode);
+        if (inode.type == 0) break;
+    }
+    if (number >= FS_MAX_INODES) return FS_ERR_NO_INODES;
+
+    memset(&inode, 0, sizeof(inode));
+    inode.type = 1;
+    write_inode(number, &inode);
+    entry[FS_NAME_WORDS] = number_word(number);
+    int block, offset;
+    entry_location(free_slot, &block, &offset);
+    bcache_write(block, offset, entry, FS_DIR_ENTRY_WORDS);
+    super.files++;
+    write_super();
+    bcache_sync();
+    log_event(LOG_INFO, "Archivo creado: %s (inodo %d)", name, number);
+    return number;
+}
+
+/*
+ * Función auxiliar: release_blocks (ESTÁTICA)
+ * Propósito: Liberar todos los bloques del inodo y dejarlo vacío (sin
+ *            escribirlo; write_inode libera el bloque de extensiones).
+ */
+static void release_blocks(Inode* inode) {
+    for (int i = 0; i < inode->count; i++) {
+        set_run(inode->extents[i].start, inode->extents[i].length, 0);
+    }
+    inode->count = 0;
+    inode->size = 0;
+}
+
+/*
+ * Función: fs_truncate
+ */
+int fs_truncate(int number) {
+    Inode inode;
+    if (!mounted) return FS_ERR_NOT_MOUNTED;
+    if (!valid_file(number, &inode)) return FS_ERR_NOT_FOUND;
+    release_blocks(&inode);
+    write_inode(number, &inode);
+    write_super();
+    bcache_sync();
+    return 0;
+}
+
+/*
+ * Función: fs_remove
+ */
+int fs_remove(const char* name) {
+    if (!mounted) return FS_ERR_NOT_MOUNTED;
+    Word encoded[FS_NAME_WORDS];
+    if (fs_encode_name(name, encoded) != 0) return FS_ERR_BAD_NAME;
+    int slot = dir_find(encoded, NULL);
+    if (slot < 0) return FS_ERR_NOT_FOUND;
+
+    int block, offset;
+    entry_location(slot, &block, &offset);
+    int number = read_number(block, offset + FS_NAME_WORDS);
+    Inode inode;
+    if (valid_file(number, &inode)) {
+        release_blocks(&inode);
+        inode.type = 0;
+        write_inode(number, &inode);
+    }
+    write_number(block, offset + FS_NAME_WORDS, 0);  // Entrada borrada
+    for (int i = 0; i < FS_MAX_OPEN; i++) {
+        if (open_files[i].used && open_files[i].inode == number) open_files[i].used = 0;
+    }
+    super.files--;
+    write_super();
+    bcache_sync();
+    log_event(LOG_INFO, "Archivo borrado: %s (inodo %d)", name, number);
+    return 0;
+}
+
+/*
+ * Función: fs_size
+ */
+int fs_size(int number) {
+    Inode inode;
+    if (!mounted) return FS_ERR_NOT_MOUNTED;
+    if (!valid_file(number, &inode)) return FS_ERR_NOT_FOUND;
+    return inode.size;
+}
+
+/*
+ * Función: fs_read
+ */
+int fs_read(int number, int offset, Word* words, int count) {
+    Inode inode;
+    if (!mounted) return FS_ERR_NOT_MOUNTED;
+    if (!valid_file(number, &inode)) return FS_ERR_NOT_FOUND;
+    if (offset < 0 || count < 0) return FS_ERR_RANGE;
+    if (offset >= inode.size) return 0;
+    if (count > inode.size - offset) count = inode.size - offset;
+
+    int done = 0;
+    while (done < count) {
+        int position = offset + done;
+        int within = position % FS_BLOCK_WORDS;
+        int chunk = FS_BLOCK_WORDS - within;
+        if (chunk > count - done) chunk = count - done;
+        int block = map_block(&inode, position / FS_BLOCK_WORDS);
+        if (block == 0) break;  // No debería pasar: el tamaño cabe en las extensiones
+        bcache_read(block, within, words + done, chunk);
+        done += chunk;
+    }
+    return done;
+}
+
+/*
+ * Función: fs_write
+ */
+int fs_write(int number, int offset, const Word* words, int count) {
+    Inode inode;
+    if (!mounted) return FS_ERR_NOT_MOUNTED;
+    if (!valid_file(number, &inode)) return FS_ERR_NOT_FOUND;
+    if (offset < 0 || offset > inode.size || count < 0) return FS_ERR_RANGE;
+
+    // Asignar de una vez todos los bloques que faltan, para que queden juntos
+    int have = file_blocks(&inode);
+    int need = (offset + count + FS_BLOCK_WORDS - 1) / FS_BLOCK_WORDS - have;
+    if (need > 0) have += grow(&inode, need);
+    if (count > have * FS_BLOCK_WORDS - offset) count = have * FS_BLOCK_WORDS - offset;
+
+    int done = 0;
+    while (done < count) {
+        int position = offset + done;
+        int within = position % FS_BLOCK_WORDS;
+        int chunk = FS_BLOCK_WORDS - within;
+        if (chunk > count - done) chunk = count - done;
+        int block = map_block(&inode, position / FS_BLOCK_WORDS);
+        bcache_write(block, within, words + done, chunk);
+        done += chunk;
+    }
+    if (offset + done > inode.size) inode.size = offset + done;
+    write_inode(number, &inode);
+    write_super();
+    bcache_sync();
+    return (done == 0 && need > 0) ? FS_ERR_NO_SPACE : done;
+}
+
+/*
+ * Función: fs_fragmentation
+ */
+int fs_fragmentation(FsFragmentation* report) {
+    memset(report, 0, sizeof(*report));
+    if (!mounted) return FS_ERR_NOT_MOUNTED;
+    for (int number = 1; number < FS_MAX_INODES; number++) {
+        Inode inode;
+        if (!valid_file(number, &inode)) continue;
+        report->files++;
+        report->extents += inode.count;
+        if (inode.count > 1) report->fragmented_files++;
+    }
+    int b = FS_DATA_START;
+    while (b < FS_TOTAL_BLOCKS) {
+        if (block_used[b]) { b++; continue; }
+        int start = b;
+        while (b < FS_TOTAL_BLOCKS && !block_used[b]) b++;
+        report->free_runs++;
+        report->free_blocks += b - start;
+        if (b - start > report->largest_free_run) report->largest_free_run = b - start;
+    }
+    return 0;
+}
+
+/*
+ * Función auxiliar: relocate (ESTÁTICA)
+ * Parámetros: number, inode - archivo; start - corrida libre con lugar para
+ *             todos sus bloques
+ * Retorna: int - bloques movidos
+ * Propósito: Copiar el archivo a la corrida, en orden, y liberar los bloques
+ *            anteriores. El inodo se escribe al final: hasta ese momento el
+ *            archivo se sigue leyendo de su ubicación anterior.
+ */
+static int relocate(int number, Inode* inode, int start) {
+    int blocks = file_blocks(inode);
+    int size = inode->size;
+    Word data[FS_BLOCK_WORDS];
+    set_run(start, blocks, 1);
+    for (int i = 0; i < blocks; i++) {
+        bcache_read(map_block(inode, i), 0, data, FS_BLOCK_WORDS);
+        bcache_write(start + i, 0, data, FS_BLOCK_WORDS);
+    }
+    release_blocks(inode);
+    inode->size = size;
+    inode->extents[0].start = start;
+    inode->extents[0].length = blocks;
+    inode->count = 1;
+    write_inode(number, inode);
+    return blocks;
+}
+
+/*
+ * Función auxiliar: compact (ESTÁTICA)
+ * Retorna: int - bloques que cambiaron de lugar
+ * Propósito: Reescribir todos los archivos uno detrás de otro desde
+ *            FS_DATA_START, en el orden en que empiezan en el disco, dejando
+ *            el espacio libre en una sola corrida al final. Los datos pasan
+ *            por memoria del host (el disco completo ocupa pocos KB).
+ */
+static int compact() {
+    static Word data[FS_MAX_FILE_BLOCKS * FS_BLOCK_WORDS];
+    static Inode inodes[FS_MAX_INODES];
+    static Inode previous[FS_MAX_INODES];   // Ubicación anterior de cada archivo
+    int order[FS_MAX_INODES];
+    int files = 0, used = 0, moved = 0;
+
+    for (int number = 1; number < FS_MAX_INODES; number++) {
+        if (!valid_file(number, &inodes[number]) || inodes[number].count == 0) continue;
+        int k = files++;
+        while (k > 0 && inodes[order[k - 1]].extents[0].start > inodes[number].extents[0].start) {
+            order[k] = order[k - 1];
+            k--;
+        }
+        order[k] = number;
+    }
+    for (int f = 0; f < files; f++) {
+        Inode* inode = &inodes[order[f]];
+        int blocks = file_blocks(inode);
+        previous[order[f]] = *inode;
+        for (int i = 0; i < blocks; i++) {
+            bcache_read(map_block(inode, i), 0, &data[(used + i) * FS_BLOCK_WORDS], FS_BLOCK_WORDS);
+        }
+        used += blocks;
+        release_blocks(inode);
+        if (inode->overflow != 0) {
+            set_used(inode->overflow, 0);
+            inode->overflow = 0;
+        }
+    }
+
+    int cursor = FS_DATA_START;
+    used = 0;
+    for (int f = 0; f < files; f++) {
+        int number = order[f];
+        Inode* old = &previous[number];
+        Inode* inode = &inodes[number];
+        int blocks = file_blocks(old);
+        set_run(cursor, blocks, 1);
+        for (int i = 0; i < blocks; i++) {
+            if (map_block(old, i) != cursor + i) moved++;
+            bcache_write(cursor + i, 0, &data[(used + i) * FS_BLOCK_WORDS], FS_BLOCK_WORDS);
+        }
+        inode->size = old->size;
+        inode->extents[0].start = cursor;
+        inode->extents[0].length = blocks;
+        inode->count = 1;
+        write_inode(number, inode);
+        cursor += blocks;
+        used += blocks;
+    }
+    return moved;
+}
+
+/*
+ * Función: fs_defragment
+ */
+int fs_defragment() {
+    if (!mounted) return FS_ERR_NOT_MOUNTED;
+    int moved = 0, pending = 0;
+    for (int number = 1; number < FS_MAX_INODES; number++) {
+        Inode inode;
+        if (!valid_file(number, &inode) || inode.count <= 1) continue;
+        int length;
+        int blocks = file_blocks(&inode);
+        int start = find_run(blocks, &length);
+        if (start >= 0 && length >= blocks) moved += relocate(number, &inode, start);
+        else pending++;
+    }
+    if (pending > 0) moved += compact();
+    write_super();
+    bcache_sync();
+    log_event(LOG_INFO, "Desfragmentación: %d bloques movidos", moved);
+    return moved;
+}
+
+/*
+ * Función: fs_list
+ */
+void fs_list() {
+    if (!mounted) {
+        printf("El disco no tiene sistema de archivos (use 'fs format')\n");
+        return;
+    }
+    printf("\n%-14s %6s %8s %7s %11s\n", "NOMBRE", "INODO", "PALABRAS", "BLOQUES", "EXTENSIONES");
+    int shown = 0;
+    for (int slot = 0; slot < FS_DIR_SLOTS; slot++) {
+        int block, offset;
+        Word entry[FS_DIR_ENTRY_WORDS];
+        entry_location(slot, &block, &offset);
+        bcache_read(block, offset, entry, FS_DIR_ENTRY_WORDS);
+        int number = word_number(&entry[FS_NAME_WORDS]);
+        char name[FS_NAME_MAX + 1];
+        Inode inode;
+        if (number == 0 || fs_decode_name(entry, name) != 0 || !valid_file(number, &inode)) continue;
+        printf("%-14s %6d %8d %7d %11d\n", name, number, inode.size, file_blocks(&inode), inode.count);
+        shown++;
+    }
+    printf("%d archivos, %d bloques libres de %d palabras\n",
+           shown, super.free_blocks, FS_BLOCK_WORDS);
+}
+
+/*
+ * Función: fs_status
+ */
+void fs_status() {
+    printf("\n=== SISTEMA DE ARCHIVOS (%s) ===\n", mounted ? "montado" : "sin montar");
+    if (mounted) {
+        printf("Bloques:              %d de %d palabras (datos desde el bloque %d)\n",
+               super.total_blocks, FS_BLOCK_WORDS, super.data_start);
+        printf("Libres:               %d de %d bloques de datos\n",
+               super.free_blocks, super.total_blocks - super.data_start);
+        printf("Archivos:             %d (máximo %d; directorio de %d entradas)\n",
+               super.files, super.inodes - 1, super.dir_slots);
+        int open = 0;
+        for (int i = 0; i < FS_MAX_OPEN; i++) open += open_files[i].used;
+        printf("Descriptores abiertos: %d de %d\n", open, FS_MAX_OPEN);
+        FsFragmentation report;
+        fs_fragmentation(&report);
+        printf("Fragmentación:        %d de %d archivos en varias extensiones; libre en %d corridas\n",
+               report.fragmented_files, report.files, report.free_runs);
+    }
+    bcache_status();
+    printf("=================================\n");
+}
+
+/*
+ * Función: fs_fragmentation_report
+ */
+void fs_fragmentation_report() {
+    FsFragmentation report;
+    if (fs_fragmentation(&report) != 0) {
+        printf("El disco no tiene sistema de archivos (use 'fs format')\n");
+        return;
+    }
+    printf("\n=== FRAGMENTACIÓN ===\n");
+    printf("Archivos:             %d (%d en más de una extensión)\n",
+           report.files, report.fragmented_files);
+    printf("Extensiones:          %d (%.2f por archivo; una búsqueda cada una al leer)\n",
+           report.extents, report.files ? (double)report.extents / report.files : 0.0);
+    printf("Espacio libre:        %d bloques en %d corridas (mayor: %d)\n",
+           report.free_blocks, report.free_runs, report.largest_free_run);
+    printf("Libre fragmentado:    %.1f%% (fuera de la corrida mayor)\n",
+           report.free_blocks ? 100.0 * (report.free_blocks - report.largest_free_run) / report.free_blocks : 0.0);
+    printf("=====================\n");
+}
+
+/*
+ * Función: fs_error_text
+ */
+const char* fs_error_text(int code) {
+    switch (code) {
+        case FS_ERR_NOT_FOUND:   return "el archivo no existe";
+        case FS_ERR_EXISTS:      return "el archivo ya existe";
+        case FS_ERR_NO_SPACE:    return "no queda espacio en el disco";
+        case FS_ERR_NO_INODES:   return "no quedan entradas de directorio";
+        case FS_ERR_BAD_NAME:    return "nombre inválido (1 a 12 caracteres de A-Z a-z 0-9 . _ -)";
+        case FS_ERR_NOT_MOUNTED: return "el disco no tiene sistema de archivos (use 'fs format')";
+        case FS_ERR_BAD_FD:      return "descriptor inválido";
+        case FS_ERR_RANGE:       return "posición o tamaño fuera del archivo";
+        case FS_ERR_TOO_MANY:    return "demasiados archivos abiertos";
+        default:                 return "error desconocido";
+    }
+}
+
+/*
+ * SERVICIOS SVC (ESTÁTICOS)
+ * Los búferes del invitado se copian enteros con read/write_memory_block:
+ * si el rango no es válido no se transfiere nada.
+ */
+static Word transfer[MEMORY_SIZE];
+
+static OpenFile* descriptor(int fd) {
+    if (fd < 0 || fd >= FS_MAX_OPEN || !open_files[fd].used) return NULL;
+    return &open_files[fd];
+}
+
+static int guest_name(int address, char* name) {
+    Word words[FS_NAME_WORDS];
+    if (read_memory_block(address, words, FS_NAME_WORDS) != 0) return SYSCALL_ERR_ADDRESS;
+    return fs_decode_name(words, name);
+}
+
+static int svc_open(const int* args) {
+    char name[FS_NAME_MAX + 1];
+    int result = guest_name(args[0], name);
+    if (result != 0) return result;
+    int number = fs_lookup(name);
+    if (number == FS_ERR_NOT_FOUND && args[1] == 1) number = fs_create(name);
+    if (number < 0) return number;
+    for (int fd = 0; fd < FS_MAX_OPEN; fd++) {
+        if (open_files[fd].used) continue;
+        open_files[fd].used = 1;
+        open_files[fd].inode = number;
+        open_files[fd].position = 0;
+        return fd;
+    }
+    return FS_ERR_TOO_MANY;
+}
+
+static int svc_close(const int* args) {
+    OpenFile* file = descriptor(args[0]);
+    if (file == NULL) return FS_ERR_BAD_FD;
+    file->used = 0;
+    return 0;
+}
+
+static int svc_read(const int* args) {
+    OpenFile* file = descriptor(args[0]);
+    if (file == NULL) return FS_ERR_BAD_FD;
+    if (args[2] < 0 || args[2] > MEMORY_SIZE) return FS_ERR_RANGE;
+    int got = fs_read(file->inode, file->position, transfer, args[2]);
+    if (got <= 0) return got;
+    if (write_memory_block(args[1], transfer, got) != 0) return SYSCALL_ERR_ADDRESS;
+    file->position += got;
+    return got;
+}
+
+static int svc_write(const int* args) {
+    OpenFile* file = descriptor(args[0]);
+    if (file == NULL) return FS_ERR_BAD_FD;
+    if (args[2] < 0 || args[2] > MEMORY_SIZE) return FS_ERR_RANGE;
+    if (read_memory_block(args[1], transfer, args[2]) != 0) return SYSCALL_ERR_ADDRESS;
+    int done = fs_write(file->inode, file->position, transfer, args[2]);
+    if (done > 0) file->position += done;
+    return done;
+}
+
+static int svc_seek(const int* args) {
+    OpenFile* file = descriptor(args[0]);
+    if (file == NULL) return FS_ERR_BAD_FD;
+    int size = fs_size(file->inode);
+    if (size < 0) return size;
+    if (args[1] < 0 || args[1] > size) return FS_ERR_RANGE;
+    file->position = args[1];
+    return file->position;
+}
+
+static int svc_size(const int* args) {
+    OpenFile* file = descriptor(args[0]);
+    if (file == NULL) return FS_ERR_BAD_FD;
+    return fs_size(file->inode);
+}
+
+static int svc_remove(const int* args) {
+    char name[FS_NAME_MAX + 1];
+    int result = guest_name(args[0], name);
+    if (result != 0) return result;
+    return fs_remove(name);
+}
+
+/*
+ * Función: init_fs
+ * Propósito: Registrar los servicios y montar el disco si ya tiene un
+ *            sistema de archivos (el disco recién iniciado no lo tiene).
+ */
+void init_fs() {
+    init_bcache();
+    syscall_register(FS_SVC_OPEN, 2, "open", svc_open);
+    syscall_register(FS_SVC_CLOSE, 1, "close", svc_close);
+    syscall_register(FS_SVC_READ, 3, "read", svc_read);
+    syscall_register(FS_SVC_WRITE, 3, "write", svc_write);
+    syscall_register(FS_SVC_SEEK, 2, "seek", svc_seek);
+    syscall_register(FS_SVC_SIZE, 1, "size", svc_size);
+    syscall_register(FS_SVC_REMOVE, 1, "remove", svc_remove);
+    fs_mount();
+}
@@ -0,0 +1,177 @@
+/*
+ * Archivo de cabecera del sistema de archivos del Sistema Operativo Virtual.
+ * Guarda archivos de palabras con nombre en el disco virtual, pasando por la
+ * caché de buffers (DISK/bcache.h). Cada sector del disco es una palabra de
+ * 8 dígitos, así que el bloque del sistema de archivos es un grupo de
+ * FS_BLOCK_WORDS sectores y toda la metadata se guarda como números
+ * decimales de 8 dígitos.
+ *
+ * Organización del disco (en bloques):
+ *   0                  - superbloque
+ *   FS_BITMAP_START    - mapa de bloques libres (un dígito 0/1 por bloque)
+ *   FS_INODE_START     - tabla de inodos (FS_INODE_WORDS palabras cada uno)
+ *   FS_DIR_START       - directorio: tabla hash de FS_DIR_SLOTS entradas
+ *   FS_DATA_START      - bloques de datos y de punteros
+ *
+ * Inodo: tipo, tamaño en palabras, FS_INODE_EXTENTS extensiones y el
+ * bloque de extensiones adicionales (FS_BLOCK_WORDS más, 0 si no hay). Una
+ * extensión es una corrida de bloques consecutivos, guardada en una palabra
+ * como inicio * FS_EXTENT_SCALE + largo; el orden de las extensiones es el
+ * orden de los datos del archivo.
+ *
+ * Asignación: al crecer, un archivo primero extiende su última extensión
+ * si el bloque siguiente está libre; lo que falte se toma de la corrida
+ * libre más chica donde quepa (best-fit) o, si no hay ninguna, de la más
+ * grande. fs_defragment() reubica los archivos con varias extensiones en
+ * una sola corrida de sectores consecutivos, así que leer un archivo
+ * completo cuesta una búsqueda del cabezal.
+ *
+ * Directorio: único y plano. La entrada de un nombre se busca a partir de
+ * hash(nombre) % FS_DIR_SLOTS con sondeo lineal, por lo que la búsqueda lee
+ * en general un solo bloque. Los nombres (hasta FS_NAME_MAX caracteres de
+ * [A-Za-z0-9._-]) se guardan con 2 dígitos por carácter, 3 por palabra:
+ * cada palabra es un número positivo (c1*10000 + c2*100 + c3, con A=1,
+ * B=2, ..., Z=26, a=27, ..., z=52, 0=53, ..., 9=62, '.'=63, '_'=64, '-'=65),
+ * así que un programa puede escribirlos con '.word'.
+ */
+
+#ifndef FS_H
+#define FS_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../types.h"          // Para el tipo Word
+#include "../DISK/bcache.h"    // Para el tamaño de bloque y del disco
+
+/*
+ * CONSTANTES DE ORGANIZACIÓN DEL DISCO
+ */
+#define FS_MAGIC 53460002                       // Firma del superbloque (versión 2: extensiones)
+#define FS_BLOCK_WORDS BCACHE_BLOCK_SECTORS     // Palabras por bloque
+#define FS_TOTAL_BLOCKS BCACHE_TOTAL_BLOCKS     // Bloques del disco
+#define FS_BITS_PER_WORD 8                      // Bloques por palabra del mapa
+#define FS_BITMAP_START 1
+#define FS_BITMAP_BLOCKS ((FS_TOTAL_BLOCKS + FS_BITS_PER_WORD * FS_BLOCK_WORDS - 1) / (FS_BITS_PER_WORD * FS_BLOCK_WORDS))
+#define FS_MAX_INODES 64                        // Inodo 0 reservado: hasta 63 archivos
+#define FS_INODE_WORDS 10
+#define FS_INODE_START (FS_BITMAP_START + FS_BITMAP_BLOCKS)
+#define FS_INODE_BLOCKS (FS_MAX_INODES * FS_INODE_WORDS / FS_BLOCK_WORDS)
+#define FS_DIR_SLOTS 128
+#define FS_DIR_ENTRY_WORDS 5                    // FS_NAME_WORDS palabras de nombre + inodo
+#define FS_DIR_START (FS_INODE_START + FS_INODE_BLOCKS)
+#define FS_DIR_BLOCKS (FS_DIR_SLOTS * FS_DIR_ENTRY_WORDS / FS_BLOCK_WORDS)
+#define FS_DATA_START (FS_DIR_START + FS_DIR_BLOCKS)
+#define FS_NAME_MAX 12
+#define FS_NAME_WORDS 4
+#define FS_NAME_CHARS_PER_WORD 3
+#define FS_INODE_EXTENTS 7
+#define FS_MAX_EXTENTS (FS_INODE_EXTENTS + FS_BLOCK_WORDS)
+#define FS_EXTENT_SCALE 10000
+#define FS_MAX_FILE_BLOCKS (FS_TOTAL_BLOCKS - FS_DATA_START)
+#define FS_MAX_OPEN 8                           // Archivos abiertos por el invitado
+
+/*
+ * CÓDIGOS DE ERROR (valores negativos; también son el resultado de los SVC)
+ */
+#define FS_ERR_NOT_FOUND   -1   // El archivo no existe
+#define FS_ERR_EXISTS      -2   // Ya existe un archivo con ese nombre
+#define FS_ERR_NO_SPACE    -3   // No quedan bloques libres
+#define FS_ERR_NO_INODES   -4   // No quedan inodos o entradas de directorio
+#define FS_ERR_BAD_NAME    -5   // Nombre vacío, largo o con caracteres inválidos
+#define FS_ERR_NOT_MOUNTED -6   // El disco no tiene sistema de archivos
+#define FS_ERR_BAD_FD      -7   // Descriptor inválido o cerrado
+#define FS_ERR_RANGE       -8   // Desplazamiento o tamaño fuera del archivo
+#define FS_ERR_TOO_MANY    -9   // No quedan descriptores libres
+                                // (FS_ERR_NO_SPACE también si el archivo necesitaría
+                                //  más de FS_MAX_EXTENTS extensiones: desfragmentar)
+
+/*
+ * Estructura: FsFragmentation
+ * Propósito: Medidas de fragmentación del sistema de archivos.
+ * Campos:
+ *   files, fragmented_files - archivos y cuántos tienen más de una extensión
+ *   extents                 - extensiones en total (búsquedas para leer todo)
+ *   free_blocks, free_runs  - bloques libres y en cuántas corridas están
+ *   largest_free_run        - corrida libre más larga (archivo más grande que
+ *                             se puede crear sin fragmentar)
+ */
+typedef struct {
+    int files;
+    int fragmented_files;
+    int extents;
+    int free_blocks;
+    int free_runs;
+    int largest_free_run;
+} FsFragmentation;
+
+/*
+ * SERVICIOS SVC DEL SISTEMA DE ARCHIVOS (ver SYSCALL/syscall.h)
+ * Los nombres se pasan como dirección lógica de FS_NAME_WORDS palabras
+ * codificadas como en el directorio (fs_encode_name).
+ *   FS_SVC_OPEN   (nombre, crear)        -> descriptor; crear=1 lo crea vacío si no existe
+ *   FS_SVC_CLOSE  (fd)                   -> 0
+ *   FS_SVC_READ   (fd, dirección, n)     -> palabras leídas (0 al final)
+ *   FS_SVC_WRITE  (fd, dirección, n)     -> palabras escritas
+ *   FS_SVC_SEEK   (fd, posición)         -> posición
+ *   FS_SVC_SIZE   (fd)                   -> tamaño en palabras
+ *   FS_SVC_REMOVE (nombre)               -> 0
+ */
+#define FS_SVC_OPEN 1
+#define FS_SVC_CLOSE 2
+#define FS_SVC_READ 3
+#define FS_SVC_WRITE 4
+#define FS_SVC_SEEK 5
+#define FS_SVC_SIZE 6
+#define FS_SVC_REMOVE 7
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del sistema de archivos
+ * Las funciones que retornan int usan los códigos FS_ERR_* para los errores.
+ */
+void init_fs();                        // Registrar los SVC y montar el disco si tiene sistema de archivos
+int fs_format();                       // Crear un sistema de archivos vacío en el disco
+int fs_mount();                        // Leer el superbloque (FS_ERR_NOT_MOUNTED si no hay)
+int fs_is_mounted();
+
+int fs_lookup(const char* name);       // Inodo del archivo
+int fs_create(const char* name);       // Crear vacío; retorna el inodo
+int fs_remove(const char* name);       // Borrar y liberar sus bloques
+int fs_size(int inode);                // Tamaño en palabras
+int fs_truncate(int inode);            // Dejar el archivo vacío
+
+/*
+ * Función: fs_read / fs_write
+ * Parámetros:
+ *   inode  - archivo
+ *   offset - primera palabra (fs_write admite offset <= tamaño: sin huecos)
+ *   words  - búfer del host
+ *   count  - cantidad de palabras
+ * Retorna: int - palabras transferidas (fs_read: menos al llegar al final)
+ */
+int fs_read(int inode, int offset, Word* words, int count);
+int fs_write(int inode, int offset, const Word* words, int count);
+
+int fs_encode_name(const char* name, Word* words);  // FS_NAME_WORDS palabras
+int fs_decode_name(const Word* words, char* name);  // name: FS_NAME_MAX + 1 bytes
+
+int fs_fragmentation(FsFragmentation* report);  // 0, o FS_ERR_NOT_MOUNTED
+
+/*
+ * Función: fs_defragment
+ * Retorna: int - bloques movidos, o un código FS_ERR_*
+ * Propósito: Dejar cada archivo en una sola extensión sin desmontar el
+ *            disco (los descriptores abiertos siguen valiendo). Cada archivo
+ *            fragmentado se copia a la corrida libre más chica donde quepa;
+ *            si no hay ninguna, se compactan todos los archivos al inicio
+ *            de la zona de datos.
+ */
+int fs_defragment();
+
+void fs_list();                        // Mostrar los archivos
+void fs_fragmentation_report();        // Mostrar las medidas de fragmentación
+void fs_status();                      // Superbloque, ocupación y caché de buffers
+const char* fs_error_text(int code);   // Mensaje para un código FS_ERR_*
+
+#endif /* FS_H */
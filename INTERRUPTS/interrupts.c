@@ -10,6 +10,9 @@
 /* Inclusión de cabeceras de otros módulos */
 #include "../LOGGER/logger.h"      // Para registro de eventos del sistema
 #include "../REGISTERS/registers.h" // Para acceder a los registros de la CPU
+#include "../METRICS/metrics.h"     // Para contar interrupciones y cambios de contexto
+#include "../PROFILER/trace.h"      // Para la pista del controlador en la traza
+#include "../SYSCALL/syscall.h"     // Para atender los SVC
 
 /* Inclusión de bibliotecas estándar */
 #include <stdlib.h>   // Para funciones generales
@@ -37,6 +40,20 @@ static InterruptHandler interrupt_vector[9];
  */
 static int pending_interrupts[9] = {0};
 
+/*
+ * Resumen de pending_interrupts para quien no puede recorrer el arreglo
+ * (el código nativo del JIT). Lo escribe también el hilo del DMA.
+ */
+volatile int interrupts_pending = 0;
+
+/*
+ * Nombres de las interrupciones para la traza (mismo orden que InterruptCode)
+ */
+static const char* interrupt_names[9] = {
+    "syscall inválida", "interrupción inválida", "syscall", "reloj", "fin de E/S",
+    "instrucción inválida", "dirección inválida", "underflow", "overflow"
+};
+
 /*
  * HANDLERS DE INTERRUPCIONES (funciones estáticas)
  * Cada función maneja un tipo específico de interrupción.
@@ -87,8 +104,9 @@ static void syscall_handler() {
     // realizar operaciones que no están permitidas en modo usuario
     cpu_registers.PSW.operation_mode = 1;  // 1 = KERNEL_MODE
     
-    // En una implementación completa, aquí se llamaría al dispatcher
-    // del sistema operativo para manejar la llamada específica
+    // El despachador lee el bloque de parámetros apuntado por el AC y deja
+    // el resultado del servicio en el AC (ver SYSCALL/syscall.h)
+    syscall_dispatch();
 }
 
 /*
@@ -261,11 +279,14 @@ void trigger_interrupt(InterruptCode code) {
     /*
      * VERIFICAR SI LAS INTERRUPCIONES ESTÁN HABILITADAS
      * Las interrupciones pueden estar deshabilitadas temporalmente
-     * durante operaciones críticas del sistema.
+     * durante operaciones críticas del sistema. El SVC es una trampa
+     * síncrona que pide el propio programa: no se puede enmascarar.
      */
-    if (cpu_registers.PSW.interrupt_enabled) {
+    if (cpu_registers.PSW.interrupt_enabled || code == INT_SYSCALL) {
         // Interrupciones habilitadas: marcar como pendiente
         pending_interrupts[code] = 1;
+        interrupts_pending = 1;
+        if (trace_enabled) trace_instant(TRACE_TRACK_INTERRUPTS, interrupt_names[code], code);
         
         // Registrar para depuración
         log_event(LOG_DEBUG, 
@@ -288,6 +309,7 @@ void trigger_interrupt(InterruptCode code) {
  * cada ciclo de instrucción de la CPU) para verificar y manejar interrupciones.
  */
 void handle_pending_interrupts() {
+    interrupts_pending = 0;
     // Recorrer todas las posibles interrupciones
     for (int i = 0; i < 9; i++) {
         // Verificar si esta interrupción está pendiente
@@ -295,6 +317,7 @@ void handle_pending_interrupts() {
             // Registrar que se va a manejar esta interrupción
             log_event(LOG_DEBUG, 
                       "Manejando interrupción pendiente: %d", i);
+            unsigned long long trace_ts = trace_enabled ? trace_now() : 0;
             
             /*
              * PASO 1: GUARDAR CONTEXTO
@@ -317,6 +340,7 @@ void handle_pending_interrupts() {
              * interrupt_vector[i]() ejecuta el handler para la interrupción i.
              */
             interrupt_vector[i]();
+            METRIC_INC(interrupts[i]);
             
             /*
              * PASO 4: LIMPIAR INTERRUPCIÓN PENDIENTE
@@ -330,6 +354,9 @@ void handle_pending_interrupts() {
              * Esto permite que el programa interrumpido continúe normalmente.
              */
             restore_context();
+            if (trace_enabled) {
+                trace_complete(TRACE_TRACK_INTERRUPTS, interrupt_names[i], trace_ts, i, 0, 0);
+            }
         }
     }
 }
@@ -351,6 +378,7 @@ void save_context() {
     // 2. save_psw_to_kernel_stack();
     // 3. update_process_table();
     
+    METRIC_INC(context_switches);
     log_event(LOG_DEBUG, 
               "Contexto guardado (simulado)");
 }
@@ -50,6 +50,14 @@ typedef enum {
  */
 typedef void (*InterruptHandler)(void);
 
+/*
+ * DECLARACIÓN DE VARIABLE GLOBAL EXTERNA
+ * interrupts_pending - 1 si se marcó alguna interrupción desde la última
+ *                      llamada a handle_pending_interrupts(); el código
+ *                      nativo del JIT la consulta para volver al intérprete
+ */
+extern volatile int interrupts_pending;
+
 /*
  * PROTOTIPOS DE FUNCIONES - Interfaz pública del módulo de interrupciones
  */
@@ -0,0 +1,109 @@
+/*
+ * Archivo de implementación del módulo ISA del Sistema Operativo Virtual.
+ * Contiene la tabla de mnemónicos indexada por opcode. Debe mantenerse
+ * sincronizada con el switch principal de execute_instruction() en CPU/cpu.c.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "isa.h"
+
+/* Inclusión de bibliotecas estándar */
+#include <stddef.h>   // Para NULL
+
+/*
+ * TABLA DE MNEMÓNICOS
+ * Índice = opcode. Las posiciones sin inicializar (NULL) corresponden
+ * a opcodes no implementados (20-24, 46-99).
+ */
+static const char* mnemonics[ISA_MAX_OPCODES] = {
+    [0]  = "SUM",           // Suma
+    [1]  = "RES",           // Resta
+    [2]  = "MULT",          // Multiplicación
+    [3]  = "DIVI",          // División
+    [4]  = "LOAD",          // Cargar en AC
+    [5]  = "STR",           // Guardar AC en memoria
+    [6]  = "CMP",           // Comparar
+    [7]  = "TST",           // Test (AND bit a bit)
+    [8]  = "MOV",           // Mover operando a AC
+    [9]  = "JEQ",           // Saltar si igual
+    [10] = "JGT",           // Saltar si mayor
+    [11] = "JLT",           // Saltar si menor
+    [12] = "JOV",           // Saltar si overflow
+    [13] = "SVC",           // Llamada al sistema
+    [14] = "CALL",          // Llamada a subrutina
+    [15] = "RET",           // Retorno de subrutina
+    [16] = "LDR",           // AC <- RB
+    [17] = "STRR",          // RB <- AC
+    [18] = "LDRL",          // AC <- RL
+    [19] = "STRL",          // RL <- AC
+    [25] = "PUSH",          // Empujar AC a la pila
+    [26] = "POP",           // Sacar de la pila a AC
+    [27] = "J",             // Salto incondicional
+    [28] = "DMA_READ",      // Iniciar lectura DMA
+    [29] = "DMA_WRITE",     // Iniciar escritura DMA
+    [30] = "DMA_WAIT",      // Esperar DMA
+    [31] = "DMA_STATUS",    // Estado DMA en AC
+    [32] = "DMA_CONFIG",    // Ubicación en disco
+    [33] = "DMA_SIZE",      // Tamaño de transferencia
+    [34] = "IN",            // Entrada desde dispositivo
+    [35] = "OUT",           // Salida a dispositivo
+    [36] = "IO_STATUS",     // Estado de E/S
+    [37] = "MOVB",          // Copiar un bloque de palabras
+    [38] = "FILL",          // Llenar un bloque con un valor
+    [39] = "CMPB",          // Comparar dos bloques de palabras
+    [40] = "HALT",          // Detener CPU
+    [41] = "NOP",           // Sin operación
+    [42] = "EI",            // Habilitar interrupciones
+    [43] = "DI",            // Deshabilitar interrupciones
+    [44] = "SWITCH_USER",   // Cambiar a modo usuario
+    [45] = "SWITCH_KERNEL"  // Cambiar a modo kernel
+};
+
+/*
+ * Función: isa_mnemonic
+ * Parámetros: opcode - código de operación
+ * Retorna: const char* - mnemónico o "???" si no existe
+ */
+const char* isa_mnemonic(int opcode) {
+    if (!isa_is_implemented(opcode)) {
+        return "???";  // Opcode fuera de rango o no implementado
+    }
+    return mnemonics[opcode];
+}
+
+/*
+ * Función: isa_is_implemented
+ * Parámetros: opcode - código de operación
+ * Retorna: int - 1 si el opcode tiene mnemónico (implementado), 0 si no
+ */
+int isa_is_implemented(int opcode) {
+    if (opcode < 0 || opcode >= ISA_MAX_OPCODES) {
+        return 0;
+    }
+    return mnemonics[opcode] != NULL;
+}
+
+/*
+ * Función: isa_is_conditional_branch
+ * Parámetros: opcode - código de operación
+ * Retorna: int - 1 para JEQ, JGT, JLT y JOV (09-12)
+ */
+int isa_is_conditional_branch(int opcode) {
+    return opcode >= 9 && opcode <= 12;
+}
+
+/*
+ * Función: isa_has_operand
+ * Parámetros: opcode - código de operación
+ * Retorna: int - 0 para las instrucciones que no leen su operando
+ */
+int isa_has_operand(int opcode) {
+    switch (opcode) {
+        case 13: case 15: case 16: case 17: case 18: case 19:  // SVC, RET, registros
+        case 25: case 26: case 30: case 31:                    // Pila, DMA_WAIT/STATUS
+        case 41: case 42: case 43: case 44: case 45:           // NOP, EI, DI, cambios de modo
+            return 0;
+        default:
+            return isa_is_implemented(opcode);
+    }
+}
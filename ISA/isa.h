@@ -0,0 +1,57 @@
+/*
+ * Archivo de cabecera del módulo ISA (Instruction Set Architecture)
+ * del Sistema Operativo Virtual.
+ * Define la tabla de mnemónicos del conjunto de instrucciones de la CPU virtual,
+ * compartida por la CPU, el profiler y las herramientas que necesitan mostrar
+ * o interpretar instrucciones por nombre.
+ */
+
+#ifndef ISA_H
+#define ISA_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+/*
+ * CONSTANTES DEL CONJUNTO DE INSTRUCCIONES
+ * ISA_MAX_OPCODES - Cantidad de opcodes representables (2 dígitos decimales: 00-99)
+ */
+#define ISA_MAX_OPCODES 100
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del módulo ISA
+ */
+
+/*
+ * Función: isa_mnemonic
+ * Parámetros: opcode - código de operación (0-99)
+ * Retorna: const char* - mnemónico de la instrucción ("LOAD", "HALT", ...)
+ *          o "???" si el opcode no está implementado
+ */
+const char* isa_mnemonic(int opcode);
+
+/*
+ * Función: isa_is_implemented
+ * Parámetros: opcode - código de operación (0-99)
+ * Retorna: int - 1 si execute_instruction() implementa el opcode, 0 si no
+ */
+int isa_is_implemented(int opcode);
+
+/*
+ * Función: isa_is_conditional_branch
+ * Parámetros: opcode - código de operación
+ * Retorna: int - 1 para los saltos condicionales (opcodes 09-12), 0 en otro caso
+ */
+int isa_is_conditional_branch(int opcode);
+
+/*
+ * Función: isa_has_operand
+ * Parámetros: opcode - código de operación
+ * Retorna: int - 1 si la instrucción usa el modo y el valor de la palabra,
+ *          0 si los ignora (RET, PUSH, POP, NOP, EI, ...). Lo usan el
+ *          ensamblador y el desensamblador para la sintaxis de cada mnemónico.
+ */
+int isa_has_operand(int opcode);
+
+#endif /* ISA_H */
@@ -8,6 +8,10 @@
 /* Inclusión de cabecera propia del módulo */
 #include "logger.h"
 
+/* Inclusión de cabeceras de otros módulos */
+#include "../PROFILER/perfstat.h"   // Para atribuir el costo del logging (perfstat)
+#include "../METRICS/metrics.h"     // Para contar mensajes escritos y descartados
+
 /* Inclusión de bibliotecas adicionales */
 #include <stdarg.h>   // Para manejo de argumentos variables (va_list, va_start, etc.)
 #include <stdlib.h>   // Para función exit()
@@ -124,6 +128,7 @@ void log_event(LogLevel level, const char* message, ...) {
      * Garantiza que solo un hilo escriba en el archivo a la vez.
      * Si otro hilo está escribiendo, este hilo se bloquea hasta que se libere.
      */
+    int perf_prev = PERF_ENTER(PERF_PHASE_LOGGING);  // Fase LOGGING (perfstat)
     pthread_mutex_lock(&log_mutex);
     
     /*
@@ -160,23 +165,32 @@ void log_event(LogLevel level, const char* message, ...) {
      * Ejemplo: "2024-01-07 14:30:45 [INFO]     Sistema iniciado"
      */
     
-    // Escribir timestamp y nivel
-    fprintf(log_file, "%s %s ", get_timestamp(), level_str[level]);
-    
-    // Escribir mensaje formateado (usa vfprintf para argumentos variables)
-    vfprintf(log_file, message, args);
-    
-    // Nueva línea al final
-    fprintf(log_file, "\n");
-    
-    /*
-     * Flushear el buffer para asegurar que los datos se escriban inmediatamente.
-     * Esto es importante para:
-     * - No perder logs si el programa crashea
-     * - Ver logs en tiempo real durante depuración
-     * - Garantizar orden de escritura en sistemas con buffering
-     */
-    fflush(log_file);
+    // Sin archivo (antes de init_logger o tras close_logger) el mensaje se descarta
+    if (log_file == NULL) {
+        METRIC_INC(log_drops);
+    } else {
+        // Escribir timestamp y nivel
+        fprintf(log_file, "%s %s ", get_timestamp(), level_str[level]);
+        
+        // Escribir mensaje formateado (usa vfprintf para argumentos variables)
+        vfprintf(log_file, message, args);
+        
+        // Nueva línea al final
+        fprintf(log_file, "\n");
+        
+        /*
+         * Flushear el buffer para asegurar que los datos se escriban inmediatamente.
+         * Esto es importante para:
+         * - No perder logs si el programa crashea
+         * - Ver logs en tiempo real durante depuración
+         * - Garantizar orden de escritura en sistemas con buffering
+         */
+        if (fflush(log_file) == 0) {
+            METRIC_INC(log_messages);
+        } else {
+            METRIC_INC(log_drops);  // Disco lleno o error de E/S
+        }
+    }
     
     /*
      * PASO 4: MOSTRAR EN CONSOLA PARA NIVELES IMPORTANTES
@@ -184,10 +198,14 @@ void log_event(LogLevel level, const char* message, ...) {
      * para que el usuario/desarrollador los vea inmediatamente.
      */
     if (level == LOG_INTERRUPT || level == LOG_ERROR) {
-        // Mismo formato que en archivo, pero en consola
+        // Mismo formato que en archivo, pero en consola.
+        // vfprintf ya consumió 'args', por lo que se usa una copia nueva.
+        va_list console_args;
+        va_start(console_args, message);
         printf("%s %s ", get_timestamp(), level_str[level]);
-        vprintf(message, args);  // vprintf para argumentos variables en consola
+        vprintf(message, console_args);  // vprintf para argumentos variables en consola
         printf("\n");
+        va_end(console_args);
     }
     
     /*
@@ -201,6 +219,7 @@ void log_event(LogLevel level, const char* message, ...) {
      * Permite que otros hilos puedan escribir en el log.
      */
     pthread_mutex_unlock(&log_mutex);
+    PERF_LEAVE(perf_prev);
 }
 
 /*
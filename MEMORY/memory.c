@@ -15,6 +15,10 @@
 #include "../LOGGER/logger.h"                  // Para registrar eventos de memoria
 #include "../REGISTERS/registers.h"  // Para acceder a registros RB y RL
 #include "../INTERRUPTS/interrupts.h" // Para disparar interrupciones por violaciones
+#include "../METRICS/metrics.h"       // Para contar accesos a memoria
+#include "../DEBUGGER/gdbstub.h"      // Para los watchpoints de GDB
+#include "../CPU/blockcache.h"        // Para invalidar bloques traducidos
+#include "../MMIO/mmio.h"             // Para la ventana de E/S mapeada en memoria
 
 /* Inclusión de bibliotecas estándar */
 #include <string.h>   // Para funciones de manipulación de cadenas (strcpy)
@@ -69,10 +73,47 @@ void init_memory() {
               MEMORY_SIZE, OS_RESERVED);
 }
 
+/*
+ * CONSTANTES INTERNAS
+ * MEMORY_MMIO - Resultado de logical_to_physical para una dirección de la
+ *               ventana de E/S mapeada (ver MMIO/mmio.h)
+ */
+#define MEMORY_MMIO -2
+
+/*
+ * Función auxiliar: segment_to_physical (ESTÁTICA)
+ * Parámetros:
+ *   logical_address - dirección lógica
+ *   count           - palabras desde esa dirección (1 para un acceso simple)
+ * Retorna: int - dirección física si todo el rango cae en la ventana del
+ *          segmento secundario (SEGMENT_WINDOW), o -1
+ * Propósito: Solo se consulta cuando la dirección no cae en la región RB/RL,
+ *            así que los accesos normales no pagan esta verificación.
+ */
+static int segment_to_physical(int logical_address, int count) {
+    int rls_value = word_to_int(cpu_registers.RLS);
+    int offset = logical_address - SEGMENT_WINDOW;
+    if (rls_value <= 0 || offset < 0 || offset + count > rls_value) return -1;
+    return word_to_int(cpu_registers.RBS) + offset;
+}
+
+/*
+ * Función auxiliar: segment_granted (ESTÁTICA)
+ * Retorna: int - 1 si la dirección física pertenece al segmento secundario
+ * Propósito: Excepción a la protección del área del SO para el segmento
+ *            concedido (solo se consulta si la dirección está en esa área).
+ */
+static int segment_granted(int physical_address) {
+    int rbs_value = word_to_int(cpu_registers.RBS);
+    return physical_address >= rbs_value &&
+           physical_address < rbs_value + word_to_int(cpu_registers.RLS);
+}
+
 /*
  * Función auxiliar: logical_to_physical (ESTÁTICA)
  * Parámetros: logical_address - dirección lógica proporcionada por un programa
- * Retorna: int - dirección física correspondiente, o -1 si hay violación
+ * Retorna: int - dirección física correspondiente, -1 si hay violación, o
+ *          MEMORY_MMIO si la dirección es de un dispositivo
  * Propósito: Convertir una dirección lógica en una dirección física,
  *            aplicando protección de memoria mediante registros base y límite.
  * 
@@ -94,6 +135,11 @@ static int logical_to_physical(int logical_address) {
      * Esto permite al sistema operativo acceder a cualquier dirección.
      */
     if (rb_value == 0 && rl_value == 0) {
+        if (logical_address >= SEGMENT_WINDOW) {
+            int segment_address = segment_to_physical(logical_address, 1);
+            if (segment_address >= 0) return segment_address;
+            if (mmio_contains(logical_address)) return MEMORY_MMIO;
+        }
         return logical_address;  // Sin traducción en modo kernel
     }
     
@@ -108,6 +154,11 @@ static int logical_to_physical(int logical_address) {
      * al proceso: [RB, RB+RL-1]
      */
     if (physical_address < rb_value || physical_address >= (rb_value + rl_value)) {
+        // Fuera de la región: puede ser la ventana del segmento compartido
+        int segment_address = segment_to_physical(logical_address, 1);
+        if (segment_address >= 0) return segment_address;
+        if (mmio_contains(logical_address)) return MEMORY_MMIO;
+        
         // VIOLACIÓN DE MEMORIA: Dirección fuera del espacio asignado
         log_event(LOG_ERROR, 
                   "Violación de memoria: dirección %d fuera de límites [RB=%d, RL=%d]", 
@@ -144,6 +195,8 @@ Word read_memory(int logical_address) {
     
     // Si hubo error en la conversión (violación de límites)
     if (physical_address < 0) {
+        // Registro de un dispositivo: lo atiende su callback
+        if (physical_address == MEMORY_MMIO) return int_to_word(mmio_read(logical_address));
         Word error_word;  // Crear palabra de error
         strcpy(error_word.data, "MEM_ERR");  // "MEM_ERR" indica error de memoria
         return error_word;  // Retornar palabra de error
@@ -165,7 +218,8 @@ Word read_memory(int logical_address) {
      * Si la dirección está en el área del SO (0-299) y estamos en modo usuario,
      * se niega el acceso.
      */
-    if (physical_address < OS_RESERVED && cpu_registers.PSW.operation_mode == USER_MODE) {
+    if (physical_address < OS_RESERVED && cpu_registers.PSW.operation_mode == USER_MODE &&
+        !segment_granted(physical_address)) {
         log_event(LOG_ERROR, 
                   "Usuario intenta leer área del SO: %d", 
                   physical_address);
@@ -179,6 +233,8 @@ Word read_memory(int logical_address) {
      * PASO 4: LECTURA EXITOSA
      * Registrar la operación para depuración y retornar el valor
      */
+    METRIC_INC(memory_reads);
+    if (gdb_watch_enabled) gdb_on_memory_access(logical_address, 0);
     log_event(LOG_DEBUG, 
               "Lectura: lógica=%d -> física=%d = %s", 
               logical_address, physical_address, memory[physical_address].data);
@@ -203,6 +259,7 @@ void write_memory(int logical_address, Word word) {
     
     // Si hubo error en la conversión, terminar sin escribir
     if (physical_address < 0) {
+        if (physical_address == MEMORY_MMIO) mmio_write(logical_address, word_to_int(word));
         return;
     }
     
@@ -219,7 +276,8 @@ void write_memory(int logical_address, Word word) {
     /*
      * PASO 3: VERIFICAR PERMISOS (PROTECCIÓN KERNEL/USUARIO)
      */
-    if (physical_address < OS_RESERVED && cpu_registers.PSW.operation_mode == USER_MODE) {
+    if (physical_address < OS_RESERVED && cpu_registers.PSW.operation_mode == USER_MODE &&
+        !segment_granted(physical_address)) {
         log_event(LOG_ERROR, 
                   "Usuario intenta escribir en área del SO: %d", 
                   physical_address);
@@ -231,6 +289,9 @@ void write_memory(int logical_address, Word word) {
      * PASO 4: ESCRITURA EXITOSA
      */
     memory[physical_address] = word;  // Escribir la palabra en memoria
+    METRIC_INC(memory_writes);
+    if (gdb_watch_enabled) gdb_on_memory_access(logical_address, 1);
+    if (blockcache_enabled) blockcache_on_write(physical_address);
     
     // Registrar la operación para depuración
     log_event(LOG_DEBUG, 
@@ -238,6 +299,248 @@ void write_memory(int logical_address, Word word) {
               logical_address, physical_address, word.data);
 }
 
+/*
+ * Función auxiliar: range_to_physical (ESTÁTICA)
+ * Parámetros:
+ *   logical_address - primera dirección lógica del rango
+ *   count           - cantidad de palabras (> 0)
+ * Retorna: int - dirección física de la primera palabra, o -1 si alguna
+ *          palabra del rango sería rechazada por read_memory/write_memory
+ *          (registra el error y dispara INT_INVALID_ADDRESS)
+ * Propósito: Validar un rango completo con una sola traducción. Con RB/RL la
+ *            región del proceso es contigua, así que basta con los extremos.
+ *            Un rango que cae entero en la ventana del segmento secundario
+ *            también vale (nunca mezcla las dos regiones).
+ */
+static int range_to_physical(int logical_address, int count) {
+    int rb_value = word_to_int(cpu_registers.RB);
+    int rl_value = word_to_int(cpu_registers.RL);
+    int physical_address = logical_address;
+
+    if (logical_address >= SEGMENT_WINDOW) {
+        int segment_address = segment_to_physical(logical_address, count);
+        if (segment_address >= 0) return segment_address;
+    }
+    if (rb_value != 0 || rl_value != 0) {
+        if (logical_address < 0 || logical_address + count > rl_value) {
+            log_event(LOG_ERROR,
+                      "Violación de memoria: rango %d..%d fuera de límites [RB=%d, RL=%d]",
+                      logical_address, logical_address + count - 1, rb_value, rl_value);
+            trigger_interrupt(INT_INVALID_ADDRESS);
+            return -1;
+        }
+        physical_address = logical_address + rb_value;
+    }
+    if (physical_address < 0 || physical_address + count > MEMORY_SIZE) {
+        log_event(LOG_ERROR, "Rango físico inválido: %d..%d",
+                  physical_address, physical_address + count - 1);
+        return -1;
+    }
+    if (physical_address < OS_RESERVED && cpu_registers.PSW.operation_mode == USER_MODE) {
+        log_event(LOG_ERROR, "Usuario intenta acceder en bloque al área del SO: %d",
+                  physical_address);
+        trigger_interrupt(INT_INVALID_ADDRESS);
+        return -1;
+    }
+    return physical_address;
+}
+
+/*
+ * Función: memory_range_to_physical
+ * Parámetros:
+ *   address - primera dirección lógica del rango
+ *   count   - cantidad de palabras (> 0)
+ * Retorna: int - dirección física de la primera palabra, o -1
+ * Propósito: Para dispositivos que, como un controlador con acceso directo
+ *            a memoria, validan un búfer del proceso una vez y después lo
+ *            escriben por su dirección física.
+ */
+int memory_range_to_physical(int address, int count) {
+    if (count <= 0) return -1;
+    return range_to_physical(address, count);
+}
+
+/*
+ * Función auxiliar: after_block_write (ESTÁTICA)
+ * Propósito: Ganchos por palabra de write_memory (watchpoints de GDB y caché
+ *            de bloques) para un rango escrito en bloque.
+ */
+static void after_block_write(int logical_address, int physical_address, int count) {
+    METRIC_ADD(memory_writes, count);
+    if (gdb_watch_enabled) {
+        for (int i = 0; i < count; i++) gdb_on_memory_access(logical_address + i, 1);
+    }
+    if (blockcache_enabled) {
+        for (int i = 0; i < count; i++) blockcache_on_write(physical_address + i);
+    }
+}
+
+/*
+ * Función: copy_memory
+ * Parámetros:
+ *   destination - primera dirección lógica de destino
+ *   source      - primera dirección lógica de origen
+ *   count       - cantidad de palabras
+ * Retorna: int - 0 si se copió, -1 si algún rango es inválido (nada se copia)
+ * Propósito: Copiar palabras como memmove (el resultado es correcto aunque
+ *            los rangos se solapen).
+ */
+int copy_memory(int destination, int source, int count) {
+    if (count <= 0) return 0;
+    int from = range_to_physical(source, count);
+    if (from < 0) return -1;
+    int to = range_to_physical(destination, count);
+    if (to < 0) return -1;
+
+    if (gdb_watch_enabled) {
+        for (int i = 0; i < count; i++) gdb_on_memory_access(source + i, 0);
+    }
+    memmove(&memory[to], &memory[from], (size_t)count * sizeof(Word));
+    METRIC_ADD(memory_reads, count);
+    after_block_write(destination, to, count);
+    log_event(LOG_DEBUG, "Copia en bloque: %d palabras lógica=%d -> lógica=%d",
+              count, source, destination);
+    return 0;
+}
+
+/*
+ * Función: fill_memory
+ * Parámetros:
+ *   destination - primera dirección lógica
+ *   word        - palabra a escribir
+ *   count       - cantidad de palabras
+ * Retorna: int - 0 si se escribió, -1 si el rango es inválido (nada se escribe)
+ */
+int fill_memory(int destination, Word word, int count) {
+    if (count <= 0) return 0;
+    int to = range_to_physical(destination, count);
+    if (to < 0) return -1;
+
+    for (int i = 0; i < count; i++) memory[to + i] = word;
+    after_block_write(destination, to, count);
+    log_event(LOG_DEBUG, "Llenado en bloque: %d palabras desde lógica=%d con %s",
+              count, destination, word.data);
+    return 0;
+}
+
+/*
+ * Función: read_memory_block
+ * Parámetros:
+ *   source - primera dirección lógica
+ *   words  - salida (count palabras)
+ *   count  - cantidad de palabras
+ * Retorna: int - 0 si se leyó, -1 si el rango es inválido (words no cambia)
+ * Propósito: Copiar un rango de memoria al host (servicios del SO, DMA).
+ */
+int read_memory_block(int source, Word* words, int count) {
+    if (count <= 0) return 0;
+    int from = range_to_physical(source, count);
+    if (from < 0) return -1;
+
+    if (gdb_watch_enabled) {
+        for (int i = 0; i < count; i++) gdb_on_memory_access(source + i, 0);
+    }
+    memcpy(words, &memory[from], (size_t)count * sizeof(Word));
+    METRIC_ADD(memory_reads, count);
+    return 0;
+}
+
+/*
+ * Función: write_memory_block
+ * Parámetros:
+ *   destination - primera dirección lógica
+ *   words       - palabras a escribir
+ *   count       - cantidad de palabras
+ * Retorna: int - 0 si se escribió, -1 si el rango es inválido (nada se escribe)
+ */
+int write_memory_block(int destination, const Word* words, int count) {
+    if (count <= 0) return 0;
+    int to = range_to_physical(destination, count);
+    if (to < 0) return -1;
+
+    memcpy(&memory[to], words, (size_t)count * sizeof(Word));
+    after_block_write(destination, to, count);
+    log_event(LOG_DEBUG, "Escritura en bloque: %d palabras desde lógica=%d", count, destination);
+    return 0;
+}
+
+/*
+ * Función: copy_to_physical
+ * Parámetros:
+ *   physical - primera dirección física de destino (memoria del SO)
+ *   source   - primera dirección lógica de origen
+ *   count    - cantidad de palabras
+ * Retorna: int - 0 si se copió, -1 si el rango lógico es inválido
+ * Propósito: Copiar datos del proceso a estructuras del SO en un solo paso:
+ *            el rango del proceso se valida una vez y el destino no pasa
+ *            por la protección (el SO es dueño de esa memoria).
+ */
+int copy_to_physical(int physical, int source, int count) {
+    if (count <= 0) return 0;
+    int from = range_to_physical(source, count);
+    if (from < 0) return -1;
+    if (physical < 0 || physical + count > MEMORY_SIZE) return -1;
+
+    if (gdb_watch_enabled) {
+        for (int i = 0; i < count; i++) gdb_on_memory_access(source + i, 0);
+    }
+    memmove(&memory[physical], &memory[from], (size_t)count * sizeof(Word));
+    METRIC_ADD(memory_reads, count);
+    if (blockcache_enabled) {
+        for (int i = 0; i < count; i++) blockcache_on_write(physical + i);
+    }
+    return 0;
+}
+
+/*
+ * Función: copy_from_physical
+ * Parámetros:
+ *   destination - primera dirección lógica de destino
+ *   physical    - primera dirección física de origen (memoria del SO)
+ *   count       - cantidad de palabras
+ * Retorna: int - 0 si se copió, -1 si el rango lógico es inválido
+ */
+int copy_from_physical(int destination, int physical, int count) {
+    if (count <= 0) return 0;
+    int to = range_to_physical(destination, count);
+    if (to < 0) return -1;
+    if (physical < 0 || physical + count > MEMORY_SIZE) return -1;
+
+    memmove(&memory[to], &memory[physical], (size_t)count * sizeof(Word));
+    after_block_write(destination, to, count);
+    return 0;
+}
+
+/*
+ * Función: compare_memory
+ * Parámetros:
+ *   first, second - primeras direcciones lógicas de los rangos
+ *   count         - cantidad de palabras
+ *   index         - salida: posición de la primera diferencia, o count si son iguales
+ * Retorna: int - 0 si se compararon, -1 si algún rango es inválido
+ */
+int compare_memory(int first, int second, int count, int* index) {
+    *index = (count > 0) ? count : 0;
+    if (count <= 0) return 0;
+    int a = range_to_physical(first, count);
+    if (a < 0) return -1;
+    int b = range_to_physical(second, count);
+    if (b < 0) return -1;
+
+    int i = 0;
+    while (i < count && memcmp(memory[a + i].data, memory[b + i].data, sizeof(memory[0].data)) == 0) i++;
+    int compared = (i < count) ? i + 1 : count;  // Palabras leídas de cada rango
+    if (gdb_watch_enabled) {
+        for (int k = 0; k < compared; k++) {
+            gdb_on_memory_access(first + k, 0);
+            gdb_on_memory_access(second + k, 0);
+        }
+    }
+    METRIC_ADD(memory_reads, 2 * compared);
+    *index = i;
+    return 0;
+}
+
 /*
  * Función: is_valid_address
  * Parámetros:
@@ -301,4 +604,18 @@ void set_memory_region(int base, int limit) {
     log_event(LOG_INFO, 
               "Región de memoria configurada: RB=%d, RL=%d", 
               base, limit);
-}
\ No newline at end of file
+}
+
+/*
+ * Función: set_memory_segment
+ * Parámetros:
+ *   base  - dirección física del segmento (va a RBS)
+ *   limit - tamaño del segmento (va a RLS); 0 quita el segmento
+ * Propósito: Configurar el segmento secundario del proceso actual, visible
+ *            a partir de la dirección lógica SEGMENT_WINDOW.
+ */
+void set_memory_segment(int base, int limit) {
+    cpu_registers.RBS = int_to_word(base);
+    cpu_registers.RLS = int_to_word(limit);
+    log_event(LOG_INFO, "Segmento secundario configurado: RBS=%d, RLS=%d", base, limit);
+}
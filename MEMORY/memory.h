@@ -26,6 +26,19 @@
 #define MEMORY_SIZE 2000   // 2000 palabras de 8 dígitos cada una
 #define OS_RESERVED 300    // 300 palabras reservadas para el sistema operativo
 
+/*
+ * SEGMENTO SECUNDARIO (memoria compartida, ver SHM/shm.h)
+ * Además de la región RB/RL, un proceso puede tener un segundo segmento
+ * descrito por RBS (base física) y RLS (tamaño). Las direcciones lógicas
+ * [SEGMENT_WINDOW, SEGMENT_WINDOW + RLS) se traducen a [RBS, RBS + RLS).
+ * El segmento lo concede el SO, así que el acceso vale aunque esté dentro
+ * del área reservada.
+ *
+ * SEGMENT_WINDOW - Primera dirección lógica del segmento (mayor que cualquier
+ *                  dirección física, para no chocar con la región RB/RL)
+ */
+#define SEGMENT_WINDOW 10000
+
 /*
  * PROTOTIPOS DE FUNCIONES - Interfaz pública del módulo de memoria
  */
@@ -33,11 +46,27 @@
 /* FUNCIONES DE INICIALIZACIÓN Y CONFIGURACIÓN */
 void init_memory();                   // Inicializar toda la memoria con valores por defecto
 void set_memory_region(int base, int limit); // Configurar región de memoria para un proceso
+void set_memory_segment(int base, int limit); // Configurar el segmento secundario (limit 0 = ninguno)
 
 /* FUNCIONES DE ACCESO A MEMORIA */
 Word read_memory(int address);        // Leer una palabra de memoria (retorna Word)
 void write_memory(int address, Word word); // Escribir una palabra en memoria
 
+/*
+ * FUNCIONES DE ACCESO EN BLOQUE
+ * Validan el rango completo una sola vez (mismas reglas que read_memory /
+ * write_memory) y no modifican nada si alguna palabra sería rechazada.
+ * Retornan 0, o -1 tras registrar el error y disparar INT_INVALID_ADDRESS.
+ */
+int copy_memory(int destination, int source, int count);   // Copiar palabras (rangos solapados permitidos)
+int fill_memory(int destination, Word word, int count);    // Llenar un rango con una palabra
+int compare_memory(int first, int second, int count, int* index); // *index = primera diferencia (o count)
+int read_memory_block(int source, Word* words, int count);          // Copiar un rango al host
+int write_memory_block(int destination, const Word* words, int count); // Copiar del host a un rango
+int copy_to_physical(int physical, int source, int count);      // Rango lógico -> memoria del SO
+int copy_from_physical(int destination, int physical, int count); // Memoria del SO -> rango lógico
+int memory_range_to_physical(int address, int count); // Primera palabra física de un rango válido, o -1
+
 /* FUNCIONES DE VERIFICACIÓN Y VISUALIZACIÓN */
 bool is_valid_address(int address, bool is_kernel_mode); // Validar dirección de memoria
 void dump_memory(int start, int end); // Mostrar contenido de memoria en rango específico
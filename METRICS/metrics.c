@@ -0,0 +1,222 @@
+/*
+ * Archivo de implementación del módulo de métricas en vivo del Sistema Operativo Virtual.
+ * Contiene la creación del segmento de memoria compartida y el hilo que
+ * publica los contadores con el protocolo seqlock.
+ */
+
+/* Macro necesaria para shm_open(), ftruncate() y clock_gettime() con -std=c99 */
+#define _POSIX_C_SOURCE 200809L
+
+/* Inclusión de cabecera propia del módulo */
+#include "metrics.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../CPU/cpu.h"         // Para cpu_instructions_retired y get_cpu_state
+#include "../LOGGER/logger.h"   // Para registrar la creación del segmento
+#include "../MMIO/mmio.h"       // Para registrar los contadores mapeados
+#include "../CPU/blockcache.h"  // Para blockcache_in_flight
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>      // Para snprintf
+#include <string.h>     // Para memset, strerror
+#include <errno.h>      // Para errno
+#include <time.h>       // Para clock_gettime, nanosleep
+#include <fcntl.h>      // Para O_CREAT, O_RDWR
+#include <unistd.h>     // Para ftruncate, close, getpid
+#include <pthread.h>    // Para el hilo publicador
+#include <sys/mman.h>   // Para shm_open, mmap
+
+/*
+ * VARIABLE GLOBAL - Contadores locales del proceso
+ */
+MetricsCounters metrics;
+
+/*
+ * VARIABLES GLOBALES ESTÁTICAS
+ * Solo accesibles dentro de este archivo (encapsulación)
+ */
+static MetricsSegment* segment = NULL;        // Segmento mapeado (NULL = sin publicar)
+static char segment_name[64] = "";            // Nombre POSIX del segmento
+static pthread_t publisher;                   // Hilo publicador
+static volatile int publisher_running = 0;    // 0 = el hilo debe terminar
+static struct timespec start_time;            // Momento de init_metrics()
+static unsigned long long last_retired = 0;   // Instrucciones en la publicación anterior
+static unsigned long long last_ms = 0;        // Tiempo de la publicación anterior
+
+/*
+ * Función auxiliar: elapsed_ms (ESTÁTICA)
+ * Retorna: unsigned long long - milisegundos desde init_metrics()
+ */
+static unsigned long long elapsed_ms() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)(now.tv_sec - start_time.tv_sec) * 1000ULL +
+           (now.tv_nsec - start_time.tv_nsec) / 1000000;
+}
+
+/*
+ * Función auxiliar: publish (ESTÁTICA)
+ * Propósito: Copiar los contadores locales al segmento compartido.
+ * Es el único escritor del segmento, así que basta el seqlock (sin mutex).
+ * Las lecturas de 'metrics' no se sincronizan con sus escritores: un valor
+ * puede llegar con un periodo de retraso, pero nunca se detiene a la CPU.
+ */
+static void publish(int running) {
+    unsigned long long now = elapsed_ms();
+    unsigned long long retired = cpu_instructions_retired;
+    double mips = 0.0;
+    if (now > last_ms) {
+        mips = (double)(retired - last_retired) / ((now - last_ms) * 1000.0);
+    }
+    last_retired = retired;
+    last_ms = now;
+
+    segment->sequence++;          // Impar: escritura en curso
+    __sync_synchronize();
+
+    segment->running = running;
+    segment->cpu_state = (int)get_cpu_state();
+    segment->uptime_ms = now;
+    segment->mips = mips;
+    segment->counters = metrics;
+    segment->counters.instructions_retired = retired;
+
+    __sync_synchronize();
+    segment->sequence++;          // Par: datos consistentes
+}
+
+/*
+ * Función: publisher_thread (función auxiliar estática)
+ * Propósito: Publicar los contadores cada METRICS_PUBLISH_MS milisegundos.
+ */
+static void* publisher_thread(void* arg) {
+    struct timespec period = {0, METRICS_PUBLISH_MS * 1000000L};
+    (void)arg;
+    while (publisher_running) {
+        publish(1);
+        nanosleep(&period, NULL);
+    }
+    return NULL;
+}
+
+/*
+ * REGISTROS MAPEADOS EN MEMORIA (ESTÁTICO, ver MMIO/mmio.h)
+ * Solo lectura; cada contador se entrega módulo METRICS_MMIO_MOD para que
+ * quepa en una palabra.
+ */
+#define METRICS_MMIO_MOD 10000000ULL
+
+static int mmio_read_register(int offset) {
+    unsigned long long value = 0;
+    switch (offset) {
+        case 0: value = cpu_instructions_retired + blockcache_in_flight; break;
+        case 1: value = metrics.memory_reads; break;
+        case 2: value = metrics.memory_writes; break;
+        default:
+            for (int v = 0; v < METRICS_VECTORS; v++) value += metrics.interrupts[v];
+            break;
+    }
+    return (int)(value % METRICS_MMIO_MOD);
+}
+
+/*
+ * Función: init_metrics
+ * Propósito: Crear el segmento "/sistema_metrics.<pid>" e iniciar el hilo
+ *            publicador. Si el segmento no se puede crear, los contadores
+ *            siguen funcionando localmente y solo se registra una advertencia.
+ */
+void init_metrics() {
+    memset(&metrics, 0, sizeof(metrics));
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    last_retired = cpu_instructions_retired;
+    last_ms = 0;
+    mmio_register("metricas", MMIO_METRICS_BASE, 4, mmio_read_register, NULL);
+
+    snprintf(segment_name, sizeof(segment_name), "%s%d", METRICS_SHM_PREFIX, (int)getpid());
+    int fd = shm_open(segment_name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        log_event(LOG_WARNING, "Métricas: no se pudo crear %s (%s)", segment_name, strerror(errno));
+        return;
+    }
+    if (ftruncate(fd, sizeof(MetricsSegment)) != 0) {
+        log_event(LOG_WARNING, "Métricas: ftruncate falló (%s)", strerror(errno));
+        close(fd);
+        shm_unlink(segment_name);
+        return;
+    }
+    void* mapped = mmap(NULL, sizeof(MetricsSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // El mapeo sigue siendo válido tras cerrar el descriptor
+    if (mapped == MAP_FAILED) {
+        log_event(LOG_WARNING, "Métricas: mmap falló (%s)", strerror(errno));
+        shm_unlink(segment_name);
+        return;
+    }
+
+    segment = (MetricsSegment*)mapped;
+    memset(segment, 0, sizeof(MetricsSegment));
+    segment->version = METRICS_VERSION;
+    segment->pid = (int)getpid();
+    publish(1);
+    __sync_synchronize();
+    segment->magic = METRICS_MAGIC;  // Último: el segmento ya es legible
+
+    publisher_running = 1;
+    if (pthread_create(&publisher, NULL, publisher_thread, NULL) != 0) {
+        publisher_running = 0;
+        log_event(LOG_WARNING, "Métricas: no se pudo crear el hilo publicador");
+    }
+    log_event(LOG_INFO, "Métricas publicadas en %s", segment_name);
+}
+
+/*
+ * Función: metrics_report
+ * Propósito: Mostrar las estadísticas acumuladas de la sesión: instrucciones
+ *            retiradas, instrucciones por segundo (promedio de la sesión y del
+ *            último periodo publicado), interrupciones, DMA y accesos a memoria.
+ */
+void metrics_report() {
+    unsigned long long uptime = elapsed_ms();
+    unsigned long long retired = cpu_instructions_retired;
+    unsigned long long interrupts = 0;
+    for (int v = 0; v < METRICS_VECTORS; v++) interrupts += metrics.interrupts[v];
+
+    printf("\n=== ESTADÍSTICAS DE LA SESIÓN ===\n");
+    printf("Tiempo activo:           %llu.%03llu s\n", uptime / 1000, uptime % 1000);
+    printf("Instrucciones retiradas: %llu\n", retired);
+    printf("Instrucciones/segundo:   %.0f (promedio de la sesión)\n",
+           uptime > 0 ? retired * 1000.0 / uptime : 0.0);
+    if (segment != NULL) {
+        printf("                         %.0f (último periodo de %d ms)\n",
+               segment->mips * 1e6, METRICS_PUBLISH_MS);
+    }
+    printf("Interrupciones:          %llu", interrupts);
+    for (int v = 0; v < METRICS_VECTORS; v++) {
+        if (metrics.interrupts[v] > 0) printf("  [%d]=%llu", v, metrics.interrupts[v]);
+    }
+    printf("\n");
+    printf("Transferencias DMA:      %llu (%llu bytes)\n", metrics.dma_transfers, metrics.dma_bytes);
+    printf("Accesos a memoria:       %llu (%llu lecturas, %llu escrituras)\n",
+           metrics.memory_reads + metrics.memory_writes, metrics.memory_reads, metrics.memory_writes);
+    printf("Operaciones de disco:    %llu lecturas, %llu escrituras, %llu búsquedas\n",
+           metrics.disk_reads, metrics.disk_writes, metrics.disk_seeks);
+    printf("=================================\n");
+}
+
+/*
+ * Función: close_metrics
+ * Propósito: Detener el publicador, publicar el estado final con running = 0
+ *            (para que vmtop lo muestre al terminar) y eliminar el segmento.
+ */
+void close_metrics() {
+    if (segment == NULL) return;
+
+    if (publisher_running) {
+        publisher_running = 0;
+        pthread_join(publisher, NULL);
+    }
+    publish(0);
+
+    munmap(segment, sizeof(MetricsSegment));
+    shm_unlink(segment_name);
+    segment = NULL;
+}
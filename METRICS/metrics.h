@@ -0,0 +1,102 @@
+/*
+ * Archivo de cabecera del módulo de métricas en vivo del Sistema Operativo Virtual.
+ * Los módulos incrementan contadores locales del proceso (sin bloqueos) y un
+ * hilo publicador los copia periódicamente a un segmento de memoria compartida
+ * POSIX protegido por un seqlock, desde donde los lee la herramienta vmtop
+ * sin detener ni adjuntarse a la máquina virtual.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+/*
+ * CONSTANTES DEL SEGMENTO COMPARTIDO
+ * METRICS_SHM_PREFIX  - Nombre del segmento: prefijo + PID del emulador
+ * METRICS_MAGIC       - Identifica un segmento válido ("VMMT")
+ * METRICS_VERSION     - Se incrementa al cambiar el formato de MetricsSegment
+ * METRICS_PUBLISH_MS  - Periodo del hilo publicador
+ * METRICS_VECTORS     - Cantidad de vectores de interrupción (ver InterruptCode)
+ */
+#define METRICS_SHM_PREFIX "/sistema_metrics."
+#define METRICS_MAGIC 0x544D4D56u
+#define METRICS_VERSION 3
+#define METRICS_PUBLISH_MS 250
+#define METRICS_VECTORS 9
+
+/*
+ * Enum: MetricsCache
+ * Propósito: Cachés del emulador cuyas tasas de acierto se publican.
+ */
+typedef enum {
+    METRICS_CACHE_DECODE,   // Instrucciones ya decodificadas
+    METRICS_CACHE_DISK,     // Bloques del disco en memoria del host
+    METRICS_CACHE_COUNT
+} MetricsCache;
+
+/*
+ * Estructura: MetricsCounters
+ * Propósito: Contadores acumulados desde el inicio del sistema.
+ * Cada campo tiene casi siempre un único escritor (la CPU, el hilo del DMA o
+ * el logger bajo su propio mutex), así que se incrementan sin bloqueos; si
+ * el DMA y la CPU coinciden en memory_writes puede perderse algún incremento,
+ * lo que es aceptable para contadores estadísticos.
+ */
+typedef struct {
+    unsigned long long instructions_retired;           // Copiado de la CPU al publicar
+    unsigned long long interrupts[METRICS_VECTORS];    // Interrupciones atendidas por vector
+    unsigned long long dma_transfers;                  // Transferencias DMA completadas
+    unsigned long long dma_bytes;                      // Bytes movidos por el DMA
+    unsigned long long disk_reads;                     // Sectores leídos
+    unsigned long long disk_writes;                    // Sectores escritos
+    unsigned long long disk_seeks;                     // Accesos no secuenciales (ver move_head)
+    unsigned long long memory_reads;                   // read_memory() exitosas
+    unsigned long long memory_writes;                  // write_memory() exitosas
+    unsigned long long cache_hits[METRICS_CACHE_COUNT];
+    unsigned long long cache_misses[METRICS_CACHE_COUNT];
+    unsigned long long context_switches;               // Guardados de contexto y cambios de modo
+    unsigned long long log_messages;                   // Mensajes escritos en el log
+    unsigned long long log_drops;                      // Mensajes que no se pudieron escribir
+} MetricsCounters;
+
+/*
+ * Estructura: MetricsSegment
+ * Propósito: Contenido del segmento de memoria compartida.
+ *
+ * Protocolo seqlock: el publicador incrementa 'sequence' (queda impar),
+ * copia los datos y vuelve a incrementarla (queda par). Un lector copia el
+ * segmento y reintenta si la secuencia era impar o cambió durante la copia.
+ */
+typedef struct {
+    unsigned int magic;                  // METRICS_MAGIC
+    unsigned int version;                // METRICS_VERSION
+    volatile unsigned int sequence;      // Contador del seqlock
+    int pid;                             // PID del emulador
+    int running;                         // 1 mientras el emulador esté activo
+    int cpu_state;                       // CPU_State actual
+    unsigned long long uptime_ms;        // Milisegundos desde init_metrics()
+    double mips;                         // Instrucciones por segundo en el último periodo (millones)
+    MetricsCounters counters;
+} MetricsSegment;
+
+/*
+ * DECLARACIÓN DE VARIABLE GLOBAL EXTERNA
+ * metrics - Contadores locales del proceso; los módulos los incrementan con
+ *           las macros METRIC_INC / METRIC_ADD.
+ */
+extern MetricsCounters metrics;
+
+#define METRIC_INC(field) ((void)(metrics.field++))
+#define METRIC_ADD(field, n) ((void)(metrics.field += (n)))
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del módulo de métricas
+ */
+void init_metrics();    // Crear el segmento e iniciar el hilo publicador
+void close_metrics();   // Publicar el estado final, detener el hilo y eliminar el segmento
+void metrics_report();  // Mostrar en consola las estadísticas de la sesión (comando 'stats')
+
+#endif /* METRICS_H */
@@ -0,0 +1,190 @@
+/*
+ * Herramienta vmtop del Sistema Operativo Virtual.
+ * Lee el segmento de métricas publicado por un sistema.exe en ejecución y lo
+ * muestra refrescando una vez por segundo, sin adjuntarse al proceso.
+ *
+ * Uso:
+ *   vmtop.exe [pid] [-n refrescos]
+ * Sin pid se usa el primer segmento /sistema_metrics.* de un emulador vivo.
+ */
+
+/* Macro necesaria para shm_open() y nanosleep() con -std=c99 */
+#define _POSIX_C_SOURCE 200809L
+
+/* Inclusión de cabeceras de otros módulos */
+#include "metrics.h"   // Formato del segmento compartido
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>      // Para printf, snprintf
+#include <stdlib.h>     // Para atoi
+#include <string.h>     // Para strncmp, strcmp
+#include <time.h>       // Para nanosleep
+#include <fcntl.h>      // Para O_RDONLY
+#include <unistd.h>     // Para close
+#include <dirent.h>     // Para recorrer /dev/shm
+#include <errno.h>      // Para ESRCH
+#include <signal.h>     // Para kill (¿sigue vivo el emulador?)
+#include <sys/mman.h>   // Para shm_open, mmap
+
+/*
+ * Nombres de los vectores de interrupción (mismo orden que InterruptCode)
+ */
+static const char* vector_names[METRICS_VECTORS] = {
+    "syscall inválida", "int. inválida", "syscall", "reloj", "fin de E/S",
+    "instr. inválida", "dir. inválida", "underflow", "overflow"
+};
+
+static const char* cache_names[METRICS_CACHE_COUNT] = { "decodificación", "disco" };
+
+/*
+ * Función auxiliar: process_alive (ESTÁTICA)
+ * Retorna: int - 0 si el proceso ya no existe (segmento huérfano de un
+ *          emulador que terminó sin close_metrics), 1 en otro caso
+ */
+static int process_alive(int pid) {
+    return !(kill(pid, 0) != 0 && errno == ESRCH);
+}
+
+/*
+ * Función auxiliar: find_segment (ESTÁTICA)
+ * Parámetros: name - buffer de salida, size - tamaño del buffer
+ * Retorna: int - 0 si se encontró un segmento de un emulador vivo, -1 si no
+ */
+static int find_segment(char* name, size_t size) {
+    const char* prefix = METRICS_SHM_PREFIX + 1;  // En /dev/shm aparece sin '/'
+    DIR* dir = opendir("/dev/shm");
+    if (!dir) return -1;
+
+    struct dirent* entry;
+    int found = -1;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strncmp(entry->d_name, prefix, strlen(prefix)) == 0 &&
+            process_alive(atoi(entry->d_name + strlen(prefix)))) {
+            snprintf(name, size, "/%s", entry->d_name);
+            found = 0;
+            break;
+        }
+    }
+    closedir(dir);
+    return found;
+}
+
+/*
+ * Función auxiliar: read_snapshot (ESTÁTICA)
+ * Parámetros:
+ *   shared - segmento mapeado
+ *   out    - copia consistente de salida
+ * Propósito: Lado lector del seqlock: reintenta mientras el publicador esté
+ *            escribiendo (secuencia impar) o la secuencia cambie durante la copia.
+ */
+static void read_snapshot(const MetricsSegment* shared, MetricsSegment* out) {
+    unsigned int before, after;
+    do {
+        before = shared->sequence;
+        __sync_synchronize();
+        memcpy(out, (const void*)shared, sizeof(MetricsSegment));
+        __sync_synchronize();
+        after = shared->sequence;
+    } while ((before & 1) || before != after);
+}
+
+/*
+ * Función auxiliar: hit_rate (ESTÁTICA)
+ * Propósito: Mostrar la tasa de aciertos de una caché (o "sin datos").
+ */
+static void hit_rate(const char* name, unsigned long long hits, unsigned long long misses) {
+    if (hits + misses == 0) {
+        printf("  %-16s sin datos\n", name);
+    } else {
+        printf("  %-16s %6.1f%%  (%llu aciertos, %llu fallos)\n", name,
+               100.0 * hits / (hits + misses), hits, misses);
+    }
+}
+
+/*
+ * Función auxiliar: show (ESTÁTICA)
+ * Propósito: Dibujar una pantalla con la instantánea.
+ */
+static void show(const MetricsSegment* s, const char* name) {
+    static const char* states[] = { "RUNNING", "HALTED", "WAITING" };
+    const MetricsCounters* c = &s->counters;
+
+    printf("\033[H\033[2J");  // Cursor al inicio y limpiar pantalla (ANSI)
+    printf("vmtop - %s (pid %d)  activo %llu.%llus  CPU %s%s\n\n", name, s->pid,
+           s->uptime_ms / 1000, (s->uptime_ms / 100) % 10,
+           (s->cpu_state >= 0 && s->cpu_state <= 2) ? states[s->cpu_state] : "?",
+           s->running ? "" : "  [FINALIZADO]");
+
+    printf("Instrucciones retiradas: %llu\n", c->instructions_retired);
+    printf("MIPS del invitado:       %.4f (%.0f instr/s)\n", s->mips, s->mips * 1e6);
+    printf("Cambios de contexto:     %llu\n", c->context_switches);
+    printf("DMA:                     %llu transferencias, %llu bytes\n", c->dma_transfers, c->dma_bytes);
+    printf("Disco:                   %llu lecturas, %llu escrituras, %llu búsquedas\n",
+           c->disk_reads, c->disk_writes, c->disk_seeks);
+    printf("Memoria:                 %llu lecturas, %llu escrituras\n", c->memory_reads, c->memory_writes);
+    printf("Log:                     %llu mensajes, %llu descartados\n\n", c->log_messages, c->log_drops);
+
+    printf("Interrupciones atendidas:\n");
+    for (int v = 0; v < METRICS_VECTORS; v++) {
+        printf("  %d %-16s %llu\n", v, vector_names[v], c->interrupts[v]);
+    }
+    printf("\nCachés:\n");
+    for (int k = 0; k < METRICS_CACHE_COUNT; k++) {
+        hit_rate(cache_names[k], c->cache_hits[k], c->cache_misses[k]);
+    }
+    fflush(stdout);
+}
+
+/*
+ * Función: main
+ * Propósito: Abrir el segmento en solo lectura y refrescar cada segundo
+ *            hasta que el emulador termine (o se alcance -n).
+ */
+int main(int argc, char* argv[]) {
+    char name[128] = "";
+    int refreshes = -1;  // -1 = sin límite
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            refreshes = atoi(argv[++i]);
+        } else if (argv[i][0] >= '0' && argv[i][0] <= '9') {
+            snprintf(name, sizeof(name), "%s%s", METRICS_SHM_PREFIX, argv[i]);
+        } else {
+            printf("Uso: %s [pid] [-n refrescos]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (name[0] == '\0' && find_segment(name, sizeof(name)) != 0) {
+        printf("No hay ningún sistema.exe publicando métricas.\n");
+        return 1;
+    }
+
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        printf("No se pudo abrir %s\n", name);
+        return 1;
+    }
+    const MetricsSegment* shared = mmap(NULL, sizeof(MetricsSegment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shared == MAP_FAILED) {
+        printf("No se pudo mapear %s\n", name);
+        return 1;
+    }
+    if (shared->magic != METRICS_MAGIC || shared->version != METRICS_VERSION) {
+        printf("%s no tiene el formato esperado (versión %u)\n", name, shared->version);
+        return 1;
+    }
+
+    struct timespec second = {1, 0};
+    MetricsSegment snapshot;
+    while (refreshes != 0) {
+        read_snapshot(shared, &snapshot);
+        show(&snapshot, name);
+        if (!snapshot.running || !process_alive(snapshot.pid)) break;  // El emulador terminó
+        if (refreshes > 0) refreshes--;
+        if (refreshes != 0) nanosleep(&second, NULL);
+    }
+    printf("\n");
+    munmap((void*)shared, sizeof(MetricsSegment));
+    return 0;
+}
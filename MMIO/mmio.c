@@ -0,0 +1,141 @@
+/*
+ * Archivo de implementación de la región de E/S mapeada en memoria del Sistema Operativo Virtual.
+ * Cada palabra de la ventana guarda directamente qué dispositivo la atiende,
+ * así que despachar un acceso es una indexación y no una búsqueda.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "mmio.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../INTERRUPTS/interrupts.h" // Para INT_INVALID_ADDRESS
+#include "../LOGGER/logger.h"         // Para registrar eventos
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf
+#include <stddef.h>   // Para NULL
+
+/*
+ * Estructura: MmioDevice
+ * Propósito: Dispositivo registrado en la ventana.
+ */
+typedef struct {
+    const char* name;
+    int base;
+    int size;
+    MmioRead read;
+    MmioWrite write;
+    unsigned long long reads;     // Accesos atendidos (para mmio_status)
+    unsigned long long writes;
+} MmioDevice;
+
+/*
+ * VARIABLES GLOBALES DEL MÓDULO (privadas)
+ * owner - para cada palabra de la ventana, índice + 1 del dispositivo que
+ *         la atiende (0 = sin dispositivo)
+ */
+static MmioDevice devices[MMIO_MAX_DEVICES];
+static int device_count = 0;
+static unsigned char owner[MMIO_SIZE];
+
+/*
+ * Función: init_mmio
+ */
+void init_mmio() {
+    device_count = 0;
+    for (int i = 0; i < MMIO_SIZE; i++) owner[i] = 0;
+}
+
+/*
+ * Función: mmio_register
+ */
+int mmio_register(const char* name, int base, int size, MmioRead read, MmioWrite write) {
+    int offset = base - MMIO_BASE;
+    if (size <= 0 || offset < 0 || offset + size > MMIO_SIZE || device_count == MMIO_MAX_DEVICES) {
+        log_event(LOG_ERROR, "MMIO: registro inválido de %s en %d (%d palabras)", name, base, size);
+        return -1;
+    }
+    for (int i = 0; i < size; i++) {
+        if (owner[offset + i] != 0) {
+            log_event(LOG_ERROR, "MMIO: %s se solapa con %s en %d",
+                      name, devices[owner[offset + i] - 1].name, base + i);
+            return -1;
+        }
+    }
+
+    MmioDevice* d = &devices[device_count++];
+    d->name = name;
+    d->base = base;
+    d->size = size;
+    d->read = read;
+    d->write = write;
+    d->reads = d->writes = 0;
+    for (int i = 0; i < size; i++) owner[offset + i] = (unsigned char)device_count;
+    log_event(LOG_INFO, "MMIO: %s registrado en %d-%d", name, base, base + size - 1);
+    return 0;
+}
+
+/*
+ * Función: mmio_contains
+ * Propósito: Una sola comparación sin signo cubre los dos extremos.
+ */
+int mmio_contains(int address) {
+    return (unsigned int)(address - MMIO_BASE) < (unsigned int)MMIO_SIZE;
+}
+
+/*
+ * Función auxiliar: device_at (ESTÁTICA)
+ * Retorna: MmioDevice* - dispositivo de la dirección, o NULL (registra el
+ *          error y dispara INT_INVALID_ADDRESS)
+ */
+static MmioDevice* device_at(int address) {
+    int index = mmio_contains(address) ? owner[address - MMIO_BASE] : 0;
+    if (index == 0) {
+        log_event(LOG_ERROR, "MMIO: ningún dispositivo en la dirección %d", address);
+        trigger_interrupt(INT_INVALID_ADDRESS);
+        return NULL;
+    }
+    return &devices[index - 1];
+}
+
+/*
+ * Función: mmio_read
+ * Parámetros: address - dirección lógica dentro de la ventana
+ * Retorna: int - valor del registro (0 si no hay dispositivo o no se lee)
+ */
+int mmio_read(int address) {
+    MmioDevice* d = device_at(address);
+    if (d == NULL) return 0;
+    d->reads++;
+    return (d->read != NULL) ? d->read(address - d->base) : 0;
+}
+
+/*
+ * Función: mmio_write
+ * Parámetros:
+ *   address - dirección lógica dentro de la ventana
+ *   value   - valor escrito
+ */
+void mmio_write(int address, int value) {
+    MmioDevice* d = device_at(address);
+    if (d == NULL) return;
+    d->writes++;
+    if (d->write != NULL) d->write(address - d->base, value);
+}
+
+/*
+ * Función: mmio_status
+ */
+void mmio_status() {
+    printf("\n=== E/S MAPEADA EN MEMORIA ===\n");
+    printf("Ventana lógica:       %d-%d\n", MMIO_BASE, MMIO_BASE + MMIO_SIZE - 1);
+    if (device_count > 0) printf("\n  DISPOSITIVO   DIRECCIONES   LECTURAS   ESCRITURAS\n");
+    for (int i = 0; i < device_count; i++) {
+        const MmioDevice* d = &devices[i];
+        printf("  %-12s %5d-%-6d %10llu %12llu\n", d->name, d->base, d->base + d->size - 1,
+               d->reads, d->writes);
+    }
+    if (device_count > 0) printf("\n");
+    printf("Dispositivos:         %d de %d\n", device_count, MMIO_MAX_DEVICES);
+    printf("==============================\n");
+}
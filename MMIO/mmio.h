@@ -0,0 +1,91 @@
+/*
+ * Archivo de cabecera de la región de E/S mapeada en memoria del Sistema Operativo Virtual.
+ *
+ * Las direcciones lógicas [MMIO_BASE, MMIO_BASE + MMIO_SIZE) no son memoria:
+ * cada rango pertenece a un dispositivo, que lo registra con mmio_register()
+ * al iniciarse indicando qué hacer al leer y al escribir cada palabra. Así
+ * un dispositivo nuevo se agrega sin tocar el switch de opcodes de la CPU:
+ * el programa usa LOAD/STORE (o cualquier instrucción con operando en
+ * memoria) sobre sus registros.
+ *
+ * La ventana solo se consulta cuando la dirección ya no cayó en la región
+ * RB/RL ni en el segmento secundario (ver MEMORY/memory.c), así que los
+ * accesos a RAM no pagan nada extra. Las instrucciones de bloque (MOVB,
+ * FILL, CMPB) y los búferes de los SVC no llegan a los dispositivos.
+ *
+ * MAPA DE DISPOSITIVOS (desplazamiento desde MMIO_BASE)
+ *   MMIO_TERMINAL_BASE - terminal (TERMINAL/terminal.h)
+ *       +0 DATOS    lectura: como IN; escritura: como OUT
+ *       +1 CONTROL  lectura: caracteres disponibles; escritura: comando TERM_CTL_*
+ *   MMIO_DMA_BASE      - canal DMA (DMA/dma.h)
+ *       +0 DIRECCIÓN  dirección de memoria de la transferencia
+ *       +1 UBICACIÓN  cilindro(2) pista(2) sector(2), como DMA_CONFIG
+ *       +2 TAMAÑO     palabras a transferir
+ *       +3 COMANDO    escritura: 0 leer del disco, 1 escribir al disco,
+ *                     2 esperar; lectura: estado de la última operación
+ *   MMIO_METRICS_BASE  - contadores (METRICS/metrics.h), solo lectura,
+ *                        módulo 10^7
+ *       +0 instrucciones ejecutadas   +1 lecturas de memoria
+ *       +2 escrituras de memoria      +3 interrupciones atendidas
+ *   MMIO_NET_BASE      - placa de red, 10 registros (NET/net.h)
+ */
+
+#ifndef MMIO_H
+#define MMIO_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../MEMORY/memory.h"   // Para SEGMENT_WINDOW
+
+/*
+ * CONSTANTES DE LA VENTANA
+ * MMIO_BASE        - Primera dirección lógica (después de la ventana del
+ *                    segmento secundario, para no chocar con ninguna región)
+ * MMIO_SIZE        - Palabras de la ventana
+ * MMIO_MAX_DEVICES - Dispositivos registrados como máximo
+ */
+#define MMIO_BASE (2 * SEGMENT_WINDOW)
+#define MMIO_SIZE 1000
+#define MMIO_MAX_DEVICES 16
+
+#define MMIO_TERMINAL_BASE (MMIO_BASE + 0)
+#define MMIO_DMA_BASE (MMIO_BASE + 10)
+#define MMIO_METRICS_BASE (MMIO_BASE + 20)
+#define MMIO_NET_BASE (MMIO_BASE + 30)
+
+/*
+ * Tipos: MmioRead / MmioWrite
+ * Parámetros:
+ *   offset - palabra dentro del rango del dispositivo (0 = la primera)
+ *   value  - valor escrito
+ * Retorna (MmioRead): int - valor para la palabra leída
+ */
+typedef int (*MmioRead)(int offset);
+typedef void (*MmioWrite)(int offset, int value);
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública de la región MMIO
+ */
+void init_mmio();                      // Vaciar la tabla de dispositivos
+
+/*
+ * Función: mmio_register
+ * Parámetros:
+ *   name  - nombre para el listado y el registro de eventos
+ *   base  - primera dirección lógica (dentro de la ventana)
+ *   size  - palabras del rango
+ *   read  - callback de lectura (NULL = se lee 0)
+ *   write - callback de escritura (NULL = se ignora)
+ * Retorna: int - 0, o -1 si el rango sale de la ventana, se solapa con otro
+ *          dispositivo o la tabla está llena
+ */
+int mmio_register(const char* name, int base, int size, MmioRead read, MmioWrite write);
+
+int mmio_contains(int address);        // 1 si la dirección cae en la ventana
+int mmio_read(int address);            // Leer un registro (la llama read_memory)
+void mmio_write(int address, int value); // Escribir un registro (la llama write_memory)
+void mmio_status();                    // Mostrar los dispositivos registrados
+
+#endif /* MMIO_H */
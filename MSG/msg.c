@@ -0,0 +1,171 @@
+/*
+ * Archivo de implementación de los buzones de mensajes del Sistema Operativo Virtual.
+ * El estado de cada buzón vive en la memoria del SO; este módulo solo
+ * lleva la cuenta total de entregas para los benchmarks.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "msg.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../REGISTERS/registers.h"   // Para word_to_int, int_to_word
+#include "../SYSCALL/syscall.h"       // Para registrar los servicios
+#include "../CPU/blockcache.h"        // Para invalidar bloques traducidos
+#include "../LOGGER/logger.h"         // Para registrar esperas imposibles
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf
+
+/*
+ * CONSTANTES INTERNAS
+ * MSG_COUNTER_MOD - Módulo del contador de entregas guardado en el buzón
+ */
+#define MSG_COUNTER_MOD 10000000
+
+static unsigned long long delivered = 0;
+
+/*
+ * Funciones auxiliares de la cabecera (ESTÁTICAS)
+ * box_base - dirección física del buzón
+ * field / set_field - palabra 'index' de la cabecera
+ */
+static int box_base(int box) {
+    return MSG_AREA_START + box * MSG_BOX_WORDS;
+}
+
+static int field(int base, int index) {
+    return word_to_int(memory[base + index]);
+}
+
+static void set_field(int base, int index, int value) {
+    memory[base + index] = int_to_word(value);
+    if (blockcache_enabled) blockcache_on_write(base + index);
+}
+
+/*
+ * Función: msg_send
+ * Parámetros:
+ *   box      - buzón
+ *   address  - dirección lógica del mensaje
+ *   count    - palabras (1 a MSG_MAX_WORDS)
+ *   blocking - 1 para la variante bloqueante
+ * Retorna: int - 0, o un código de error
+ */
+int msg_send(int box, int address, int count, int blocking) {
+    if (box < 0 || box >= MSG_MAILBOXES || count < 1 || count > MSG_MAX_WORDS) return MSG_ERR_INVALID;
+    int base = box_base(box);
+    int queued = field(base, 1);
+    if (queued >= MSG_SLOTS) {
+        if (!blocking) return MSG_ERR_FULL;
+        log_event(LOG_ERROR, "Envío bloqueante al buzón %d lleno: ningún proceso puede vaciarlo", box);
+        return MSG_ERR_DEADLOCK;
+    }
+
+    int slot = base + MSG_HEADER_WORDS + ((field(base, 0) + queued) % MSG_SLOTS) * MSG_SLOT_WORDS;
+    if (copy_to_physical(slot + 1, address, count) != 0) return SYSCALL_ERR_ADDRESS;
+    set_field(slot, 0, count);
+    set_field(base, 1, queued + 1);
+    return 0;
+}
+
+/*
+ * Función: msg_receive
+ * Parámetros:
+ *   box      - buzón
+ *   address  - dirección lógica del búfer
+ *   max      - palabras que caben en el búfer (>= 1)
+ *   blocking - 1 para la variante bloqueante
+ * Retorna: int - palabras copiadas, o un código de error
+ */
+int msg_receive(int box, int address, int max, int blocking) {
+    if (box < 0 || box >= MSG_MAILBOXES || max < 1) return MSG_ERR_INVALID;
+    int base = box_base(box);
+    int queued = field(base, 1);
+    if (queued == 0) {
+        if (!blocking) return MSG_ERR_EMPTY;
+        log_event(LOG_ERROR, "Recepción bloqueante del buzón %d vacío: ningún proceso puede llenarlo", box);
+        return MSG_ERR_DEADLOCK;
+    }
+
+    int first = field(base, 0);
+    int slot = base + MSG_HEADER_WORDS + first * MSG_SLOT_WORDS;
+    int count = field(slot, 0);
+    if (count > max) count = max;
+    if (copy_from_physical(address, slot + 1, count) != 0) return SYSCALL_ERR_ADDRESS;
+    set_field(base, 0, (first + 1) % MSG_SLOTS);
+    set_field(base, 1, queued - 1);
+    set_field(base, 2, (field(base, 2) + 1) % MSG_COUNTER_MOD);
+    delivered++;
+    return count;
+}
+
+/*
+ * Función: msg_delivered
+ */
+unsigned long long msg_delivered() {
+    return delivered;
+}
+
+/*
+ * Función: msg_status
+ */
+void msg_status() {
+    printf("\n=== BUZONES DE MENSAJES ===\n");
+    printf("Área del SO:          físicas %d-%d (%d buzones de %d mensajes de hasta %d palabras)\n",
+           MSG_AREA_START, MSG_AREA_START + MSG_AREA_WORDS - 1, MSG_MAILBOXES, MSG_SLOTS, MSG_MAX_WORDS);
+    printf("\n  BUZÓN  EN COLA  ENTREGADOS\n");
+    for (int box = 0; box < MSG_MAILBOXES; box++) {
+        int base = box_base(box);
+        printf("  %5d %8d %11d\n", box, field(base, 1), field(base, 2));
+    }
+    printf("\nEntregados:           %llu\n", delivered);
+    printf("===========================\n");
+}
+
+/*
+ * Función: msg_error_text
+ */
+const char* msg_error_text(int code) {
+    switch (code) {
+        case MSG_ERR_INVALID:  return "buzón o largo inválidos";
+        case MSG_ERR_FULL:     return "buzón lleno";
+        case MSG_ERR_EMPTY:    return "buzón vacío";
+        case MSG_ERR_DEADLOCK: return "la espera no terminaría nunca";
+        default:               return "error desconocido";
+    }
+}
+
+/*
+ * SERVICIOS SVC (ESTÁTICOS)
+ */
+static int svc_send(const int* args) { return msg_send(args[0], args[1], args[2], 1); }
+static int svc_receive(const int* args) { return msg_receive(args[0], args[1], args[2], 1); }
+static int svc_trysend(const int* args) { return msg_send(args[0], args[1], args[2], 0); }
+static int svc_tryreceive(const int* args) { return msg_receive(args[0], args[1], args[2], 0); }
+
+/*
+ * Función: msg_reset
+ * Propósito: Dejar vacíos todos los buzones (el área del SO no tiene ceros
+ *            al arrancar) y la cuenta de entregas, sin tocar los SVC
+ *            (bench.exe --verify la usa después de cada init_memory).
+ */
+void msg_reset() {
+    Word zero = int_to_word(0);
+    for (int i = 0; i < MSG_AREA_WORDS; i++) memory[MSG_AREA_START + i] = zero;
+    if (blockcache_enabled) {
+        for (int i = 0; i < MSG_AREA_WORDS; i++) blockcache_on_write(MSG_AREA_START + i);
+    }
+    delivered = 0;
+}
+
+/*
+ * Función: init_msg
+ * Propósito: Vaciar los buzones y registrar los servicios.
+ */
+void init_msg() {
+    msg_reset();
+    syscall_register(MSG_SVC_SEND, 3, "send", svc_send);
+    syscall_register(MSG_SVC_RECEIVE, 3, "receive", svc_receive);
+    syscall_register(MSG_SVC_TRYSEND, 3, "trysend", svc_trysend);
+    syscall_register(MSG_SVC_TRYRECEIVE, 3, "tryreceive", svc_tryreceive);
+}
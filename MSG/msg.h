@@ -0,0 +1,76 @@
+/*
+ * Archivo de cabecera de los buzones de mensajes del Sistema Operativo Virtual.
+ * Los buzones son colas circulares de tamaño fijo guardadas en el área del
+ * SO (direcciones físicas MSG_AREA_START en adelante, antes de la reserva
+ * de memoria compartida de SHM/shm.h). Un mensaje tiene de 1 a
+ * MSG_MAX_WORDS palabras y se copia una sola vez entre el proceso y el
+ * buzón, validando el rango del proceso una vez y no palabra por palabra.
+ *
+ * Organización de cada buzón (MSG_BOX_WORDS palabras):
+ *   0 - posición del mensaje más antiguo
+ *   1 - mensajes en la cola
+ *   2 - mensajes entregados (módulo 10^7)
+ *   MSG_HEADER_WORDS + i * MSG_SLOT_WORDS - largo del mensaje i y sus palabras
+ *
+ * Variantes bloqueantes: no hay planificador ni otros procesos que puedan
+ * llenar o vaciar un buzón mientras el proceso actual espera, así que en
+ * lugar de dormirlo para siempre la llamada retorna MSG_ERR_DEADLOCK. Las
+ * variantes no bloqueantes retornan MSG_ERR_FULL / MSG_ERR_EMPTY.
+ */
+
+#ifndef MSG_H
+#define MSG_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../SHM/shm.h"   // Para SHM_POOL_START (límite del área de buzones)
+
+/*
+ * CONSTANTES DE CONFIGURACIÓN
+ */
+#define MSG_AREA_START 0
+#define MSG_MAILBOXES 4                  // Buzones 0..MSG_MAILBOXES-1
+#define MSG_SLOTS 5                      // Mensajes en cola por buzón
+#define MSG_MAX_WORDS 3                  // Palabras por mensaje
+#define MSG_SLOT_WORDS (1 + MSG_MAX_WORDS)
+#define MSG_HEADER_WORDS 3
+#define MSG_BOX_WORDS (MSG_HEADER_WORDS + MSG_SLOTS * MSG_SLOT_WORDS)
+#define MSG_AREA_WORDS (MSG_MAILBOXES * MSG_BOX_WORDS)   // Debe terminar antes de SHM_POOL_START
+
+/*
+ * CÓDIGOS DE ERROR (resultado negativo de los SVC)
+ */
+#define MSG_ERR_INVALID  -21   // Buzón o largo inválidos
+#define MSG_ERR_FULL     -22   // Buzón lleno (no bloqueante)
+#define MSG_ERR_EMPTY    -23   // Buzón vacío (no bloqueante)
+#define MSG_ERR_DEADLOCK -24   // Bloqueante que nadie podría despertar
+
+/*
+ * SERVICIOS SVC DE MENSAJES (ver SYSCALL/syscall.h)
+ *   MSG_SVC_SEND       (buzón, dirección, n)   -> 0; espera si está lleno
+ *   MSG_SVC_RECEIVE    (buzón, dirección, max) -> palabras copiadas; espera si está vacío
+ *   MSG_SVC_TRYSEND    (buzón, dirección, n)   -> 0 o MSG_ERR_FULL
+ *   MSG_SVC_TRYRECEIVE (buzón, dirección, max) -> palabras copiadas o MSG_ERR_EMPTY
+ * Si el mensaje tiene más de max palabras se copian max y el resto se descarta.
+ */
+#define MSG_SVC_SEND 20
+#define MSG_SVC_RECEIVE 21
+#define MSG_SVC_TRYSEND 22
+#define MSG_SVC_TRYRECEIVE 23
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública de los buzones
+ * Las funciones que retornan int usan los códigos MSG_ERR_* para los errores
+ * (SYSCALL_ERR_ADDRESS si el rango del proceso es inválido).
+ */
+void init_msg();                       // Vaciar los buzones y registrar los SVC
+void msg_reset();                      // Solo vaciar los buzones (tras init_memory)
+int msg_send(int box, int address, int count, int blocking);
+int msg_receive(int box, int address, int max, int blocking);
+unsigned long long msg_delivered();    // Mensajes entregados desde el inicio
+void msg_status();                     // Mostrar la ocupación de los buzones
+const char* msg_error_text(int code);  // Mensaje para un código MSG_ERR_*
+
+#endif /* MSG_H */
@@ -0,0 +1,332 @@
+/*
+ * Archivo de implementación de la placa de red virtual del Sistema Operativo Virtual.
+ * La transmisión la hace la CPU al escribir TX_COMANDO; la recepción, un
+ * hilo propio que escribe la memoria del invitado como el DMA.
+ */
+
+/* Macro necesaria para clock_gettime(), nanosleep() y kill() con -std=c99 */
+#define _POSIX_C_SOURCE 200809L
+
+/* Inclusión de cabecera propia del módulo */
+#include "net.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../MEMORY/memory.h"         // Para memory y read_memory_block
+#include "../REGISTERS/registers.h"   // Para int_to_word
+#include "../INTERRUPTS/interrupts.h" // Para INT_IO_COMPLETION
+#include "../DMA/dma.h"               // Para tomar el bus al escribir la memoria
+#include "../CPU/blockcache.h"        // Para invalidar bloques traducidos
+#include "../MMIO/mmio.h"             // Para registrar los registros de la placa
+#include "../LOGGER/logger.h"         // Para registrar eventos
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>      // Para printf
+#include <string.h>     // Para memcpy, strncpy
+#include <errno.h>      // Para ESRCH
+#include <time.h>       // Para clock_gettime, nanosleep
+#include <signal.h>     // Para kill (¿sigue viva la VM dueña del puerto?)
+#include <unistd.h>     // Para getpid
+#include <pthread.h>    // Para el hilo de recepción
+
+/*
+ * CONSTANTES INTERNAS
+ * NET_RX_IDLE_NS - Pausa del hilo de recepción cuando no hay nada que copiar
+ */
+#define NET_RX_IDLE_NS 20000
+
+/*
+ * VARIABLES GLOBALES DEL MÓDULO (privadas)
+ * segment / port      - conexión actual (NULL / -1 = desconectada)
+ * tx_*                - registros de transmisión
+ * rx_*                - anillo del invitado; rx_physical y rx_capacity
+ *                       cambian bajo rx_lock porque los usa el hilo
+ * rx_produced         - solo la escribe el hilo
+ * rx_consumed         - solo la escribe la CPU
+ */
+static NetSegment* segment = NULL;
+static char segment_name[64] = "";
+static int port = -1;
+static int tx_destination = 0, tx_address = 0, tx_length = 0, tx_result = 0;
+static int rx_address = 0, rx_capacity = 0, rx_physical = 0;
+static volatile int rx_produced = 0, rx_consumed = 0;
+static volatile int coalesce = NET_COALESCE_FRAMES;
+static unsigned long long sent = 0, received = 0, signals = 0;
+
+static pthread_mutex_t rx_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t rx_thread;
+static volatile int receiving = 0;
+
+/*
+ * Función auxiliar: now_us (ESTÁTICA)
+ */
+static long long now_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+/*
+ * Función auxiliar: copy_frame (ESTÁTICA)
+ * Propósito: Escribir la trama en la ranura rx_produced del anillo del
+ *            invitado con el bus tomado, como una transferencia DMA.
+ */
+static void copy_frame(const NetFrame* frame) {
+    int base = rx_physical + rx_produced * NET_SLOT_WORDS;
+    int words = 2 + frame->length;
+    dma_bus_request();
+    memory[base] = int_to_word(frame->length);
+    memory[base + 1] = int_to_word(frame->source);
+    memcpy(&memory[base + 2], frame->words, (size_t)frame->length * sizeof(Word));
+    if (blockcache_enabled) {
+        for (int i = 0; i < words; i++) blockcache_on_write(base + i);
+    }
+    dma_bus_release();
+}
+
+/*
+ * Función auxiliar: receive_main (ESTÁTICA)
+ * Propósito: Cuerpo del hilo de recepción. Copia tramas mientras el anillo
+ *            del invitado tenga lugar y agrupa los avisos: una interrupción
+ *            cada 'coalesce' tramas, o al vencer NET_COALESCE_US.
+ */
+static void* receive_main(void* arg) {
+    (void)arg;
+    struct timespec idle = { 0, NET_RX_IDLE_NS };
+    int unsignaled = 0;
+    long long first_unsignaled = 0;
+
+    while (receiving) {
+        int moved = 0;
+        pthread_mutex_lock(&rx_lock);
+        while (rx_capacity > 0) {
+            int next = (rx_produced + 1) % rx_capacity;
+            if (next == rx_consumed) break;  // Anillo del invitado lleno
+            NetFrame* frame = net_ring_peek(&segment->ports[port].rx);
+            if (frame == NULL) break;
+            copy_frame(frame);
+            net_ring_release(&segment->ports[port].rx);
+            __sync_synchronize();  // La ranura se ve completa antes que el índice
+            rx_produced = next;
+            received++;
+            moved++;
+            if (unsignaled++ == 0) first_unsignaled = now_us();
+            if (unsignaled >= coalesce) {
+                trigger_interrupt(INT_IO_COMPLETION);
+                signals++;
+                unsignaled = 0;
+            }
+        }
+        pthread_mutex_unlock(&rx_lock);
+
+        if (unsignaled > 0 && now_us() - first_unsignaled >= NET_COALESCE_US) {
+            trigger_interrupt(INT_IO_COMPLETION);
+            signals++;
+            unsignaled = 0;
+        }
+        if (moved == 0) nanosleep(&idle, NULL);
+    }
+    return NULL;
+}
+
+/*
+ * Función auxiliar: send_frame (ESTÁTICA)
+ * Retorna: int - 0, o un código NET_ERR_*
+ * Propósito: TX_COMANDO: copiar los datos del invitado a una ranura libre
+ *            del anillo tx compartido y publicarla.
+ */
+static int send_frame() {
+    if (segment == NULL) return NET_ERR_DOWN;
+    if (tx_length < 1 || tx_length > NET_MTU) return NET_ERR_INVALID;
+    NetRing* tx = &segment->ports[port].tx;
+    NetFrame* frame = net_ring_reserve(tx);
+    if (frame == NULL) return NET_ERR_FULL;
+    if (read_memory_block(tx_address, frame->words, tx_length) != 0) return NET_ERR_INVALID;
+    frame->source = port;
+    frame->destination = tx_destination;
+    frame->length = tx_length;
+    net_ring_publish(tx);
+    sent++;
+    return 0;
+}
+
+/*
+ * Función auxiliar: configure_receive (ESTÁTICA)
+ * Propósito: RX_CAPACIDAD: validar el anillo del invitado una sola vez y
+ *            dejarlo vacío. Con un rango inválido la recepción queda apagada.
+ */
+static void configure_receive(int capacity) {
+    int physical = -1;
+    if (capacity >= 2) physical = memory_range_to_physical(rx_address, capacity * NET_SLOT_WORDS);
+    pthread_mutex_lock(&rx_lock);
+    rx_capacity = (physical >= 0) ? capacity : 0;
+    rx_physical = (physical >= 0) ? physical : 0;
+    rx_produced = rx_consumed = 0;
+    pthread_mutex_unlock(&rx_lock);
+    if (capacity != 0 && physical < 0) {
+        log_event(LOG_ERROR, "Red: anillo de recepción inválido (%d ranuras en %d)", capacity, rx_address);
+    }
+}
+
+/*
+ * REGISTROS MAPEADOS EN MEMORIA (ESTÁTICOS, ver net.h)
+ */
+static int mmio_read_register(int offset) {
+    switch (offset) {
+        case 0:  return port;
+        case 1:  return tx_destination;
+        case 2:  return tx_address;
+        case 3:  return tx_length;
+        case 4:  return tx_result;
+        case 5:  return rx_address;
+        case 6:  return rx_capacity;
+        case 7:  return rx_produced;
+        case 8:  return rx_consumed;
+        default: return coalesce;
+    }
+}
+
+static void mmio_write_register(int offset, int value) {
+    switch (offset) {
+        case 1: tx_destination = value; break;
+        case 2: tx_address = value; break;
+        case 3: tx_length = value; break;
+        case 4: tx_result = send_frame(); break;
+        case 5: rx_address = value; break;
+        case 6: configure_receive(value); break;
+        case 8:
+            if (value >= 0 && value < rx_capacity) rx_consumed = value;
+            break;
+        case 9:
+            if (value >= 1 && value <= NET_RING_FRAMES) coalesce = value;
+            break;
+        default:
+            break;  // PUERTO es de solo lectura
+    }
+}
+
+/*
+ * Función: init_net
+ */
+void init_net() {
+    tx_destination = tx_address = tx_length = tx_result = 0;
+    rx_address = rx_capacity = rx_physical = 0;
+    rx_produced = rx_consumed = 0;
+    coalesce = NET_COALESCE_FRAMES;
+    mmio_register("red", MMIO_NET_BASE, NET_REGISTERS, mmio_read_register, mmio_write_register);
+}
+
+/*
+ * Función auxiliar: claim_port (ESTÁTICA)
+ * Retorna: int - 1 si el puerto quedó para este proceso. Un puerto cuyo
+ *          dueño ya no existe se recupera.
+ */
+static int claim_port(NetSegment* s, int p) {
+    int owner = s->ports[p].owner;
+    if (owner != 0 && (kill(owner, 0) == 0 || errno != ESRCH)) return 0;
+    return __sync_bool_compare_and_swap(&s->ports[p].owner, owner, (int)getpid());
+}
+
+/*
+ * Función: net_attach
+ * Parámetros:
+ *   name - segmento del switch (NULL = NET_SEGMENT_NAME)
+ *   p    - puerto, o -1 para el primero libre
+ */
+int net_attach(const char* name, int p) {
+    if (name == NULL) name = NET_SEGMENT_NAME;
+    if (segment != NULL) net_detach();
+    if (p < -1 || p >= NET_MAX_PORTS) return NET_ERR_PORT;
+
+    NetSegment* s = net_segment_open(name);
+    if (s == NULL) {
+        log_event(LOG_ERROR, "Red: no hay switch en %s", name);
+        return NET_ERR_PORT;
+    }
+    int claimed = -1;
+    for (int i = (p < 0) ? 0 : p; i < NET_MAX_PORTS && claimed < 0; i++) {
+        if (claim_port(s, i)) claimed = i;
+        if (p >= 0) break;
+    }
+    if (claimed < 0) {
+        net_segment_close(s);
+        return NET_ERR_PORT;
+    }
+
+    net_ring_reset(&s->ports[claimed].rx);  // Tramas para el dueño anterior
+    segment = s;
+    port = claimed;
+    strncpy(segment_name, name, sizeof(segment_name) - 1);
+    segment_name[sizeof(segment_name) - 1] = '\0';
+    receiving = 1;
+    if (pthread_create(&rx_thread, NULL, receive_main, NULL) != 0) {
+        receiving = 0;
+        log_event(LOG_ERROR, "Red: no se pudo crear el hilo de recepción");
+    }
+    log_event(LOG_INFO, "Red: conectada al puerto %d de %s", port, name);
+    return port;
+}
+
+/*
+ * Función: net_detach
+ */
+void net_detach() {
+    if (segment == NULL) return;
+    if (receiving) {
+        receiving = 0;
+        pthread_join(rx_thread, NULL);
+    }
+    segment->ports[port].owner = 0;
+    net_segment_close(segment);
+    log_event(LOG_INFO, "Red: desconectada del puerto %d", port);
+    segment = NULL;
+    port = -1;
+}
+
+/*
+ * Función: net_release
+ * Propósito: El anillo del invitado apunta a la memoria del proceso que
+ *            termina: la consola lo apaga al cargar el programa siguiente.
+ */
+void net_release() {
+    configure_receive(0);
+    coalesce = NET_COALESCE_FRAMES;
+}
+
+/*
+ * Función: net_status
+ */
+void net_status() {
+    printf("\n=== PLACA DE RED ===\n");
+    if (segment == NULL) {
+        printf("Conexión:             ninguna (net attach [puerto] [segmento])\n");
+    } else {
+        printf("Conexión:             puerto %d de %s (switch: PID %d)\n",
+               port, segment_name, segment->switch_pid);
+        printf("\n  PUERTO    PID  ENTREGADAS  DESCARTADAS\n");
+        for (int i = 0; i < NET_MAX_PORTS; i++) {
+            const NetPort* p = &segment->ports[i];
+            if (p->owner == 0 && p->forwarded == 0 && p->dropped == 0) continue;
+            printf("  %6d %6d %11llu %12llu%s\n", i, p->owner, p->forwarded, p->dropped,
+                   (i == port) ? "  (esta VM)" : "");
+        }
+        printf("\n");
+    }
+    printf("Anillo del invitado:  %d ranuras en %d (productor %d, consumidor %d)\n",
+           rx_capacity, rx_address, rx_produced, rx_consumed);
+    printf("Tramas:               %llu enviadas, %llu recibidas, %llu interrupciones (cada %d)\n",
+           sent, received, signals, coalesce);
+    printf("====================\n");
+}
+
+/*
+ * Función: net_error_text
+ */
+const char* net_error_text(int code) {
+    switch (code) {
+        case NET_ERR_DOWN:    return "la placa no está conectada";
+        case NET_ERR_FULL:    return "anillo de transmisión lleno";
+        case NET_ERR_INVALID: return "largo o dirección inválidos";
+        case NET_ERR_PORT:    return "no hay switch o el puerto está ocupado";
+        default:              return "error desconocido";
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Archivo de cabecera de la placa de red virtual del Sistema Operativo Virtual.
+ *
+ * La placa conecta la VM a un puerto del switch de NET/netring.h y se
+ * maneja con registros de la ventana MMIO (ver MMIO/mmio.h):
+ *   +0 PUERTO        lectura: puerto conectado, o -1
+ *   +1 DESTINO       puerto destino de la próxima trama (NET_BROADCAST = todos)
+ *   +2 TX_DIRECCIÓN  dirección lógica de los datos a enviar
+ *   +3 TX_LARGO      palabras a enviar (1..NET_MTU)
+ *   +4 TX_COMANDO    escritura: enviar; lectura: resultado del último envío
+ *                    (0, NET_ERR_DOWN, NET_ERR_FULL o NET_ERR_INVALID)
+ *   +5 RX_DIRECCIÓN  dirección lógica del anillo de recepción del invitado
+ *   +6 RX_CAPACIDAD  ranuras del anillo; escribirla lo (re)inicia vacío
+ *                    (0 = recepción apagada)
+ *   +7 RX_PRODUCTOR  lectura: ranura que la placa llenará a continuación
+ *   +8 RX_CONSUMIDOR ranura que el invitado leerá a continuación
+ *   +9 COALESCENCIA  tramas por interrupción (1..NET_RING_FRAMES)
+ *
+ * Transmisión: al escribir TX_COMANDO la placa copia los datos del
+ * invitado directamente a una ranura del anillo tx compartido (el rango se
+ * valida una vez), sin pasar por un búfer intermedio.
+ *
+ * Recepción: un hilo de la placa, como el DMA, toma el bus, copia cada
+ * trama del anillo rx compartido a la siguiente ranura del anillo del
+ * invitado (NET_SLOT_WORDS palabras: largo, puerto de origen y datos) y
+ * avanza RX_PRODUCTOR. El anillo está vacío cuando PRODUCTOR == CONSUMIDOR
+ * y lleno cuando solo queda una ranura; mientras esté lleno las tramas
+ * esperan en el anillo compartido. Las interrupciones se agrupan: una
+ * INT_IO_COMPLETION cada COALESCENCIA tramas, o NET_COALESCE_US
+ * microsegundos después de la primera trama sin avisar.
+ */
+
+#ifndef NET_H
+#define NET_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "netring.h"   // Para NET_MTU, NET_BROADCAST y el segmento compartido
+
+/*
+ * CONSTANTES DE LA PLACA
+ */
+#define NET_REGISTERS 10
+#define NET_SLOT_WORDS (2 + NET_MTU)        // Ranura del anillo del invitado
+#define NET_COALESCE_FRAMES 8               // Tramas por interrupción por defecto
+#define NET_COALESCE_US 200                 // Espera máxima antes de avisar
+
+/*
+ * CÓDIGOS DE ERROR
+ */
+#define NET_ERR_DOWN    -31   // La placa no está conectada
+#define NET_ERR_FULL    -32   // Anillo tx lleno: reintentar
+#define NET_ERR_INVALID -33   // Largo o dirección inválidos
+#define NET_ERR_PORT    -34   // No hay switch o el puerto está ocupado
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública de la placa de red
+ */
+void init_net();                       // Registrar los registros MMIO
+int net_attach(const char* segment, int port); // Conectar (port -1 = el primero libre); retorna el puerto o NET_ERR_*
+void net_detach();                     // Desconectar y liberar el puerto
+void net_release();                    // Apagar la recepción del proceso que termina
+void net_status();                     // Mostrar el estado de la placa y del switch
+const char* net_error_text(int code);  // Mensaje para un código NET_ERR_*
+
+#endif /* NET_H */
@@ -0,0 +1,237 @@
+/*
+ * Archivo de implementación de la red local entre máquinas virtuales del Sistema Operativo Virtual.
+ * Contiene el segmento compartido, los anillos SPSC y el hilo del switch.
+ */
+
+/* Macro necesaria para shm_open(), ftruncate() y nanosleep() con -std=c99 */
+#define _POSIX_C_SOURCE 200809L
+
+/* Inclusión de cabecera propia del módulo */
+#include "netring.h"
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>      // Para fprintf
+#include <string.h>     // Para memset, memcpy, strerror
+#include <errno.h>      // Para errno
+#include <time.h>       // Para nanosleep
+#include <fcntl.h>      // Para O_CREAT, O_RDWR
+#include <unistd.h>     // Para ftruncate, close, getpid
+#include <pthread.h>    // Para el hilo del switch
+#include <sys/mman.h>   // Para shm_open, mmap
+
+/*
+ * CONSTANTES INTERNAS
+ * NET_IDLE_NS - Pausa del switch cuando una pasada no movió ninguna trama
+ */
+#define NET_IDLE_NS 20000
+
+/*
+ * VARIABLES GLOBALES ESTÁTICAS
+ * Estado del hilo del switch (uno por proceso)
+ */
+static pthread_t switch_thread;
+static volatile int switch_running = 0;
+static NetSegment* switch_segment = NULL;
+
+/*
+ * Función auxiliar: map_segment (ESTÁTICA)
+ * Parámetros:
+ *   name  - nombre POSIX del segmento
+ *   flags - O_RDWR, con O_CREAT para crearlo
+ * Retorna: NetSegment* - segmento mapeado, o NULL
+ */
+static NetSegment* map_segment(const char* name, int flags) {
+    int fd = shm_open(name, flags, 0644);
+    if (fd < 0) return NULL;
+    if ((flags & O_CREAT) && ftruncate(fd, sizeof(NetSegment)) != 0) {
+        close(fd);
+        return NULL;
+    }
+    void* mapped = mmap(NULL, sizeof(NetSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // El mapeo sigue siendo válido tras cerrar el descriptor
+    return (mapped == MAP_FAILED) ? NULL : (NetSegment*)mapped;
+}
+
+/*
+ * Función: net_segment_create
+ * Propósito: Crear el segmento vacío. magic se escribe al final para que
+ *            ninguna VM lo abra a medio inicializar.
+ */
+NetSegment* net_segment_create(const char* name) {
+    NetSegment* segment = map_segment(name, O_CREAT | O_RDWR);
+    if (segment == NULL) {
+        fprintf(stderr, "Red: no se pudo crear %s (%s)\n", name, strerror(errno));
+        return NULL;
+    }
+    memset(segment, 0, sizeof(NetSegment));
+    segment->version = NET_VERSION;
+    segment->switch_pid = (int)getpid();
+    __sync_synchronize();
+    segment->magic = NET_MAGIC;
+    return segment;
+}
+
+/*
+ * Función: net_segment_open
+ */
+NetSegment* net_segment_open(const char* name) {
+    NetSegment* segment = map_segment(name, O_RDWR);
+    if (segment == NULL) return NULL;
+    if (segment->magic != NET_MAGIC || segment->version != NET_VERSION) {
+        net_segment_close(segment);
+        return NULL;
+    }
+    return segment;
+}
+
+/*
+ * Función: net_segment_close
+ */
+void net_segment_close(NetSegment* segment) {
+    if (segment != NULL) munmap(segment, sizeof(NetSegment));
+}
+
+/*
+ * Función: net_segment_destroy
+ */
+void net_segment_destroy(const char* name) {
+    shm_unlink(name);
+}
+
+/*
+ * Función: net_ring_reserve
+ * Propósito: Solo la llama el productor; lee head (del consumidor) para
+ *            saber si queda lugar.
+ */
+NetFrame* net_ring_reserve(NetRing* ring) {
+    unsigned int tail = ring->tail;
+    if (tail - ring->head >= NET_RING_FRAMES) return NULL;
+    return &ring->frames[tail % NET_RING_FRAMES];
+}
+
+/*
+ * Función: net_ring_publish
+ * Propósito: La barrera garantiza que el consumidor vea la trama completa
+ *            antes que el nuevo tail.
+ */
+void net_ring_publish(NetRing* ring) {
+    __sync_synchronize();
+    ring->tail = ring->tail + 1;
+}
+
+/*
+ * Función: net_ring_peek
+ * Propósito: Solo la llama el consumidor.
+ */
+NetFrame* net_ring_peek(NetRing* ring) {
+    unsigned int head = ring->head;
+    if (head == ring->tail) return NULL;
+    __sync_synchronize();  // Leer la trama después de ver el tail que la publica
+    return &ring->frames[head % NET_RING_FRAMES];
+}
+
+/*
+ * Función: net_ring_release
+ * Propósito: La barrera evita que el productor reuse la ranura antes de
+ *            que el consumidor termine de copiarla.
+ */
+void net_ring_release(NetRing* ring) {
+    __sync_synchronize();
+    ring->head = ring->head + 1;
+}
+
+/*
+ * Función: net_ring_reset
+ * Propósito: Descartar las tramas pendientes (lo hace el consumidor).
+ */
+void net_ring_reset(NetRing* ring) {
+    ring->head = ring->tail;
+}
+
+/*
+ * Función auxiliar: deliver (ESTÁTICA)
+ * Retorna: int - 1 si la trama entró en el anillo rx del puerto
+ */
+static int deliver(NetPort* port, const NetFrame* frame, int source) {
+    NetFrame* slot = net_ring_reserve(&port->rx);
+    if (slot == NULL) return 0;
+    slot->source = source;
+    slot->destination = frame->destination;
+    slot->length = frame->length;
+    memcpy(slot->words, frame->words, (size_t)frame->length * sizeof(Word));
+    net_ring_publish(&port->rx);
+    port->forwarded++;
+    return 1;
+}
+
+/*
+ * Función: net_switch_pass
+ * Propósito: Vaciar los anillos tx de todos los puertos. Una trama unicast
+ *            a un anillo rx lleno detiene ese puerto hasta la próxima
+ *            pasada (contrapresión en lugar de descarte).
+ */
+int net_switch_pass(NetSegment* segment) {
+    int moved = 0;
+    for (int p = 0; p < NET_MAX_PORTS; p++) {
+        NetRing* tx = &segment->ports[p].tx;
+        NetFrame* frame;
+        while ((frame = net_ring_peek(tx)) != NULL) {
+            int destination = frame->destination;
+            if (frame->length < 1 || frame->length > NET_MTU) {
+                segment->ports[p].dropped++;
+            } else if (destination == NET_BROADCAST) {
+                for (int q = 0; q < NET_MAX_PORTS; q++) {
+                    NetPort* port = &segment->ports[q];
+                    if (q == p || port->owner == 0) continue;
+                    if (!deliver(port, frame, p)) port->dropped++;
+                }
+            } else if (destination < 0 || destination >= NET_MAX_PORTS ||
+                       segment->ports[destination].owner == 0) {
+                segment->ports[p].dropped++;
+            } else if (!deliver(&segment->ports[destination], frame, p)) {
+                break;  // Destino lleno: la trama espera en el anillo tx
+            }
+            net_ring_release(tx);
+            moved++;
+        }
+    }
+    return moved;
+}
+
+/*
+ * Función auxiliar: switch_main (ESTÁTICA)
+ * Propósito: Cuerpo del hilo: pasadas continuas mientras haya tráfico y
+ *            una pausa corta cuando no lo hay.
+ */
+static void* switch_main(void* arg) {
+    NetSegment* segment = (NetSegment*)arg;
+    struct timespec idle = { 0, NET_IDLE_NS };
+    while (switch_running) {
+        if (net_switch_pass(segment) == 0) nanosleep(&idle, NULL);
+    }
+    return NULL;
+}
+
+/*
+ * Función: net_switch_start
+ */
+int net_switch_start(NetSegment* segment) {
+    if (switch_running) return -1;
+    switch_segment = segment;
+    switch_running = 1;
+    if (pthread_create(&switch_thread, NULL, switch_main, segment) != 0) {
+        switch_running = 0;
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Función: net_switch_stop
+ */
+void net_switch_stop() {
+    if (!switch_running) return;
+    switch_running = 0;
+    pthread_join(switch_thread, NULL);
+    switch_segment->switch_pid = 0;
+}
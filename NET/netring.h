@@ -0,0 +1,125 @@
+/*
+ * Archivo de cabecera de la red local entre máquinas virtuales del Sistema Operativo Virtual.
+ *
+ * Varias instancias de sistema.exe en el mismo host se comunican como si
+ * estuvieran en una LAN, sin red real: un segmento POSIX de memoria
+ * compartida tiene NET_MAX_PORTS puertos y cada puerto dos anillos de
+ * tramas de un solo productor y un solo consumidor (SPSC):
+ *   tx - la placa de red de la VM produce, el switch consume
+ *   rx - el switch produce, la placa de red de la VM consume
+ * Como cada anillo tiene exactamente un escritor de cada índice, no hacen
+ * falta locks: basta con publicar el índice después de copiar la trama
+ * (barrera __sync_synchronize, igual que el seqlock de las métricas).
+ *
+ * El switch es un hilo del host (netswitch.exe, o bench.exe durante su
+ * prueba de red) que vacía los anillos tx y copia cada trama al anillo rx
+ * del puerto destino. Si ese anillo está lleno la trama espera en el tx
+ * del origen (sin pérdidas); solo se descartan las tramas a puertos sin
+ * VM y las copias de difusión que no caben.
+ *
+ * Este módulo no depende del resto del emulador para poder enlazarse
+ * solo en netswitch.exe.
+ */
+
+#ifndef NETRING_H
+#define NETRING_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../types.h"   // Para Word (las tramas viajan sin convertir)
+
+/*
+ * CONSTANTES DE LA RED
+ * NET_SEGMENT_NAME - Segmento por defecto (el que crea netswitch.exe)
+ * NET_MAX_PORTS    - Puertos del switch (0..NET_MAX_PORTS-1)
+ * NET_BROADCAST    - Destino que el switch copia a todos los demás puertos
+ * NET_MTU          - Palabras de datos por trama
+ * NET_RING_FRAMES  - Tramas por anillo (potencia de 2)
+ */
+#define NET_SEGMENT_NAME "/sistema_net"
+#define NET_MAGIC 0x54454E56u
+#define NET_VERSION 1
+#define NET_MAX_PORTS 8
+#define NET_BROADCAST 99
+#define NET_MTU 16
+#define NET_RING_FRAMES 64
+
+/*
+ * Estructura: NetFrame
+ * Propósito: Trama en un anillo.
+ */
+typedef struct {
+    int source;              // Puerto de origen (lo completa el switch)
+    int destination;         // Puerto destino o NET_BROADCAST
+    int length;              // Palabras de datos (1..NET_MTU)
+    Word words[NET_MTU];
+} NetFrame;
+
+/*
+ * Estructura: NetRing
+ * Propósito: Anillo SPSC. head solo lo escribe el consumidor y tail solo el
+ * productor; están en líneas de caché distintas para que no se peleen.
+ * Los índices crecen sin límite y se usan módulo NET_RING_FRAMES.
+ */
+typedef struct {
+    volatile unsigned int head;
+    char pad_head[60];
+    volatile unsigned int tail;
+    char pad_tail[60];
+    NetFrame frames[NET_RING_FRAMES];
+} NetRing;
+
+/*
+ * Estructura: NetPort
+ * Propósito: Un puerto del switch.
+ */
+typedef struct {
+    volatile int owner;                      // PID de la VM conectada (0 = libre)
+    volatile unsigned long long forwarded;   // Tramas entregadas a este puerto
+    volatile unsigned long long dropped;     // Tramas descartadas con este destino
+    NetRing tx;
+    NetRing rx;
+} NetPort;
+
+/*
+ * Estructura: NetSegment
+ * Propósito: Contenido del segmento compartido.
+ */
+typedef struct {
+    unsigned int magic;          // NET_MAGIC cuando el segmento está listo
+    unsigned int version;        // NET_VERSION
+    volatile int switch_pid;     // Proceso que ejecuta el switch (0 = ninguno)
+    NetPort ports[NET_MAX_PORTS];
+} NetSegment;
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Segmento compartido
+ */
+NetSegment* net_segment_create(const char* name);  // Crear (o reiniciar) el segmento
+NetSegment* net_segment_open(const char* name);    // Abrir uno existente; NULL si no hay switch
+void net_segment_close(NetSegment* segment);       // Desmapear
+void net_segment_destroy(const char* name);        // Eliminar el nombre
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Anillos SPSC
+ * net_ring_reserve - trama libre para escribir, o NULL si el anillo está lleno
+ * net_ring_publish - la trama reservada queda visible para el consumidor
+ * net_ring_peek    - trama más antigua, o NULL si el anillo está vacío
+ * net_ring_release - descartar la trama devuelta por net_ring_peek
+ */
+NetFrame* net_ring_reserve(NetRing* ring);
+void net_ring_publish(NetRing* ring);
+NetFrame* net_ring_peek(NetRing* ring);
+void net_ring_release(NetRing* ring);
+void net_ring_reset(NetRing* ring);
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Switch
+ */
+int net_switch_start(NetSegment* segment);   // Lanzar el hilo del switch (0, o -1)
+void net_switch_stop();                      // Detenerlo y esperar que termine
+int net_switch_pass(NetSegment* segment);    // Una pasada; retorna tramas movidas
+
+#endif /* NETRING_H */
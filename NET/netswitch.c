@@ -0,0 +1,86 @@
+/*
+ * Herramienta netswitch del Sistema Operativo Virtual.
+ * Crea el segmento de la red entre VMs y ejecuta el hilo del switch hasta
+ * recibir Ctrl+C (o durante los segundos pedidos). Cada sistema.exe se
+ * conecta con 'net attach [puerto]'.
+ *
+ * Uso:
+ *   netswitch.exe [segmento] [-t segundos]
+ * Sin segmento se usa NET_SEGMENT_NAME.
+ */
+
+/* Macro necesaria para sigaction() y nanosleep() con -std=c99 */
+#define _POSIX_C_SOURCE 200809L
+
+/* Inclusión de cabeceras de otros módulos */
+#include "netring.h"   // Segmento, anillos y switch
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>      // Para printf
+#include <stdlib.h>     // Para atoi
+#include <string.h>     // Para strcmp
+#include <time.h>       // Para nanosleep
+#include <signal.h>     // Para sigaction
+
+static volatile sig_atomic_t stop_requested = 0;
+
+/*
+ * Función auxiliar: on_signal (ESTÁTICA)
+ */
+static void on_signal(int signal_number) {
+    (void)signal_number;
+    stop_requested = 1;
+}
+
+/*
+ * Función: main
+ */
+int main(int argc, char* argv[]) {
+    const char* name = NET_SEGMENT_NAME;
+    int seconds = -1;  // -1 = hasta Ctrl+C
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            seconds = atoi(argv[++i]);
+        } else if (argv[i][0] == '/') {
+            name = argv[i];
+        } else {
+            printf("Uso: %s [segmento] [-t segundos]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    NetSegment* segment = net_segment_create(name);
+    if (segment == NULL) return 1;
+    if (net_switch_start(segment) != 0) {
+        printf("No se pudo iniciar el switch\n");
+        net_segment_destroy(name);
+        return 1;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    printf("Switch activo en %s (%d puertos, tramas de hasta %d palabras)\n",
+           name, NET_MAX_PORTS, NET_MTU);
+    fflush(stdout);
+    struct timespec second = {1, 0};
+    while (!stop_requested && seconds != 0) {
+        nanosleep(&second, NULL);
+        if (seconds > 0) seconds--;
+    }
+
+    net_switch_stop();
+    printf("\n  PUERTO  ENTREGADAS  DESCARTADAS\n");
+    for (int p = 0; p < NET_MAX_PORTS; p++) {
+        const NetPort* port = &segment->ports[p];
+        if (port->forwarded == 0 && port->dropped == 0) continue;
+        printf("  %6d %11llu %12llu\n", p, port->forwarded, port->dropped);
+    }
+    net_segment_close(segment);
+    net_segment_destroy(name);
+    return 0;
+}
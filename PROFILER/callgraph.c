@@ -0,0 +1,396 @@
+/*
+ * Archivo de implementación del profiler de grafo de llamadas del
+ * Sistema Operativo Virtual.
+ * Contiene la pila sombra, el árbol de contextos de llamada (CCT, calling
+ * context tree) y la exportación en formato folded-stack para flamegraph.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "callgraph.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../LOGGER/logger.h"   // Para registrar retornos no estándar
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf, fopen, fprintf
+#include <stdlib.h>   // Para qsort
+#include <string.h>   // Para memset
+
+/*
+ * Estructura: CallNode (INTERNA)
+ * Propósito: Nodo del árbol de contextos de llamada. Cada camino desde la
+ *            raíz representa una pila de llamadas distinta.
+ * Campos:
+ *   function     - Dirección de entrada de la función (-1 en la raíz)
+ *   parent       - Índice del nodo padre (-1 en la raíz)
+ *   first_child  - Índice del primer hijo (-1 si no tiene)
+ *   next_sibling - Índice del siguiente hermano (-1 si no tiene)
+ *   self         - Instrucciones ejecutadas con este contexto en el tope
+ */
+typedef struct {
+    int function;
+    int parent;
+    int first_child;
+    int next_sibling;
+    unsigned long long self;
+} CallNode;
+
+/*
+ * Estructura: ShadowFrame (INTERNA)
+ * Propósito: Marco de la pila sombra
+ * Campos:
+ *   node           - Nodo del CCT correspondiente a este marco
+ *   function       - Función llamada (con el CCT lleno, 'node' es el del padre)
+ *   return_address - Dirección a la que debería volver el RET
+ *   entry_retired  - Instrucciones retiradas al entrar (para la cuenta inclusiva)
+ */
+typedef struct {
+    int node;
+    int function;
+    int return_address;
+    unsigned long long entry_retired;
+} ShadowFrame;
+
+/*
+ * VARIABLE GLOBAL - Bandera de habilitación
+ */
+int callgraph_enabled = 0;
+
+/*
+ * VARIABLES GLOBALES ESTÁTICAS
+ * Solo accesibles dentro de este archivo (encapsulación)
+ */
+static CallNode nodes[CALLGRAPH_MAX_NODES];       // Árbol de contextos (nodo 0 = raíz)
+static int node_count = 0;                        // Nodos usados
+static ShadowFrame stack[CALLGRAPH_MAX_DEPTH];    // Pila sombra
+static int depth = 0;                             // Marcos en la pila sombra
+static int overflow_depth = 0;                    // CALLs no registrados por exceder la profundidad
+static FunctionProfile functions[MEMORY_SIZE];    // Estadísticas por dirección de entrada
+static int active_frames[MEMORY_SIZE];            // Marcos activos por función (recursión)
+static unsigned long long retired = 0;            // Instrucciones atribuidas
+static unsigned long long mismatches = 0;         // Retornos no estándar
+static unsigned long long dropped_nodes = 0;      // Contextos sin nodo propio (CCT lleno)
+static int max_depth = 0;                         // Profundidad máxima observada
+
+/*
+ * Función auxiliar: child_node (ESTÁTICA)
+ * Parámetros:
+ *   parent   - nodo padre
+ *   function - dirección de entrada de la función llamada
+ * Retorna: índice del nodo hijo (lo crea si no existe). Si el árbol está
+ *          lleno, retorna el padre para no perder las cuentas.
+ */
+static int child_node(int parent, int function) {
+    for (int c = nodes[parent].first_child; c != -1; c = nodes[c].next_sibling) {
+        if (nodes[c].function == function) return c;
+    }
+    if (node_count >= CALLGRAPH_MAX_NODES) {
+        dropped_nodes++;
+        return parent;
+    }
+    int n = node_count++;
+    nodes[n].function = function;
+    nodes[n].parent = parent;
+    nodes[n].first_child = -1;
+    nodes[n].next_sibling = nodes[parent].first_child;
+    nodes[n].self = 0;
+    nodes[parent].first_child = n;
+    return n;
+}
+
+/*
+ * Función auxiliar: push_frame (ESTÁTICA)
+ * Propósito: Entrar en la función 'function' desde el marco actual.
+ */
+static void push_frame(int function, int return_address) {
+    if (depth >= CALLGRAPH_MAX_DEPTH) {
+        overflow_depth++;  // Se sigue atribuyendo al marco del tope
+        return;
+    }
+    int parent = (depth > 0) ? stack[depth - 1].node : 0;
+    stack[depth].node = child_node(parent, function);
+    stack[depth].function = function;
+    stack[depth].return_address = return_address;
+    stack[depth].entry_retired = retired;
+    depth++;
+    if (depth > max_depth) max_depth = depth;
+
+    if (function >= 0 && function < MEMORY_SIZE) {
+        functions[function].calls++;
+        active_frames[function]++;
+    }
+}
+
+/*
+ * Función auxiliar: pop_frame (ESTÁTICA)
+ * Propósito: Salir del marco del tope, acumulando la cuenta inclusiva.
+ *            En recursión solo el marco más externo suma, para no contar
+ *            dos veces las mismas instrucciones.
+ */
+static void pop_frame() {
+    depth--;
+    int function = stack[depth].function;
+    if (function >= 0 && function < MEMORY_SIZE) {
+        active_frames[function]--;
+        if (active_frames[function] == 0) {
+            functions[function].inclusive += retired - stack[depth].entry_retired;
+        }
+    }
+}
+
+/*
+ * Función: init_callgraph
+ * Propósito: Inicializar el call graph con todos los datos vacíos.
+ */
+void init_callgraph() {
+    callgraph_enabled = 0;
+    callgraph_reset();
+    log_event(LOG_INFO, "Call graph inicializado (deshabilitado)");
+}
+
+/*
+ * Función: callgraph_set_enabled
+ * Parámetros: enabled - 1 para habilitar, 0 para deshabilitar
+ * Nota: Al cambiar de estado se vacía la pila sombra, porque los CALL/RET
+ *       ejecutados mientras estaba deshabilitado no se registraron.
+ */
+void callgraph_set_enabled(int enabled) {
+    callgraph_enabled = enabled ? 1 : 0;
+    callgraph_reset_stack();
+    log_event(LOG_INFO, "Call graph %s", callgraph_enabled ? "habilitado" : "deshabilitado");
+}
+
+/*
+ * Función: callgraph_reset
+ * Propósito: Borrar el árbol, las estadísticas por función y la pila sombra.
+ */
+void callgraph_reset() {
+    memset(functions, 0, sizeof(functions));
+    memset(active_frames, 0, sizeof(active_frames));
+    node_count = 1;  // Nodo 0: raíz "guest"
+    nodes[0].function = -1;
+    nodes[0].parent = -1;
+    nodes[0].first_child = -1;
+    nodes[0].next_sibling = -1;
+    nodes[0].self = 0;
+    depth = 0;
+    overflow_depth = 0;
+    retired = 0;
+    mismatches = 0;
+    dropped_nodes = 0;
+    max_depth = 0;
+}
+
+/*
+ * Función: callgraph_reset_stack
+ * Propósito: Vaciar la pila sombra conservando las estadísticas.
+ *            Se llama al comenzar la ejecución de un programa.
+ */
+void callgraph_reset_stack() {
+    while (depth > 0) pop_frame();
+    overflow_depth = 0;
+}
+
+/*
+ * Función: callgraph_on_instruction
+ * Parámetros: pc - dirección de la instrucción que se va a ejecutar
+ * Propósito: Atribuir la instrucción al marco del tope de la pila sombra.
+ *            Si la pila está vacía, la función actual se toma como punto de
+ *            entrada del programa.
+ */
+void callgraph_on_instruction(int pc) {
+    if (depth == 0) {
+        push_frame(pc, -1);  // Marco de entrada: no tiene dirección de retorno
+    }
+    nodes[stack[depth - 1].node].self++;
+    int function = stack[depth - 1].function;  // Aunque el CCT esté lleno
+    if (function >= 0 && function < MEMORY_SIZE) {
+        functions[function].exclusive++;
+    }
+    retired++;
+}
+
+/*
+ * Función: callgraph_on_call
+ * Parámetros:
+ *   target         - dirección de la subrutina (entrada de la función)
+ *   return_address - dirección guardada en la pila del invitado
+ */
+void callgraph_on_call(int target, int return_address) {
+    push_frame(target, return_address);
+}
+
+/*
+ * Función: callgraph_on_return
+ * Parámetros: return_address - dirección a la que realmente vuelve el RET
+ * Propósito: Sacar el marco del tope verificando que el retorno sea estándar.
+ *
+ * Casos de retorno no estándar (mismatch):
+ * - RET con la pila sombra vacía o desde el marco de entrada
+ * - RET a una dirección que no es la guardada por el CALL correspondiente.
+ *   Si coincide con un marco más profundo (la pila del invitado fue
+ *   manipulada), se desenrolla hasta ese marco; si no, se saca solo el tope.
+ */
+void callgraph_on_return(int return_address) {
+    if (overflow_depth > 0) {
+        overflow_depth--;  // Retorno de un CALL no registrado
+        return;
+    }
+
+    if (depth <= 1) {
+        mismatches++;
+        log_event(LOG_WARNING, "Call graph: RET a %d sin CALL correspondiente", return_address);
+        return;  // Se conserva el marco de entrada
+    }
+
+    if (stack[depth - 1].return_address == return_address) {
+        pop_frame();  // Retorno estándar
+        return;
+    }
+
+    mismatches++;
+
+    // Buscar un marco más profundo que espere esta dirección de retorno
+    int match = -1;
+    for (int i = depth - 2; i >= 1; i--) {
+        if (stack[i].return_address == return_address) {
+            match = i;
+            break;
+        }
+    }
+
+    if (match != -1) {
+        log_event(LOG_WARNING, "Call graph: RET a %d desenrolla %d marcos",
+                  return_address, depth - match);
+        while (depth > match) pop_frame();
+    } else {
+        log_event(LOG_WARNING, "Call graph: RET a %d, se esperaba %d",
+                  return_address, stack[depth - 1].return_address);
+        pop_frame();
+    }
+}
+
+/*
+ * Función: callgraph_mismatches
+ * Retorna: cantidad de retornos no estándar detectados
+ */
+unsigned long long callgraph_mismatches() {
+    return mismatches;
+}
+
+/*
+ * Función auxiliar de ordenamiento para qsort (ESTÁTICA)
+ * Ordena direcciones de función de mayor a menor cuenta inclusiva.
+ */
+static int compare_functions(const void* a, const void* b) {
+    unsigned long long ia = functions[*(const int*)a].inclusive;
+    unsigned long long ib = functions[*(const int*)b].inclusive;
+    return (ia < ib) - (ia > ib);
+}
+
+/*
+ * Función: callgraph_report
+ * Parámetros: top_n - cantidad de funciones a mostrar
+ * Propósito: Mostrar las funciones más costosas (cuenta inclusiva) con
+ *            sus llamadas y cuenta exclusiva.
+ * Nota: Las funciones que siguen en la pila sombra todavía no suman su
+ *       cuenta inclusiva; se incluye lo ejecutado hasta ahora.
+ */
+void callgraph_report(int top_n) {
+    if (top_n <= 0) top_n = 10;
+
+    printf("\n=== CALL GRAPH (%s) ===\n", callgraph_enabled ? "habilitado" : "deshabilitado");
+    printf("Instrucciones atribuidas: %llu\n", retired);
+    printf("Profundidad máxima:       %d\n", max_depth);
+    printf("Retornos no estándar:     %llu\n", mismatches);
+    if (dropped_nodes > 0) {
+        printf("Contextos sin nodo (CCT lleno): %llu\n", dropped_nodes);
+    }
+    if (retired == 0) {
+        printf("Sin datos. Use 'callgraph on' y ejecute un programa.\n");
+        return;
+    }
+
+    // Sumar lo ejecutado por los marcos aún activos (sin duplicar recursión)
+    static unsigned long long pending[MEMORY_SIZE];
+    memset(pending, 0, sizeof(pending));
+    for (int i = 0; i < depth; i++) {
+        int function = stack[i].function;
+        if (function < 0 || function >= MEMORY_SIZE) continue;
+        int outermost = 1;
+        for (int j = 0; j < i; j++) {
+            if (stack[j].function == function) outermost = 0;
+        }
+        if (outermost) pending[function] = retired - stack[i].entry_retired;
+    }
+
+    static int order[MEMORY_SIZE];
+    int used = 0;
+    for (int f = 0; f < MEMORY_SIZE; f++) {
+        functions[f].inclusive += pending[f];
+        if (functions[f].calls > 0) order[used++] = f;
+    }
+    qsort(order, used, sizeof(int), compare_functions);
+
+    printf("\n%-8s %10s %14s %7s %14s %7s\n",
+           "FUNCIÓN", "LLAMADAS", "INCLUSIVAS", "%", "EXCLUSIVAS", "%");
+    for (int i = 0; i < used && i < top_n; i++) {
+        const FunctionProfile* p = &functions[order[i]];
+        printf("fn_%04d  %10llu %14llu %6.2f%% %14llu %6.2f%%\n",
+               order[i], p->calls,
+               p->inclusive, 100.0 * (double)p->inclusive / (double)retired,
+               p->exclusive, 100.0 * (double)p->exclusive / (double)retired);
+    }
+
+    // Retirar la parte pendiente para no acumularla dos veces
+    for (int f = 0; f < MEMORY_SIZE; f++) {
+        functions[f].inclusive -= pending[f];
+    }
+    printf("==========================\n");
+}
+
+/*
+ * Función auxiliar: write_folded (ESTÁTICA)
+ * Parámetros:
+ *   out  - archivo de salida
+ *   node - nodo a escribir (se escriben también sus descendientes)
+ *   path - buffer con el camino desde la raíz hasta el padre
+ *   len  - longitud actual del camino
+ */
+static void write_folded(FILE* out, int node, char* path, size_t len) {
+    size_t added = 0;
+    if (node != 0) {
+        added = (size_t)snprintf(path + len, 4096 - len, ";fn_%04d", nodes[node].function);
+        if (len + added >= 4096) added = 4095 - len;  // Camino truncado
+    }
+    if (nodes[node].self > 0) {
+        fprintf(out, "%s %llu\n", path, nodes[node].self);
+    }
+    for (int c = nodes[node].first_child; c != -1; c = nodes[c].next_sibling) {
+        write_folded(out, c, path, len + added);
+    }
+    path[len] = '\0';
+}
+
+/*
+ * Función: callgraph_export_folded
+ * Parámetros: filename - archivo de salida
+ * Retorna: int - 0 si se exportó, -1 si no se pudo abrir el archivo
+ * Propósito: Exportar el árbol de contextos en formato folded-stack
+ *            ("guest;fn_0000;fn_0010 123"), listo para flamegraph.pl.
+ */
+int callgraph_export_folded(const char* filename) {
+    FILE* out = fopen(filename, "w");
+    if (!out) {
+        log_event(LOG_ERROR, "Call graph: no se pudo abrir %s", filename);
+        return -1;
+    }
+
+    static char path[4096];
+    strcpy(path, "guest");
+    write_folded(out, 0, path, strlen(path));
+
+    fclose(out);
+    log_event(LOG_INFO, "Call graph: exportado a %s", filename);
+    return 0;
+}
@@ -0,0 +1,69 @@
+/*
+ * Archivo de cabecera del profiler de grafo de llamadas (call graph)
+ * del Sistema Operativo Virtual.
+ * Mantiene una pila sombra (shadow stack) actualizada en CALL (opcode 14) y
+ * RET (opcode 15) para atribuir instrucciones a funciones del programa invitado:
+ * cuentas inclusivas y exclusivas por función, árbol de contextos de llamada
+ * exportable en formato folded-stack (flamegraph) y detección de retornos
+ * no estándar (RET que no vuelve a la dirección guardada por el CALL).
+ */
+
+#ifndef CALLGRAPH_H
+#define CALLGRAPH_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../types.h"   // Para MEMORY_SIZE
+
+/*
+ * CONSTANTES DE CONFIGURACIÓN DEL CALL GRAPH
+ * CALLGRAPH_MAX_DEPTH - Profundidad máxima de la pila sombra
+ * CALLGRAPH_MAX_NODES - Nodos máximos del árbol de contextos de llamada
+ */
+#define CALLGRAPH_MAX_DEPTH 256
+#define CALLGRAPH_MAX_NODES 4096
+
+/*
+ * Estructura: FunctionProfile
+ * Propósito: Estadísticas de una función del invitado (identificada por su
+ *            dirección de entrada, el destino del CALL)
+ * Campos:
+ *   calls     - Veces que se llamó a la función
+ *   inclusive - Instrucciones ejecutadas dentro de la función y sus llamadas
+ *   exclusive - Instrucciones ejecutadas en el cuerpo de la propia función
+ */
+typedef struct {
+    unsigned long long calls;
+    unsigned long long inclusive;
+    unsigned long long exclusive;
+} FunctionProfile;
+
+/*
+ * DECLARACIÓN DE VARIABLE GLOBAL EXTERNA
+ * La CPU consulta esta bandera antes de llamar al call graph.
+ */
+extern int callgraph_enabled;
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del call graph
+ */
+
+/* FUNCIONES DE INICIALIZACIÓN Y CONTROL */
+void init_callgraph();                    // Limpiar datos, call graph deshabilitado
+void callgraph_set_enabled(int enabled);  // Habilitar (1) o deshabilitar (0)
+void callgraph_reset();                   // Borrar estadísticas y pila sombra
+void callgraph_reset_stack();             // Vaciar solo la pila sombra (nuevo programa)
+
+/* FUNCIONES DE RECOLECCIÓN (llamadas por la CPU) */
+void callgraph_on_instruction(int pc);                  // Antes de cada instrucción
+void callgraph_on_call(int target, int return_address); // Al ejecutar CALL
+void callgraph_on_return(int return_address);           // Al ejecutar RET
+
+/* FUNCIONES DE CONSULTA Y REPORTE */
+unsigned long long callgraph_mismatches();          // Retornos no estándar detectados
+void callgraph_report(int top_n);                   // Reporte de funciones en consola
+int callgraph_export_folded(const char* filename);  // Exportar folded-stack (0=ok)
+
+#endif /* CALLGRAPH_H */
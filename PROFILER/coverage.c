@@ -0,0 +1,229 @@
+/*
+ * Archivo de implementación del módulo de cobertura del Sistema Operativo Virtual.
+ * Contiene los mapas de bits de instrucciones ejecutadas y de saltos tomados /
+ * no tomados, el mapa dirección -> línea del programa cargado y el generador
+ * del listado anotado.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "coverage.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../LOGGER/logger.h"   // Para registrar eventos de cobertura
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf, fopen, fgets
+#include <string.h>   // Para memset, strcmp, strncpy
+
+/*
+ * VARIABLES GLOBALES - Bandera y mapa de instrucciones ejecutadas
+ * Se exportan para que la macro COVERAGE_MARK las use sin llamadas a función.
+ */
+int coverage_enabled = 0;
+unsigned int coverage_executed[COVERAGE_WORDS];
+
+/*
+ * VARIABLES GLOBALES ESTÁTICAS
+ * Solo accesibles dentro de este archivo (encapsulación)
+ */
+static unsigned int branch_taken[COVERAGE_WORDS];      // Bit i = salto en i se tomó
+static unsigned int branch_not_taken[COVERAGE_WORDS];  // Bit i = salto en i no se tomó
+static unsigned int branch_seen[COVERAGE_WORDS];       // Bit i = hay un salto condicional en i
+static int address_line[MEMORY_SIZE];                  // Línea del fuente por dirección (0 = ninguna)
+static char source_file[100] = "";                     // Archivo del programa cargado
+
+/*
+ * Macros auxiliares: TEST_BIT / SET_BIT
+ * Consultan / encienden el bit 'i' del mapa 'map'
+ */
+#define TEST_BIT(map, i) ((map)[(i) >> 5] & (1u << ((i) & 31)))
+#define SET_BIT(map, i)  ((map)[(i) >> 5] |= (1u << ((i) & 31)))
+
+/*
+ * Función: init_coverage
+ * Propósito: Inicializar el módulo con los mapas vacíos y la cobertura apagada.
+ */
+void init_coverage() {
+    coverage_enabled = 0;
+    coverage_reset();
+    memset(address_line, 0, sizeof(address_line));
+    source_file[0] = '\0';
+    log_event(LOG_INFO, "Cobertura inicializada (deshabilitada)");
+}
+
+/*
+ * Función: coverage_set_enabled
+ * Parámetros: enabled - 1 para habilitar, 0 para deshabilitar
+ */
+void coverage_set_enabled(int enabled) {
+    coverage_enabled = enabled ? 1 : 0;
+    log_event(LOG_INFO, "Cobertura %s", coverage_enabled ? "habilitada" : "deshabilitada");
+}
+
+/*
+ * Función: coverage_reset
+ * Propósito: Limpiar los mapas de bits (conserva el mapa de líneas).
+ */
+void coverage_reset() {
+    memset(coverage_executed, 0, sizeof(coverage_executed));
+    memset(branch_taken, 0, sizeof(branch_taken));
+    memset(branch_not_taken, 0, sizeof(branch_not_taken));
+    memset(branch_seen, 0, sizeof(branch_seen));
+}
+
+/*
+ * Función: coverage_record_branch
+ * Parámetros:
+ *   address - dirección lógica del salto condicional
+ *   taken   - 1 si se tomó, 0 si no
+ */
+void coverage_record_branch(int address, int taken) {
+    if (address < 0 || address >= MEMORY_SIZE) return;
+    SET_BIT(branch_seen, address);
+    if (taken) {
+        SET_BIT(branch_taken, address);
+    } else {
+        SET_BIT(branch_not_taken, address);
+    }
+}
+
+/*
+ * Función: coverage_set_source
+ * Parámetros: filename - archivo desde el que se carga el programa
+ * Propósito: Preparar el mapa de líneas para un nuevo programa. Si el archivo
+ *            es distinto del anterior, también se limpian los mapas de bits,
+ *            porque las direcciones ya no corresponden al mismo código.
+ *            Recargar el mismo archivo acumula cobertura entre ejecuciones.
+ */
+void coverage_set_source(const char* filename) {
+    if (strcmp(source_file, filename) != 0) {
+        coverage_reset();
+        strncpy(source_file, filename, sizeof(source_file) - 1);
+        source_file[sizeof(source_file) - 1] = '\0';
+    }
+    memset(address_line, 0, sizeof(address_line));
+}
+
+/*
+ * Función: coverage_map_line
+ * Parámetros:
+ *   address - dirección lógica donde se cargó la palabra
+ *   line    - número de línea (desde 1) en el archivo fuente
+ */
+void coverage_map_line(int address, int line) {
+    if (address < 0 || address >= MEMORY_SIZE) return;
+    address_line[address] = line;
+}
+
+/*
+ * Función: coverage_summary
+ * Propósito: Mostrar en consola el porcentaje de instrucciones y de
+ *            sentidos de salto cubiertos del programa cargado.
+ */
+void coverage_summary() {
+    int words = 0, executed = 0;          // Palabras cargadas / ejecutadas
+    int branches = 0, directions = 0;     // Saltos ejecutados / sentidos cubiertos
+
+    for (int a = 0; a < MEMORY_SIZE; a++) {
+        if (address_line[a] != 0) {
+            words++;
+            if (TEST_BIT(coverage_executed, a)) executed++;
+        }
+        if (TEST_BIT(branch_seen, a)) {
+            branches++;
+            if (TEST_BIT(branch_taken, a)) directions++;
+            if (TEST_BIT(branch_not_taken, a)) directions++;
+        }
+    }
+
+    printf("\n=== COBERTURA (%s) ===\n", coverage_enabled ? "habilitada" : "deshabilitada");
+    printf("Programa: %s\n", source_file[0] ? source_file : "(ninguno)");
+    if (words > 0) {
+        printf("Instrucciones: %d/%d palabras ejecutadas (%.1f%%)\n",
+               executed, words, 100.0 * executed / words);
+    }
+    if (branches > 0) {
+        printf("Saltos:        %d/%d sentidos cubiertos (%.1f%%)\n",
+               directions, 2 * branches, 50.0 * directions / branches);
+    }
+    printf("======================\n");
+}
+
+/*
+ * Función auxiliar: line_marker (ESTÁTICA)
+ * Parámetros:
+ *   address - dirección lógica de la palabra
+ *   marker  - buffer de salida (al menos 4 caracteres)
+ * Propósito: Construir la marca del listado para una dirección:
+ *   "  -" no ejecutada, "  X" ejecutada, y para saltos condicionales
+ *   "T/N" según qué sentidos se observaron ("T N" ambos, "T -" solo tomado...)
+ */
+static void line_marker(int address, char* marker) {
+    if (!TEST_BIT(coverage_executed, address)) {
+        strcpy(marker, "  -");
+    } else if (TEST_BIT(branch_seen, address)) {
+        marker[0] = TEST_BIT(branch_taken, address) ? 'T' : '-';
+        marker[1] = ' ';
+        marker[2] = TEST_BIT(branch_not_taken, address) ? 'N' : '-';
+        marker[3] = '\0';
+    } else {
+        strcpy(marker, "  X");
+    }
+}
+
+/*
+ * Función: coverage_write_report
+ * Parámetros: output_filename - archivo de salida (NULL para la consola)
+ * Retorna: int - 0 si se generó, -1 si no hay programa o no se pudo abrir un archivo
+ * Propósito: Generar el listado anotado del programa: cada línea del archivo
+ *            fuente que cargó una palabra se muestra con su dirección lógica
+ *            y la marca de cobertura; el resto de líneas se copia sin marca.
+ */
+int coverage_write_report(const char* output_filename) {
+    if (source_file[0] == '\0') {
+        printf("No hay programa cargado.\n");
+        return -1;
+    }
+
+    FILE* source = fopen(source_file, "r");
+    if (!source) {
+        log_event(LOG_ERROR, "Cobertura: no se pudo abrir el fuente %s", source_file);
+        return -1;
+    }
+
+    FILE* out = stdout;
+    if (output_filename != NULL) {
+        out = fopen(output_filename, "w");
+        if (!out) {
+            log_event(LOG_ERROR, "Cobertura: no se pudo abrir %s", output_filename);
+            fclose(source);
+            return -1;
+        }
+    }
+
+    fprintf(out, "# Cobertura de %s\n", source_file);
+    fprintf(out, "# X = ejecutada, - = no ejecutada, T/N = salto tomado / no tomado\n");
+
+    char text[256];
+    int line = 0;
+    int a = 0;  // Las palabras se cargan en orden, así que basta un recorrido
+    while (fgets(text, sizeof(text), source) != NULL) {
+        line++;
+        text[strcspn(text, "\r\n")] = '\0';
+
+        // Avanzar hasta la dirección cargada desde esta línea (si existe)
+        while (a < MEMORY_SIZE && address_line[a] != 0 && address_line[a] < line) a++;
+
+        if (a < MEMORY_SIZE && address_line[a] == line) {
+            char marker[4];
+            line_marker(a, marker);
+            fprintf(out, "%s %04d | %s\n", marker, a, text);
+        } else {
+            fprintf(out, "         | %s\n", text);
+        }
+    }
+
+    fclose(source);
+    if (out != stdout) fclose(out);
+    return 0;
+}
@@ -0,0 +1,63 @@
+/*
+ * Archivo de cabecera del módulo de cobertura (coverage) del Sistema Operativo Virtual.
+ * Registra qué direcciones de memoria se ejecutaron como instrucciones y en qué
+ * sentido se resolvió cada salto condicional, usando mapas de bits de 1 bit por
+ * palabra. El reporte relaciona cada dirección con la línea del archivo fuente
+ * desde el que se cargó el programa.
+ */
+
+#ifndef COVERAGE_H
+#define COVERAGE_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../types.h"   // Para MEMORY_SIZE
+
+/*
+ * CONSTANTES DEL MAPA DE BITS
+ * COVERAGE_WORDS - Cantidad de enteros de 32 bits necesarios para 1 bit por palabra
+ */
+#define COVERAGE_WORDS ((MEMORY_SIZE + 31) / 32)
+
+/*
+ * DECLARACIONES DE VARIABLES GLOBALES EXTERNAS
+ * coverage_enabled  - La CPU la consulta antes de marcar (una comparación si está apagado)
+ * coverage_executed - Bit i = 1 si la dirección lógica i se ejecutó como instrucción
+ */
+extern int coverage_enabled;
+extern unsigned int coverage_executed[COVERAGE_WORDS];
+
+/*
+ * Macro: COVERAGE_MARK
+ * Propósito: Marcar una dirección como ejecutada. Es una macro para que el
+ *            camino de FETCH no pague una llamada a función.
+ */
+#define COVERAGE_MARK(address) \
+    do { \
+        unsigned int _a = (unsigned int)(address); \
+        if (_a < MEMORY_SIZE) coverage_executed[_a >> 5] |= 1u << (_a & 31); \
+    } while (0)
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del módulo de cobertura
+ */
+
+/* FUNCIONES DE INICIALIZACIÓN Y CONTROL */
+void init_coverage();                    // Limpiar mapas, cobertura deshabilitada
+void coverage_set_enabled(int enabled);  // Habilitar (1) o deshabilitar (0)
+void coverage_reset();                   // Limpiar los mapas de bits
+
+/* FUNCIONES DE RECOLECCIÓN */
+void coverage_record_branch(int address, int taken); // Sentido de un salto condicional
+
+/* FUNCIONES DE MAPEO CON EL ARCHIVO FUENTE (llamadas por el cargador) */
+void coverage_set_source(const char* filename);      // Programa cargado (reinicia si cambia)
+void coverage_map_line(int address, int line);       // Dirección lógica <- línea del fuente
+
+/* FUNCIONES DE REPORTE */
+void coverage_summary();                               // Resumen en consola
+int coverage_write_report(const char* output_filename); // Listado anotado (NULL = consola)
+
+#endif /* COVERAGE_H */
@@ -0,0 +1,299 @@
+/*
+ * Archivo de implementación del módulo Perfstat del Sistema Operativo Virtual.
+ * Contiene la apertura de los contadores de hardware (grupo perf_event con
+ * lectura agrupada), la atribución de deltas a fases y el reporte.
+ */
+
+/* Macro necesaria para syscall() y clock_gettime() con -std=c99 */
+#define _GNU_SOURCE
+
+/* Inclusión de cabecera propia del módulo */
+#include "perfstat.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../LOGGER/logger.h"   // Para registrar la disponibilidad de contadores
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf
+#include <string.h>   // Para memset, strerror
+#include <errno.h>    // Para errno
+#include <time.h>     // Para clock_gettime
+#include <unistd.h>   // Para read, close, syscall
+
+#ifdef __linux__
+#include <sys/ioctl.h>          // Para ioctl (habilitar/reiniciar contadores)
+#include <sys/syscall.h>        // Para __NR_perf_event_open
+#include <linux/perf_event.h>   // Para perf_event_attr
+#endif
+
+/*
+ * CONTADORES MEDIDOS
+ * Índice 0 es siempre el reloj del host (nanosegundos); los demás son
+ * contadores de hardware y solo son válidos si hw_available = 1.
+ */
+#define COUNTER_NS 0
+#define COUNTER_CYCLES 1
+#define COUNTER_INSTRUCTIONS 2
+#define COUNTER_BRANCH_MISSES 3
+#define COUNTER_CACHE_MISSES 4
+#define COUNTER_COUNT 5
+#define HW_COUNTERS (COUNTER_COUNT - 1)
+
+/*
+ * VARIABLES GLOBALES - Banderas consultadas en el camino rápido
+ */
+int perfstat_active = 0;
+int perfstat_sampling = 0;
+
+/*
+ * VARIABLES GLOBALES ESTÁTICAS
+ * Solo accesibles dentro de este archivo (encapsulación)
+ */
+static int hw_fds[HW_COUNTERS] = {-1, -1, -1, -1};   // Descriptores perf (0 = líder del grupo)
+static int hw_available = 0;                          // 1 si el grupo se abrió correctamente
+static int hw_tried = 0;                              // 1 si ya se intentó abrir
+static char hw_error[128] = "";                       // Motivo si no hay contadores
+
+static unsigned long long run_start[COUNTER_COUNT];   // Valores al comenzar la medición
+static unsigned long long run_total[COUNTER_COUNT];   // Totales de la ejecución
+static unsigned long long phase_total[PERF_PHASE_COUNT][COUNTER_COUNT]; // Por fase (muestreado)
+static unsigned long long last_read[COUNTER_COUNT];   // Última lectura (inicio de la fase actual)
+static PerfPhase current_phase = PERF_PHASE_OTHER;    // Fase a la que se atribuye el tramo actual
+
+static unsigned long long guest_instructions = 0;     // Instrucciones del invitado medidas
+static unsigned long long sampled_instructions = 0;   // Instrucciones desglosadas por fase
+
+static const char* phase_names[PERF_PHASE_COUNT] = {
+    "otros", "fetch", "decode", "execute", "interrupts", "logging"
+};
+
+/*
+ * Función auxiliar: open_hw_counters (ESTÁTICA)
+ * Propósito: Abrir el grupo de contadores de hardware del proceso actual
+ *            (solo espacio de usuario). Se intenta una sola vez.
+ */
+static void open_hw_counters() {
+    if (hw_tried) return;
+    hw_tried = 1;
+
+#ifdef __linux__
+    static const unsigned long long configs[HW_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_CACHE_MISSES
+    };
+
+    for (int i = 0; i < HW_COUNTERS; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.disabled = (i == 0);          // El líder arranca deshabilitado
+        attr.exclude_kernel = 1;           // Solo el código del emulador
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+
+        int group = (i == 0) ? -1 : hw_fds[0];
+        int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+        if (fd < 0) {
+            snprintf(hw_error, sizeof(hw_error), "perf_event_open: %s", strerror(errno));
+            for (int j = 0; j < i; j++) {
+                close(hw_fds[j]);
+                hw_fds[j] = -1;
+            }
+            log_event(LOG_WARNING, "Perfstat: contadores de hardware no disponibles (%s)", hw_error);
+            return;
+        }
+        hw_fds[i] = fd;
+    }
+    hw_available = 1;
+    log_event(LOG_INFO, "Perfstat: contadores de hardware disponibles");
+#else
+    snprintf(hw_error, sizeof(hw_error), "perf_event_open solo existe en Linux");
+#endif
+}
+
+/*
+ * Función auxiliar: read_counters (ESTÁTICA)
+ * Parámetros: values - arreglo de COUNTER_COUNT posiciones a llenar
+ * Propósito: Leer el reloj y, si hay, todo el grupo de contadores con
+ *            una sola llamada read().
+ */
+static void read_counters(unsigned long long* values) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    values[COUNTER_NS] = (unsigned long long)now.tv_sec * 1000000000ULL
+                         + (unsigned long long)now.tv_nsec;
+
+    if (hw_available) {
+        // Formato PERF_FORMAT_GROUP: { nr, valor[nr] }
+        unsigned long long buffer[1 + HW_COUNTERS];
+        if (read(hw_fds[0], buffer, sizeof(buffer)) == (ssize_t)sizeof(buffer)) {
+            for (int i = 0; i < HW_COUNTERS; i++) {
+                values[1 + i] = buffer[1 + i];
+            }
+            return;
+        }
+    }
+    for (int i = 1; i < COUNTER_COUNT; i++) values[i] = 0;
+}
+
+/*
+ * Función: perfstat_start
+ * Propósito: Comenzar una medición: pone a cero todos los acumuladores,
+ *            reinicia y habilita los contadores de hardware.
+ */
+void perfstat_start() {
+    open_hw_counters();
+
+    memset(run_total, 0, sizeof(run_total));
+    memset(phase_total, 0, sizeof(phase_total));
+    guest_instructions = 0;
+    sampled_instructions = 0;
+    current_phase = PERF_PHASE_OTHER;
+    perfstat_sampling = 0;
+
+#ifdef __linux__
+    if (hw_available) {
+        ioctl(hw_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(hw_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+
+    read_counters(run_start);
+    perfstat_active = 1;
+}
+
+/*
+ * Función: perfstat_stop
+ * Propósito: Terminar la medición y calcular los totales de la ejecución.
+ */
+void perfstat_stop() {
+    if (!perfstat_active) return;
+
+    if (perfstat_sampling) {
+        perfstat_switch_phase(PERF_PHASE_OTHER);  // Cerrar la última fase abierta
+    }
+
+    unsigned long long end[COUNTER_COUNT];
+    read_counters(end);
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        run_total[i] = end[i] - run_start[i];
+    }
+
+#ifdef __linux__
+    if (hw_available) {
+        ioctl(hw_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+
+    perfstat_active = 0;
+    perfstat_sampling = 0;
+}
+
+/*
+ * Función: perfstat_begin_instruction
+ * Propósito: Contar una instrucción del invitado y decidir si se desglosa
+ *            por fases. Al terminar una instrucción muestreada, el tramo
+ *            pendiente (bucle de ejecución, pausas) se atribuye a "otros".
+ */
+void perfstat_begin_instruction() {
+    if (perfstat_sampling) {
+        perfstat_switch_phase(PERF_PHASE_OTHER);  // Cierra el tramo de la instrucción anterior
+    }
+
+    perfstat_sampling = ((guest_instructions++ & (PERFSTAT_SAMPLE_PERIOD - 1)) == 0);
+    if (perfstat_sampling) {
+        sampled_instructions++;
+        read_counters(last_read);
+        current_phase = PERF_PHASE_OTHER;
+    }
+}
+
+/*
+ * Función: perfstat_switch_phase
+ * Parámetros: phase - fase que comienza
+ * Retorna: int - fase que estaba activa (para restaurarla con PERF_LEAVE)
+ * Propósito: Atribuir lo medido desde la última lectura a la fase actual
+ *            y pasar a la nueva fase.
+ */
+int perfstat_switch_phase(PerfPhase phase) {
+    unsigned long long now[COUNTER_COUNT];
+    read_counters(now);
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        phase_total[current_phase][i] += now[i] - last_read[i];
+        last_read[i] = now[i];
+    }
+
+    PerfPhase previous = current_phase;
+    current_phase = phase;
+    return (int)previous;
+}
+
+/*
+ * Función: perfstat_report
+ * Propósito: Mostrar los totales por instrucción del invitado (IPC del host,
+ *            fallos de salto y de caché) y el desglose por fase.
+ */
+void perfstat_report() {
+    printf("\n=== PERFSTAT (host) ===\n");
+    printf("Instrucciones del invitado: %llu (desglose de 1 de cada %d: %llu)\n",
+           guest_instructions, PERFSTAT_SAMPLE_PERIOD, sampled_instructions);
+    if (guest_instructions == 0) {
+        printf("Sin datos. Use 'perfstat <archivo>'.\n");
+        return;
+    }
+
+    double n = (double)guest_instructions;
+    double seconds = (double)run_total[COUNTER_NS] / 1e9;
+    printf("Tiempo total:               %.3f ms (%.3f MIPS del invitado)\n",
+           seconds * 1000.0, seconds > 0 ? n / seconds / 1e6 : 0.0);
+
+    if (hw_available) {
+        double cycles = (double)run_total[COUNTER_CYCLES];
+        double instrs = (double)run_total[COUNTER_INSTRUCTIONS];
+        printf("Ciclos del host:            %.0f (%.1f por instrucción del invitado)\n",
+               cycles, cycles / n);
+        printf("Instrucciones del host:     %.0f (%.1f por instrucción del invitado)\n",
+               instrs, instrs / n);
+        printf("IPC del host:               %.2f\n", cycles > 0 ? instrs / cycles : 0.0);
+        printf("Fallos de salto:            %llu (%.3f por instrucción del invitado)\n",
+               run_total[COUNTER_BRANCH_MISSES], (double)run_total[COUNTER_BRANCH_MISSES] / n);
+        printf("Fallos de caché:            %llu (%.3f por instrucción del invitado)\n",
+               run_total[COUNTER_CACHE_MISSES], (double)run_total[COUNTER_CACHE_MISSES] / n);
+    } else {
+        printf("Contadores de hardware no disponibles (%s); solo se reporta tiempo.\n", hw_error);
+    }
+
+    if (sampled_instructions == 0) return;
+
+    // Desglose por fase, promediado por instrucción muestreada
+    double s = (double)sampled_instructions;
+    unsigned long long sampled_ns = 0;
+    for (int p = 0; p < PERF_PHASE_COUNT; p++) sampled_ns += phase_total[p][COUNTER_NS];
+
+    printf("\n-- Por fase (promedio por instrucción muestreada) --\n");
+    if (hw_available) {
+        printf("%-11s %10s %7s %10s %10s %6s %9s %9s\n",
+               "FASE", "ns", "%", "ciclos", "instr", "IPC", "br-miss", "c-miss");
+    } else {
+        printf("%-11s %10s %7s\n", "FASE", "ns", "%");
+    }
+    for (int p = 0; p < PERF_PHASE_COUNT; p++) {
+        const unsigned long long* t = phase_total[p];
+        double pct = sampled_ns ? 100.0 * (double)t[COUNTER_NS] / (double)sampled_ns : 0.0;
+        if (hw_available) {
+            printf("%-11s %10.1f %6.2f%% %10.1f %10.1f %6.2f %9.3f %9.3f\n",
+                   phase_names[p], (double)t[COUNTER_NS] / s, pct,
+                   (double)t[COUNTER_CYCLES] / s, (double)t[COUNTER_INSTRUCTIONS] / s,
+                   t[COUNTER_CYCLES] ? (double)t[COUNTER_INSTRUCTIONS] / (double)t[COUNTER_CYCLES] : 0.0,
+                   (double)t[COUNTER_BRANCH_MISSES] / s, (double)t[COUNTER_CACHE_MISSES] / s);
+        } else {
+            printf("%-11s %10.1f %6.2f%%\n", phase_names[p], (double)t[COUNTER_NS] / s, pct);
+        }
+    }
+    printf("* incluye el costo de leer los contadores en cada cambio de fase\n");
+    printf("=======================\n");
+}
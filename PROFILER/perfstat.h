@@ -0,0 +1,70 @@
+/*
+ * Archivo de cabecera del módulo Perfstat del Sistema Operativo Virtual.
+ * Mide el costo del emulador en el host (no del programa invitado) usando los
+ * contadores de hardware de Linux (perf_event_open): ciclos, instrucciones,
+ * fallos de predicción de saltos y fallos de caché, reportados por instrucción
+ * del invitado y desglosados por fase del ciclo de la CPU.
+ * Si los contadores no están disponibles se reporta solo el tiempo.
+ */
+
+#ifndef PERFSTAT_H
+#define PERFSTAT_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+/*
+ * CONSTANTES DE CONFIGURACIÓN DE PERFSTAT
+ * PERFSTAT_SAMPLE_PERIOD - Se desglosa por fases 1 de cada N instrucciones
+ *                          (leer los contadores cuesta una llamada al sistema)
+ */
+#define PERFSTAT_SAMPLE_PERIOD 16
+
+/*
+ * Enum: PerfPhase
+ * Propósito: Fases del ciclo de la CPU a las que se atribuyen los contadores.
+ * La atribución es exclusiva: si se entra en LOGGING durante FETCH, ese
+ * tramo se cuenta solo en LOGGING.
+ */
+typedef enum {
+    PERF_PHASE_OTHER,      // Fuera de las fases instrumentadas (bucle, pausas, profilers)
+    PERF_PHASE_FETCH,      // Lectura de la instrucción de memoria
+    PERF_PHASE_DECODE,     // Decodificación de la palabra
+    PERF_PHASE_EXECUTE,    // execute_instruction()
+    PERF_PHASE_INTERRUPTS, // handle_pending_interrupts()
+    PERF_PHASE_LOGGING,    // log_event()
+    PERF_PHASE_COUNT
+} PerfPhase;
+
+/*
+ * DECLARACIONES DE VARIABLES GLOBALES EXTERNAS
+ * perfstat_active   - 1 mientras se mide una ejecución
+ * perfstat_sampling - 1 si la instrucción en curso se desglosa por fases
+ */
+extern int perfstat_active;
+extern int perfstat_sampling;
+
+/*
+ * Macros: PERF_ENTER / PERF_LEAVE
+ * Propósito: Delimitar una fase. PERF_ENTER retorna la fase anterior (o -1 si
+ *            la instrucción no se muestrea) y PERF_LEAVE la restaura.
+ * Uso:
+ *   int prev = PERF_ENTER(PERF_PHASE_FETCH);
+ *   ...
+ *   PERF_LEAVE(prev);
+ */
+#define PERF_ENTER(phase) (perfstat_sampling ? perfstat_switch_phase(phase) : -1)
+#define PERF_LEAVE(prev) \
+    do { if ((prev) >= 0) perfstat_switch_phase((PerfPhase)(prev)); } while (0)
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del módulo Perfstat
+ */
+void perfstat_start();                        // Abrir/poner a cero contadores y comenzar a medir
+void perfstat_stop();                         // Dejar de medir y acumular totales
+void perfstat_begin_instruction();            // Llamada por la CPU al comenzar cada ciclo
+int perfstat_switch_phase(PerfPhase phase);   // Cambiar de fase (retorna la anterior)
+void perfstat_report();                       // Mostrar el reporte en consola
+
+#endif /* PERFSTAT_H */
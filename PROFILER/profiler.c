@@ -0,0 +1,274 @@
+/*
+ * Archivo de implementación del módulo Profiler del Sistema Operativo Virtual.
+ * Contiene los contadores por opcode y por PC, el muestreo de tiempo del host
+ * y la generación de reportes (consola y formato folded-stack para flamegraph).
+ */
+
+/* Macro necesaria para clock_gettime() con -std=c99 */
+#define _POSIX_C_SOURCE 199309L
+
+/* Inclusión de cabecera propia del módulo */
+#include "profiler.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../LOGGER/logger.h"   // Para registrar eventos del profiler
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf, fopen, fprintf
+#include <stdlib.h>   // Para qsort
+#include <string.h>   // Para memset
+#include <time.h>     // Para clock_gettime
+
+/*
+ * VARIABLE GLOBAL - Bandera de habilitación
+ * Consultada por la CPU antes de cada llamada al profiler.
+ */
+int profiler_enabled = 0;
+
+/*
+ * VARIABLES GLOBALES ESTÁTICAS
+ * Solo accesibles dentro de este archivo (encapsulación)
+ */
+static OpcodeProfile opcode_stats[ISA_MAX_OPCODES]; // Estadísticas por opcode
+static unsigned long long pc_counts[MEMORY_SIZE];   // Ejecuciones por dirección (PC)
+static unsigned char pc_opcode[MEMORY_SIZE];        // Último opcode visto en cada PC
+static unsigned long long total_instructions = 0;   // Total de instrucciones perfiladas
+
+/* Estado de la instrucción en curso (entre begin y end) */
+static int current_opcode = -1;         // Opcode de la instrucción en curso
+static int current_sampled = 0;         // 1 si se está midiendo su tiempo
+static struct timespec sample_start;    // Marca de tiempo al comenzar la muestra
+
+/*
+ * Función auxiliar: elapsed_ns (ESTÁTICA)
+ * Retorna: nanosegundos transcurridos entre 'start' y 'end'
+ */
+static unsigned long long elapsed_ns(const struct timespec* start, const struct timespec* end) {
+    return (unsigned long long)(end->tv_sec - start->tv_sec) * 1000000000ULL
+           + (unsigned long long)(end->tv_nsec - start->tv_nsec);
+}
+
+/*
+ * Función: init_profiler
+ * Propósito: Inicializar el profiler con todos los contadores en cero.
+ * El profiler queda deshabilitado hasta que se active con 'profile on'.
+ */
+void init_profiler() {
+    profiler_enabled = 0;
+    profiler_reset();
+    log_event(LOG_INFO, "Profiler inicializado (deshabilitado)");
+}
+
+/*
+ * Función: profiler_set_enabled
+ * Parámetros: enabled - 1 para habilitar, 0 para deshabilitar
+ */
+void profiler_set_enabled(int enabled) {
+    profiler_enabled = enabled ? 1 : 0;
+    current_opcode = -1;  // Descartar cualquier instrucción a medio medir
+    log_event(LOG_INFO, "Profiler %s", profiler_enabled ? "habilitado" : "deshabilitado");
+}
+
+/*
+ * Función: profiler_reset
+ * Propósito: Poner a cero todos los contadores acumulados.
+ */
+void profiler_reset() {
+    memset(opcode_stats, 0, sizeof(opcode_stats));
+    memset(pc_counts, 0, sizeof(pc_counts));
+    memset(pc_opcode, 0, sizeof(pc_opcode));
+    total_instructions = 0;
+    current_opcode = -1;
+}
+
+/*
+ * Función: profiler_begin_instruction
+ * Parámetros:
+ *   pc     - dirección (lógica) desde donde se obtuvo la instrucción
+ *   opcode - opcode decodificado (-1 si la instrucción es inválida)
+ * Propósito: Contar la instrucción y, si le toca ser muestreada, tomar
+ *            la marca de tiempo inicial del host.
+ */
+void profiler_begin_instruction(int pc, int opcode) {
+    if (opcode < 0 || opcode >= ISA_MAX_OPCODES) {
+        current_opcode = -1;  // Instrucción inválida: no se perfila
+        return;
+    }
+
+    opcode_stats[opcode].count++;
+    if (pc >= 0 && pc < MEMORY_SIZE) {
+        pc_counts[pc]++;
+        pc_opcode[pc] = (unsigned char)opcode;
+    }
+
+    current_opcode = opcode;
+    current_sampled = ((total_instructions++ & (PROFILER_SAMPLE_PERIOD - 1)) == 0);
+    if (current_sampled) {
+        clock_gettime(CLOCK_MONOTONIC, &sample_start);
+    }
+}
+
+/*
+ * Función: profiler_end_instruction
+ * Propósito: Cerrar la muestra de tiempo de la instrucción en curso (si se muestreó).
+ */
+void profiler_end_instruction() {
+    if (current_opcode < 0) return;
+
+    if (current_sampled) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        opcode_stats[current_opcode].sampled_count++;
+        opcode_stats[current_opcode].sampled_ns += elapsed_ns(&sample_start, &now);
+    }
+    current_opcode = -1;
+}
+
+/*
+ * Función: profiler_record_branch
+ * Parámetros:
+ *   opcode - opcode del salto condicional (09-12)
+ *   taken  - 1 si el salto se tomó, 0 si no
+ */
+void profiler_record_branch(int opcode, int taken) {
+    if (!isa_is_conditional_branch(opcode)) return;
+    if (taken) {
+        opcode_stats[opcode].taken++;
+    } else {
+        opcode_stats[opcode].not_taken++;
+    }
+}
+
+/*
+ * Función: profiler_total_instructions
+ * Retorna: total de instrucciones contadas desde el último reset
+ */
+unsigned long long profiler_total_instructions() {
+    return total_instructions;
+}
+
+/*
+ * Función: profiler_pc_count
+ * Parámetros: pc - dirección lógica
+ * Retorna: número de veces que se ejecutó la instrucción en 'pc'
+ */
+unsigned long long profiler_pc_count(int pc) {
+    if (pc < 0 || pc >= MEMORY_SIZE) return 0;
+    return pc_counts[pc];
+}
+
+/*
+ * Función auxiliar: estimated_ns (ESTÁTICA)
+ * Retorna: tiempo total estimado del host para un opcode, extrapolando
+ *          el promedio de las muestras a todas sus ejecuciones.
+ */
+static double estimated_ns(const OpcodeProfile* p) {
+    if (p->sampled_count == 0) return 0.0;
+    return (double)p->sampled_ns / (double)p->sampled_count * (double)p->count;
+}
+
+/*
+ * Funciones auxiliares de ordenamiento para qsort (ESTÁTICAS)
+ * Ordenan índices de mayor a menor cantidad de ejecuciones.
+ */
+static int compare_opcodes(const void* a, const void* b) {
+    unsigned long long ca = opcode_stats[*(const int*)a].count;
+    unsigned long long cb = opcode_stats[*(const int*)b].count;
+    return (ca < cb) - (ca > cb);
+}
+
+static int compare_pcs(const void* a, const void* b) {
+    unsigned long long ca = pc_counts[*(const int*)a];
+    unsigned long long cb = pc_counts[*(const int*)b];
+    return (ca < cb) - (ca > cb);
+}
+
+/*
+ * Función: profiler_report
+ * Parámetros: top_n - cantidad de opcodes y direcciones a mostrar
+ * Propósito: Mostrar en consola los opcodes y PCs más ejecutados, el tiempo
+ *            estimado del host por opcode y las estadísticas de saltos.
+ */
+void profiler_report(int top_n) {
+    if (top_n <= 0) top_n = PROFILER_DEFAULT_TOP;
+
+    printf("\n=== PROFILER (%s) ===\n", profiler_enabled ? "habilitado" : "deshabilitado");
+    printf("Instrucciones perfiladas: %llu\n", total_instructions);
+    if (total_instructions == 0) {
+        printf("Sin datos. Use 'profile on' y ejecute un programa.\n");
+        return;
+    }
+
+    /* TOP-N POR OPCODE */
+    int order[ISA_MAX_OPCODES];
+    int used = 0;
+    for (int op = 0; op < ISA_MAX_OPCODES; op++) {
+        if (opcode_stats[op].count > 0) order[used++] = op;
+    }
+    qsort(order, used, sizeof(int), compare_opcodes);
+
+    printf("\n-- Opcodes más ejecutados --\n");
+    printf("%-4s %-14s %12s %7s %12s\n", "OP", "MNEMÓNICO", "EJECUCIONES", "%", "HOST(us)*");
+    for (int i = 0; i < used && i < top_n; i++) {
+        const OpcodeProfile* p = &opcode_stats[order[i]];
+        printf("%02d   %-14s %12llu %6.2f%% %12.1f\n",
+               order[i], isa_mnemonic(order[i]), p->count,
+               100.0 * (double)p->count / (double)total_instructions,
+               estimated_ns(p) / 1000.0);
+    }
+    printf("* estimado a partir de 1 de cada %d instrucciones\n", PROFILER_SAMPLE_PERIOD);
+
+    /* TOP-N POR PC (HOT SPOTS) */
+    static int pc_order[MEMORY_SIZE];
+    int pcs = 0;
+    for (int pc = 0; pc < MEMORY_SIZE; pc++) {
+        if (pc_counts[pc] > 0) pc_order[pcs++] = pc;
+    }
+    qsort(pc_order, pcs, sizeof(int), compare_pcs);
+
+    printf("\n-- Direcciones más ejecutadas --\n");
+    printf("%-6s %-14s %12s %7s\n", "PC", "MNEMÓNICO", "EJECUCIONES", "%");
+    for (int i = 0; i < pcs && i < top_n; i++) {
+        int pc = pc_order[i];
+        printf("%04d   %-14s %12llu %6.2f%%\n",
+               pc, isa_mnemonic(pc_opcode[pc]), pc_counts[pc],
+               100.0 * (double)pc_counts[pc] / (double)total_instructions);
+    }
+
+    /* SALTOS CONDICIONALES */
+    printf("\n-- Saltos condicionales --\n");
+    printf("%-4s %-6s %12s %12s\n", "OP", "SALTO", "TOMADOS", "NO TOMADOS");
+    for (int op = 9; op <= 12; op++) {
+        if (opcode_stats[op].count == 0) continue;
+        printf("%02d   %-6s %12llu %12llu\n", op, isa_mnemonic(op),
+               opcode_stats[op].taken, opcode_stats[op].not_taken);
+    }
+    printf("=====================\n");
+}
+
+/*
+ * Función: profiler_export_folded
+ * Parámetros: filename - archivo de salida
+ * Retorna: int - 0 si se exportó, -1 si no se pudo abrir el archivo
+ * Propósito: Exportar los contadores por PC en formato "folded stacks"
+ *            (una línea "marco;marco;... cuenta"), compatible con
+ *            flamegraph.pl, speedscope y 'pprof -raw' tras conversión.
+ *            Cada pila es: guest;<MNEMÓNICO>;pc_<dirección>
+ */
+int profiler_export_folded(const char* filename) {
+    FILE* out = fopen(filename, "w");
+    if (!out) {
+        log_event(LOG_ERROR, "Profiler: no se pudo abrir %s", filename);
+        return -1;
+    }
+
+    for (int pc = 0; pc < MEMORY_SIZE; pc++) {
+        if (pc_counts[pc] == 0) continue;
+        fprintf(out, "guest;%s;pc_%04d %llu\n",
+                isa_mnemonic(pc_opcode[pc]), pc, pc_counts[pc]);
+    }
+
+    fclose(out);
+    log_event(LOG_INFO, "Profiler: perfil exportado a %s", filename);
+    return 0;
+}
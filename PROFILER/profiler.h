@@ -0,0 +1,73 @@
+/*
+ * Archivo de cabecera del módulo Profiler del Sistema Operativo Virtual.
+ * Define la interfaz del profiler de instrucciones del programa invitado (guest):
+ * cuenta instrucciones ejecutadas por opcode y por PC, acumula tiempo del host
+ * por opcode (muestreado para limitar el costo) y cuenta saltos condicionales
+ * tomados y no tomados. Es opcional: solo trabaja cuando se habilita.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../types.h"     // Para MEMORY_SIZE
+#include "../ISA/isa.h"   // Para ISA_MAX_OPCODES
+
+/*
+ * CONSTANTES DE CONFIGURACIÓN DEL PROFILER
+ * PROFILER_SAMPLE_PERIOD - Se mide el tiempo del host en 1 de cada N instrucciones
+ *                          (potencia de 2 para que el módulo sea una máscara)
+ * PROFILER_DEFAULT_TOP   - Cantidad de entradas por defecto en el reporte
+ */
+#define PROFILER_SAMPLE_PERIOD 64
+#define PROFILER_DEFAULT_TOP 10
+
+/*
+ * Estructura: OpcodeProfile
+ * Propósito: Estadísticas acumuladas para un opcode
+ * Campos:
+ *   count          - Instrucciones ejecutadas con este opcode
+ *   sampled_count  - Ejecuciones en las que se midió el tiempo del host
+ *   sampled_ns     - Nanosegundos del host acumulados en las muestras
+ *   taken          - Saltos tomados (solo opcodes 09-12)
+ *   not_taken      - Saltos no tomados (solo opcodes 09-12)
+ */
+typedef struct {
+    unsigned long long count;
+    unsigned long long sampled_count;
+    unsigned long long sampled_ns;
+    unsigned long long taken;
+    unsigned long long not_taken;
+} OpcodeProfile;
+
+/*
+ * DECLARACIÓN DE VARIABLE GLOBAL EXTERNA
+ * La CPU consulta esta bandera antes de llamar al profiler, de modo que
+ * con el profiler deshabilitado el costo es una sola comparación.
+ */
+extern int profiler_enabled;
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del módulo Profiler
+ */
+
+/* FUNCIONES DE INICIALIZACIÓN Y CONTROL */
+void init_profiler();                     // Limpiar contadores, profiler deshabilitado
+void profiler_set_enabled(int enabled);   // Habilitar (1) o deshabilitar (0)
+void profiler_reset();                    // Poner a cero todos los contadores
+
+/* FUNCIONES DE RECOLECCIÓN (llamadas por la CPU) */
+void profiler_begin_instruction(int pc, int opcode); // Antes de ejecutar una instrucción
+void profiler_end_instruction();                     // Después de ejecutarla
+void profiler_record_branch(int opcode, int taken);  // Resultado de un salto condicional
+
+/* FUNCIONES DE CONSULTA Y REPORTE */
+unsigned long long profiler_total_instructions();    // Total de instrucciones perfiladas
+unsigned long long profiler_pc_count(int pc);        // Ejecuciones de la dirección 'pc'
+void profiler_report(int top_n);                     // Reporte top-N en consola
+int profiler_export_folded(const char* filename);    // Exportar en formato folded-stack (0=ok)
+
+#endif /* PROFILER_H */
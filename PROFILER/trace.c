@@ -0,0 +1,235 @@
+/*
+ * Archivo de implementación del módulo de trazas del Sistema Operativo Virtual.
+ * Contiene los buffers circulares por pista, el reloj de la traza y el
+ * exportador al formato JSON de Chrome Trace Event.
+ */
+
+/* Macro necesaria para clock_gettime() con -std=c99 */
+#define _POSIX_C_SOURCE 199309L
+
+/* Inclusión de cabecera propia del módulo */
+#include "trace.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../LOGGER/logger.h"   // Para registrar inicio, fin y exportación
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf, fopen, fprintf
+#include <time.h>     // Para clock_gettime
+
+/*
+ * Estructura: TraceEvent
+ * Propósito: Un evento en el buffer de una pista.
+ *
+ * Campos:
+ *   ts    - inicio en ns desde trace_start()
+ *   dur   - duración en ns (solo franjas)
+ *   name  - nombre del evento (cadena estática: no se copia)
+ *   args  - argumentos numéricos; su significado depende de la pista
+ *   phase - 'X' franja, 'i' instante, 'C' contador (códigos de Chrome Trace)
+ */
+typedef struct {
+    unsigned long long ts;
+    unsigned long long dur;
+    const char* name;
+    int args[3];
+    char phase;
+} TraceEvent;
+
+/*
+ * VARIABLE GLOBAL - Bandera consultada por los módulos instrumentados
+ */
+int trace_enabled = 0;
+
+/*
+ * VARIABLES GLOBALES ESTÁTICAS
+ * Cada pista tiene su propio buffer. El índice de escritura se reserva con
+ * una suma atómica, así que el hilo del DMA y la CPU pueden registrar en la
+ * misma pista sin mutex.
+ */
+static TraceEvent buffers[TRACE_TRACK_COUNT][TRACE_BUFFER_EVENTS];
+static unsigned long next_slot[TRACE_TRACK_COUNT];   // Eventos registrados (total)
+static struct timespec origin;                       // Momento de trace_start()
+
+/*
+ * Nombres de las pistas y de los argumentos de cada una (NULL = sin usar)
+ */
+static const char* track_names[TRACE_TRACK_COUNT] = {
+    "CPU", "DMA canal 0", "Controlador de interrupciones", "Cabezal del disco"
+};
+static const char* arg_names[TRACE_TRACK_COUNT][3] = {
+    { "pc", NULL, NULL },
+    { "memoria", "sector", "palabras" },
+    { "vector", NULL, NULL },
+    { "pista", "cilindro", "sector" }
+};
+
+/*
+ * Función auxiliar: reserve (ESTÁTICA)
+ * Retorna: TraceEvent* - ranura para el siguiente evento de la pista.
+ * Al dar la vuelta se sobrescriben los eventos más antiguos.
+ */
+static TraceEvent* reserve(TraceTrack track) {
+    unsigned long slot = __sync_fetch_and_add(&next_slot[track], 1);
+    return &buffers[track][slot & (TRACE_BUFFER_EVENTS - 1)];
+}
+
+/*
+ * Función: trace_now
+ * Retorna: unsigned long long - nanosegundos desde trace_start()
+ */
+unsigned long long trace_now() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)(now.tv_sec - origin.tv_sec) * 1000000000ULL +
+           (now.tv_nsec - origin.tv_nsec);
+}
+
+/*
+ * Función: trace_start
+ * Propósito: Descartar la traza anterior y comenzar a registrar.
+ */
+void trace_start() {
+    trace_enabled = 0;
+    for (int t = 0; t < TRACE_TRACK_COUNT; t++) next_slot[t] = 0;
+    clock_gettime(CLOCK_MONOTONIC, &origin);
+    trace_enabled = 1;
+    log_event(LOG_INFO, "Traza iniciada");
+}
+
+/*
+ * Función: trace_stop
+ * Propósito: Dejar de registrar; los eventos quedan disponibles para exportar.
+ */
+void trace_stop() {
+    trace_enabled = 0;
+    log_event(LOG_INFO, "Traza detenida");
+}
+
+/*
+ * Función: trace_complete
+ * Parámetros:
+ *   track    - pista del evento
+ *   name     - nombre (cadena estática)
+ *   start_ns - inicio obtenido con trace_now(); el fin es el momento actual
+ *   arg0..2  - argumentos (ver arg_names)
+ */
+void trace_complete(TraceTrack track, const char* name, unsigned long long start_ns,
+                    int arg0, int arg1, int arg2) {
+    unsigned long long end = trace_now();
+    TraceEvent* e = reserve(track);
+    e->ts = start_ns;
+    e->dur = end - start_ns;
+    e->name = name;
+    e->args[0] = arg0;
+    e->args[1] = arg1;
+    e->args[2] = arg2;
+    e->phase = 'X';
+}
+
+/*
+ * Función: trace_instant
+ * Parámetros: track - pista, name - nombre, arg0 - primer argumento
+ */
+void trace_instant(TraceTrack track, const char* name, int arg0) {
+    TraceEvent* e = reserve(track);
+    e->ts = trace_now();
+    e->dur = 0;
+    e->name = name;
+    e->args[0] = arg0;
+    e->phase = 'i';
+}
+
+/*
+ * Función: trace_counter
+ * Parámetros: track - pista, name - nombre del contador, value - nuevo valor
+ */
+void trace_counter(TraceTrack track, const char* name, int value) {
+    TraceEvent* e = reserve(track);
+    e->ts = trace_now();
+    e->dur = 0;
+    e->name = name;
+    e->args[0] = value;
+    e->phase = 'C';
+}
+
+/*
+ * Función auxiliar: retained (ESTÁTICA)
+ * Retorna: unsigned long - eventos de la pista que siguen en el buffer
+ */
+static unsigned long retained(int track) {
+    return next_slot[track] < TRACE_BUFFER_EVENTS ? next_slot[track] : TRACE_BUFFER_EVENTS;
+}
+
+/*
+ * Función: trace_status
+ * Propósito: Mostrar si se está registrando y cuántos eventos tiene cada pista.
+ */
+void trace_status() {
+    printf("\n=== TRAZA (%s) ===\n", trace_enabled ? "registrando" : "detenida");
+    for (int t = 0; t < TRACE_TRACK_COUNT; t++) {
+        unsigned long lost = next_slot[t] - retained(t);
+        printf("  %-30s %8lu eventos", track_names[t], retained(t));
+        if (lost > 0) printf(" (%lu sobrescritos)", lost);
+        printf("\n");
+    }
+    printf("==================\n");
+}
+
+/*
+ * Función: trace_export
+ * Parámetros: filename - archivo JSON de salida
+ * Retorna: int - 0 si se exportó, -1 si no se pudo crear el archivo
+ * Propósito: Escribir la traza en formato Chrome Trace Event: metadatos con
+ *            el nombre de cada pista (un "hilo" por pista) y los eventos con
+ *            marcas de tiempo en microsegundos.
+ */
+int trace_export(const char* filename) {
+    FILE* out = fopen(filename, "w");
+    if (!out) {
+        log_event(LOG_ERROR, "Traza: no se pudo crear %s", filename);
+        return -1;
+    }
+
+    fprintf(out, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    fprintf(out, "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"sistema.exe\"}}");
+    for (int t = 0; t < TRACE_TRACK_COUNT; t++) {
+        fprintf(out, ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"%s\"}}",
+                t, track_names[t]);
+        fprintf(out, ",\n{\"name\": \"thread_sort_index\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"sort_index\": %d}}",
+                t, t);
+    }
+
+    unsigned long total = 0;
+    for (int t = 0; t < TRACE_TRACK_COUNT; t++) {
+        unsigned long count = retained(t);
+        unsigned long first = next_slot[t] - count;
+        for (unsigned long i = first; i < first + count; i++) {
+            const TraceEvent* e = &buffers[t][i & (TRACE_BUFFER_EVENTS - 1)];
+            fprintf(out, ",\n{\"name\": \"%s\", \"ph\": \"%c\", \"pid\": 1, \"tid\": %d, \"ts\": %llu.%03llu",
+                    e->name, e->phase, t, e->ts / 1000, e->ts % 1000);
+            if (e->phase == 'X') {
+                fprintf(out, ", \"dur\": %llu.%03llu", e->dur / 1000, e->dur % 1000);
+            } else if (e->phase == 'i') {
+                fprintf(out, ", \"s\": \"t\"");
+            }
+
+            fprintf(out, ", \"args\": {");
+            if (e->phase == 'C') {
+                fprintf(out, "\"valor\": %d", e->args[0]);
+            } else {
+                int args = (e->phase == 'X') ? 3 : 1;
+                for (int a = 0; a < args && arg_names[t][a] != NULL; a++) {
+                    fprintf(out, "%s\"%s\": %d", a ? ", " : "", arg_names[t][a], e->args[a]);
+                }
+            }
+            fprintf(out, "}}");
+        }
+        total += count;
+    }
+    fprintf(out, "\n]}\n");
+    fclose(out);
+
+    log_event(LOG_INFO, "Traza exportada a %s (%lu eventos)", filename, total);
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * Archivo de cabecera del módulo de trazas (trace) del Sistema Operativo Virtual.
+ * Registra en memoria eventos con marca de tiempo de la CPU, el DMA, el
+ * controlador de interrupciones y el cabezal del disco, y los exporta en el
+ * formato JSON de Chrome Trace Event, que abren chrome://tracing y Perfetto
+ * (ui.perfetto.dev) con una pista por componente.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+/*
+ * CONSTANTES DE CONFIGURACIÓN DE LAS TRAZAS
+ * TRACE_BUFFER_EVENTS - Capacidad del buffer circular de cada pista (potencia de 2).
+ *                       Al llenarse se conservan los eventos más recientes.
+ */
+#define TRACE_BUFFER_EVENTS 65536
+
+/*
+ * Enum: TraceTrack
+ * Propósito: Pistas de la traza (una fila en el visor por componente).
+ * El sistema tiene un único controlador DMA, así que hay un solo canal.
+ */
+typedef enum {
+    TRACE_TRACK_CPU,          // Una franja por instrucción ejecutada
+    TRACE_TRACK_DMA,          // Una franja por transferencia (canal 0)
+    TRACE_TRACK_INTERRUPTS,   // Interrupciones disparadas (instantes) y atendidas (franjas)
+    TRACE_TRACK_DISK,         // Accesos a sectores y posición del cabezal
+    TRACE_TRACK_COUNT
+} TraceTrack;
+
+/*
+ * DECLARACIÓN DE VARIABLE GLOBAL EXTERNA
+ * trace_enabled - Los módulos la consultan antes de registrar (una comparación
+ *                 por evento si la traza está apagada)
+ */
+extern int trace_enabled;
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del módulo de trazas
+ */
+
+/* FUNCIONES DE CONTROL */
+void trace_start();                        // Vaciar buffers y comenzar a registrar
+void trace_stop();                         // Dejar de registrar (los eventos se conservan)
+void trace_status();                       // Mostrar estado y eventos por pista
+int trace_export(const char* filename);    // Escribir el JSON (0 = éxito, -1 = error)
+
+/* FUNCIONES DE REGISTRO (llamar solo si trace_enabled) */
+unsigned long long trace_now();            // Marca de tiempo actual en ns (relativa al inicio)
+void trace_complete(TraceTrack track, const char* name, unsigned long long start_ns,
+                    int arg0, int arg1, int arg2);   // Franja [start_ns, ahora]
+void trace_instant(TraceTrack track, const char* name, int arg0);  // Evento puntual
+void trace_counter(TraceTrack track, const char* name, int value); // Valor de un contador
+
+#endif /* TRACE_H */
@@ -0,0 +1,39 @@
+; Servicios del sistema de archivos: crea DATOS, escribe 5 palabras,
+; vuelve al inicio y las lee en otro búfer. Al terminar el AC tiene las
+; palabras leídas (5).
+
+main:   LOAD #p_open
+        SVC                     ; AC = descriptor
+        STR p_write+1
+        STR p_seek+1
+        STR p_read+1
+        STR p_size+1
+        STR p_close+1
+        LOAD #p_write
+        SVC
+        LOAD #p_seek
+        SVC
+        LOAD #p_read
+        SVC
+        STR leidas
+        LOAD #p_size
+        SVC
+        STR tam
+        LOAD #p_close
+        SVC
+        LOAD leidas
+        HALT
+
+; Bloques de parámetros: servicio y argumentos
+p_open:  .word 1, nombre, 1     ; open(nombre, crear)
+p_write: .word 4, 0, datos, 5   ; write(fd, datos, 5)
+p_seek:  .word 5, 0, 0          ; seek(fd, 0)
+p_read:  .word 3, 0, copia, 5   ; read(fd, copia, 5)
+p_size:  .word 6, 0             ; size(fd)
+p_close: .word 2, 0             ; close(fd)
+
+nombre: .word 40120, 151900, 0, 0   ; "DATOS" (D=04 A=01 T=20 O=15 S=19)
+datos:  .word 11, 22, 33, 44, 55
+copia:  .space 5
+leidas: .word 0
+tam:    .word 0
@@ -0,0 +1,31 @@
+; Consumidor de memoria compartida: adjunta el segmento de clave 77 que dejó
+; productor.asm, suma los datos leyéndolos directamente del segmento y lo
+; borra. Al terminar el AC tiene la suma (165 con los datos del productor).
+
+        .equ SEGMENTO, 10000    ; Ventana lógica del segmento (SEGMENT_WINDOW)
+
+main:   LOAD #p_create
+        SVC                     ; Misma clave: el segmento existente
+        STR p_attach+1
+        STR p_remove+1
+        LOAD #p_attach
+        SVC
+        LOAD SEGMENTO+1
+        SUM SEGMENTO+2
+        SUM SEGMENTO+3
+        SUM SEGMENTO+4
+        SUM SEGMENTO+5
+        STR suma
+        LOAD #p_remove
+        SVC                     ; Se libera al soltarlo
+        LOAD #p_detach
+        SVC
+        LOAD suma
+        HALT
+
+p_create: .word 10, 77, 6
+p_attach: .word 11, 0
+p_remove: .word 13, 0           ; shmremove(id)
+p_detach: .word 12
+
+suma:   .word 0
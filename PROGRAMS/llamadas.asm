@@ -0,0 +1,22 @@
+; Llamadas anidadas: main llama 3 veces a fn_10, que llama a fn_20
+; (mismo programa que llamadas.txt, escrito para asm.exe)
+
+        .macro LLAMAR_VECES rutina
+        CALL \rutina
+        CALL \rutina
+        CALL \rutina
+        .endm
+
+main:   LOAD #0
+        LLAMAR_VECES fn_10
+        HALT
+        .org 10
+
+fn_10:  SUM #1
+        CALL fn_20
+        RET
+        .org 20
+
+fn_20:  SUM #10
+        SUM #10
+        RET
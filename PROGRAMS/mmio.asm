@@ -0,0 +1,35 @@
+; E/S mapeada en memoria: los mismos dispositivos que IN/OUT, DMA_* e
+; IO_STATUS, manejados solo con LOAD/STORE sobre la ventana MMIO
+; (ver MMIO/mmio.h). Escribe una palabra al disco con el canal DMA y
+; muestra por el terminal el estado de la transferencia, la palabra y las
+; instrucciones ejecutadas hasta ese momento.
+
+        .equ TERM_DATOS, 20000
+        .equ TERM_CONTROL, 20001
+        .equ DMA_DIRECCION, 20010
+        .equ DMA_UBICACION, 20011
+        .equ DMA_TAMANO, 20012
+        .equ DMA_COMANDO, 20013
+        .equ INSTRUCCIONES, 20020
+
+main:   LOAD #1
+        STR DMA_TAMANO
+        LOAD #10203             ; Pista 1, cilindro 2, sector 3
+        STR DMA_UBICACION
+        LOAD #dato
+        STR DMA_DIRECCION
+        LOAD #1
+        STR DMA_COMANDO         ; Escribir al disco
+        LOAD #2
+        STR DMA_COMANDO         ; Esperar
+        LOAD DMA_COMANDO        ; Estado: 0 = éxito
+        STR TERM_DATOS
+        LOAD dato
+        STR TERM_DATOS
+        LOAD INSTRUCCIONES
+        STR TERM_DATOS
+        LOAD #3
+        STR TERM_CONTROL        ; Entregar al host
+        HALT
+
+dato:   .word 4321
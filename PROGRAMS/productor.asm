@@ -0,0 +1,28 @@
+; Productor de memoria compartida: crea (o encuentra) el segmento de clave
+; 77, lo adjunta y deja en él la cantidad de datos seguida de los datos.
+; El segmento queda en la reserva del SO después del HALT; consumidor.asm
+; lo lee sin copias. Al terminar el AC tiene la dirección del segmento.
+
+        .equ SEGMENTO, 10000    ; Ventana lógica del segmento (SEGMENT_WINDOW)
+
+main:   LOAD #p_create
+        SVC                     ; AC = identificador
+        STR p_attach+1
+        LOAD #p_attach
+        SVC                     ; AC = SEGMENTO
+        STR base
+        LOAD #5
+        STR SEGMENTO            ; palabra 0: cantidad
+        MOVB copia              ; palabras 1..5: datos
+        LOAD #p_detach
+        SVC
+        LOAD base
+        HALT
+
+p_create: .word 10, 77, 6       ; shmcreate(clave 77, 6 palabras)
+p_attach: .word 11, 0           ; shmattach(id)
+p_detach: .word 12              ; shmdetach()
+
+copia:  .word datos, SEGMENTO+1, 5   ; MOVB: origen, destino, cantidad
+datos:  .word 11, 22, 33, 44, 55
+base:   .word 0
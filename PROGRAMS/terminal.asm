@@ -0,0 +1,24 @@
+; Dispositivo de terminal: muestra los cuadrados de 1 a 10 con OUT (una
+; palabra por línea, todo en una sola escritura al host) y después un saludo
+; en formato de caracteres con un único SVC de escritura en bloque.
+
+main:   LOAD #1
+        STR i
+bucle:  LOAD i
+        MULT i
+        STR cuad
+        OUT cuad                ; Se encola; nada llega al host todavía
+        LOAD i
+        SUM #1
+        STR i
+        CMP #11
+        JLT bucle
+        IO_STATUS #2            ; Formato de caracteres (entrega lo anterior)
+        LOAD #p_write
+        SVC                     ; termwrite(saludo, 6)
+        HALT                    ; Entrega el saludo
+
+p_write: .word 30, saludo, 6
+saludo:  .word 72, 111, 108, 97, 33, 10   ; "Hola!\n"
+i:       .word 0
+cuad:    .word 0
@@ -14,6 +14,8 @@ void init_registers() {
     cpu_registers.IR = int_to_word(0);
     cpu_registers.RB = int_to_word(0);
     cpu_registers.RL = int_to_word(1024);  // Ejemplo: límite de 1024 palabras
+    cpu_registers.RBS = int_to_word(0);
+    cpu_registers.RLS = int_to_word(0);    // Sin segmento compartido
     cpu_registers.RX = int_to_word(0);
     cpu_registers.SP = int_to_word(1023);  // Stack al final de memoria
     
@@ -37,6 +39,8 @@ void dump_registers() {
     printf("IR:  %s\n", cpu_registers.IR.data);
     printf("RB:  %s\n", cpu_registers.RB.data);
     printf("RL:  %s\n", cpu_registers.RL.data);
+    printf("RBS: %s\n", cpu_registers.RBS.data);
+    printf("RLS: %s\n", cpu_registers.RLS.data);
     printf("RX:  %s\n", cpu_registers.RX.data);
     printf("SP:  %s\n", cpu_registers.SP.data);
     printf("PC:  %s (int: %d)\n", cpu_registers.PC.data, word_to_int(cpu_registers.PC));
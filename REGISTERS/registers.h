@@ -19,6 +19,8 @@ typedef struct {
     Word IR;     // Instruction Register
     Word RB;     // Registro Base
     Word RL;     // Registro Límite
+    Word RBS;    // Base física del segmento compartido (ver SEGMENT_WINDOW)
+    Word RLS;    // Límite del segmento compartido (0 = ninguno)
     Word RX;     // Base de pila
     Word SP;     // Stack Pointer
     Word PC;     // Program Counter real (como Word)
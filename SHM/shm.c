@@ -0,0 +1,229 @@
+/*
+ * Archivo de implementación de la memoria compartida del Sistema Operativo Virtual.
+ * Administra la tabla de segmentos y la reserva de palabras físicas, y
+ * adjunta segmentos al proceso actual cargando RBS/RLS.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "shm.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../REGISTERS/registers.h"   // Para int_to_word
+#include "../SYSCALL/syscall.h"       // Para registrar los servicios
+#include "../CPU/blockcache.h"        // Para invalidar bloques traducidos
+#include "../LOGGER/logger.h"         // Para registrar eventos
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf
+
+/*
+ * Estructura: Segment
+ * Propósito: Entrada de la tabla de segmentos.
+ */
+typedef struct {
+    int used;
+    int key;          // Clave con la que se creó (0 = privado)
+    int base;         // Primera palabra física
+    int size;
+    int attached;     // Procesos que lo tienen adjunto
+    int removed;      // Borrado pendiente hasta que attached llegue a 0
+} Segment;
+
+/*
+ * VARIABLES GLOBALES DEL MÓDULO (privadas)
+ * current - identificador adjunto al proceso actual (0 = ninguno)
+ */
+static Segment segments[SHM_MAX_SEGMENTS];
+static int current = 0;
+
+/*
+ * Función auxiliar: segment (ESTÁTICA)
+ * Retorna: Segment* - entrada del identificador, o NULL si no existe
+ */
+static Segment* segment(int id) {
+    if (id < 1 || id > SHM_MAX_SEGMENTS || !segments[id - 1].used) return NULL;
+    return &segments[id - 1];
+}
+
+/*
+ * Función auxiliar: find_space (ESTÁTICA)
+ * Retorna: int - dirección física donde caben size palabras sin solaparse
+ *          con ningún segmento (primer hueco), o -1
+ */
+static int find_space(int size) {
+    int start = SHM_POOL_START;
+    int moved = 1;
+    while (moved && start + size <= OS_RESERVED) {
+        moved = 0;
+        for (int i = 0; i < SHM_MAX_SEGMENTS; i++) {
+            const Segment* s = &segments[i];
+            if (s->used && s->base < start + size && start < s->base + s->size) {
+                start = s->base + s->size;  // Saltar el segmento que estorba
+                moved = 1;
+            }
+        }
+    }
+    return (start + size <= OS_RESERVED) ? start : -1;
+}
+
+/*
+ * Función auxiliar: free_segment (ESTÁTICA)
+ */
+static void free_segment(int id) {
+    Segment* s = &segments[id - 1];
+    log_event(LOG_INFO, "Segmento compartido %d liberado (%d palabras en %d)", id, s->size, s->base);
+    s->used = 0;
+}
+
+/*
+ * Función: shm_create
+ * Parámetros:
+ *   key  - clave del segmento (> 0 para compartirlo; 0 = privado)
+ *   size - palabras
+ * Retorna: int - identificador, o un código SHM_ERR_*
+ * Propósito: Crear un segmento lleno de ceros, o encontrar el de la clave.
+ */
+int shm_create(int key, int size) {
+    if (key < 0 || size <= 0 || size > SHM_POOL_SIZE) return SHM_ERR_INVALID;
+    if (key > 0) {
+        for (int i = 0; i < SHM_MAX_SEGMENTS; i++) {
+            const Segment* s = &segments[i];
+            if (!s->used || s->removed || s->key != key) continue;
+            return (size <= s->size) ? i + 1 : SHM_ERR_SIZE;
+        }
+    }
+
+    int slot = -1;
+    for (int i = 0; i < SHM_MAX_SEGMENTS && slot < 0; i++) {
+        if (!segments[i].used) slot = i;
+    }
+    int base = find_space(size);
+    if (slot < 0 || base < 0) return SHM_ERR_NO_SPACE;
+
+    Segment* s = &segments[slot];
+    s->used = 1;
+    s->key = key;
+    s->base = base;
+    s->size = size;
+    s->attached = 0;
+    s->removed = 0;
+    Word zero = int_to_word(0);
+    for (int i = 0; i < size; i++) memory[base + i] = zero;
+    if (blockcache_enabled) {
+        for (int i = 0; i < size; i++) blockcache_on_write(base + i);
+    }
+    log_event(LOG_INFO, "Segmento compartido %d creado: clave %d, %d palabras en %d",
+              slot + 1, key, size, base);
+    return slot + 1;
+}
+
+/*
+ * Función: shm_attach
+ * Parámetros: id - identificador
+ * Retorna: int - dirección lógica del segmento, o un código SHM_ERR_*
+ */
+int shm_attach(int id) {
+    Segment* s = segment(id);
+    if (s == NULL || s->removed) return SHM_ERR_NOT_FOUND;
+    if (current == id) return SEGMENT_WINDOW;
+    if (current != 0) return SHM_ERR_ATTACHED;
+    s->attached++;
+    current = id;
+    set_memory_segment(s->base, s->size);
+    return SEGMENT_WINDOW;
+}
+
+/*
+ * Función: shm_detach
+ * Retorna: int - 0, o SHM_ERR_NOT_FOUND si no había segmento adjunto
+ */
+int shm_detach() {
+    Segment* s = segment(current);
+    if (s == NULL) return SHM_ERR_NOT_FOUND;
+    set_memory_segment(0, 0);
+    s->attached--;
+    if (s->removed && s->attached == 0) free_segment(current);
+    current = 0;
+    return 0;
+}
+
+/*
+ * Función: shm_remove
+ * Parámetros: id - identificador
+ * Retorna: int - 0, o SHM_ERR_NOT_FOUND
+ * Propósito: Borrar la clave en el acto; las palabras se liberan cuando el
+ *            último proceso que lo tiene adjunto lo suelta.
+ */
+int shm_remove(int id) {
+    Segment* s = segment(id);
+    if (s == NULL || s->removed) return SHM_ERR_NOT_FOUND;
+    s->removed = 1;
+    if (s->attached == 0) free_segment(id);
+    return 0;
+}
+
+/*
+ * Función: shm_release
+ * Propósito: Soltar el segmento del proceso que termina (la consola la
+ *            llama al cargar el programa siguiente).
+ */
+void shm_release() {
+    if (current != 0) shm_detach();
+    set_memory_segment(0, 0);
+}
+
+/*
+ * Función: shm_status
+ */
+void shm_status() {
+    int used = 0, count = 0;
+    printf("\n=== MEMORIA COMPARTIDA ===\n");
+    printf("Reserva:              %d palabras (físicas %d-%d), ventana lógica %d\n",
+           SHM_POOL_SIZE, SHM_POOL_START, OS_RESERVED - 1, SEGMENT_WINDOW);
+    for (int i = 0; i < SHM_MAX_SEGMENTS; i++) {
+        const Segment* s = &segments[i];
+        if (!s->used) continue;
+        if (count++ == 0) printf("\n  ID    CLAVE  PALABRAS  FÍSICA  ADJUNTOS\n");
+        printf("  %2d %8d %9d %7d %9d%s%s\n", i + 1, s->key, s->size, s->base, s->attached,
+               (i + 1 == current) ? "  (proceso actual)" : "", s->removed ? "  (borrado)" : "");
+        used += s->size;
+    }
+    if (count > 0) printf("\n");
+    printf("Segmentos:            %d de %d (%d de %d palabras usadas)\n",
+           count, SHM_MAX_SEGMENTS, used, SHM_POOL_SIZE);
+    printf("==========================\n");
+}
+
+/*
+ * Función: shm_error_text
+ */
+const char* shm_error_text(int code) {
+    switch (code) {
+        case SHM_ERR_INVALID:   return "clave o tamaño inválidos";
+        case SHM_ERR_NO_SPACE:  return "no queda lugar para segmentos compartidos";
+        case SHM_ERR_NOT_FOUND: return "el segmento no existe";
+        case SHM_ERR_SIZE:      return "el segmento de esa clave es más chico";
+        case SHM_ERR_ATTACHED:  return "el proceso ya tiene otro segmento adjunto";
+        default:                return "error desconocido";
+    }
+}
+
+/*
+ * SERVICIOS SVC (ESTÁTICOS)
+ */
+static int svc_create(const int* args) { return shm_create(args[0], args[1]); }
+static int svc_attach(const int* args) { return shm_attach(args[0]); }
+static int svc_detach(const int* args) { (void)args; return shm_detach(); }
+static int svc_remove(const int* args) { return shm_remove(args[0]); }
+
+/*
+ * Función: init_shm
+ */
+void init_shm() {
+    for (int i = 0; i < SHM_MAX_SEGMENTS; i++) segments[i].used = 0;
+    current = 0;
+    syscall_register(SHM_SVC_CREATE, 2, "shmcreate", svc_create);
+    syscall_register(SHM_SVC_ATTACH, 1, "shmattach", svc_attach);
+    syscall_register(SHM_SVC_DETACH, 0, "shmdetach", svc_detach);
+    syscall_register(SHM_SVC_REMOVE, 1, "shmremove", svc_remove);
+}
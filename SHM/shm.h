@@ -0,0 +1,72 @@
+/*
+ * Archivo de cabecera de la memoria compartida del Sistema Operativo Virtual.
+ * Un segmento compartido es un rango de palabras físicas tomado de la
+ * reserva SHM_POOL_START..OS_RESERVED-1 (dentro del área del SO, fuera del
+ * alcance de la región RB/RL de cualquier proceso). Los procesos lo
+ * identifican por una clave numérica y lo adjuntan a su espacio de
+ * direcciones por medio del segmento secundario (RBS/RLS, ver
+ * MEMORY/memory.h): queda visible en las direcciones lógicas
+ * SEGMENT_WINDOW en adelante, sin copias entre procesos.
+ *
+ * Con registros base y límite cada proceso tiene un solo segmento
+ * secundario, así que un proceso adjunta un segmento a la vez. Los
+ * segmentos sobreviven a los procesos que los usan (el productor puede
+ * terminar antes de que el consumidor los lea) hasta que se borran con
+ * SHM_SVC_REMOVE o el comando 'shm rm' de la consola.
+ */
+
+#ifndef SHM_H
+#define SHM_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../MEMORY/memory.h"  // Para OS_RESERVED y SEGMENT_WINDOW
+
+/*
+ * CONSTANTES DE CONFIGURACIÓN
+ * SHM_POOL_START   - Primera palabra física de la reserva de segmentos
+ * SHM_POOL_SIZE    - Palabras de la reserva
+ * SHM_MAX_SEGMENTS - Segmentos existentes a la vez (identificadores 1..N)
+ */
+#define SHM_POOL_START 100
+#define SHM_POOL_SIZE (OS_RESERVED - SHM_POOL_START)
+#define SHM_MAX_SEGMENTS 8
+
+/*
+ * CÓDIGOS DE ERROR (resultado negativo de los SVC)
+ */
+#define SHM_ERR_INVALID   -11   // Tamaño o clave inválidos
+#define SHM_ERR_NO_SPACE  -12   // No hay lugar en la reserva o en la tabla
+#define SHM_ERR_NOT_FOUND -13   // El identificador no existe
+#define SHM_ERR_SIZE      -14   // La clave ya existe con un tamaño menor
+#define SHM_ERR_ATTACHED  -15   // El proceso ya tiene otro segmento adjunto
+
+/*
+ * SERVICIOS SVC DE MEMORIA COMPARTIDA (ver SYSCALL/syscall.h)
+ *   SHM_SVC_CREATE (clave, tamaño) -> identificador; si la clave ya existe
+ *                                     retorna su segmento (clave 0: siempre uno nuevo)
+ *   SHM_SVC_ATTACH (identificador) -> dirección lógica del segmento (SEGMENT_WINDOW)
+ *   SHM_SVC_DETACH ()              -> 0
+ *   SHM_SVC_REMOVE (identificador) -> 0; se libera cuando nadie lo tiene adjunto
+ */
+#define SHM_SVC_CREATE 10
+#define SHM_SVC_ATTACH 11
+#define SHM_SVC_DETACH 12
+#define SHM_SVC_REMOVE 13
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública de la memoria compartida
+ * Las funciones que retornan int usan los códigos SHM_ERR_* para los errores.
+ */
+void init_shm();                       // Vaciar la tabla y registrar los SVC
+int shm_create(int key, int size);     // Identificador del segmento
+int shm_attach(int id);                // Adjuntarlo al proceso actual
+int shm_detach();                      // Quitar el segmento del proceso actual
+int shm_remove(int id);                // Borrar (diferido mientras esté adjunto)
+void shm_release();                    // El proceso actual terminó: soltar su segmento
+void shm_status();                     // Mostrar los segmentos
+const char* shm_error_text(int code);  // Mensaje para un código SHM_ERR_*
+
+#endif /* SHM_H */
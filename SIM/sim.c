@@ -0,0 +1,208 @@
+/*
+ * Archivo de implementación del núcleo de simulación por eventos del Sistema Operativo Virtual.
+ * La cola es un montículo binario de mínimos ordenado por vencimiento; a
+ * igual vencimiento sale primero el evento agendado antes, para que el
+ * orden no dependa de cómo quedó el montículo.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "sim.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../INTERRUPTS/interrupts.h"  // Para el tic del reloj (INT_TIMER)
+#include "../LOGGER/logger.h"          // Para registro de eventos
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para printf
+
+/*
+ * Estructura: SimEvent
+ * Propósito: Un evento agendado.
+ */
+typedef struct {
+    unsigned long long deadline;   // Ciclo del reloj virtual en que vence
+    int id;                        // Orden de creación (desempata vencimientos iguales)
+    const char* name;
+    SimCallback callback;
+    int arg;
+} SimEvent;
+
+/*
+ * VARIABLES GLOBALES
+ */
+unsigned long long sim_next_deadline = SIM_NEVER;
+unsigned long long sim_idle_cycles = 0;
+
+static SimEvent queue[SIM_MAX_EVENTS];   // queue[0] es el próximo evento
+static int queued = 0;
+static int next_id = 0;
+static unsigned long long timer_period = 0;
+static int timer_event = -1;             // Evento del próximo tic (-1 = apagado)
+
+/*
+ * Función auxiliar: earlier (ESTÁTICA)
+ * Retorna: int - 1 si a debe atenderse antes que b
+ */
+static int earlier(const SimEvent* a, const SimEvent* b) {
+    if (a->deadline != b->deadline) return a->deadline < b->deadline;
+    return a->id < b->id;
+}
+
+/*
+ * Funciones auxiliares: sift_up / sift_down (ESTÁTICAS)
+ * Propósito: Restaurar el montículo desde la posición i.
+ */
+static void sift_up(int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!earlier(&queue[i], &queue[parent])) break;
+        SimEvent tmp = queue[i];
+        queue[i] = queue[parent];
+        queue[parent] = tmp;
+        i = parent;
+    }
+}
+
+static void sift_down(int i) {
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= queued) break;
+        if (child + 1 < queued && earlier(&queue[child + 1], &queue[child])) child++;
+        if (!earlier(&queue[child], &queue[i])) break;
+        SimEvent tmp = queue[i];
+        queue[i] = queue[child];
+        queue[child] = tmp;
+        i = child;
+    }
+}
+
+/*
+ * Función auxiliar: remove_at (ESTÁTICA)
+ * Retorna: SimEvent - el evento quitado de la posición i
+ */
+static SimEvent remove_at(int i) {
+    SimEvent event = queue[i];
+    queue[i] = queue[--queued];
+    if (i < queued) {
+        sift_down(i);
+        sift_up(i);
+    }
+    sim_next_deadline = (queued > 0) ? queue[0].deadline : SIM_NEVER;
+    return event;
+}
+
+/*
+ * Función auxiliar: timer_tick (ESTÁTICA)
+ * Propósito: Tic del reloj del sistema: marcar INT_TIMER y agendar el siguiente.
+ */
+static void timer_tick(int arg) {
+    (void)arg;
+    timer_event = sim_schedule(timer_period, "reloj", timer_tick, 0);
+    trigger_interrupt(INT_TIMER);
+}
+
+/*
+ * Función: init_sim
+ */
+void init_sim() {
+    queued = 0;
+    next_id = 0;
+    sim_next_deadline = SIM_NEVER;
+    sim_idle_cycles = 0;
+    timer_period = 0;
+    timer_event = -1;
+    log_event(LOG_INFO, "Núcleo de simulación inicializado (reloj virtual en ciclos)");
+}
+
+/*
+ * Función: sim_schedule
+ */
+int sim_schedule(unsigned long long delay, const char* name, SimCallback callback, int arg) {
+    if (queued == SIM_MAX_EVENTS) {
+        log_event(LOG_ERROR, "Simulación: cola de eventos llena, se descarta '%s'", name);
+        return -1;
+    }
+    SimEvent* event = &queue[queued];
+    event->deadline = SIM_NOW() + delay;
+    event->id = next_id++;
+    event->name = name;
+    event->callback = callback;
+    event->arg = arg;
+    sift_up(queued++);
+    sim_next_deadline = queue[0].deadline;
+    return event->id;
+}
+
+/*
+ * Función: sim_cancel
+ */
+int sim_cancel(int id) {
+    for (int i = 0; i < queued; i++) {
+        if (queue[i].id != id) continue;
+        remove_at(i);
+        return 0;
+    }
+    return -1;
+}
+
+/*
+ * Función: sim_run_due
+ * Propósito: Atender, en orden, los eventos cuyo vencimiento ya llegó. Una
+ *            acción puede agendar eventos nuevos; si vencen ya, también se
+ *            atienden en esta llamada.
+ */
+void sim_run_due() {
+    while (queued > 0 && queue[0].deadline <= SIM_NOW()) {
+        SimEvent event = remove_at(0);
+        event.callback(event.arg);
+    }
+}
+
+/*
+ * Función: sim_skip
+ * Retorna: int - 1 si atendió un evento, 0 si la cola estaba vacía
+ * Propósito: La CPU no tiene nada que hacer hasta el próximo evento (espera
+ *            de E/S): adelantar el reloj hasta su vencimiento y atenderlo.
+ */
+int sim_skip() {
+    if (queued == 0) return 0;
+    unsigned long long now = SIM_NOW();
+    if (queue[0].deadline > now) sim_idle_cycles += queue[0].deadline - now;
+    sim_run_due();
+    return 1;
+}
+
+/*
+ * Función: sim_set_timer
+ */
+void sim_set_timer(unsigned long long period) {
+    if (timer_event >= 0) sim_cancel(timer_event);
+    timer_event = -1;
+    timer_period = period;
+    if (period > 0) timer_event = sim_schedule(period, "reloj", timer_tick, 0);
+    log_event(LOG_INFO, "Reloj del sistema: %s (%llu ciclos)", period > 0 ? "activo" : "apagado", period);
+}
+
+/*
+ * Función: sim_get_timer
+ */
+unsigned long long sim_get_timer() {
+    return timer_period;
+}
+
+/*
+ * Función: sim_status
+ */
+void sim_status() {
+    unsigned long long now = SIM_NOW();
+    printf("\n=== SIMULACIÓN ===\n");
+    printf("Reloj virtual:   %llu ciclos (%llu ejecutando, %llu esperando E/S)\n",
+           now, cpu_instructions_retired, sim_idle_cycles);
+    if (timer_period > 0) printf("Reloj del sistema: INT_TIMER cada %llu ciclos\n", timer_period);
+    else printf("Reloj del sistema: apagado\n");
+    printf("Eventos agendados: %d\n", queued);
+    for (int i = 0; i < queued; i++) {
+        printf("  %-10s vence en el ciclo %llu (en %llu)\n", queue[i].name, queue[i].deadline,
+               queue[i].deadline > now ? queue[i].deadline - now : 0);
+    }
+}
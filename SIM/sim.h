@@ -0,0 +1,81 @@
+/*
+ * Archivo de cabecera del núcleo de simulación por eventos del Sistema Operativo Virtual.
+ *
+ * El tiempo de la máquina es un reloj virtual en ciclos: avanza un ciclo por
+ * instrucción retirada y salta hacia adelante cuando la CPU espera sin hacer
+ * nada (DMA_WAIT). Los dispositivos no duermen en el host: agendan un evento
+ * para el ciclo en que terminan (fin de una transferencia DMA, tic del reloj)
+ * en una cola de prioridad. La CPU ejecuta bloques sin pasarse del próximo
+ * vencimiento y atiende los eventos vencidos entre bloques, así que cada
+ * evento ocurre siempre en la misma instrucción: las ejecuciones son
+ * deterministas y van tan rápido como lo permita el host.
+ *
+ * Los eventos se atienden en el hilo de la CPU. La red entre VMs
+ * (NET/net.h) sigue con su hilo propio: su tiempo es el de las otras VMs.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+#include "../CPU/cpu.h"   // Para cpu_instructions_retired
+#include "../CPU/blockcache.h"  // Para blockcache_in_flight
+
+/*
+ * CONSTANTES DEL NÚCLEO DE SIMULACIÓN
+ * SIM_NEVER      - Vencimiento cuando la cola está vacía
+ * SIM_MAX_EVENTS - Eventos agendados al mismo tiempo como máximo
+ */
+#define SIM_NEVER 0xFFFFFFFFFFFFFFFFULL
+#define SIM_MAX_EVENTS 64
+
+/*
+ * Tipo: SimCallback
+ * Parámetros: arg - el valor indicado al agendar el evento
+ * Propósito: Acción de un evento, ejecutada en el ciclo de su vencimiento.
+ */
+typedef void (*SimCallback)(int arg);
+
+/*
+ * DECLARACIÓN DE VARIABLES GLOBALES EXTERNAS
+ * sim_next_deadline - ciclo del próximo evento (SIM_NEVER si no hay); la CPU
+ *                     lo compara después de cada bloque
+ * sim_idle_cycles   - ciclos que el reloj saltó con la CPU esperando
+ */
+extern unsigned long long sim_next_deadline;
+extern unsigned long long sim_idle_cycles;
+
+/*
+ * Macro: SIM_NOW
+ * Propósito: Ciclo actual del reloj virtual. Incluye las instrucciones del
+ *            bloque en curso que todavía no se sumaron a las retiradas.
+ */
+#define SIM_NOW() (cpu_instructions_retired + blockcache_in_flight + sim_idle_cycles)
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del núcleo de simulación
+ */
+void init_sim();                           // Vaciar la cola y apagar el reloj del sistema
+
+/*
+ * Función: sim_schedule
+ * Parámetros:
+ *   delay    - ciclos desde ahora hasta el evento (0 = al terminar la instrucción)
+ *   name     - nombre para 'sim status' y el registro de eventos
+ *   callback - acción del evento
+ *   arg      - argumento de la acción
+ * Retorna: int - identificador del evento, o -1 si la cola está llena
+ */
+int sim_schedule(unsigned long long delay, const char* name, SimCallback callback, int arg);
+
+int sim_cancel(int id);                    // Quitar un evento de la cola (0, o -1 si no está)
+void sim_run_due();                        // Atender los eventos vencidos, en orden
+int sim_skip();                            // CPU ociosa: saltar al próximo evento (0 si no hay)
+void sim_set_timer(unsigned long long period); // INT_TIMER cada 'period' ciclos (0 = apagado)
+unsigned long long sim_get_timer();        // Período del reloj del sistema (0 = apagado)
+void sim_status();                         // Mostrar el reloj y la cola de eventos
+
+#endif /* SIM_H */
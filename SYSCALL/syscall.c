@@ -0,0 +1,86 @@
+/*
+ * Archivo de implementación del despachador de llamadas al sistema del Sistema Operativo Virtual.
+ * Lee el bloque de parámetros apuntado por el AC, llama al servicio
+ * registrado y deja el resultado en el AC.
+ */
+
+/* Inclusión de cabecera propia del módulo */
+#include "syscall.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../MEMORY/memory.h"         // Para read_memory_block
+#include "../REGISTERS/registers.h"   // Para cpu_registers (AC)
+#include "../INTERRUPTS/interrupts.h" // Para INT_INVALID_SYSCALL
+#include "../LOGGER/logger.h"         // Para registrar cada llamada
+
+/* Inclusión de bibliotecas estándar */
+#include <stddef.h>   // Para NULL
+
+/*
+ * Estructura: ServiceEntry
+ * Propósito: Servicio registrado en la tabla.
+ */
+typedef struct {
+    const char* name;
+    int args;
+    SyscallService function;    // NULL si el número no está registrado
+} ServiceEntry;
+
+static ServiceEntry services[SYSCALL_MAX_SERVICES];
+
+/*
+ * Función: init_syscalls
+ */
+void init_syscalls() {
+    for (int i = 0; i < SYSCALL_MAX_SERVICES; i++) {
+        services[i].name = NULL;
+        services[i].args = 0;
+        services[i].function = NULL;
+    }
+}
+
+/*
+ * Función: syscall_register
+ */
+void syscall_register(int service, int args, const char* name, SyscallService function) {
+    if (service < 0 || service >= SYSCALL_MAX_SERVICES || args < 0 || args > SYSCALL_MAX_ARGS) {
+        log_event(LOG_ERROR, "Registro de servicio inválido: %d (%s)", service, name);
+        return;
+    }
+    services[service].name = name;
+    services[service].args = args;
+    services[service].function = function;
+}
+
+/*
+ * Función: syscall_dispatch
+ */
+void syscall_dispatch() {
+    int block = word_to_int(cpu_registers.AC);
+    Word words[1 + SYSCALL_MAX_ARGS];
+    int result;
+
+    if (read_memory_block(block, words, 1) != 0) {
+        log_event(LOG_ERROR, "SVC: bloque de parámetros inválido en %d", block);
+        cpu_registers.AC = int_to_word(SYSCALL_ERR_ADDRESS);
+        return;
+    }
+    int service = word_to_int(words[0]);
+    if (service < 0 || service >= SYSCALL_MAX_SERVICES || services[service].function == NULL) {
+        log_event(LOG_ERROR, "SVC: servicio %d no existe", service);
+        cpu_registers.AC = int_to_word(SYSCALL_ERR_UNKNOWN);
+        trigger_interrupt(INT_INVALID_SYSCALL);
+        return;
+    }
+
+    int args[SYSCALL_MAX_ARGS] = {0};
+    int count = services[service].args;
+    if (read_memory_block(block + 1, words + 1, count) != 0) {
+        result = SYSCALL_ERR_ADDRESS;
+    } else {
+        for (int i = 0; i < count; i++) args[i] = word_to_int(words[1 + i]);
+        result = services[service].function(args);
+    }
+    log_event(LOG_INFO, "SVC %d (%s) -> %d", service, services[service].name, result);
+    cpu_registers.AC = int_to_word(result);
+}
@@ -0,0 +1,66 @@
+/*
+ * Archivo de cabecera del despachador de llamadas al sistema del Sistema Operativo Virtual.
+ *
+ * Convención de SVC: antes de la instrucción el programa deja en el AC la
+ * dirección lógica de un bloque de parámetros:
+ *   bloque[0]     - número de servicio
+ *   bloque[1..n]  - argumentos (n según el servicio)
+ * Al volver, el AC tiene el resultado: >= 0 si el servicio terminó bien, o
+ * un código de error negativo (SYSCALL_ERR_* o los propios del servicio).
+ * Los búferes se pasan como dirección lógica + cantidad de palabras.
+ *
+ * Cada módulo registra sus servicios con syscall_register() al iniciarse.
+ */
+
+#ifndef SYSCALL_H
+#define SYSCALL_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+/*
+ * CONSTANTES DEL DESPACHADOR
+ * SYSCALL_MAX_SERVICES - Números de servicio válidos: 0 a SYSCALL_MAX_SERVICES-1
+ * SYSCALL_MAX_ARGS     - Argumentos como máximo en el bloque de parámetros
+ */
+#define SYSCALL_MAX_SERVICES 100
+#define SYSCALL_MAX_ARGS 6
+
+/*
+ * CÓDIGOS DE ERROR COMUNES (en el AC)
+ * SYSCALL_ERR_UNKNOWN - Servicio no registrado (además dispara INT_INVALID_SYSCALL)
+ * SYSCALL_ERR_ADDRESS - El bloque de parámetros o un búfer está fuera de la región
+ */
+#define SYSCALL_ERR_UNKNOWN -99
+#define SYSCALL_ERR_ADDRESS -98
+
+/*
+ * Tipo: SyscallService
+ * Parámetros: args - argumentos ya convertidos a entero
+ * Retorna: int - valor para el AC
+ */
+typedef int (*SyscallService)(const int* args);
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del despachador
+ */
+void init_syscalls();                  // Vaciar la tabla de servicios
+
+/*
+ * Función: syscall_register
+ * Parámetros:
+ *   service  - número de servicio
+ *   args     - cantidad de argumentos que se leen del bloque
+ *   name     - nombre para el registro de eventos
+ *   function - implementación
+ */
+void syscall_register(int service, int args, const char* name, SyscallService function);
+
+/*
+ * Función: syscall_dispatch
+ * Propósito: Atender el SVC pendiente (la llama el handler de INT_SYSCALL).
+ */
+void syscall_dispatch();
+
+#endif /* SYSCALL_H */
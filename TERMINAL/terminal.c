@@ -0,0 +1,214 @@
+/*
+ * Archivo de implementación del dispositivo de terminal del Sistema Operativo Virtual.
+ * La salida se acumula en un anillo de enteros y se convierte a texto recién
+ * al entregar el búfer; la entrada se lee del descriptor 0 solo cuando
+ * poll() indica que hay datos, así que el invitado nunca queda esperando.
+ */
+
+/* Macro necesaria para poll() y read() con -std=c99 */
+#define _POSIX_C_SOURCE 200809L
+
+/* Inclusión de cabecera propia del módulo */
+#include "terminal.h"
+
+/* Inclusión de cabeceras de otros módulos */
+#include "../MEMORY/memory.h"         // Para read/write_memory_block
+#include "../INTERRUPTS/interrupts.h" // Para INT_IO_COMPLETION
+#include "../SYSCALL/syscall.h"       // Para registrar los servicios
+#include "../MMIO/mmio.h"             // Para registrar los registros mapeados
+#include "../CODEC/wordcodec.h"       // Para convertir búferes completos
+#include "../LOGGER/logger.h"         // Para registrar eventos
+
+/* Inclusión de bibliotecas estándar */
+#include <stdio.h>    // Para fwrite, snprintf
+#include <poll.h>     // Para consultar la entrada sin bloquear
+#include <unistd.h>   // Para read
+
+/*
+ * VARIABLE GLOBAL - Bandera consultada por bench.exe
+ */
+int terminal_output_enabled = 1;
+
+/*
+ * VARIABLES GLOBALES DEL MÓDULO (privadas)
+ * output     - anillo de salida (se vacía entero en cada entrega)
+ * input      - caracteres leídos del host y aún no consumidos
+ * input_eof  - la entrada del host terminó: no se vuelve a consultar
+ */
+static int output[TERM_RING_WORDS];
+static int pending = 0;
+static int format = TERM_FORMAT_NUMBER;
+static unsigned char input[TERM_INPUT_SIZE];
+static int input_first = 0, input_count = 0;
+static int input_eof = 0;
+
+/*
+ * Función auxiliar: poll_input (ESTÁTICA)
+ * Propósito: Si el búfer de entrada está vacío, traer lo que el host ya
+ *            tenga disponible (una lectura, sin esperar).
+ */
+static void poll_input() {
+    if (input_count > 0 || input_eof) return;
+    struct pollfd fd = { .fd = 0, .events = POLLIN, .revents = 0 };
+    if (poll(&fd, 1, 0) <= 0 || !(fd.revents & (POLLIN | POLLHUP))) return;
+
+    ssize_t got = read(0, input, sizeof(input));
+    if (got <= 0) {
+        input_eof = 1;
+        return;
+    }
+    input_first = 0;
+    input_count = (int)got;
+    trigger_interrupt(INT_IO_COMPLETION);  // Un búfer de entrada recibido
+}
+
+/*
+ * Función: terminal_flush
+ * Propósito: Convertir el anillo a texto y entregarlo con una sola escritura.
+ */
+void terminal_flush() {
+    if (pending == 0) return;
+    if (terminal_output_enabled) {
+        static char text[TERM_RING_WORDS * 10 + 1];  // +1: el NUL que escribe snprintf
+        size_t length = 0;
+        for (int i = 0; i < pending; i++) {
+            if (format == TERM_FORMAT_CHAR) {
+                int c = output[i];
+                text[length++] = (c >= 0 && c < 256) ? (char)c : '?';
+            } else {
+                int written = snprintf(text + length, sizeof(text) - length, "%d\n", output[i]);
+                if (written < 0) break;
+                length += (size_t)written;
+                if (length >= sizeof(text)) {  // Truncado: solo lo que cupo
+                    length = sizeof(text) - 1;
+                    break;
+                }
+            }
+        }
+        fwrite(text, 1, length, stdout);
+        fflush(stdout);
+    }
+    log_event(LOG_DEBUG, "Terminal: %d palabras entregadas", pending);
+    pending = 0;
+    trigger_interrupt(INT_IO_COMPLETION);  // Un búfer de salida completado
+}
+
+/*
+ * Función: terminal_out
+ * Parámetros: value - palabra a mostrar
+ */
+void terminal_out(int value) {
+    output[pending++] = value;
+    if (pending == TERM_RING_WORDS) terminal_flush();
+}
+
+/*
+ * Función: terminal_in
+ * Retorna: int - siguiente carácter de la entrada, o TERM_NO_INPUT
+ */
+int terminal_in() {
+    poll_input();
+    if (input_count == 0) return TERM_NO_INPUT;
+    int c = input[input_first++];
+    input_count--;
+    return c;
+}
+
+/*
+ * Función: terminal_control
+ * Parámetros: command - TERM_CTL_*
+ * Retorna: int - caracteres de entrada disponibles
+ */
+int terminal_control(int command) {
+    switch (command) {
+        case TERM_CTL_NUMBER:
+        case TERM_CTL_CHAR:
+            terminal_flush();  // Lo ya encolado se muestra con el formato anterior
+            format = (command == TERM_CTL_CHAR) ? TERM_FORMAT_CHAR : TERM_FORMAT_NUMBER;
+            break;
+        case TERM_CTL_FLUSH:
+            terminal_flush();
+            break;
+        default:
+            break;
+    }
+    poll_input();
+    return input_count;
+}
+
+/*
+ * Función: terminal_write
+ * Parámetros:
+ *   address - dirección lógica del búfer
+ *   count   - palabras
+ * Retorna: int - count, o SYSCALL_ERR_ADDRESS si el rango es inválido
+ * Propósito: Encolar un búfer completo: el rango se valida una vez y se
+ *            convierte en bloque, en trozos del tamaño del anillo.
+ */
+int terminal_write(int address, int count) {
+    static Word words[TERM_RING_WORDS];
+    if (count < 0) return SYSCALL_ERR_ADDRESS;
+    for (int done = 0; done < count; ) {
+        int chunk = TERM_RING_WORDS - pending;
+        if (chunk > count - done) chunk = count - done;
+        if (read_memory_block(address + done, words, chunk) != 0) return SYSCALL_ERR_ADDRESS;
+        codec_words_to_ints(words, &output[pending], chunk);
+        pending += chunk;
+        done += chunk;
+        if (pending == TERM_RING_WORDS) terminal_flush();
+    }
+    return count;
+}
+
+/*
+ * Función: terminal_read
+ * Parámetros:
+ *   address - dirección lógica del búfer
+ *   max     - caracteres que caben
+ * Retorna: int - caracteres copiados (0 si no hay), o SYSCALL_ERR_ADDRESS
+ */
+int terminal_read(int address, int max) {
+    static int values[TERM_INPUT_SIZE];
+    static Word words[TERM_INPUT_SIZE];
+    poll_input();
+    int count = (max < input_count) ? max : input_count;
+    if (count <= 0) return 0;
+    for (int i = 0; i < count; i++) values[i] = input[input_first + i];
+    codec_ints_to_words(values, words, count);
+    if (write_memory_block(address, words, count) != 0) return SYSCALL_ERR_ADDRESS;
+    input_first += count;
+    input_count -= count;
+    return count;
+}
+
+/*
+ * SERVICIOS SVC (ESTÁTICOS)
+ */
+static int svc_write(const int* args) { return terminal_write(args[0], args[1]); }
+static int svc_read(const int* args) { return terminal_read(args[0], args[1]); }
+
+/*
+ * REGISTROS MAPEADOS EN MEMORIA (ESTÁTICOS, ver MMIO/mmio.h)
+ * +0 DATOS: como IN / OUT; +1 CONTROL: como IO_STATUS
+ */
+static int mmio_read_register(int offset) {
+    return (offset == 0) ? terminal_in() : terminal_control(TERM_CTL_STATUS);
+}
+
+static void mmio_write_register(int offset, int value) {
+    if (offset == 0) terminal_out(value);
+    else terminal_control(value);
+}
+
+/*
+ * Función: init_terminal
+ */
+void init_terminal() {
+    pending = 0;
+    format = TERM_FORMAT_NUMBER;
+    input_first = input_count = 0;
+    input_eof = 0;
+    syscall_register(TERM_SVC_WRITE, 2, "termwrite", svc_write);
+    syscall_register(TERM_SVC_READ, 2, "termread", svc_read);
+    mmio_register("terminal", MMIO_TERMINAL_BASE, 2, mmio_read_register, mmio_write_register);
+}
@@ -0,0 +1,76 @@
+/*
+ * Archivo de cabecera del dispositivo de terminal del Sistema Operativo Virtual.
+ * Es el dispositivo de las instrucciones de E/S:
+ *   IN        - AC = siguiente carácter de la entrada, o TERM_NO_INPUT si
+ *               no hay ninguno (nunca espera)
+ *   OUT op    - encola el operando (#valor o palabra de memoria) en el
+ *               anillo de salida
+ *   IO_STATUS - ejecuta el comando del operando (TERM_CTL_*) y deja en el AC
+ *               los caracteres de entrada disponibles
+ *
+ * La salida se guarda en un anillo de TERM_RING_WORDS palabras y llega al
+ * host en una sola escritura por búfer: cuando el anillo se llena, con
+ * TERM_CTL_FLUSH, al detenerse la CPU o al terminar la ejecución. Cada
+ * búfer entregado (de salida o de entrada) dispara una sola
+ * INT_IO_COMPLETION, no una por carácter.
+ *
+ * Cada palabra se muestra según el formato actual: TERM_FORMAT_NUMBER (el
+ * valor decimal y un salto de línea) o TERM_FORMAT_CHAR (el carácter ASCII).
+ * Los SVC TERM_SVC_WRITE / TERM_SVC_READ transfieren un búfer completo en
+ * una sola operación.
+ */
+
+#ifndef TERMINAL_H
+#define TERMINAL_H
+/*
+ * Directivas de preprocesador para evitar inclusión múltiple.
+ * Garantiza que este archivo solo se incluya una vez durante la compilación.
+ */
+
+/*
+ * CONSTANTES DEL DISPOSITIVO
+ * TERM_RING_WORDS - Palabras del anillo de salida (una escritura al host por búfer)
+ * TERM_INPUT_SIZE - Caracteres del búfer de entrada
+ * TERM_NO_INPUT   - Resultado de IN / lectura sin datos
+ */
+#define TERM_RING_WORDS 256
+#define TERM_INPUT_SIZE 256
+#define TERM_NO_INPUT -1
+
+#define TERM_FORMAT_NUMBER 0
+#define TERM_FORMAT_CHAR 1
+
+/*
+ * COMANDOS DE IO_STATUS (operando inmediato)
+ */
+#define TERM_CTL_STATUS 0        // Solo consultar
+#define TERM_CTL_NUMBER 1        // Formato decimal, una palabra por línea
+#define TERM_CTL_CHAR 2          // Formato de caracteres ASCII
+#define TERM_CTL_FLUSH 3         // Entregar ya el anillo al host
+
+/*
+ * SERVICIOS SVC DEL TERMINAL (ver SYSCALL/syscall.h)
+ *   TERM_SVC_WRITE (dirección, n)   -> n; encola n palabras de una vez
+ *   TERM_SVC_READ  (dirección, max) -> caracteres copiados (0 si no hay; no espera)
+ */
+#define TERM_SVC_WRITE 30
+#define TERM_SVC_READ 31
+
+/*
+ * VARIABLE GLOBAL - 0 para descartar la salida en lugar de escribirla
+ * (bench.exe mide el dispositivo sin llenar la pantalla)
+ */
+extern int terminal_output_enabled;
+
+/*
+ * PROTOTIPOS DE FUNCIONES - Interfaz pública del terminal
+ */
+void init_terminal();                  // Vaciar los búferes y registrar los SVC
+int terminal_in();                     // IN
+void terminal_out(int value);          // OUT
+int terminal_control(int command);     // IO_STATUS; retorna el estado para el AC
+int terminal_write(int address, int count);  // Encolar un rango lógico
+int terminal_read(int address, int max);     // Copiar la entrada disponible
+void terminal_flush();                 // Entregar al host lo pendiente
+
+#endif /* TERMINAL_H */
@@ -1,17 +1,63 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "types.h"
 #include "LOGGER/logger.h"
 #include "MEMORY/memory.h"
 #include "REGISTERS/registers.h"
 #include "INTERRUPTS/interrupts.h"
 #include "DISK/disk.h"
+#include "SYSCALL/syscall.h"
+#include "FS/fs.h"
+#include "SHM/shm.h"
+#include "MSG/msg.h"
+#include "TERMINAL/terminal.h"
+#include "MMIO/mmio.h"
+#include "NET/net.h"
+#include "SIM/sim.h"
 #include "DMA/dma.h"
 #include "CPU/cpu.h"
+#include "PROFILER/profiler.h"
+#include "PROFILER/callgraph.h"
+#include "PROFILER/coverage.h"
+#include "METRICS/metrics.h"
 #include "CONSOLE/console.h"
 
-int main() {
-    printf("=== Inicializando Sistema Operativo Virtual ===\n");
+/*
+ * Función auxiliar: usage
+ * Propósito: Mostrar las opciones de línea de comandos.
+ */
+static void usage(const char* program) {
+    printf("Uso: %s                                   (consola interactiva)\n", program);
+    printf("     %s --script <comandos.txt> [--max-instructions N]\n", program);
+    printf("     %s --run <programa.txt> [--max-instructions N]\n", program);
+}
+
+int main(int argc, char* argv[]) {
+    // Opciones del modo por lotes (sin ellas se usa la consola interactiva)
+    const char* script = NULL;
+    const char* program = NULL;
+    unsigned long long max_instructions = 0;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            script = argv[++i];
+        } else if (strcmp(argv[i], "--run") == 0 && i + 1 < argc) {
+            program = argv[++i];
+        } else if (strcmp(argv[i], "--max-instructions") == 0 && i + 1 < argc) {
+            max_instructions = strtoull(argv[++i], NULL, 10);
+        } else {
+            usage(argv[0]);
+            return BATCH_EXIT_ERROR;
+        }
+    }
+    if (script != NULL && program != NULL) {
+        usage(argv[0]);
+        return BATCH_EXIT_ERROR;
+    }
+    int batch = (script != NULL || program != NULL);
+    
+    if (!batch) printf("=== Inicializando Sistema Operativo Virtual ===\n");
     
     // Inicializar componentes en orden
     init_logger();
@@ -19,18 +65,39 @@ int main() {
     init_registers();
     init_interrupts();
     init_disk();
+    init_syscalls();
+    init_fs();
+    init_shm();
+    init_msg();
+    init_mmio();
+    init_terminal();
+    init_net();
+    init_sim();
     init_dma();
     init_cpu();
-    init_console();
-    
-    printf("Sistema inicializado correctamente.\n");
+    init_profiler();
+    init_callgraph();
+    init_coverage();
+    init_metrics();
+    set_cpu_instruction_limit(max_instructions);
     
-    // Ejecutar consola principal
-    run_console();
+    int status = 0;
+    if (batch) {
+        // Modo por lotes: sin banner ni prompt, código de salida del invitado
+        status = run_batch(script, program);
+    } else {
+        init_console();
+        printf("Sistema inicializado correctamente.\n");
+        
+        // Ejecutar consola principal
+        run_console();
+    }
     
     // Limpieza antes de salir
+    net_detach();
+    close_metrics();
     close_logger();
     
-    printf("=== Sistema finalizado ===\n");
-    return 0;
-}
\ No newline at end of file
+    if (!batch) printf("=== Sistema finalizado ===\n");
+    return status;
+}